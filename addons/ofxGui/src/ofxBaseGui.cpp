@@ -107,7 +107,16 @@ void ofxBaseGui::loadFont(const std::string& filename, int fontsize, bool _bAnti
 }
 
 void ofxBaseGui::loadFont(const ofTrueTypeFontSettings & fontSettings){
-	font.load(fontSettings);
+	// the text meshes are cached and drawn with the font texture, glyphs
+	// loaded on demand could be in other atlas pages or be evicted
+	if(fontSettings.onDemand){
+		ofLogWarning("ofxGui") << "loadFont(): fonts loading glyphs on demand aren't supported, loading every glyph";
+		auto settings = fontSettings;
+		settings.onDemand = false;
+		font.load(settings);
+	}else{
+		font.load(fontSettings);
+	}
 	fontLoaded = true;
 	useTTF = true;
 }
@@ -440,6 +440,36 @@ ofVec3f ofxKinect::getWorldCoordinateAt(float cx, float cy, float wz)  const{
 	return ofVec3f(wx, wy, wz);
 }
 
+//------------------------------------
+bool ofxKinect::setupPointCloud() const{
+	if(kinectDevice == NULL) {
+		ofLogWarning("ofxKinect") << "getWorldCoordinates(): device not connected";
+		return false;
+	}
+	// only recalculates the rays if the device changed
+	pointCloud.setup(getZeroPlanePixelSize(), getZeroPlaneDistance(), width, height);
+	return pointCloud.isSetup();
+}
+
+//------------------------------------
+void ofxKinect::getWorldCoordinates(float * xyz) const{
+	if(setupPointCloud()) {
+		pointCloud.getWorldCoordinates(depthPixelsRaw, xyz);
+	}
+}
+
+//------------------------------------
+void ofxKinect::getWorldCoordinates(ofMesh & mesh, int step, bool bColored) const{
+	if(!setupPointCloud()) {
+		return;
+	}
+	if(bColored && bGrabVideo) {
+		pointCloud.getWorldCoordinates(depthPixelsRaw, videoPixels, mesh, step);
+	} else {
+		pointCloud.getWorldCoordinates(depthPixelsRaw, mesh, step);
+	}
+}
+
 //------------------------------------
 float ofxKinect::getSensorEmitterDistance()  const{
 	return kinectDevice->registration.zero_plane_info.dcmos_emitter_dist;
@@ -44,6 +44,7 @@
 
 
 #include "ofxBase3DVideo.h"
+#include "ofxKinectPointCloud.h"
 
 class ofxKinectContext;
 
@@ -129,6 +130,18 @@ public:
 	ofVec3f getWorldCoordinateAt(int cx, int cy) const;
 	ofVec3f getWorldCoordinateAt(float cx, float cy, float wz) const;
 
+	/// calculates the coordinates in the world for every depth point at
+	/// once, much faster than calling getWorldCoordinateAt() for each of them
+	///
+	/// xyz needs room for width * height * 3 floats, points without depth
+	/// are 0, 0, 0
+	void getWorldCoordinates(float * xyz) const;
+
+	/// replaces the vertices of mesh with the coordinates in the world of
+	/// every step depth points with depth, and its colors with the video
+	/// colors if bColored is true and the video is being grabbed
+	void getWorldCoordinates(ofMesh & mesh, int step=1, bool bColored=true) const;
+
 /// \section Intrinsic IR Sensor Parameters
 
 	/// these values are used when depth registration is enabled to align the
@@ -386,6 +399,9 @@ private:
 	ofShortPixels depthPixelsRawBack;	///< depth back
 	ofPixels videoPixelsBack;			///< rgb back
 
+	mutable ofxKinectPointCloud pointCloud; ///< for getWorldCoordinates()
+	bool setupPointCloud() const;
+
 	vector<unsigned char> depthLookupTable;
 	void updateDepthLookupTable();
 	void updateDepthPixels();
@@ -0,0 +1,514 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#include "ofxKinectPlayer.h"
+
+//--------------------------------------------------------------------
+ofxKinectPlayer::ofxKinectPlayer() {
+	memset(&fileHeader, 0, sizeof(fileHeader));
+	memset(&nextHeader, 0, sizeof(nextHeader));
+	bHasNext = false;
+	bUseTexture = true;
+	frameTimestamp = 0;
+	playStartMicros = 0;
+	currentFrame = 0;
+	nextFrameIndex = 0;
+	bIsFrameNew = false;
+	bIsFrameNewVideo = false;
+	bPaused = false;
+	bLoop = true;
+	bNearWhite = true;
+	setDepthClipping();
+}
+
+//--------------------------------------------------------------------
+ofxKinectPlayer::~ofxKinectPlayer() {
+	close();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::load(const std::string & _filename) {
+	close();
+	if(!file.open(_filename, ofFile::ReadOnly, true)) {
+		ofLogError("ofxKinectPlayer") << "load(): couldn't open \"" << _filename << "\"";
+		return false;
+	}
+	file.read((char*)&fileHeader, sizeof(fileHeader));
+	if(file.gcount() != sizeof(fileHeader)
+	   || memcmp(fileHeader.magic, ofxKinectRecorder::MAGIC, sizeof(fileHeader.magic)) != 0) {
+		ofLogError("ofxKinectPlayer") << "load(): \"" << _filename << "\" is not a kinect recording";
+		close();
+		return false;
+	}
+	if(fileHeader.version != ofxKinectRecorder::VERSION) {
+		ofLogError("ofxKinectPlayer") << "load(): \"" << _filename << "\" has unsupported version " << fileHeader.version;
+		close();
+		return false;
+	}
+	filename = _filename;
+	nextFrameIndex = 0;
+	if(!readHeader() || !readFrame()) {
+		ofLogError("ofxKinectPlayer") << "load(): \"" << _filename << "\" has no frames";
+		close();
+		return false;
+	}
+	showFrame();
+	playStartMicros = ofGetElapsedTimeMicros() - frameTimestamp;
+	return true;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::close() {
+	if(file.is_open()) {
+		file.close();
+	}
+	filename.clear();
+	bHasNext = false;
+	bIsFrameNew = false;
+	bIsFrameNewVideo = false;
+	depthPixelsRaw.clear();
+	depthPixels.clear();
+	videoPixels.clear();
+	distancePixels.clear();
+	depthTex.clear();
+	videoTex.clear();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isInitialized() const {
+	return file.is_open() && depthPixelsRaw.isAllocated();
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::update() {
+	bIsFrameNew = false;
+	bIsFrameNewVideo = false;
+	if(!isInitialized() || bPaused) {
+		return;
+	}
+
+	// read every frame that is due and only decode the last one
+	uint64_t now = ofGetElapsedTimeMicros();
+	bool bRead = false;
+	while(true) {
+		if(!bHasNext) {
+			// wrap at most once per update so a single frame file doesn't spin
+			if(bRead || !bLoop || !rewind()) {
+				break;
+			}
+			playStartMicros = now - nextHeader.timestampMicros;
+		}
+		if(playStartMicros + nextHeader.timestampMicros > now) {
+			break;
+		}
+		if(!readFrame()) {
+			break;
+		}
+		bRead = true;
+	}
+	if(bRead) {
+		showFrame();
+	}
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::nextFrame() {
+	bIsFrameNew = false;
+	bIsFrameNewVideo = false;
+	if(!file.is_open()) {
+		return false;
+	}
+	if(!bHasNext && (!bLoop || !rewind())) {
+		return false;
+	}
+	if(!readFrame()) {
+		return false;
+	}
+	showFrame();
+	playStartMicros = ofGetElapsedTimeMicros() - frameTimestamp;
+	return true;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::firstFrame() {
+	if(!file.is_open() || !rewind() || !readFrame()) {
+		return;
+	}
+	showFrame();
+	playStartMicros = ofGetElapsedTimeMicros() - frameTimestamp;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setPaused(bool _bPaused) {
+	if(bPaused && !_bPaused) {
+		// continue from the current frame
+		playStartMicros = ofGetElapsedTimeMicros() - frameTimestamp;
+	}
+	bPaused = _bPaused;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isPaused() const {
+	return bPaused;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setLoop(bool _bLoop) {
+	bLoop = _bLoop;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isLooping() const {
+	return bLoop;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isDone() const {
+	return file.is_open() && !bHasNext && !bLoop;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isFrameNew() const {
+	return bIsFrameNew;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isFrameNewVideo() const {
+	return bIsFrameNewVideo;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isFrameNewDepth() const {
+	return bIsFrameNew;
+}
+
+//--------------------------------------------------------------------
+uint64_t ofxKinectPlayer::getFrameTimestampMicros() const {
+	return frameTimestamp;
+}
+
+//--------------------------------------------------------------------
+size_t ofxKinectPlayer::getCurrentFrame() const {
+	return currentFrame;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::setPixelFormat(ofPixelFormat pixelFormat) {
+	return pixelFormat == getPixelFormat();
+}
+
+//--------------------------------------------------------------------
+ofPixelFormat ofxKinectPlayer::getPixelFormat() const {
+	return videoPixels.getNumChannels() == 1 ? OF_PIXELS_GRAY : OF_PIXELS_RGB;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getDistanceAt(int x, int y) const {
+	return depthPixelsRaw[y * depthPixelsRaw.getWidth() + x];
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getDistanceAt(const ofPoint & p) const {
+	return getDistanceAt(p.x, p.y);
+}
+
+//--------------------------------------------------------------------
+ofVec3f ofxKinectPlayer::getWorldCoordinateAt(int x, int y) const {
+	return pointCloud.getWorldCoordinateAt(x, y, getDistanceAt(x, y));
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::getWorldCoordinates(float * xyz) const {
+	if(isInitialized()) {
+		pointCloud.getWorldCoordinates(depthPixelsRaw, xyz);
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::getWorldCoordinates(ofMesh & mesh, int step, bool bColored) const {
+	if(!isInitialized()) {
+		return;
+	}
+	if(bColored) {
+		pointCloud.getWorldCoordinates(depthPixelsRaw, videoPixels, mesh, step);
+	} else {
+		pointCloud.getWorldCoordinates(depthPixelsRaw, mesh, step);
+	}
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getZeroPlanePixelSize() const {
+	return fileHeader.zeroPlanePixelSize;
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getZeroPlaneDistance() const {
+	return fileHeader.zeroPlaneDistance;
+}
+
+//--------------------------------------------------------------------
+ofColor ofxKinectPlayer::getColorAt(int x, int y) const {
+	if(!videoPixels.isAllocated()) {
+		return ofColor::black;
+	}
+	return videoPixels.getColor(x, y);
+}
+
+//--------------------------------------------------------------------
+ofColor ofxKinectPlayer::getColorAt(const ofPoint & p) const {
+	return getColorAt(p.x, p.y);
+}
+
+//--------------------------------------------------------------------
+ofPixels & ofxKinectPlayer::getPixels() {
+	return videoPixels;
+}
+
+//--------------------------------------------------------------------
+const ofPixels & ofxKinectPlayer::getPixels() const {
+	return videoPixels;
+}
+
+//--------------------------------------------------------------------
+ofPixels & ofxKinectPlayer::getDepthPixels() {
+	return depthPixels;
+}
+
+//--------------------------------------------------------------------
+const ofPixels & ofxKinectPlayer::getDepthPixels() const {
+	return depthPixels;
+}
+
+//--------------------------------------------------------------------
+ofShortPixels & ofxKinectPlayer::getRawDepthPixels() {
+	return depthPixelsRaw;
+}
+
+//--------------------------------------------------------------------
+const ofShortPixels & ofxKinectPlayer::getRawDepthPixels() const {
+	return depthPixelsRaw;
+}
+
+//--------------------------------------------------------------------
+ofFloatPixels & ofxKinectPlayer::getDistancePixels() {
+	return distancePixels;
+}
+
+//--------------------------------------------------------------------
+const ofFloatPixels & ofxKinectPlayer::getDistancePixels() const {
+	return distancePixels;
+}
+
+//--------------------------------------------------------------------
+ofTexture & ofxKinectPlayer::getTexture() {
+	return videoTex;
+}
+
+//--------------------------------------------------------------------
+const ofTexture & ofxKinectPlayer::getTexture() const {
+	return videoTex;
+}
+
+//--------------------------------------------------------------------
+ofTexture & ofxKinectPlayer::getDepthTexture() {
+	return depthTex;
+}
+
+//--------------------------------------------------------------------
+const ofTexture & ofxKinectPlayer::getDepthTexture() const {
+	return depthTex;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setDepthClipping(float nearClip, float farClip) {
+	nearClipping = nearClip;
+	farClipping = farClip;
+	updateDepthLookupTable();
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::enableDepthNearValueWhite(bool bEnabled) {
+	bNearWhite = bEnabled;
+	updateDepthLookupTable();
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::setUseTexture(bool bUse) {
+	bUseTexture = bUse;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::isUsingTexture() const {
+	return bUseTexture;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::draw(float x, float y, float w, float h) const {
+	if(bUseTexture && videoTex.isAllocated()) {
+		videoTex.draw(x, y, w, h);
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::draw(float x, float y) const {
+	draw(x, y, getWidth(), getHeight());
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::drawDepth(float x, float y, float w, float h) const {
+	if(bUseTexture && depthTex.isAllocated()) {
+		depthTex.draw(x, y, w, h);
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::drawDepth(float x, float y) const {
+	drawDepth(x, y, getWidth(), getHeight());
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getWidth() const {
+	return depthPixelsRaw.getWidth();
+}
+
+//--------------------------------------------------------------------
+float ofxKinectPlayer::getHeight() const {
+	return depthPixelsRaw.getHeight();
+}
+
+/* ***** PRIVATE ***** */
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::readHeader() {
+	bHasNext = false;
+	ofxKinectRecorder::FrameHeader header;
+	file.read((char*)&header, sizeof(header));
+	if(file.gcount() == 0) {
+		return false;
+	}
+	if(file.gcount() != sizeof(header)) {
+		ofLogWarning("ofxKinectPlayer") << "\"" << filename << "\" ends with a truncated frame";
+		return false;
+	}
+	size_t numPixels = size_t(header.width) * header.height;
+	if(numPixels == 0 || header.depthBytes < numPixels || header.depthBytes > numPixels * 3
+	   || (header.videoChannels != 0 && header.videoChannels != 1 && header.videoChannels != 3)
+	   || header.videoBytes != numPixels * header.videoChannels) {
+		ofLogError("ofxKinectPlayer") << "\"" << filename << "\" has a corrupt frame " << nextFrameIndex;
+		return false;
+	}
+	nextHeader = header;
+	bHasNext = true;
+	return true;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::readFrame() {
+	const ofxKinectRecorder::FrameHeader & header = nextHeader;
+	if(depthPixelsRaw.getWidth() != header.width || depthPixelsRaw.getHeight() != header.height) {
+		depthPixelsRaw.allocate(header.width, header.height, 1);
+	}
+	encodedDepth.resize(header.depthBytes);
+	file.read((char*)encodedDepth.data(), header.depthBytes);
+
+	// skipped frames are read too, video is only a copy and the depth is
+	// decoded in showFrame()
+	if(header.videoBytes > 0) {
+		ofPixelFormat format = header.videoChannels == 1 ? OF_PIXELS_GRAY : OF_PIXELS_RGB;
+		if(videoPixels.getWidth() != header.width || videoPixels.getHeight() != header.height
+		   || videoPixels.getPixelFormat() != format) {
+			videoPixels.allocate(header.width, header.height, format);
+		}
+		file.read((char*)videoPixels.getData(), header.videoBytes);
+	} else {
+		videoPixels.clear();
+	}
+
+	if(!file.good()) {
+		ofLogWarning("ofxKinectPlayer") << "\"" << filename << "\" ends with a truncated frame";
+		bHasNext = false;
+		return false;
+	}
+	frameTimestamp = header.timestampMicros;
+	currentFrame = nextFrameIndex++;
+	bIsFrameNewVideo = header.videoBytes > 0;
+	readHeader();
+	return true;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::showFrame() {
+	if(!ofxKinectRecorder::decodeDepth(encodedDepth.data(), encodedDepth.size(), depthPixelsRaw)) {
+		ofLogError("ofxKinectPlayer") << "\"" << filename << "\" has corrupt depth in frame " << currentFrame;
+	}
+	updateDepthPixels();
+	pointCloud.setup(fileHeader.zeroPlanePixelSize, fileHeader.zeroPlaneDistance, depthPixelsRaw.getWidth(), depthPixelsRaw.getHeight());
+	bIsFrameNew = true;
+
+	if(bUseTexture) {
+		if(depthTex.getWidth() != depthPixels.getWidth() || depthTex.getHeight() != depthPixels.getHeight()) {
+			depthTex.allocate(depthPixels);
+		}
+		depthTex.loadData(depthPixels);
+		if(videoPixels.isAllocated()) {
+			if(videoTex.getWidth() != videoPixels.getWidth() || videoTex.getHeight() != videoPixels.getHeight()) {
+				videoTex.allocate(videoPixels);
+			}
+			videoTex.loadData(videoPixels);
+		}
+	}
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectPlayer::rewind() {
+	file.clear();
+	file.seekg(sizeof(ofxKinectRecorder::FileHeader));
+	nextFrameIndex = 0;
+	return readHeader();
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::updateDepthLookupTable() {
+	unsigned char nearColor = bNearWhite ? 255 : 0;
+	unsigned char farColor = bNearWhite ? 0 : 255;
+	unsigned int maxDepthLevels = 10001;
+	depthLookupTable.resize(maxDepthLevels);
+	depthLookupTable[0] = 0;
+	for(unsigned int i = 1; i < maxDepthLevels; i++) {
+		depthLookupTable[i] = ofMap(i, nearClipping, farClipping, nearColor, farColor, true);
+	}
+}
+
+//--------------------------------------------------------------------
+void ofxKinectPlayer::updateDepthPixels() {
+	size_t n = depthPixelsRaw.size();
+	if(depthPixels.getWidth() != depthPixelsRaw.getWidth() || depthPixels.getHeight() != depthPixelsRaw.getHeight()) {
+		depthPixels.allocate(depthPixelsRaw.getWidth(), depthPixelsRaw.getHeight(), 1);
+		distancePixels.allocate(depthPixelsRaw.getWidth(), depthPixelsRaw.getHeight(), 1);
+	}
+	size_t maxDepth = depthLookupTable.size() - 1;
+	for(size_t i = 0; i < n; i++) {
+		distancePixels[i] = depthPixelsRaw[i];
+		depthPixels[i] = depthLookupTable[std::min<size_t>(depthPixelsRaw[i], maxDepth)];
+	}
+}
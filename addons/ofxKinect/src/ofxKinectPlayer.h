@@ -0,0 +1,180 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+#include "ofxBase3DVideo.h"
+#include "ofxKinectPointCloud.h"
+#include "ofxKinectRecorder.h"
+
+/// \class ofxKinectPlayer
+///
+/// plays files recorded with ofxKinectRecorder with the same interface as
+/// ofxKinect, to work on an app or test it without the device
+///
+/// frames are shown at the time they were recorded, read in order, if the
+/// app is slower than the recording the frames it missed are skipped
+///
+class ofxKinectPlayer : public ofxBase3DVideo {
+
+public:
+
+	ofxKinectPlayer();
+	virtual ~ofxKinectPlayer();
+
+	/// open a recording and start playing it
+	bool load(const std::string & filename);
+	void close();
+	bool isInitialized() const;
+
+	/// show the frames that are due since the last update
+	void update();
+
+	/// show the next frame without waiting for its time, returns false at
+	/// the end of the file when not looping
+	bool nextFrame();
+
+	/// go back to the first frame
+	void firstFrame();
+
+	void setPaused(bool bPaused);
+	bool isPaused() const;
+
+	/// start again from the first frame at the end of the file, enabled by default
+	void setLoop(bool bLoop);
+	bool isLooping() const;
+
+	/// true when the last frame has been shown and not looping
+	bool isDone() const;
+
+	/// is the current frame new? this is set by update() or nextFrame()
+	bool isFrameNew() const;
+	bool isFrameNewVideo() const;
+	bool isFrameNewDepth() const;
+
+	/// the time of the current frame since the recording started
+	uint64_t getFrameTimestampMicros() const;
+
+	/// index of the current frame, counting from 0 each loop
+	size_t getCurrentFrame() const;
+
+	/// only the format of the recording is supported
+	bool setPixelFormat(ofPixelFormat pixelFormat);
+	ofPixelFormat getPixelFormat() const;
+
+	/// get the distance in millimeters to a given point
+	float getDistanceAt(int x, int y) const;
+	float getDistanceAt(const ofPoint & p) const;
+
+	/// calculates the coordinate in the world for the depth point
+	ofVec3f getWorldCoordinateAt(int x, int y) const;
+
+	/// world coordinates of every pixel, see ofxKinect::getWorldCoordinates()
+	void getWorldCoordinates(float * xyz) const;
+	void getWorldCoordinates(ofMesh & mesh, int step=1, bool bColored=true) const;
+
+	/// the parameters of the depth camera the file was recorded with
+	float getZeroPlanePixelSize() const;
+	float getZeroPlaneDistance() const;
+
+	ofColor getColorAt(int x, int y) const;
+	ofColor getColorAt(const ofPoint & p) const;
+
+	/// get the pixels of the most recent video frame, empty if the
+	/// recording has no video
+	ofPixels & getPixels();
+	const ofPixels & getPixels() const;
+
+	/// get the grayscale depth pixels
+	ofPixels & getDepthPixels();
+	const ofPixels & getDepthPixels() const;
+
+	/// get the raw depth values in mm
+	ofShortPixels & getRawDepthPixels();
+	const ofShortPixels & getRawDepthPixels() const;
+
+	/// get the distance in millimeters as floats
+	ofFloatPixels & getDistancePixels();
+	const ofFloatPixels & getDistancePixels() const;
+
+	ofTexture & getTexture();
+	const ofTexture & getTexture() const;
+	ofTexture & getDepthTexture();
+	const ofTexture & getDepthTexture() const;
+
+	/// set the near and far clipping of the grayscale depth, as in ofxKinect
+	void setDepthClipping(float nearClip=500, float farClip=4000);
+	void enableDepthNearValueWhite(bool bEnabled=true);
+
+	/// upload the frames to textures, call before load(), enabled by default
+	void setUseTexture(bool bUse);
+	bool isUsingTexture() const;
+
+	void draw(float x, float y, float w, float h) const;
+	void draw(float x, float y) const;
+	void drawDepth(float x, float y, float w, float h) const;
+	void drawDepth(float x, float y) const;
+
+	float getWidth() const;
+	float getHeight() const;
+
+private:
+
+	bool readHeader();
+	bool readFrame();
+	void showFrame();
+	bool rewind();
+	void updateDepthLookupTable();
+	void updateDepthPixels();
+
+	ofFile file;
+	std::string filename;
+	ofxKinectRecorder::FileHeader fileHeader;
+	ofxKinectRecorder::FrameHeader nextHeader; ///< header of the frame after the current one
+	bool bHasNext;
+	std::vector<unsigned char> encodedDepth;
+
+	ofShortPixels depthPixelsRaw;
+	ofPixels depthPixels;
+	ofPixels videoPixels;
+	ofFloatPixels distancePixels;
+	ofTexture depthTex;
+	ofTexture videoTex;
+	bool bUseTexture;
+
+	mutable ofxKinectPointCloud pointCloud;
+
+	uint64_t frameTimestamp;
+	uint64_t playStartMicros; ///< elapsed time when the first frame would have been shown
+	size_t currentFrame;
+	size_t nextFrameIndex;
+	bool bIsFrameNew;
+	bool bIsFrameNewVideo;
+	bool bPaused;
+	bool bLoop;
+
+	std::vector<unsigned char> depthLookupTable;
+	bool bNearWhite;
+	float nearClipping, farClipping;
+};
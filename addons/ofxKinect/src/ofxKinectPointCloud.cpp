@@ -0,0 +1,222 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#include "ofxKinectPointCloud.h"
+
+// SSE2 is always available on x86_64 and NEON is used when compiling for
+// ARM with NEON enabled
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define OFX_KINECT_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define OFX_KINECT_NEON
+	#include <arm_neon.h>
+#endif
+
+bool ofxKinectPointCloud::bUseSIMD = true;
+
+//---------------------------------------------------------------------------
+// writes x, y, z for n depth values of a row, returns how many it processed
+static size_t rowToWorldSIMD(const uint16_t * depth, const float * rayX, float rayY, float * xyz, size_t n){
+#if defined(OFX_KINECT_SSE2)
+	size_t i = 0;
+	__m128 ry = _mm_set1_ps(rayY);
+	__m128i zero = _mm_setzero_si128();
+	for(; i + 4 <= n; i += 4){
+		__m128i d = _mm_loadl_epi64((const __m128i*)(depth + i));
+		__m128 z = _mm_cvtepi32_ps(_mm_unpacklo_epi16(d, zero));
+		__m128 x = _mm_mul_ps(_mm_loadu_ps(rayX + i), z);
+		__m128 y = _mm_mul_ps(ry, z);
+		// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+		__m128 xy01 = _mm_unpacklo_ps(x, y);
+		__m128 xy23 = _mm_unpackhi_ps(x, y);
+		__m128 z0x1 = _mm_shuffle_ps(z, xy01, _MM_SHUFFLE(2,2,0,0));
+		__m128 y1z1 = _mm_shuffle_ps(xy01, z, _MM_SHUFFLE(1,1,3,3));
+		__m128 z2z3 = _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(3,2,3,2));
+		_mm_storeu_ps(xyz + i * 3, _mm_shuffle_ps(xy01, z0x1, _MM_SHUFFLE(2,0,1,0)));
+		_mm_storeu_ps(xyz + i * 3 + 4, _mm_shuffle_ps(y1z1, xy23, _MM_SHUFFLE(1,0,2,0)));
+		_mm_storeu_ps(xyz + i * 3 + 8, _mm_shuffle_ps(z2z3, z2z3, _MM_SHUFFLE(1,3,2,0)));
+	}
+	return i;
+#elif defined(OFX_KINECT_NEON)
+	size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		float32x4x3_t p;
+		p.val[2] = vcvtq_f32_u32(vmovl_u16(vld1_u16(depth + i)));
+		p.val[0] = vmulq_f32(vld1q_f32(rayX + i), p.val[2]);
+		p.val[1] = vmulq_n_f32(p.val[2], rayY);
+		vst3q_f32(xyz + i * 3, p);
+	}
+	return i;
+#else
+	return 0;
+#endif
+}
+
+//---------------------------------------------------------------------------
+static void rowToWorld(const uint16_t * depth, const float * rayX, float rayY, float * xyz, size_t n, bool bUseSIMD){
+	size_t i = bUseSIMD ? rowToWorldSIMD(depth, rayX, rayY, xyz, n) : 0;
+	for(; i < n; i++){
+		float z = depth[i];
+		xyz[i * 3] = rayX[i] * z;
+		xyz[i * 3 + 1] = rayY * z;
+		xyz[i * 3 + 2] = z;
+	}
+}
+
+//---------------------------------------------------------------------------
+ofxKinectPointCloud::ofxKinectPointCloud(){
+	zeroPlanePixelSize = 0;
+	zeroPlaneDistance = 0;
+	width = 0;
+	height = 0;
+}
+
+//---------------------------------------------------------------------------
+void ofxKinectPointCloud::setup(float pixelSize, float distance, int w, int h){
+	if(distance <= 0){
+		ofLogError("ofxKinectPointCloud") << "setup(): zero plane distance must be positive";
+		return;
+	}
+	if(pixelSize == zeroPlanePixelSize && distance == zeroPlaneDistance && w == width && h == height){
+		return;
+	}
+	zeroPlanePixelSize = pixelSize;
+	zeroPlaneDistance = distance;
+	width = w;
+	height = h;
+
+	// libfreenect's freenect_camera_to_world: the pixel size is for a
+	// 1280x1024 image which is scaled by .5 to get the 640x480 depth image
+	double factor = 2.0 * pixelSize / distance;
+	rayX.resize(width);
+	for(int x = 0; x < width; x++){
+		rayX[x] = (x - width / 2) * factor;
+	}
+	rayY.resize(height);
+	for(int y = 0; y < height; y++){
+		rayY[y] = (y - height / 2) * factor;
+	}
+}
+
+//---------------------------------------------------------------------------
+bool ofxKinectPointCloud::isSetup() const{
+	return zeroPlaneDistance > 0;
+}
+
+//---------------------------------------------------------------------------
+float ofxKinectPointCloud::getZeroPlanePixelSize() const{
+	return zeroPlanePixelSize;
+}
+
+//---------------------------------------------------------------------------
+float ofxKinectPointCloud::getZeroPlaneDistance() const{
+	return zeroPlaneDistance;
+}
+
+//---------------------------------------------------------------------------
+int ofxKinectPointCloud::getWidth() const{
+	return width;
+}
+
+//---------------------------------------------------------------------------
+int ofxKinectPointCloud::getHeight() const{
+	return height;
+}
+
+//---------------------------------------------------------------------------
+ofVec3f ofxKinectPointCloud::getWorldCoordinateAt(int x, int y, float z) const{
+	if(x < 0 || x >= width || y < 0 || y >= height){
+		return ofVec3f(0, 0, z);
+	}
+	return ofVec3f(rayX[x] * z, rayY[y] * z, z);
+}
+
+//---------------------------------------------------------------------------
+void ofxKinectPointCloud::getWorldCoordinates(const ofShortPixels & depth, float * xyz) const{
+	if(!isSetup() || (int)depth.getWidth() != width || (int)depth.getHeight() != height){
+		ofLogError("ofxKinectPointCloud") << "getWorldCoordinates(): depth doesn't match the size of the point cloud, call setup first";
+		return;
+	}
+	const uint16_t * d = depth.getData();
+	for(int y = 0; y < height; y++){
+		rowToWorld(d + y * width, rayX.data(), rayY[y], xyz + y * width * 3, width, bUseSIMD);
+	}
+}
+
+//---------------------------------------------------------------------------
+void ofxKinectPointCloud::getWorldCoordinates(const ofShortPixels & depth, ofMesh & mesh, int step) const{
+	getWorldCoordinates(depth, ofPixels(), mesh, step);
+}
+
+//---------------------------------------------------------------------------
+void ofxKinectPointCloud::getWorldCoordinates(const ofShortPixels & depth, const ofPixels & video, ofMesh & mesh, int step) const{
+	if(!isSetup() || (int)depth.getWidth() != width || (int)depth.getHeight() != height){
+		ofLogError("ofxKinectPointCloud") << "getWorldCoordinates(): depth doesn't match the size of the point cloud, call setup first";
+		return;
+	}
+	step = std::max(step, 1);
+	bool bColored = video.isAllocated() && (int)video.getWidth() == width && (int)video.getHeight() == height;
+	size_t channels = video.getNumChannels();
+
+	// every row is converted at once and the pixels with depth on the
+	// step columns copied to the mesh
+	auto & vertices = mesh.getVertices();
+	auto & colors = mesh.getColors();
+	size_t maxPoints = ((width + step - 1) / step) * ((height + step - 1) / step);
+	vertices.resize(maxPoints);
+	colors.resize(bColored ? maxPoints : 0);
+	row.resize(width * 3);
+	size_t n = 0;
+	const uint16_t * d = depth.getData();
+	for(int y = 0; y < height; y += step){
+		rowToWorld(d + y * width, rayX.data(), rayY[y], row.data(), width, bUseSIMD);
+		for(int x = 0; x < width; x += step){
+			if(d[y * width + x] == 0){
+				continue;
+			}
+			vertices[n] = ofDefaultVertexType(row[x * 3], row[x * 3 + 1], row[x * 3 + 2]);
+			if(bColored){
+				const unsigned char * c = video.getData() + (y * width + x) * channels;
+				colors[n] = ofFloatColor(c[0] / 255.f, c[(channels - 1) / 2] / 255.f, c[channels - 1] / 255.f);
+			}
+			n++;
+		}
+	}
+	vertices.resize(n);
+	colors.resize(bColored ? n : 0);
+}
+
+//---------------------------------------------------------------------------
+void ofxKinectPointCloud::setUseSIMD(bool bUse){
+	bUseSIMD = bUse;
+}
+
+//---------------------------------------------------------------------------
+bool ofxKinectPointCloud::isUsingSIMD(){
+#if defined(OFX_KINECT_SSE2) || defined(OFX_KINECT_NEON)
+	return bUseSIMD;
+#else
+	return false;
+#endif
+}
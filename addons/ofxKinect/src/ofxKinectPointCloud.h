@@ -0,0 +1,87 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+
+/// \class ofxKinectPointCloud
+///
+/// converts whole depth frames to world coordinates
+///
+/// uses the same projection as ofxKinect::getWorldCoordinateAt() with the
+/// ray of every column and row precomputed, so converting a frame is a
+/// multiply per coordinate instead of a libfreenect call per pixel. the
+/// conversion is vectorized with SSE2 or NEON when available
+///
+/// ofxKinect and ofxKinectPlayer keep one set up with the parameters of
+/// their device, see getWorldCoordinates()
+///
+class ofxKinectPointCloud {
+
+public:
+
+	ofxKinectPointCloud();
+
+	/// set the parameters of the depth camera, see
+	/// ofxKinect::getZeroPlanePixelSize() & ofxKinect::getZeroPlaneDistance()
+	void setup(float zeroPlanePixelSize, float zeroPlaneDistance, int width=640, int height=480);
+	bool isSetup() const;
+
+	float getZeroPlanePixelSize() const;
+	float getZeroPlaneDistance() const;
+	int getWidth() const;
+	int getHeight() const;
+
+	/// calculates the coordinate in the world for a depth point in mm,
+	/// same as ofxKinect::getWorldCoordinateAt()
+	ofVec3f getWorldCoordinateAt(int x, int y, float z) const;
+
+	/// writes x, y, z for every pixel of a depth frame in mm to xyz, which
+	/// needs room for width * height * 3 floats
+	///
+	/// pixels without depth are 0, 0, 0
+	void getWorldCoordinates(const ofShortPixels & depth, float * xyz) const;
+
+	/// replaces the vertices of mesh with the world coordinates of every
+	/// step pixels with depth, and its colors with the ones of video if it's
+	/// allocated with the same size as the depth
+	void getWorldCoordinates(const ofShortPixels & depth, ofMesh & mesh, int step=1) const;
+	void getWorldCoordinates(const ofShortPixels & depth, const ofPixels & video, ofMesh & mesh, int step=1) const;
+
+	/// use SIMD instructions when available, enabled by default
+	static void setUseSIMD(bool bUseSIMD);
+	static bool isUsingSIMD();
+
+private:
+
+	float zeroPlanePixelSize;
+	float zeroPlaneDistance;
+	int width, height;
+
+	std::vector<float> rayX; ///< world x per mm of depth of each column
+	std::vector<float> rayY; ///< world y per mm of depth of each row
+	mutable std::vector<float> row; ///< one row of coordinates while building a mesh
+
+	static bool bUseSIMD;
+};
@@ -0,0 +1,187 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#include "ofxKinectRecorder.h"
+#include "ofxKinect.h"
+
+const char ofxKinectRecorder::MAGIC[8] = {'O', 'F', 'K', 'I', 'N', 'E', 'C', 'T'};
+
+//--------------------------------------------------------------------
+ofxKinectRecorder::ofxKinectRecorder() {
+	startMicros = 0;
+	numFrames = 0;
+}
+
+//--------------------------------------------------------------------
+ofxKinectRecorder::~ofxKinectRecorder() {
+	close();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::open(const std::string & filename, float zeroPlanePixelSize, float zeroPlaneDistance) {
+	close();
+	if(!file.open(filename, ofFile::WriteOnly, true)) {
+		ofLogError("ofxKinectRecorder") << "open(): couldn't open \"" << filename << "\" for writing";
+		return false;
+	}
+
+	FileHeader header;
+	memcpy(header.magic, MAGIC, sizeof(header.magic));
+	header.version = VERSION;
+	header.zeroPlanePixelSize = zeroPlanePixelSize;
+	header.zeroPlaneDistance = zeroPlaneDistance;
+	header.reserved = 0;
+	file.write((const char*)&header, sizeof(header));
+	if(!file.good()) {
+		ofLogError("ofxKinectRecorder") << "open(): couldn't write to \"" << filename << "\"";
+		file.close();
+		return false;
+	}
+
+	startMicros = ofGetElapsedTimeMicros();
+	numFrames = 0;
+	return true;
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::open(const std::string & filename, const ofxKinect & kinect) {
+	if(!kinect.isConnected()) {
+		ofLogError("ofxKinectRecorder") << "open(): kinect not connected";
+		return false;
+	}
+	return open(filename, kinect.getZeroPlanePixelSize(), kinect.getZeroPlaneDistance());
+}
+
+//--------------------------------------------------------------------
+void ofxKinectRecorder::close() {
+	if(file.is_open()) {
+		file.close();
+	}
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::isOpen() const {
+	return file.is_open();
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::addFrame(const ofxKinect & kinect) {
+	return addFrame(kinect.getRawDepthPixels(), kinect.getPixels(), ofGetElapsedTimeMicros() - startMicros);
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::addFrame(const ofShortPixels & rawDepth, const ofPixels & video, uint64_t timestampMicros) {
+	if(!isOpen()) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): no file open";
+		return false;
+	}
+	if(!rawDepth.isAllocated() || rawDepth.getNumChannels() != 1
+	   || rawDepth.getWidth() > 0xffff || rawDepth.getHeight() > 0xffff) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): depth must be a single channel image";
+		return false;
+	}
+	if(video.isAllocated() && (video.getWidth() != rawDepth.getWidth()
+	   || video.getHeight() != rawDepth.getHeight()
+	   || (video.getNumChannels() != 1 && video.getNumChannels() != 3))) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): video must be gray or rgb and the size of the depth";
+		return false;
+	}
+
+	encodeDepth(rawDepth, encodedDepth);
+
+	FrameHeader header;
+	memset(&header, 0, sizeof(header));
+	header.timestampMicros = timestampMicros;
+	header.depthBytes = encodedDepth.size();
+	header.videoBytes = video.isAllocated() ? video.getTotalBytes() : 0;
+	header.width = rawDepth.getWidth();
+	header.height = rawDepth.getHeight();
+	header.videoChannels = video.isAllocated() ? video.getNumChannels() : 0;
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)encodedDepth.data(), encodedDepth.size());
+	if(header.videoBytes > 0) {
+		file.write((const char*)video.getData(), header.videoBytes);
+	}
+	if(!file.good()) {
+		ofLogError("ofxKinectRecorder") << "addFrame(): couldn't write frame " << numFrames;
+		return false;
+	}
+	numFrames++;
+	return true;
+}
+
+//--------------------------------------------------------------------
+size_t ofxKinectRecorder::getNumFrames() const {
+	return numFrames;
+}
+
+//--------------------------------------------------------------------
+void ofxKinectRecorder::encodeDepth(const ofShortPixels & rawDepth, std::vector<unsigned char> & encoded) {
+	size_t w = rawDepth.getWidth();
+	size_t h = rawDepth.getHeight();
+	// a 16 bit difference zigzag encoded takes at most 17 bits, 3 bytes
+	encoded.resize(w * h * 3);
+	unsigned char * out = encoded.data();
+	const unsigned short * depth = rawDepth.getData();
+	for(size_t y = 0; y < h; y++) {
+		int previous = 0;
+		for(size_t x = 0; x < w; x++) {
+			int delta = int(*depth) - previous;
+			previous = *depth++;
+			uint32_t zigzag = (uint32_t(delta) << 1) ^ uint32_t(delta >> 31);
+			while(zigzag >= 0x80) {
+				*out++ = (zigzag & 0x7f) | 0x80;
+				zigzag >>= 7;
+			}
+			*out++ = zigzag;
+		}
+	}
+	encoded.resize(out - encoded.data());
+}
+
+//--------------------------------------------------------------------
+bool ofxKinectRecorder::decodeDepth(const unsigned char * encoded, size_t size, ofShortPixels & rawDepth) {
+	const unsigned char * end = encoded + size;
+	size_t w = rawDepth.getWidth();
+	size_t h = rawDepth.getHeight();
+	unsigned short * depth = rawDepth.getData();
+	for(size_t y = 0; y < h; y++) {
+		int previous = 0;
+		for(size_t x = 0; x < w; x++) {
+			uint32_t zigzag = 0;
+			int shift = 0;
+			unsigned char byte;
+			do {
+				if(encoded == end || shift > 14) {
+					return false;
+				}
+				byte = *encoded++;
+				zigzag |= uint32_t(byte & 0x7f) << shift;
+				shift += 7;
+			} while(byte & 0x80);
+			previous += int(zigzag >> 1) ^ -int(zigzag & 1);
+			*depth++ = previous;
+		}
+	}
+	return encoded == end;
+}
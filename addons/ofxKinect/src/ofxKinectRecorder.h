@@ -0,0 +1,108 @@
+/*==============================================================================
+
+    Copyright (c) 2010, 2011 ofxKinect Team
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+    THE SOFTWARE.
+    
+==============================================================================*/
+#pragma once
+
+#include "ofMain.h"
+
+class ofxKinect;
+
+/// \class ofxKinectRecorder
+///
+/// records the raw depth and the video of a kinect to a file with the time
+/// of each frame, see ofxKinectPlayer to play it back without the device
+///
+/// the file starts with a header: "OFKINECT", the format version and the
+/// zero plane pixel size and distance of the depth camera, followed by the
+/// frames, each a FrameHeader, the depth and the video
+///
+/// the depth is stored as the difference with the previous pixel of its
+/// row, zigzag varint encoded, since neighbouring pixels have close depths
+/// most of them take 1 byte instead of 2. the video is stored as is.
+/// values are written in the byte order of the machine, little endian in
+/// every platform supported by libfreenect
+///
+class ofxKinectRecorder {
+
+public:
+
+	ofxKinectRecorder();
+	~ofxKinectRecorder();
+
+	/// start recording to a file, the zero plane values are the parameters
+	/// of the depth camera needed to get world coordinates when playing
+	bool open(const std::string & filename, float zeroPlanePixelSize, float zeroPlaneDistance);
+
+	/// start recording the frames of a connected kinect
+	bool open(const std::string & filename, const ofxKinect & kinect);
+
+	/// finish the recording
+	void close();
+
+	bool isOpen() const;
+
+	/// add the current depth and video of a kinect, timestamped with the
+	/// time since open(), call it when kinect.isFrameNew()
+	bool addFrame(const ofxKinect & kinect);
+
+	/// add a frame, video can be unallocated to record only the depth
+	bool addFrame(const ofShortPixels & rawDepth, const ofPixels & video, uint64_t timestampMicros);
+
+	size_t getNumFrames() const;
+
+/// \section File Format
+
+	static const char MAGIC[8];
+	static const uint32_t VERSION = 1;
+
+	struct FileHeader {
+		char magic[8];
+		uint32_t version;
+		float zeroPlanePixelSize;
+		float zeroPlaneDistance;
+		uint32_t reserved;
+	};
+
+	struct FrameHeader {
+		uint64_t timestampMicros;
+		uint32_t depthBytes;	///< size of the encoded depth
+		uint32_t videoBytes;	///< 0 if there's no video
+		uint16_t width;
+		uint16_t height;
+		uint8_t videoChannels;	///< 1 for infrared, 3 for rgb
+		uint8_t reserved[3];
+	};
+
+	/// encode a depth frame as described above
+	static void encodeDepth(const ofShortPixels & rawDepth, std::vector<unsigned char> & encoded);
+
+	/// decode a depth frame into an allocated rawDepth, returns false if the data is corrupt
+	static bool decodeDepth(const unsigned char * encoded, size_t size, ofShortPixels & rawDepth);
+
+private:
+
+	ofFile file;
+	uint64_t startMicros;
+	size_t numFrames;
+	std::vector<unsigned char> encodedDepth;
+};
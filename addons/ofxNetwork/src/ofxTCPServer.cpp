@@ -3,6 +3,364 @@
 #include "ofUtils.h"
 #include "ofLog.h"
 
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+
+#ifdef TARGET_LINUX
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace{
+	//--------------------------
+	// byte ring buffer with a power of two capacity, queued data and free
+	// space are each accessible as at most two contiguous spans
+	class RingBuffer{
+	public:
+		struct Span{
+			char * data;
+			std::size_t size;
+		};
+
+		void allocate(std::size_t bytes){
+			std::size_t capacity = 1;
+			while(capacity < bytes) capacity *= 2;
+			buffer.assign(capacity, 0);
+			head = tail = 0;
+		}
+
+		std::size_t size() const{ return tail - head; }
+		std::size_t capacity() const{ return buffer.size(); }
+		std::size_t space() const{ return capacity() - size(); }
+		bool empty() const{ return head == tail; }
+
+		char at(std::size_t i) const{
+			return buffer[(head + i) & (capacity() - 1)];
+		}
+
+		int readable(Span spans[2]){ return getSpans(head, size(), spans); }
+		int writable(Span spans[2]){ return getSpans(tail, space(), spans); }
+
+		void produce(std::size_t bytes){ tail += bytes; }
+
+		void consume(std::size_t bytes){
+			head += bytes;
+			if(head == tail) head = tail = 0;
+		}
+
+		std::size_t peek(char * dst, std::size_t bytes) const{
+			bytes = std::min(bytes, size());
+			if(bytes == 0) return 0;
+			std::size_t start = head & (capacity() - 1);
+			std::size_t first = std::min(bytes, capacity() - start);
+			memcpy(dst, buffer.data() + start, first);
+			memcpy(dst + first, buffer.data(), bytes - first);
+			return bytes;
+		}
+
+		std::size_t read(char * dst, std::size_t bytes){
+			bytes = peek(dst, bytes);
+			consume(bytes);
+			return bytes;
+		}
+
+		// appends bytes growing the buffer as needed, fails if that
+		// would make it bigger than maxCapacity
+		bool write(const char * src, std::size_t bytes, std::size_t maxCapacity){
+			if(space() < bytes){
+				std::size_t newCapacity = std::max<std::size_t>(capacity(), 1024);
+				while(newCapacity - size() < bytes) newCapacity *= 2;
+				if(newCapacity > maxCapacity) return false;
+				std::vector<char> grown(newCapacity);
+				std::size_t queued = peek(grown.data(), size());
+				buffer.swap(grown);
+				head = 0;
+				tail = queued;
+			}
+			Span spans[2];
+			int numSpans = writable(spans);
+			std::size_t written = 0;
+			for(int i = 0; i < numSpans && written < bytes; i++){
+				std::size_t n = std::min(spans[i].size, bytes - written);
+				memcpy(spans[i].data, src + written, n);
+				written += n;
+			}
+			produce(bytes);
+			return true;
+		}
+
+		// position of the first delimiter starting at or after from
+		std::size_t find(const std::string & delimiter, std::size_t from) const{
+			std::size_t n = size();
+			std::size_t d = delimiter.size();
+			for(std::size_t i = from; d > 0 && i + d <= n; i++){
+				std::size_t j = 0;
+				while(j < d && at(i + j) == delimiter[j]) j++;
+				if(j == d) return i;
+			}
+			return std::string::npos;
+		}
+
+	private:
+		int getSpans(std::size_t position, std::size_t bytes, Span spans[2]){
+			if(bytes == 0) return 0;
+			std::size_t start = position & (capacity() - 1);
+			std::size_t first = std::min(bytes, capacity() - start);
+			spans[0].data = buffer.data() + start;
+			spans[0].size = first;
+			if(first == bytes) return 1;
+			spans[1].data = buffer.data();
+			spans[1].size = bytes - first;
+			return 2;
+		}
+
+		std::vector<char> buffer;
+		std::size_t head = 0;
+		std::size_t tail = 0;
+	};
+
+	// epoll tokens for the listening socket and the wake up eventfd,
+	// client events carry the client id
+	const std::uint64_t listenToken = std::numeric_limits<std::uint64_t>::max();
+	const std::uint64_t wakeToken = listenToken - 1;
+}
+
+//--------------------------
+// state of a client of the event driven server, only accessed while
+// holding the server's mConnectionsLock
+struct ofxTCPServer::EventClient{
+	struct Segment{
+		const char * data;
+		std::size_t size;
+	};
+
+	// sends anything still pending followed by segments in one call,
+	// queuing whatever the socket doesn't accept right away
+	bool send(std::initializer_list<Segment> segments);
+	bool flush(){ return send({}); }
+
+	// same semantics as the ofxTCPClient methods but reading from the
+	// receive buffer instead of the socket
+	std::string receive(const std::string & delimiter);
+	int receiveRawMsg(char * receiveBuffer, int numBytes, const std::string & delimiter);
+	int receiveRawBytes(char * receiveBuffer, int numBytes);
+	int peekReceiveRawBytes(char * receiveBuffer, int numBytes);
+
+	// ofxTCPClient::send follows the delimiter with a 0, after receive()
+	// drops it from the receive buffer, now or once it arrives
+	void dropTerminator(){
+		if(terminated && !received.empty()){
+			if(received.at(0) == 0) received.consume(1);
+			terminated = false;
+		}
+	}
+
+	// shuts the socket down, the reactor then removes the client
+	void disconnect();
+
+	// the peer closed the connection, the client is kept until the data
+	// still in the socket and the receive buffer has been read
+	void hangUp(){
+		if(connected){
+			connected = false;
+			draining = true;
+			updateEvents();
+		}
+	}
+
+	// the reactor removes the client once it's disconnected and, if
+	// it was the peer that hung up, there's nothing left to read
+	bool isRemovable() const{
+		return !connected && (!draining || (eof && received.empty()));
+	}
+
+	// arms EPOLLIN while there's space to receive and EPOLLOUT while
+	// there's data pending to be sent. a client that is draining is
+	// only watched while it can read or once it can be removed, since
+	// its hang up would otherwise keep waking up the reactor
+	void updateEvents();
+
+	int id = -1;
+	int fd = -1;
+	int epollFd = -1;
+	std::string ip = "000.000.000.000";
+	int port = 0;
+	bool connected = true;
+	bool draining = false; ///< the peer hung up but there's still data to read
+	bool eof = false; ///< the socket has nothing else to read
+	bool watching = true;
+	bool terminated = false; ///< a 0 after the last delimiter is still to be dropped
+	bool reading = true;
+	bool writing = false;
+	int messageSize = 0;
+	std::size_t searched = 0; ///< received bytes known not to start a delimiter
+	std::size_t maxPending = 0;
+	RingBuffer received;
+	RingBuffer pending;
+};
+
+//--------------------------
+std::string ofxTCPServer::EventClient::receive(const std::string & delimiter){
+	std::size_t pos = received.find(delimiter, searched);
+	if(pos == std::string::npos){
+		searched = received.size() >= delimiter.size() ? received.size() - delimiter.size() + 1 : 0;
+		return "";
+	}
+	std::string message(pos, 0);
+	received.read(&message[0], pos);
+	received.consume(delimiter.size());
+	searched = 0;
+	terminated = true;
+	dropTerminator();
+	updateEvents();
+	// a sender terminating the message before the delimiter, any
+	// other 0 is part of the message
+	if(!message.empty() && message[message.size() - 1] == 0){
+		message.erase(message.size() - 1);
+	}
+	return message;
+}
+
+//--------------------------
+int ofxTCPServer::EventClient::receiveRawMsg(char * receiveBuffer, int numBytes, const std::string & delimiter){
+	std::size_t pos = received.find(delimiter, searched);
+	if(pos == std::string::npos){
+		searched = received.size() >= delimiter.size() ? received.size() - delimiter.size() + 1 : 0;
+		return 0;
+	}
+	int copied = received.peek(receiveBuffer, std::min<std::size_t>(pos, std::max(numBytes, 0)));
+	received.consume(pos + delimiter.size());
+	searched = 0;
+	terminated = false;
+	updateEvents();
+	return copied;
+}
+
+//--------------------------
+int ofxTCPServer::EventClient::receiveRawBytes(char * receiveBuffer, int numBytes){
+	messageSize = received.read(receiveBuffer, std::max(numBytes, 0));
+	searched = 0;
+	terminated = false;
+	updateEvents();
+	return messageSize;
+}
+
+//--------------------------
+int ofxTCPServer::EventClient::peekReceiveRawBytes(char * receiveBuffer, int numBytes){
+	messageSize = received.peek(receiveBuffer, std::max(numBytes, 0));
+	return messageSize;
+}
+
+#ifdef TARGET_LINUX
+//--------------------------
+bool ofxTCPServer::EventClient::send(std::initializer_list<Segment> segments){
+	if(!connected) return false;
+
+	iovec iov[2 + 4];
+	int count = 0;
+	RingBuffer::Span spans[2];
+	int numSpans = pending.readable(spans);
+	for(int i = 0; i < numSpans; i++){
+		iov[count].iov_base = spans[i].data;
+		iov[count].iov_len = spans[i].size;
+		count++;
+	}
+	for(auto & segment: segments){
+		if(segment.size > 0 && count < 6){
+			iov[count].iov_base = const_cast<char*>(segment.data);
+			iov[count].iov_len = segment.size;
+			count++;
+		}
+	}
+	if(count == 0) return true;
+
+	// sendmsg instead of writev to be able to pass MSG_NOSIGNAL
+	msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = count;
+	ssize_t ret = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+	if(ret < 0){
+		if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR){
+			hangUp();
+			return false;
+		}
+		ret = 0;
+	}
+
+	std::size_t sent = ret;
+	std::size_t sentPending = std::min(sent, pending.size());
+	pending.consume(sentPending);
+	sent -= sentPending;
+	for(auto & segment: segments){
+		std::size_t sentSegment = std::min(sent, segment.size);
+		sent -= sentSegment;
+		if(sentSegment < segment.size && !pending.write(segment.data + sentSegment, segment.size - sentSegment, maxPending)){
+			ofLogWarning("ofxTCPServer") << "client " << id << " is not keeping up, send buffer full, disconnecting";
+			disconnect();
+			return false;
+		}
+	}
+	updateEvents();
+	return true;
+}
+
+//--------------------------
+void ofxTCPServer::EventClient::disconnect(){
+	if(connected || draining){
+		connected = false;
+		draining = false;
+		::shutdown(fd, SHUT_RDWR);
+		updateEvents();
+	}
+}
+
+//--------------------------
+void ofxTCPServer::EventClient::updateEvents(){
+	bool read = (connected || draining) && !eof && received.space() > 0;
+	bool write = connected && !pending.empty();
+	bool watch = !draining || read || isRemovable();
+	if(read == reading && write == writing && watch == watching) return;
+	reading = read;
+	writing = write;
+	if(!watch){
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+		watching = false;
+		return;
+	}
+	epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLRDHUP;
+	if(reading) event.events |= EPOLLIN;
+	if(writing) event.events |= EPOLLOUT;
+	event.data.u64 = id;
+	epoll_ctl(epollFd, watching ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event);
+	watching = true;
+}
+#else
+//--------------------------
+bool ofxTCPServer::EventClient::send(std::initializer_list<Segment>){
+	return false;
+}
+
+//--------------------------
+void ofxTCPServer::EventClient::disconnect(){
+	connected = false;
+	draining = false;
+}
+
+//--------------------------
+void ofxTCPServer::EventClient::updateEvents(){}
+#endif
+
 //--------------------------
 ofxTCPServer::ofxTCPServer(){
 	connected	= false;
@@ -11,6 +369,12 @@ ofxTCPServer::ofxTCPServer(){
 	str			= "";
 	messageDelimiter = "[/TCP]";
 	bClientBlocking = false;
+	eventDriven	= false;
+	listenFd	= -1;
+	epollFd		= -1;
+	wakeFd		= -1;
+	receiveBufferSize = 0;
+	sendBufferSize = 0;
 }
 
 //--------------------------
@@ -35,6 +399,14 @@ bool ofxTCPServer::setup(int _port, bool blocking){
 
 //--------------------------
 bool ofxTCPServer::setup(const ofxTCPSettings &settings){
+	if(settings.eventDriven){
+#ifdef TARGET_LINUX
+		return setupEventDriven(settings);
+#else
+		ofLogWarning("ofxTCPServer") << "setup(): event driven mode is only available on linux, using the default mode";
+#endif
+	}
+
 	if( !TCPServer.Create() ){
 		ofLogError("ofxTCPServer") << "setup(): couldn't create server";
 		return false;
@@ -66,6 +438,25 @@ void ofxTCPServer::setMessageDelimiter(std::string delim){
 
 //--------------------------
 bool ofxTCPServer::close(){
+	if(eventDriven){
+		stopThread();
+#ifdef TARGET_LINUX
+		// wake up the reactor so it sees the thread has been stopped
+		std::uint64_t wake = 1;
+		if(::write(wakeFd, &wake, sizeof(wake)) < 0){
+			ofLogWarning("ofxTCPServer") << "close(): couldn't wake up the reactor thread";
+		}
+		waitForThread(false);
+		::close(listenFd);
+		::close(epollFd);
+		::close(wakeFd);
+#endif
+		listenFd = epollFd = wakeFd = -1;
+		eventDriven = false;
+		ofLogVerbose("ofxTCPServer") << "Closing server";
+		return true;
+	}
+
     stopThread();
 	if( !TCPServer.Close() ){
 		ofLogWarning("ofxTCPServer") << "close(): couldn't close connections";
@@ -82,12 +473,19 @@ ofxTCPClient & ofxTCPServer::getClient(int clientID){
 	return *TCPConnections.find(clientID)->second;
 }
 
+ofxTCPServer::EventClient & ofxTCPServer::getEventClient(int clientID){
+	return *eventClients.find(clientID)->second;
+}
+
 //--------------------------
 bool ofxTCPServer::disconnectClient(int clientID){
 	std::unique_lock<std::mutex> lck( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "disconnectClient(): client " << clientID << " doesn't exist";
 		return false;
+	}else if(eventDriven){
+		getEventClient(clientID).disconnect();
+		return true;
 	}else if(getClient(clientID).close()){
 		TCPConnections.erase(clientID);
 		return true;
@@ -98,6 +496,9 @@ bool ofxTCPServer::disconnectClient(int clientID){
 //--------------------------
 bool ofxTCPServer::disconnectAllClients(){
 	std::unique_lock<std::mutex> lck( mConnectionsLock );
+	for(auto & client: eventClients){
+		client.second->disconnect();
+	}
     TCPConnections.clear();
     return true;
 }
@@ -108,6 +509,8 @@ bool ofxTCPServer::send(int clientID, std::string message){
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "send(): client " << clientID << " doesn't exist";
 		return false;
+	}else if(eventDriven){
+		return getEventClient(clientID).send({{message.c_str(), message.size()}, {messageDelimiter.c_str(), messageDelimiter.size()}, {"", 1}});
 	}else{
         auto ret = getClient(clientID).send(message);
 		if(!getClient(clientID).isConnected()) TCPConnections.erase(clientID);
@@ -118,6 +521,15 @@ bool ofxTCPServer::send(int clientID, std::string message){
 //--------------------------
 bool ofxTCPServer::sendToAll(std::string message){
 	std::unique_lock<std::mutex> lck( mConnectionsLock );
+	if(eventDriven){
+		// the message is gathered with the delimiter for each client
+		// instead of being copied into a new string
+		if(eventClients.empty()) return false;
+		for(auto & client: eventClients){
+			client.second->send({{message.c_str(), message.size()}, {messageDelimiter.c_str(), messageDelimiter.size()}, {"", 1}});
+		}
+		return true;
+	}
 	if(TCPConnections.size() == 0) return false;
 
 	std::vector<int> disconnect;
@@ -138,6 +550,10 @@ std::string ofxTCPServer::receive(int clientID){
 		ofLogWarning("ofxTCPServer") << "receive(): client " << clientID << " doesn't exist";
 		return "client " + ofToString(clientID) + "doesn't exist";
 	}
+
+	if(eventDriven){
+		return getEventClient(clientID).receive(messageDelimiter);
+	}
 	
 	if( !getClient(clientID).isConnected() ){
         TCPConnections.erase(clientID);
@@ -155,6 +571,9 @@ bool ofxTCPServer::sendRawBytes(int clientID, const char * rawBytes, const int n
 		
 		return false;
 	}
+	else if(eventDriven){
+		return numBytes > 0 && getEventClient(clientID).send({{rawBytes, std::size_t(numBytes)}});
+	}
 	else{
 		return getClient(clientID).sendRawBytes(rawBytes, numBytes);
 	}
@@ -163,6 +582,13 @@ bool ofxTCPServer::sendRawBytes(int clientID, const char * rawBytes, const int n
 //--------------------------
 bool ofxTCPServer::sendRawBytesToAll(const char * rawBytes, const int numBytes){
 	std::unique_lock<std::mutex> lck( mConnectionsLock );
+	if(eventDriven){
+		if(eventClients.empty() || numBytes <= 0) return false;
+		for(auto & client: eventClients){
+			client.second->send({{rawBytes, std::size_t(numBytes)}});
+		}
+		return true;
+	}
 	if(TCPConnections.size() == 0 || numBytes <= 0) return false;
 
 	for(auto & conn: TCPConnections){
@@ -181,6 +607,9 @@ bool ofxTCPServer::sendRawMsg(int clientID, const char * rawBytes, const int num
 		ofLogWarning("ofxTCPServer") << "sendRawMsg(): client " << clientID << " doesn't exist";
 		return false;
 	}
+	else if(eventDriven){
+		return getEventClient(clientID).send({{rawBytes, std::size_t(std::max(numBytes, 0))}, {messageDelimiter.c_str(), messageDelimiter.size()}});
+	}
 	else{
 		return getClient(clientID).sendRawMsg(rawBytes, numBytes);
 	}
@@ -189,6 +618,13 @@ bool ofxTCPServer::sendRawMsg(int clientID, const char * rawBytes, const int num
 //--------------------------
 bool ofxTCPServer::sendRawMsgToAll(const char * rawBytes, const int numBytes){
 	std::unique_lock<std::mutex> lck( mConnectionsLock );
+	if(eventDriven){
+		if(eventClients.empty() || numBytes <= 0) return false;
+		for(auto & client: eventClients){
+			client.second->send({{rawBytes, std::size_t(numBytes)}, {messageDelimiter.c_str(), messageDelimiter.size()}});
+		}
+		return true;
+	}
 	if(TCPConnections.empty() || numBytes <= 0) return false;
 
 	for(auto & conn: TCPConnections){
@@ -207,6 +643,9 @@ int ofxTCPServer::getNumReceivedBytes(int clientID){
 		return 0;
 	}
 
+	if(eventDriven){
+		return getEventClient(clientID).messageSize;
+	}
 	return getClient(clientID).getNumReceivedBytes();
 }
 
@@ -218,6 +657,9 @@ int ofxTCPServer::receiveRawBytes(int clientID, char * receiveBytes,  int numByt
 		return 0;
 	}
 
+	if(eventDriven){
+		return getEventClient(clientID).receiveRawBytes(receiveBytes, numBytes);
+	}
 	return getClient(clientID).receiveRawBytes(receiveBytes, numBytes);
 }
 
@@ -230,6 +672,9 @@ int ofxTCPServer::peekReceiveRawBytes(int clientID, char * receiveBytes,  int nu
 		return 0;
 	}
 
+	if(eventDriven){
+		return getEventClient(clientID).peekReceiveRawBytes(receiveBytes, numBytes);
+	}
 	return getClient(clientID).peekReceiveRawBytes(receiveBytes, numBytes);
 }
 
@@ -241,6 +686,9 @@ int ofxTCPServer::receiveRawMsg(int clientID, char * receiveBytes,  int numBytes
 		return 0;
 	}
 
+	if(eventDriven){
+		return getEventClient(clientID).receiveRawMsg(receiveBytes, numBytes, messageDelimiter);
+	}
 	return getClient(clientID).receiveRawMsg(receiveBytes, numBytes);
 }
 
@@ -251,6 +699,7 @@ int ofxTCPServer::getClientPort(int clientID){
 		ofLogWarning("ofxTCPServer") << "getClientPort(): client " << clientID << " doesn't exist";
 		return 0;
 	}
+	else if(eventDriven) return getEventClient(clientID).port;
 	else return getClient(clientID).getPort();
 }
 
@@ -261,11 +710,16 @@ std::string ofxTCPServer::getClientIP(int clientID){
 		ofLogWarning("ofxTCPServer") << "getClientIP(): client " << clientID << " doesn't exist";
 		return "000.000.000.000";
 	}
+	else if(eventDriven) return getEventClient(clientID).ip;
 	else return getClient(clientID).getIP();
 }
 
 //--------------------------
 int ofxTCPServer::getNumClients(){
+	if(eventDriven){
+		std::unique_lock<std::mutex> lck( mConnectionsLock );
+		return eventClients.size();
+	}
 	return TCPConnections.size();
 }
 
@@ -286,26 +740,32 @@ bool ofxTCPServer::isConnected(){
 
 //--------------------------
 bool ofxTCPServer::isClientSetup(int clientID){
+	if(eventDriven){
+		return eventClients.find(clientID)!=eventClients.end();
+	}
 	return TCPConnections.find(clientID)!=TCPConnections.end();
 }
 
 //--------------------------
 bool ofxTCPServer::isClientConnected(int clientID){
 	std::unique_lock<std::mutex> lck( mConnectionsLock );
+	if(eventDriven){
+		return isClientSetup(clientID) && getEventClient(clientID).connected;
+	}
 	return isClientSetup(clientID) && getClient(clientID).isConnected();
 }
 
 
 void ofxTCPServer::waitConnectedClient(){
 	std::unique_lock<std::mutex> lck( mConnectionsLock );
-	if(TCPConnections.empty()){
+	if(TCPConnections.empty() && eventClients.empty()){
 		serverReady.wait(lck);
 	}
 }
 
 void ofxTCPServer::waitConnectedClient(int ms){
 	std::unique_lock<std::mutex> lck( mConnectionsLock );
-	if(TCPConnections.empty()){
+	if(TCPConnections.empty() && eventClients.empty()){
 		serverReady.wait_for(lck, std::chrono::milliseconds(ms));
 	}
 }
@@ -314,6 +774,13 @@ void ofxTCPServer::waitConnectedClient(int ms){
 //--------------------------
 void ofxTCPServer::threadedFunction(){
 
+	if(eventDriven){
+#ifdef TARGET_LINUX
+		eventLoop();
+#endif
+		return;
+	}
+
 	ofLogVerbose("ofxTCPServer") << "listening thread started";
 	while( isThreadRunning() ){
 		
@@ -359,7 +826,228 @@ void ofxTCPServer::threadedFunction(){
 	ofLogVerbose("ofxTCPServer") << "listening thread stopped";
 }
 
+#ifdef TARGET_LINUX
+//--------------------------
+bool ofxTCPServer::setupEventDriven(const ofxTCPSettings & settings){
+	auto closeAll = [this]{
+		if(listenFd >= 0) ::close(listenFd);
+		if(epollFd >= 0) ::close(epollFd);
+		if(wakeFd >= 0) ::close(wakeFd);
+		listenFd = epollFd = wakeFd = -1;
+	};
 
+	listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(listenFd < 0){
+		ofLogError("ofxTCPServer") << "setup(): couldn't create server";
+		return false;
+	}
+	if(settings.reuse){
+		int enable = 1;
+		setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+	}
+	sockaddr_in local;
+	memset(&local, 0, sizeof(local));
+	local.sin_family = AF_INET;
+	local.sin_addr.s_addr = INADDR_ANY;
+	local.sin_port = htons(settings.port);
+	if(::bind(listenFd, (sockaddr*)&local, sizeof(local)) < 0){
+		ofLogError("ofxTCPServer") << "setup(): couldn't bind to port " << settings.port;
+		closeAll();
+		return false;
+	}
+	if(::listen(listenFd, SOMAXCONN) < 0){
+		ofLogError("ofxTCPServer") << "setup(): listening failed on port " << settings.port;
+		closeAll();
+		return false;
+	}
 
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	epoll_event listenEvent, wakeEvent;
+	memset(&listenEvent, 0, sizeof(listenEvent));
+	memset(&wakeEvent, 0, sizeof(wakeEvent));
+	listenEvent.events = EPOLLIN;
+	listenEvent.data.u64 = listenToken;
+	wakeEvent.events = EPOLLIN;
+	wakeEvent.data.u64 = wakeToken;
+	if(epollFd < 0 || wakeFd < 0 ||
+	   epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) < 0 ||
+	   epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent) < 0){
+		ofLogError("ofxTCPServer") << "setup(): couldn't create epoll reactor: " << strerror(errno);
+		closeAll();
+		return false;
+	}
+
+	eventDriven			= true;
+	connected			= true;
+	idCount				= 0;
+	port				= settings.port;
+	receiveBufferSize	= std::max<std::size_t>(settings.receiveBufferSize, 1);
+	sendBufferSize		= settings.sendBufferSize;
+	setMessageDelimiter(settings.messageDelimiter);
+
+	startThread();
+	return true;
+}
+
+//--------------------------
+void ofxTCPServer::eventLoop(){
+	ofLogVerbose("ofxTCPServer") << "reactor thread started";
+	std::vector<epoll_event> events(256);
+	while( isThreadRunning() ){
+		int count = epoll_wait(epollFd, events.data(), events.size(), -1);
+		if(count < 0){
+			if(errno == EINTR) continue;
+			ofLogError("ofxTCPServer") << "epoll_wait failed: " << strerror(errno);
+			break;
+		}
+		for(int i = 0; i < count; i++){
+			std::uint64_t token = events[i].data.u64;
+			std::uint32_t flags = events[i].events;
+			if(token == listenToken){
+				acceptEventClients();
+			}else if(token == wakeToken){
+				std::uint64_t value;
+				while(::read(wakeFd, &value, sizeof(value)) > 0){}
+			}else{
+				int clientID = int(token);
+				if(flags & EPOLLOUT){
+					std::unique_lock<std::mutex> lck( mConnectionsLock );
+					if(isClientSetup(clientID)){
+						getEventClient(clientID).flush();
+					}
+				}
+				if(flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)){
+					readEventClient(clientID, flags & (EPOLLRDHUP | EPOLLHUP | EPOLLERR));
+				}
+			}
+		}
+	}
 
+	std::unique_lock<std::mutex> lck( mConnectionsLock );
+	for(auto & client: eventClients){
+		::close(client.second->fd);
+	}
+	eventClients.clear();
+	idCount = 0;
+	connected = false;
+	ofLogVerbose("ofxTCPServer") << "reactor thread stopped";
+}
+
+//--------------------------
+void ofxTCPServer::acceptEventClients(){
+	while(true){
+		sockaddr_in remote;
+		socklen_t remoteSize = sizeof(remote);
+		int fd = ::accept4(listenFd, (sockaddr*)&remote, &remoteSize, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if(fd < 0){
+			if(errno == EINTR || errno == ECONNABORTED) continue;
+			if(errno != EAGAIN && errno != EWOULDBLOCK){
+				ofLogError("ofxTCPServer") << "couldn't accept client: " << strerror(errno);
+			}
+			return;
+		}
 
+		auto client = std::make_shared<EventClient>();
+		char ip[INET_ADDRSTRLEN];
+		if(inet_ntop(AF_INET, &remote.sin_addr, ip, sizeof(ip))){
+			client->ip = ip;
+		}
+		client->port = ntohs(remote.sin_port);
+		client->fd = fd;
+		client->epollFd = epollFd;
+		client->maxPending = sendBufferSize;
+		client->received.allocate(receiveBufferSize);
+
+		ofxTCPServerEventArgs args;
+		{
+			std::unique_lock<std::mutex> lck( mConnectionsLock );
+			int clientID = 0;
+			while(isClientSetup(clientID)) clientID++;
+			client->id = clientID;
+
+			epoll_event event;
+			memset(&event, 0, sizeof(event));
+			event.events = EPOLLIN | EPOLLRDHUP;
+			event.data.u64 = clientID;
+			if(epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0){
+				ofLogError("ofxTCPServer") << "couldn't accept client " << clientID << ": " << strerror(errno);
+				::close(fd);
+				continue;
+			}
+			eventClients[clientID] = client;
+			if(clientID >= idCount) idCount = clientID + 1;
+			serverReady.notify_all();
+			args.clientID = clientID;
+		}
+		ofLogVerbose("ofxTCPServer") << "client " << args.clientID << " connected on port " << client->port;
+		ofNotifyEvent(clientConnected, args, this);
+	}
+}
+
+//--------------------------
+void ofxTCPServer::readEventClient(int clientID, bool hangUp){
+	ofxTCPServerEventArgs args;
+	args.clientID = clientID;
+	bool closed = false;
+	std::size_t numRead = 0;
+	{
+		std::unique_lock<std::mutex> lck( mConnectionsLock );
+		if(!isClientSetup(clientID)) return;
+		EventClient & client = getEventClient(clientID);
+		if(hangUp){
+			client.hangUp();
+		}
+		// after a hang up keeps reading what's left in the socket, the
+		// client is only removed once that has been received
+		while((client.connected || client.draining) && !client.eof && client.received.space() > 0){
+			RingBuffer::Span spans[2];
+			int numSpans = client.received.writable(spans);
+			iovec iov[2];
+			for(int i = 0; i < numSpans; i++){
+				iov[i].iov_base = spans[i].data;
+				iov[i].iov_len = spans[i].size;
+			}
+			ssize_t ret = ::readv(client.fd, iov, numSpans);
+			if(ret > 0){
+				client.received.produce(ret);
+				numRead += ret;
+			}else if(ret < 0 && errno == EINTR){
+				continue;
+			}else if(ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+				break;
+			}else{
+				client.eof = true;
+				client.hangUp();
+				break;
+			}
+		}
+		client.dropTerminator();
+		closed = client.isRemovable();
+		// pauses reading while the receive buffer is full
+		client.updateEvents();
+		args.numBytes = client.received.size();
+	}
+
+	if(numRead > 0){
+		ofNotifyEvent(dataReceived, args, this);
+	}
+	if(closed){
+		removeEventClient(clientID);
+	}
+}
+
+//--------------------------
+void ofxTCPServer::removeEventClient(int clientID){
+	{
+		std::unique_lock<std::mutex> lck( mConnectionsLock );
+		if(!isClientSetup(clientID)) return;
+		::close(getEventClient(clientID).fd);
+		eventClients.erase(clientID);
+	}
+	ofLogVerbose("ofxTCPServer") << "client " << clientID << " disconnected";
+	ofxTCPServerEventArgs args;
+	args.clientID = clientID;
+	ofNotifyEvent(clientDisconnected, args, this);
+}
+#endif
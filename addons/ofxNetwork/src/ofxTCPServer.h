@@ -2,6 +2,7 @@
 
 #include "ofConstants.h"
 #include "ofThread.h"
+#include "ofEvents.h"
 #include "ofxTCPManager.h"
 #include "ofxTCPSettings.h"
 #include <map>
@@ -12,6 +13,14 @@
 //forward decleration
 class ofxTCPClient;
 
+class ofxTCPServerEventArgs : public ofEventArgs{
+public:
+	int clientID = -1;
+
+	// bytes waiting in the client's receive buffer, only set for dataReceived
+	std::size_t numBytes = 0;
+};
+
 class ofxTCPServer : public ofThread{
 
 	public:
@@ -90,12 +99,38 @@ class ofxTCPServer : public ofThread{
 		void waitConnectedClient();
 		void waitConnectedClient(int ms);
 
+		//only notified when the server was setup with
+		//ofxTCPSettings::eventDriven, from the reactor thread.
+		//incoming data is kept in a ring buffer per client
+		//that can be read with receive(), receiveRawBytes()...
+		//from the listener or later from any other thread.
+		//a client that hangs up is kept, no longer connected,
+		//until all the data it sent has been read or it's
+		//disconnected with disconnectClient()
+		ofEvent<ofxTCPServerEventArgs> clientConnected;
+		ofEvent<ofxTCPServerEventArgs> clientDisconnected;
+		ofEvent<ofxTCPServerEventArgs> dataReceived;
+
 	private:
 		ofxTCPClient & getClient(int clientID);
 		bool isClientSetup(int clientID);
 
 		void threadedFunction();
 
+		// event driven mode, only implemented on linux
+		struct EventClient;
+		bool setupEventDriven(const ofxTCPSettings & settings);
+		void eventLoop();
+		void acceptEventClients();
+		void readEventClient(int clientID, bool hangUp);
+		void removeEventClient(int clientID);
+		EventClient & getEventClient(int clientID);
+
+		bool			eventDriven;
+		int				listenFd, epollFd, wakeFd;
+		std::size_t		receiveBufferSize, sendBufferSize;
+		std::map<int,std::shared_ptr<EventClient> >	eventClients;
+
 		ofxTCPManager			TCPServer;
 		std::map<int,std::shared_ptr<ofxTCPClient> >	TCPConnections;
 		std::mutex					mConnectionsLock;
@@ -15,6 +15,21 @@ public:
 	bool blocking = false;
 	bool reuse = false;
 
+	// server only: serve all the clients from one epoll reactor thread
+	// instead of a socket per client that has to be polled, connections,
+	// disconnections and incoming data are notified through the server's
+	// events. only available on linux, other platforms fall back to the
+	// default mode
+	bool eventDriven = false;
+
+	// event driven server only: size in bytes of each client's receive
+	// ring buffer, reading from a client pauses while its buffer is full
+	std::size_t receiveBufferSize = 64 * 1024;
+
+	// event driven server only: maximum bytes queued for a client that
+	// doesn't keep up with what is sent to it before it's disconnected
+	std::size_t sendBufferSize = 1024 * 1024;
+
 	std::string messageDelimiter = "[/TCP]";
 
 };
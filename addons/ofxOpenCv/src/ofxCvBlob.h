@@ -23,6 +23,10 @@ class ofxCvBlob {
         ofRectangle         boundingRect;
         ofDefaultVec3       centroid;
         bool                hole;
+        int                 id;         // stable across frames when the contour finder
+                                        // is tracking, -1 otherwise
+        ofDefaultVec3       velocity;   // movement of the centroid since the previous
+                                        // frame in pixels per frame, 0 for new blobs
 
         std::vector<ofDefaultVec3> pts;    // the contour of the blob
         int                        nPts;   // number of pts;
@@ -32,6 +36,8 @@ class ofxCvBlob {
             area 		= 0.0f;
             length 		= 0.0f;
             hole 		= false;
+            id          = -1;
+            velocity    = ofDefaultVec3(0, 0, 0);
             nPts        = 0;
         }
 
@@ -114,7 +114,9 @@ void ofxCvColorImage::setFromPixels( const unsigned char* _pixels, int w, int h
 		allocate(w,h);
 	}
 	
-	if( cvImage->width*cvImage->nChannels == cvImage->widthStep ){
+	if( _pixels == (unsigned char*)cvImage->imageData ){
+		// the pixels of this image, when sharing them
+	}else if( cvImage->width*cvImage->nChannels == cvImage->widthStep ){
 		memcpy( cvImage->imageData,  _pixels, w*h*iplchannels);
 	}else{		
 		for( int i=0; i < height; i++ ) {
@@ -4,13 +4,9 @@
 
 
 //--------------------------------------------------------------------------------
-static bool sort_carea_compare( const CvSeq* a, const CvSeq* b) {
-	
-	// use opencv to calc size, then sort based on size
-	float areaa = cvContourArea(a, CV_WHOLE_SEQ);
-	float areab = cvContourArea(b, CV_WHOLE_SEQ);
-	
-	return (areaa > areab);
+static bool sort_carea_compare( const std::pair<float,CvSeq*> & a, const std::pair<float,CvSeq*> & b) {
+	// areas are computed once per contour, signed when finding holes
+	return fabs(a.first) > fabs(b.first);
 }
 
 
@@ -20,13 +16,23 @@ static bool sort_carea_compare( const CvSeq* a, const CvSeq* b) {
 ofxCvContourFinder::ofxCvContourFinder() {
     _width = 0;
     _height = 0;
+	bAnchorIsPct = false;
+	bCopyInput = true;
+	bTracking = false;
+	maxTrackingDistance = 50;
+	nextBlobId = 0;
 	myMoments = (CvMoments*)malloc( sizeof(CvMoments) );
+	// the storage is kept between calls and cleared instead of created
+	// and released every time
+	contour_storage = cvCreateMemStorage( 1000 );
+	storage = NULL;
 	reset();
 }
 
 //--------------------------------------------------------------------------------
 ofxCvContourFinder::~ofxCvContourFinder() {
 	free( myMoments );
+	if( contour_storage != NULL ) { cvReleaseMemStorage(&contour_storage); }
 }
 
 //--------------------------------------------------------------------------------
@@ -60,53 +66,66 @@ int ofxCvContourFinder::findContours( ofxCvGrayscaleImage&  input,
     // sizes, ie, if you are finding contours in a 640x480 image but also a
     // 320x240 image better to make two ofxCvContourFinder objects then to use
     // one, because you will get penalized less.
+	//
+	// with setCopyInput(false) the contours are found in the input itself
+
+	IplImage* contourImage = ipltemp;
+	if( bCopyInput ) {
+		inputCopy.setUseTexture(false);
+		if( inputCopy.getWidth() == 0 ) {
+			inputCopy.allocate( _width, _height );
+		} else if( inputCopy.getWidth() != _width || inputCopy.getHeight() != _height ) {
+			// reallocate to new size
+			inputCopy.clear();
+			inputCopy.allocate( _width, _height );
+		}
 
-    inputCopy.setUseTexture(false);
-	if( inputCopy.getWidth() == 0 ) {
-		inputCopy.allocate( _width, _height );
-	} else if( inputCopy.getWidth() != _width || inputCopy.getHeight() != _height ) {
-        // reallocate to new size
-        inputCopy.clear();
-        inputCopy.allocate( _width, _height );
+		inputCopy.setROI( input.getROI() );
+		inputCopy = input;
+		contourImage = inputCopy.getCvImage();
 	}
 
-    inputCopy.setROI( input.getROI() );
-    inputCopy = input;
-
 	CvSeq* contour_list = NULL;
-	contour_storage = cvCreateMemStorage( 1000 );
-	storage	= cvCreateMemStorage( 1000 );
+	if( contour_storage == NULL ) { contour_storage = cvCreateMemStorage( 1000 ); }
+	cvClearMemStorage( contour_storage );
 
 	int retrieve_mode
         = (bFindHoles) ? CV_RETR_LIST : CV_RETR_EXTERNAL;
-	cvFindContours( inputCopy.getCvImage(), contour_storage, &contour_list,
+	cvFindContours( contourImage, contour_storage, &contour_list,
                     sizeof(CvContour), retrieve_mode, bUseApproximation ? CV_CHAIN_APPROX_SIMPLE : CV_CHAIN_APPROX_NONE );
+	if( !bCopyInput ) {
+		input.flagImageChanged();
+	}
 	CvSeq* contour_ptr = contour_list;
 
 	// put the contours from the linked list, into an array for sorting
+	cvSeqAreas.clear();
 	while( (contour_ptr != NULL) ) {
 		float area = cvContourArea(contour_ptr, CV_WHOLE_SEQ, bFindHoles); // oriented=true for holes
-		if(bFindHoles && area < 0) { // areas can be non negative in the case of holes
-			area = fabs(area);
-		}
-		if((area > minArea) && (area < maxArea)) {
-			cvSeqBlobs.push_back(contour_ptr);
+		// areas can be non negative in the case of holes
+		if((fabs(area) > minArea) && (fabs(area) < maxArea)) {
+			cvSeqAreas.push_back(std::make_pair(area, contour_ptr));
 		}
 		contour_ptr = contour_ptr->h_next;
 	}
 
 
-	// sort the pointers based on size
-	if( cvSeqBlobs.size() > 1 ) {
-        sort( cvSeqBlobs.begin(), cvSeqBlobs.end(), sort_carea_compare );
+	// sort the pointers based on size, only the nConsidered biggest ones
+	// need to be in order
+	int nBiggest = MAX(0, MIN(nConsidered, (int)cvSeqAreas.size()));
+	std::partial_sort( cvSeqAreas.begin(), cvSeqAreas.begin() + nBiggest, cvSeqAreas.end(), sort_carea_compare );
+	cvSeqBlobs.reserve( cvSeqAreas.size() );
+	for( auto & seqArea : cvSeqAreas ) {
+		cvSeqBlobs.push_back( seqArea.second );
 	}
 
 
 	// now, we have cvSeqBlobs.size() contours, sorted by size in the array
     // cvSeqBlobs let's get the data out and into our structures that we like
-	for( int i = 0; i < MIN(nConsidered, (int)cvSeqBlobs.size()); i++ ) {
+	blobs.reserve( nBiggest );
+	for( int i = 0; i < nBiggest; i++ ) {
 		blobs.push_back( ofxCvBlob() );
-		float area = cvContourArea( cvSeqBlobs[i], CV_WHOLE_SEQ, bFindHoles ); // oriented=true for holes
+		float area = cvSeqAreas[i].first;
 		CvRect rect	= cvBoundingRect( cvSeqBlobs[i], 0 );
 		cvMoments( cvSeqBlobs[i], myMoments );
 
@@ -135,6 +154,7 @@ int ofxCvContourFinder::findContours( ofxCvGrayscaleImage&  input,
 		CvSeqReader       reader;
 		cvStartReadSeq( cvSeqBlobs[i], &reader, 0 );
 
+		blobs[i].pts.reserve( cvSeqBlobs[i]->total );
     	for( int j=0; j < cvSeqBlobs[i]->total; j++ ) {
 			CV_READ_SEQ_ELEM( pt, reader );
             blobs[i].pts.push_back( ofPoint((float)pt.x, (float)pt.y) );
@@ -145,15 +165,117 @@ int ofxCvContourFinder::findContours( ofxCvGrayscaleImage&  input,
 
     nBlobs = blobs.size();
 
-	// Free the storage memory.
-	// Warning: do this inside this function otherwise a strange memory leak
-	if( contour_storage != NULL ) { cvReleaseMemStorage(&contour_storage); }
-	if( storage != NULL ) { cvReleaseMemStorage(&storage); }
+	if( bTracking ) {
+		trackBlobs();
+	}
+
+	// the contours point to the storage, which is cleared on the next call
+	cvSeqAreas.clear();
 
 	return nBlobs;
 
 }
 
+//--------------------------------------------------------------------------------
+void ofxCvContourFinder::trackBlobs() {
+	float cellSize = MAX(maxTrackingDistance, 1.0f);
+	int cols = MAX(1, (int)ceil(_width / cellSize));
+	int rows = MAX(1, (int)ceil(_height / cellSize));
+	auto cellOf = [&]( const ofDefaultVec3 & p, int & col, int & row ) {
+		float x = p.x / cellSize;
+		float y = p.y / cellSize;
+		col = x >= 0 ? ( x < cols ? (int)x : cols - 1 ) : 0;
+		row = y >= 0 ? ( y < rows ? (int)y : rows - 1 ) : 0;
+	};
+
+	// bucket the blobs of the previous call in the grid
+	trackingGrid.assign( cols * rows, -1 );
+	for( int i = 0; i < (int)trackedBlobs.size(); i++ ) {
+		int col, row;
+		cellOf( trackedBlobs[i].centroid, col, row );
+		trackedBlobs[i].next = trackingGrid[row * cols + col];
+		trackingGrid[row * cols + col] = i;
+	}
+
+	// every pair closer than the max distance in the 9 cells around
+	// each blob, the closest pairs are matched first
+	float maxDistance2 = maxTrackingDistance * maxTrackingDistance;
+	blobMatches.clear();
+	for( int i = 0; i < (int)blobs.size(); i++ ) {
+		int col, row;
+		cellOf( blobs[i].centroid, col, row );
+		for( int y = MAX(row - 1, 0); y <= MIN(row + 1, rows - 1); y++ ) {
+			for( int x = MAX(col - 1, 0); x <= MIN(col + 1, cols - 1); x++ ) {
+				for( int j = trackingGrid[y * cols + x]; j != -1; j = trackedBlobs[j].next ) {
+					if( trackedBlobs[j].hole != blobs[i].hole ) {
+						continue;
+					}
+					auto d = blobs[i].centroid - trackedBlobs[j].centroid;
+					float distance2 = d.x * d.x + d.y * d.y;
+					if( distance2 <= maxDistance2 ) {
+						blobMatches.push_back( { distance2, i, j } );
+					}
+				}
+			}
+		}
+	}
+	std::sort( blobMatches.begin(), blobMatches.end(), []( const BlobMatch & a, const BlobMatch & b ) {
+		return a.distance < b.distance;
+	});
+
+	// blobs and tracked blobs are matched at most once, ids of tracked
+	// blobs that are already taken are marked with -1
+	for( auto & match : blobMatches ) {
+		auto & blob = blobs[match.blob];
+		auto & tracked = trackedBlobs[match.tracked];
+		if( blob.id == -1 && tracked.id != -1 ) {
+			blob.id = tracked.id;
+			blob.velocity = blob.centroid - tracked.centroid;
+			tracked.id = -1;
+		}
+	}
+
+	trackedBlobs.resize( blobs.size() );
+	for( int i = 0; i < (int)blobs.size(); i++ ) {
+		if( blobs[i].id == -1 ) {
+			blobs[i].id = nextBlobId++;
+		}
+		trackedBlobs[i].id = blobs[i].id;
+		trackedBlobs[i].centroid = blobs[i].centroid;
+		trackedBlobs[i].hole = blobs[i].hole;
+	}
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvContourFinder::setTracking( bool bTrack, float maxDistance ) {
+	if( bTrack != bTracking ) {
+		resetTracking();
+	}
+	bTracking = bTrack;
+	maxTrackingDistance = maxDistance;
+}
+
+//--------------------------------------------------------------------------------
+bool ofxCvContourFinder::isTracking() const {
+	return bTracking;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvContourFinder::resetTracking() {
+	trackedBlobs.clear();
+	nextBlobId = 0;
+}
+
+//--------------------------------------------------------------------------------
+void ofxCvContourFinder::setCopyInput( bool bCopy ) {
+	bCopyInput = bCopy;
+}
+
+//--------------------------------------------------------------------------------
+bool ofxCvContourFinder::isCopyingInput() const {
+	return bCopyInput;
+}
+
 //--------------------------------------------------------------------------------
 void ofxCvContourFinder::draw( float x, float y, float w, float h ) const {
 
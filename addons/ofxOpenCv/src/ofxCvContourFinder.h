@@ -5,6 +5,9 @@
 * centroid, bounding box, area, length and polygonal contour
 * The result is placed in a vector of ofxCvBlob objects.
 *
+* When tracking, blobs keep their id across calls to findContours
+* and carry their velocity.
+*
 */
 
 #pragma once
@@ -37,6 +40,19 @@ class ofxCvContourFinder : public ofBaseDraws {
                                // of the contour, if the contour runs
                                // along a straight line, for example...
 
+    // tracking matches every blob to the closest blob of the previous
+    // call, up to maxDistance pixels away, so it keeps the same id and
+    // gets a velocity. blobs that disappear lose their id
+    void setTracking( bool bTrack, float maxDistance = 50 );
+    bool isTracking() const;
+    void resetTracking();      // forget the previous blobs, ids start from 0 again
+
+    // by default findContours works on a copy of the input, since opencv
+    // modifies the image it finds contours in. without the copy the input
+    // is overwritten, which is faster if the app doesn't use it afterwards
+    void setCopyInput( bool bCopy );
+    bool isCopyingInput() const;
+
     virtual void  draw() const { draw(0,0, _width, _height); };
     virtual void  draw( float x, float y ) const { draw(x,y, _width, _height); };
     virtual void  draw( float x, float y, float w, float h ) const;
@@ -58,10 +74,33 @@ class ofxCvContourFinder : public ofBaseDraws {
     CvMemStorage*           storage;
     CvMoments*              myMoments;
     std::vector<CvSeq*>     cvSeqBlobs;  //these will become blobs
+    std::vector<std::pair<float,CvSeq*> > cvSeqAreas;  // area of each contour, computed once
     
     ofPoint  anchor;
     bool  bAnchorIsPct;      
+    bool  bCopyInput;
+
+    // blobs of the previous call, bucketed in a grid of maxTrackingDistance
+    // sized cells so each blob is only compared with its 9 closest cells
+    struct TrackedBlob {
+        int            id;
+        ofDefaultVec3  centroid;
+        bool           hole;
+        int            next;      // next blob in the same cell, -1 at the end
+    };
+    struct BlobMatch {
+        float  distance;
+        int    blob;
+        int    tracked;
+    };
+    bool                      bTracking;
+    float                     maxTrackingDistance;
+    int                       nextBlobId;
+    std::vector<TrackedBlob>  trackedBlobs;
+    std::vector<int>          trackingGrid;   // first tracked blob of each cell
+    std::vector<BlobMatch>    blobMatches;
 
     virtual void reset();
+    void trackBlobs();
 
 };
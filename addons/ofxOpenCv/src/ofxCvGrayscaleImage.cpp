@@ -76,7 +76,9 @@ void ofxCvGrayscaleImage::setFromPixels( const unsigned char* _pixels, int w, in
 	
     if( w == width && h == height ) {
 		
-		if( cvImage->width == cvImage->widthStep ){
+		if( _pixels == (unsigned char*)cvImage->imageData ){
+			// the pixels of this image, when sharing them
+		}else if( cvImage->width == cvImage->widthStep ){
 			memcpy( cvImage->imageData,  _pixels, w*h);
 		}else{
 		
@@ -23,6 +23,7 @@ ofxCvImage::ofxCvImage() {
     cvImage = nullptr;
     ipldepth = 0;
     iplchannels = 0;
+    bSharePixels = false;
 }
 
 //--------------------------------------------------------------------------------
@@ -42,15 +43,28 @@ void ofxCvImage::allocate( int w, int h ) {
 		return;
 	}
 
-	cvImage = cvCreateImage( cvSize(w,h), ipldepth, iplchannels );
-	cvImageTemp	= cvCreateImage( cvSize(w,h), ipldepth, iplchannels );
+	if( bSharePixels ) {
+		// the images point to the memory of pixels and pixelsTemp, which
+		// are swapped with them in swapTemp
+		allocatePixels(w,h);
+		pixelsTemp.allocate(w,h,pixels.getPixelFormat());
+		cvImage = cvCreateImageHeader( cvSize(w,h), ipldepth, iplchannels );
+		cvImageTemp	= cvCreateImageHeader( cvSize(w,h), ipldepth, iplchannels );
+		cvSetData( cvImage, pixels.getData(), w*iplchannels );
+		cvSetData( cvImageTemp, pixelsTemp.getData(), w*iplchannels );
+	} else {
+		cvImage = cvCreateImage( cvSize(w,h), ipldepth, iplchannels );
+		cvImageTemp	= cvCreateImage( cvSize(w,h), ipldepth, iplchannels );
+	}
 
 	width = w;
 	height = h;
 	bAllocated = true;
 
     if( bUseTexture ) {
-    	allocatePixels(w,h);
+    	if( !bSharePixels ) {
+    		allocatePixels(w,h);
+    	}
         allocateTexture();
         bTextureDirty = true;
     }
@@ -61,10 +75,16 @@ void ofxCvImage::clear() {
 
 	if (bAllocated == true){
 		if (width > 0 && height > 0){
-			cvReleaseImage( &cvImage );
-			cvReleaseImage( &cvImageTemp );
+			if( bSharePixels ) {
+				cvReleaseImageHeader( &cvImage );
+				cvReleaseImageHeader( &cvImageTemp );
+			} else {
+				cvReleaseImage( &cvImage );
+				cvReleaseImage( &cvImageTemp );
+			}
 		}
         pixels.clear();
+        pixelsTemp.clear();
         bPixelsDirty = true;
         bRoiPixelsDirty = true;
 
@@ -119,6 +139,40 @@ const ofTexture & ofxCvImage::getTextureReference() const{
 	return tex;
 }
 
+//--------------------------------------------------------------------------------
+void ofxCvImage::setSharePixels( bool bShare ) {
+	if( bShare && ipldepth != IPL_DEPTH_8U ) {
+		ofLogError("ofxCvImage") << "setSharePixels(): only 8 bit images can share their pixels";
+		return;
+	}
+	if( bShare == bSharePixels ) {
+		return;
+	}
+	if( !bAllocated ) {
+		bSharePixels = bShare;
+		return;
+	}
+
+	// reallocate keeping the image and its ROI
+	ofRectangle roi = getROI();
+	resetImageROI( cvImage );
+	IplImage* temp = cvCloneImage( cvImage );
+	int w = width;
+	int h = height;
+	clear();
+	bSharePixels = bShare;
+	allocate( w, h );
+	cvCopy( temp, cvImage );
+	cvReleaseImage( &temp );
+	setROI( roi );
+	flagImageChanged();
+}
+
+//--------------------------------------------------------------------------------
+bool ofxCvImage::isSharingPixels() const {
+	return bSharePixels;
+}
+
 //--------------------------------------------------------------------------------
 void ofxCvImage::flagImageChanged() {
     bTextureDirty = true;
@@ -808,6 +862,9 @@ void ofxCvImage::swapTemp() {
 		temp = cvImage;
 		cvImage	= cvImageTemp;
 		cvImageTemp	= temp;
+		if( bSharePixels ) {
+			pixels.swap( pixelsTemp );
+		}
 	}
 }
 
@@ -858,6 +915,8 @@ void ofxCvImage::setRoiFromPixels( const ofPixels & pixels ){
 ofPixels& ofxCvImage::getPixels(){
 	if(!bAllocated) {
 		ofLogWarning("ofxCvImage") << "getPixels(): image not allocated";
+	} else if(bSharePixels) {
+		// pixels is the memory of cvImage
 	} else if(bPixelsDirty) {
 		IplImage * cv8bit= getCv8BitsImage();
 
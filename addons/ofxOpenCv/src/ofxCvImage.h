@@ -44,6 +44,14 @@ class ofxCvImage : public ofBaseImage {
 	OF_DEPRECATED_MSG("Use getTexture",virtual const ofTexture & getTextureReference() const);
     virtual void flagImageChanged();  //mostly used internally
 
+    // 8 bit images can keep their pixels in ofPixels instead of opencv
+    // allocated memory, the opencv image is a header over the same memory
+    // so getPixels() and the texture upload don't copy or wrap it and apps
+    // can write to getPixels() and call flagImageChanged(). rows are packed
+    // instead of aligned to 4 bytes. changing it reallocates the image
+    virtual void  setSharePixels( bool bShare );
+    virtual bool  isSharingPixels() const;
+
     
     // ROI - region of interest
     //
@@ -87,6 +95,8 @@ class ofxCvImage : public ofBaseImage {
     virtual const ofPixels&		getPixels() const;
     virtual const ofPixels&		getRoiPixels() const;
     virtual const IplImage*  getCvImage() const { return cvImage; };
+    // a cv::Mat header over the memory of the image, without copying it
+    virtual cv::Mat  getCvMat() { return cv::cvarrToMat(cvImage); };
 
 
     // Draw Image
@@ -176,6 +186,8 @@ class ofxCvImage : public ofBaseImage {
     int iplchannels;          // 1, 3, 4, ...
     
     ofPixels pixels;	  // not width stepped for getPixels(), allocated on demand
+    ofPixels pixelsTemp;      // memory of cvImageTemp when sharing pixels
+    bool bSharePixels;
     ofPixels roiPixels;
     bool bPixelsDirty;        // pixels need to be reloaded
     bool bRoiPixelsDirty;        // pixels need to be reloaded
@@ -13,15 +13,24 @@ public:
 	~ofxOscMessage();
 	ofxOscMessage(const ofxOscMessage &other);
 	ofxOscMessage& operator=(const ofxOscMessage &other);
-	/// for operator= and copy constructor
+	ofxOscMessage(ofxOscMessage &&other);
+	ofxOscMessage& operator=(ofxOscMessage &&other);
+	/// for operator= and copy constructor,
+	/// reuses the storage already allocated by this message
 	ofxOscMessage& copy(const ofxOscMessage &other);
 
 	/// clear this message
+	///
+	/// the argument storage keeps its capacity, so refilling a cleared
+	/// message with a similar number of arguments doesn't allocate
 	void clear();
 
 	/// set the message address, must start with a /
 	void setAddress(const std::string &address);
 
+	/// set the message address from a null terminated char array
+	void setAddress(const char *address);
+
 	/// \return the OSC address
 	std::string getAddress() const;
 
@@ -188,9 +197,15 @@ public:
 	/// add a string
 	void addStringArg(const std::string &argument);
 	
+	/// add a string from a null terminated char array
+	void addStringArg(const char *argument);
+	
 	/// add a symbol (string)
 	void addSymbolArg(const std::string &argument);
 	
+	/// add a symbol (string) from a null terminated char array
+	void addSymbolArg(const char *argument);
+	
 	/// add a char
 	void addCharArg(char argument);
 	
@@ -221,6 +236,9 @@ public:
 	/// add a binary blog
 	void addBlobArg(const ofBuffer &argument);
 	
+	/// add a binary blob copying size bytes from data
+	void addBlobArg(const char *data, std::size_t size);
+	
 	/// add a 32-bit color
 	void addRgbaColorArg(std::uint32_t argument);
 
@@ -243,8 +261,40 @@ public:
 
 private:
 
+	/// an argument, fixed size values are stored inline while string,
+	/// symbol & blob bytes live in argsData
+	struct Arg{
+		/// byte range in argsData
+		struct DataRange{
+			std::uint32_t offset;
+			std::uint32_t size;
+		};
+
+		Arg(ofxOscArgType type) : type(type), int64Value(0) {}
+
+		ofxOscArgType type;
+		union{
+			std::int32_t int32Value;
+			std::int64_t int64Value;
+			float floatValue;
+			double doubleValue;
+			char charValue;
+			std::uint32_t midiMessageValue;
+			std::uint32_t rgbaColorValue;
+			std::uint64_t timetagValue;
+			DataRange data;
+		};
+	};
+
+	/// append a string, symbol or blob argument
+	void addDataArg(ofxOscArgType type, const char *data, std::size_t size);
+
+	/// \return the bytes of a string, symbol or blob argument as a string
+	std::string getArgDataAsString(std::size_t index) const;
+
 	std::string address; ///< OSC address, must start with a /
-	std::vector<ofxOscArg*> args; ///< current arguments
+	std::vector<Arg> args; ///< current arguments
+	std::vector<char> argsData; ///< contiguous storage for variable size arguments
 
 	std::string remoteHost; ///< host name/ip the message was sent from
 	int remotePort; ///< port the message was sent from
@@ -120,7 +120,8 @@ bool ofxOscReceiver::isListening() const{
 
 //--------------------------------------------------------------
 bool ofxOscReceiver::hasWaitingMessages() const{
-	return !messagesChannel.empty();
+	std::unique_lock<std::mutex> lock(messagesMutex);
+	return nextMessage < messages.size();
 }
 
 //--------------------------------------------------------------
@@ -130,13 +131,36 @@ bool ofxOscReceiver::getNextMessage(ofxOscMessage *message){
 
 //--------------------------------------------------------------
 bool ofxOscReceiver::getNextMessage(ofxOscMessage &message){
-	return messagesChannel.tryReceive(message);
+	std::unique_ptr<ofxOscMessage> next;
+	{
+		std::unique_lock<std::mutex> lock(messagesMutex);
+		if(nextMessage == messages.size()){
+			return false;
+		}
+		next = std::move(messages[nextMessage++]);
+		if(nextMessage == messages.size()){
+			messages.clear();
+			nextMessage = 0;
+		}
+		else if(nextMessage >= messages.size() / 2){
+			// compact the queue once half of it has been collected
+			messages.erase(messages.begin(), messages.begin() + nextMessage);
+			nextMessage = 0;
+		}
+	}
+
+	// hand out the received message and recycle the storage of the old one
+	std::swap(message, *next);
+
+	std::unique_lock<std::mutex> lock(messagesMutex);
+	recycledMessages.push_back(std::move(next));
+	return true;
 }
 
 //--------------------------------------------------------------
 bool ofxOscReceiver::getParameter(ofAbstractParameter &parameter){
 	ofxOscMessage msg;
-	while(messagesChannel.tryReceive(msg)){
+	while(getNextMessage(msg)){
 		ofAbstractParameter * p = &parameter;
 		std::vector<std::string> address = ofSplitString(msg.getAddress(),"/", true);
 		for(unsigned int i = 0; i < address.size(); i++){
@@ -199,8 +223,9 @@ const ofxOscReceiverSettings &ofxOscReceiver::getSettings() const {
 // PROTECTED
 //--------------------------------------------------------------
 void ofxOscReceiver::ProcessMessage(const osc::ReceivedMessage &m, const osc::IpEndpointName &remoteEndpoint){
-	// convert the message to an ofxOscMessage
-	ofxOscMessage msg;
+	// convert the message to an ofxOscMessage, refilling a recycled one
+	std::unique_ptr<ofxOscMessage> recycled = getRecycledMessage();
+	ofxOscMessage &msg = *recycled;
 
 	// set the address
 	msg.setAddress(m.AddressPattern());
@@ -255,8 +280,7 @@ void ofxOscReceiver::ProcessMessage(const osc::ReceivedMessage &m, const osc::Ip
 			const char * dataPtr;
 			osc::osc_bundle_element_size_t len = 0;
 			arg->AsBlobUnchecked((const void*&)dataPtr, len);
-			ofBuffer buffer(dataPtr, len);
-			msg.addBlobArg(buffer);
+			msg.addBlobArg(dataPtr, len);
 		}
 		else {
 			ofLogError("ofxOscReceiver") << "ProcessMessage(): argument in message "
@@ -266,8 +290,28 @@ void ofxOscReceiver::ProcessMessage(const osc::ReceivedMessage &m, const osc::Ip
 		}
 	}
 
-	// send msg to main thread
-	messagesChannel.send(std::move(msg));
+	// queue msg for the main thread
+	std::unique_lock<std::mutex> lock(messagesMutex);
+	messages.push_back(std::move(recycled));
+}
+
+//--------------------------------------------------------------
+std::unique_ptr<ofxOscMessage> ofxOscReceiver::getRecycledMessage(){
+	std::unique_ptr<ofxOscMessage> msg;
+	{
+		std::unique_lock<std::mutex> lock(messagesMutex);
+		if(!recycledMessages.empty()){
+			msg = std::move(recycledMessages.back());
+			recycledMessages.pop_back();
+		}
+	}
+	if(msg){
+		msg->clear();
+	}
+	else{
+		msg.reset(new ofxOscMessage);
+	}
+	return msg;
 }
 
 // friend functions
@@ -4,7 +4,9 @@
 
 #include "ofxOscMessage.h"
 #include "ofParameter.h"
-#include "ofThreadChannel.h"
+
+#include <mutex>
+#include <thread>
 
 #include "OscTypes.h"
 #include "OscPacketListener.h"
@@ -67,6 +69,11 @@ public:
 	bool hasWaitingMessages() const;
 
 	/// remove a message from the queue and copy it's data into msg
+	///
+	/// the previous contents of msg are recycled by the listener thread
+	/// for later messages, so reusing the same msg every frame avoids
+	/// allocations on the receive path
+	///
 	/// \return false if there are no waiting messages, otherwise return true
 	bool getNextMessage(ofxOscMessage& msg);
 	OF_DEPRECATED_MSG("Pass a reference instead of a pointer", bool getNextMessage(ofxOscMessage *msg));
@@ -97,7 +104,14 @@ private:
 	std::unique_ptr<osc::UdpListeningReceiveSocket, std::function<void(osc::UdpListeningReceiveSocket*)>> listenSocket;
 
 	std::thread listenThread; ///< listener thread
-	ofThreadChannel<ofxOscMessage> messagesChannel; ///< message passing thread channel
+
+	/// \return a cleared message from the pool or a new one if it's empty
+	std::unique_ptr<ofxOscMessage> getRecycledMessage();
+
+	mutable std::mutex messagesMutex; ///< protects messages & recycledMessages
+	std::vector<std::unique_ptr<ofxOscMessage>> messages; ///< received messages waiting for collection
+	std::size_t nextMessage = 0; ///< index of the oldest waiting message
+	std::vector<std::unique_ptr<ofxOscMessage>> recycledMessages; ///< pool of collected messages to refill
 
 	ofxOscReceiverSettings settings; ///< current settings
 };
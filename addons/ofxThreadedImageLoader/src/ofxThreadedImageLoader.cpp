@@ -1,98 +1,354 @@
 #include "ofxThreadedImageLoader.h"
 #include <sstream>
-ofxThreadedImageLoader::ofxThreadedImageLoader(){
+ofxThreadedImageLoader::ofxThreadedImageLoader(size_t numWorkers){
 	nextID = 0;
+	uploadBudget = 4 * 1024 * 1024;
+	this->numWorkers = 0;
+	numWorkersStopped = 0;
+	closed = false;
     ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofAddListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
-    
-    startThread();
-    lastUpdate = 0;
+
+	if(numWorkers == 0){
+		numWorkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+	}
+	setNumWorkers(numWorkers);
 }
 
 ofxThreadedImageLoader::~ofxThreadedImageLoader(){
-	images_to_load_from_disk.close();
-	images_to_update.close();
-	waitForThread(true);
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		closed = true;
+	}
+	condition.notify_all();
+	for(auto & worker: workers){
+		worker.join();
+	}
     ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofRemoveListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
 }
 
 // Load an image from disk.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename) {
-	nextID++;
+void ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename, int priority) {
 	ofImageLoaderEntry entry(image);
 	entry.filename = filename;
-	entry.image->setUseTexture(false);
 	entry.name = filename;
-    
-	images_to_load_from_disk.send(entry);
+	entry.priority = priority;
+
+	addRequest(std::move(entry));
 }
 
 
 // Load an url asynchronously from an url.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromURL(ofImage& image, string url) {
-	nextID++;
+void ofxThreadedImageLoader::loadFromURL(ofImage& image, string url, int priority) {
+	removeRequests(&image);
 	ofImageLoaderEntry entry(image);
 	entry.url = url;
-	entry.image->setUseTexture(false);	
-	entry.name = "image" + ofToString(nextID);
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		entry.id = nextID++;
+	}
+	entry.name = "image" + ofToString(entry.id);
+	entry.priority = priority;
+	entry.requestID = ofLoadURLAsync(entry.url, entry.name);
 	images_async_loading[entry.name] = entry;
-	ofLoadURLAsync(entry.url, entry.name);
 }
 
 
-// Reads from the queue and loads new images.
+// Queues an entry to be decoded, replacing any pending request for the
+// same image.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::addRequest(ofImageLoaderEntry && entry) {
+	removeRequests(entry.image);
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		entry.id = nextID++;
+		request_key key(entry.priority, entry.id);
+		images_to_load_keys[entry.image] = key;
+		images_to_load[key] = std::move(entry);
+	}
+	condition.notify_one();
+}
+
+
+// Removes every request for image in any of the queues, an image being
+// decoded is discarded by the worker once it finishes.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::threadedFunction() {
-	setThreadName("ofxThreadedImageLoader " + ofToString(thread.get_id()));
-	ofImageLoaderEntry entry;
-	while( images_to_load_from_disk.receive(entry) ) {
-		if(entry.image->load(entry.filename) )  {
-			images_to_update.send(entry);
+void ofxThreadedImageLoader::removeRequests(ofImage * image) {
+	for(auto it = images_async_loading.begin(); it != images_async_loading.end();){
+		if(it->second.image == image){
+			ofRemoveURLRequest(it->second.requestID);
+			it = images_async_loading.erase(it);
 		}else{
-			ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+			++it;
 		}
 	}
-	ofLogVerbose("ofxThreadedImageLoader") << "finishing thread on closed queue";
+
+	std::unique_lock<std::mutex> lock(mutex);
+	auto key = images_to_load_keys.find(image);
+	if(key != images_to_load_keys.end()){
+		images_to_load.erase(key->second);
+		images_to_load_keys.erase(key);
+	}
+	images_decoding.erase(image);
+	images_to_update.erase(std::remove_if(images_to_update.begin(), images_to_update.end(), [&](const ofImageLoaderEntry & entry){
+		return entry.image == image;
+	}), images_to_update.end());
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setPriority(ofImage& image, int priority) {
+	std::unique_lock<std::mutex> lock(mutex);
+	auto key = images_to_load_keys.find(&image);
+	if(key != images_to_load_keys.end()){
+		if(key->second.first != priority){
+			auto entry = images_to_load.find(key->second);
+			request_key newKey(priority, key->second.second);
+			entry->second.priority = priority;
+			images_to_load[newKey] = std::move(entry->second);
+			images_to_load.erase(entry);
+			key->second = newKey;
+		}
+	}else{
+		// still waiting for the url response
+		for(auto & entry: images_async_loading){
+			if(entry.second.image == &image){
+				entry.second.priority = priority;
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancel(ofImage& image) {
+	removeRequests(&image);
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancelAll() {
+	for(auto & entry: images_async_loading){
+		ofRemoveURLRequest(entry.second.requestID);
+	}
+	images_async_loading.clear();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	images_to_load.clear();
+	images_to_load_keys.clear();
+	images_decoding.clear();
+	images_to_update.clear();
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setNumWorkers(size_t numWorkers) {
+	numWorkers = std::max(size_t(1), numWorkers);
+	{
+		// workers with an index over numWorkers finish
+		std::unique_lock<std::mutex> lock(mutex);
+		this->numWorkers = std::min(this->numWorkers, numWorkers);
+	}
+	condition.notify_all();
+	joinStoppedWorkers();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	this->numWorkers = numWorkers;
+	while(workers.size() < numWorkers){
+		workers.emplace_back(&ofxThreadedImageLoader::workerFunction, this, workers.size());
+	}
 }
 
 
-// When we receive an url response this method is called; 
-// The loaded image is removed from the async_queue and added to the
-// update queue. The update queue is used to update the texture.
+// Waits for the workers told to finish, they have to be joined before
+// numWorkers grows again or they could keep running.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::joinStoppedWorkers() {
+	size_t running;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		running = numWorkers;
+	}
+	for(size_t i = running; i < workers.size(); i++){
+		workers[i].join();
+	}
+	if(workers.size() > running){
+		workers.resize(running);
+	}
+}
+
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getNumWorkers() const {
+	std::unique_lock<std::mutex> lock(mutex);
+	return numWorkers;
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setUploadBudget(size_t bytesPerFrame) {
+	uploadBudget = bytesPerFrame;
+}
+
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getUploadBudget() const {
+	return uploadBudget;
+}
+
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getNumPending() const {
+	std::unique_lock<std::mutex> lock(mutex);
+	return images_async_loading.size() + images_to_load.size() + images_decoding.size() + images_to_update.size();
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::startThread(bool) {
+	size_t numWorkers;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if(this->numWorkers > 0){
+			return;
+		}
+		numWorkers = numWorkersStopped;
+	}
+	setNumWorkers(numWorkers);
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::stopThread() {
+	stopWorkers();
+}
+
+
+// Tells every worker to finish once it's done with the image it's
+// decoding, startThread restarts the same number of them.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::stopWorkers() {
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if(numWorkers == 0){
+			return;
+		}
+		numWorkersStopped = numWorkers;
+		numWorkers = 0;
+	}
+	condition.notify_all();
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::waitForThread(bool callStopThread, long) {
+	if(callStopThread){
+		stopWorkers();
+	}
+	joinStoppedWorkers();
+}
+
+
+//--------------------------------------------------------------
+bool ofxThreadedImageLoader::isThreadRunning() const {
+	return getNumWorkers() > 0;
+}
+
+
+// Decodes the highest priority request into pixels and queues them to be
+// uploaded. The ofImage itself is only modified in update.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::workerFunction(size_t index) {
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true){
+		condition.wait(lock, [&]{
+			return closed || index >= numWorkers || !images_to_load.empty();
+		});
+		if(closed || index >= numWorkers){
+			break;
+		}
+
+		auto next = images_to_load.begin();
+		ofImageLoaderEntry entry = std::move(next->second);
+		images_to_load.erase(next);
+		images_to_load_keys.erase(entry.image);
+		images_decoding[entry.image] = entry.id;
+		lock.unlock();
+
+		bool loaded;
+		if(entry.url.empty()){
+			loaded = ofLoadImage(entry.pixels, entry.filename);
+		}else{
+			loaded = ofLoadImage(entry.pixels, entry.data);
+			entry.data.clear();
+		}
+		if(!loaded){
+			ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.name << "\"";
+		}
+
+		lock.lock();
+		// discard the result if the request was canceled or replaced
+		auto decoding = images_decoding.find(entry.image);
+		if(decoding != images_decoding.end() && decoding->second == entry.id){
+			images_decoding.erase(decoding);
+			if(loaded){
+				images_to_update.push_back(std::move(entry));
+			}
+		}
+	}
+	ofLogVerbose("ofxThreadedImageLoader") << "finishing worker " << index;
+}
+
+
+// When we receive an url response this method is called;
+// The loaded image is removed from the async_queue and its data
+// queued to be decoded by the workers.
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 	// this happens in the update thread so no need to lock to access
 	// images_async_loading
 	entry_iterator it = images_async_loading.find(response.request.name);
+	if(it == images_async_loading.end()) {
+		return;
+	}
 	if(response.status == 200) {
-		if(it != images_async_loading.end()) {
-			it->second.image->load(response.data);
-			images_to_update.send(it->second);
-		}
+		ofImageLoaderEntry entry = std::move(it->second);
+		images_async_loading.erase(it);
+		entry.data = response.data;
+		entry.name = entry.url;
+		addRequest(std::move(entry));
 	}else{
 		// log error.
 		ofLogError("ofxThreadedImageLoader") << "couldn't load url, response status: " << response.status;
 		ofRemoveURLRequest(response.request.getId());
-	}
-
-	// remove the entry from the queue
-	if(it != images_async_loading.end()) {
 		images_async_loading.erase(it);
 	}
 }
 
 
-// Check the update queue and update the texture
+// Check the update queue and upload decoded images to their textures
+// until the per frame upload budget is spent
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::update(ofEventArgs & a){
-    // Load 1 image per update so we don't block the gl thread for too long
-	ofImageLoaderEntry entry;
-	if (images_to_update.tryReceive(entry)) {
-		entry.image->setUseTexture(true);
+	size_t uploaded = 0;
+	std::unique_lock<std::mutex> lock(mutex);
+	while(!images_to_update.empty()){
+		size_t size = images_to_update.front().pixels.getTotalBytes();
+		if(uploaded > 0 && uploaded + size > uploadBudget){
+			break;
+		}
+		ofImageLoaderEntry entry = std::move(images_to_update.front());
+		images_to_update.pop_front();
+		lock.unlock();
+
+		entry.image->getPixels().swap(entry.pixels);
 		entry.image->update();
+		uploaded += size;
+
+		lock.lock();
 	}
 }
 
@@ -1,35 +1,83 @@
 #pragma once
 
-#include "ofThread.h"
 #include "ofImage.h"
 #include "ofURLFileLoader.h"
-#include "ofTypes.h" 
-#include "ofThreadChannel.h"
+#include "ofTypes.h"
+#include "ofEvents.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 
 using namespace std;
 
-class ofxThreadedImageLoader : public ofThread {
+/// \brief Loads images from disk or urls in a pool of worker threads
+///
+/// Images are decoded in parallel by the workers into pixels that are only
+/// moved into the ofImage and uploaded to the graphics card during update, so
+/// the ofImage is never touched from another thread. Pending requests are
+/// decoded highest priority first and can be reprioritized or canceled, for
+/// example when an image in a gallery scrolls out of view.
+class ofxThreadedImageLoader {
 public:
-    ofxThreadedImageLoader();
+	/// \param numWorkers number of decoding threads, 0 uses one less
+	/// than the number of cores
+	ofxThreadedImageLoader(size_t numWorkers = 0);
     ~ofxThreadedImageLoader();
 
-	void loadFromDisk(ofImage& image, string file);
-	void loadFromURL(ofImage& image, string url);
+	/// load a file into image, a new request for an image replaces any
+	/// request still pending for it. like cancel and setPriority this
+	/// should be called from the main thread
+	void loadFromDisk(ofImage& image, string file, int priority = 0);
+	void loadFromURL(ofImage& image, string url, int priority = 0);
 
+	/// change the priority of a request that hasn't started decoding yet
+	void setPriority(ofImage& image, int priority);
 
+	/// drop any pending request for image, it won't be modified afterwards
+	void cancel(ofImage& image);
+	void cancelAll();
+
+	/// change the number of decoding threads, when reducing them this
+	/// waits for the removed workers to finish the image they are decoding
+	void setNumWorkers(size_t numWorkers);
+	size_t getNumWorkers() const;
+
+	/// maximum number of bytes of decoded images handed to their ofImage,
+	/// and uploaded to its texture if it uses one, per frame. at least one
+	/// image is always updated per frame
+	void setUploadBudget(size_t bytesPerFrame);
+	size_t getUploadBudget() const;
+
+	/// \return number of requests not yet uploaded
+	size_t getNumPending() const;
+
+	/// the loader used to be an ofThread, the workers are now started
+	/// on construction. these stop and restart them, requests made while
+	/// stopped are decoded once started again
+	OF_DEPRECATED_MSG("The workers start on construction, use setNumWorkers instead",
+		void startThread(bool mutexBlocks = true));
+	OF_DEPRECATED_MSG("The workers stop on destruction",
+		void stopThread());
+	OF_DEPRECATED_MSG("The workers stop on destruction",
+		void waitForThread(bool callStopThread = true, long milliseconds = -1));
+	OF_DEPRECATED_MSG("Use getNumWorkers instead",
+		bool isThreadRunning() const);
 
 private:
 	void update(ofEventArgs & a);
-    virtual void threadedFunction();
+	void workerFunction(size_t index);
 	void urlResponse(ofHttpResponse & response);
-    
+	void stopWorkers();
+	void joinStoppedWorkers();
+
     // Entry to load.
     struct ofImageLoaderEntry {
         ofImageLoaderEntry() {
             image = NULL;
         }
-        
+
         ofImageLoaderEntry(ofImage & pImage) {
             image = &pImage;
         }
@@ -37,17 +85,43 @@ private:
         string filename;
         string url;
         string name;
+        uint64_t id = 0;
+        int priority = 0;
+        int requestID = -1; // url request id
+        ofBuffer data; // response to decode for url requests
+        ofPixels pixels; // decoded image waiting to be uploaded
     };
 
+	// priority and id of a pending request
+	typedef pair<int, uint64_t> request_key;
+
+	// pending requests are sorted by descending priority then by request order
+	struct request_order{
+		bool operator()(const request_key & a, const request_key & b) const{
+			return a.first > b.first || (a.first == b.first && a.second < b.second);
+		}
+	};
+
+	void addRequest(ofImageLoaderEntry && entry);
+	void removeRequests(ofImage * image);
 
     typedef map<string, ofImageLoaderEntry>::iterator entry_iterator;
 
-	int                 nextID;
-    int                 lastUpdate;
+	uint64_t            nextID;
+	size_t              uploadBudget;
 
 	map<string,ofImageLoaderEntry> images_async_loading; // keeps track of images which are loading async
-	ofThreadChannel<ofImageLoaderEntry> images_to_load_from_disk;
-	ofThreadChannel<ofImageLoaderEntry> images_to_update;
+
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	map<request_key, ofImageLoaderEntry, request_order> images_to_load; // requests waiting for a worker
+	map<ofImage*, request_key> images_to_load_keys; // pending request per image
+	map<ofImage*, uint64_t> images_decoding; // request being decoded per image
+	deque<ofImageLoaderEntry> images_to_update; // decoded images waiting for upload
+	vector<std::thread> workers;
+	size_t numWorkers;
+	size_t numWorkersStopped; // workers to restart after stopThread
+	bool closed;
 };
 
 
@@ -0,0 +1,19 @@
+#include "ofMain.h"
+#include "ofApp.h"
+
+//========================================================================
+int main(int argc, char *argv[]){
+	// batching is only available in the programmable renderer
+	ofGLWindowSettings settings;
+	settings.setGLVersion(3,2);
+	settings.setSize(1024,768);
+	ofCreateWindow(settings);
+
+	auto app = new ofApp();
+	// with --benchmark the app exits once it has measured both modes,
+	// to run it without a display use mesa's software renderer:
+	// LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ./batchedDrawingExample --benchmark
+	app->exitAfterBenchmark = argc > 1 && std::string(argv[1]) == "--benchmark";
+	ofRunApp(app);
+
+}
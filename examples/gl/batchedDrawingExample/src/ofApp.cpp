@@ -0,0 +1,118 @@
+#include "ofApp.h"
+
+static const size_t numShapes = 50000;
+static const size_t numColors = 10;
+static const uint64_t warmupFrames = 30;
+static const uint64_t benchmarkFrames = 200;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofBackground(30);
+	// measure how long drawing takes, not the vertical sync
+	ofSetVerticalSync(false);
+	ofSetFrameRate(0);
+	ofSetCircleResolution(12);
+
+	for(size_t i = 0; i < numColors; i++){
+		colors.push_back(ofColor::fromHsb(i * 255 / numColors, 180, 230, 200));
+	}
+	shapesByColor.resize(numColors);
+	for(size_t i = 0; i < numShapes; i++){
+		Shape shape;
+		shape.type = Shape::Type(i % 4);
+		shape.pos = {ofRandomWidth(), ofRandom(60, ofGetHeight())};
+		shape.size = ofRandom(2, 8);
+		shapesByColor[i % numColors].push_back(shape);
+	}
+
+	// the first frames are measured without batching, then with it
+	batching = false;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	auto frame = ofGetFrameNum();
+	if(frame == warmupFrames + benchmarkFrames){
+		batching = true;
+	}else if(frame == warmupFrames * 2 + benchmarkFrames * 2){
+		ofLogNotice() << numShapes << " shapes";
+		for(auto batched: {false, true}){
+			const auto & measure = measures[batched];
+			ofLogNotice() << (batched ? "batched: " : "not batched: ")
+				<< measure.drawCalls << " draw calls, "
+				<< measure.drawMillis / measure.frames << "ms drawing, "
+				<< measure.frameMillis / measure.frames << "ms per frame";
+		}
+		if(exitAfterBenchmark){
+			ofExit();
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::drawShapes(){
+	for(size_t i = 0; i < shapesByColor.size(); i++){
+		ofSetColor(colors[i]);
+		for(auto & shape: shapesByColor[i]){
+			switch(shape.type){
+				case Shape::Rectangle:
+					ofDrawRectangle(shape.pos, shape.size, shape.size);
+					break;
+				case Shape::Circle:
+					ofDrawCircle(shape.pos, shape.size);
+					break;
+				case Shape::Triangle:
+					ofDrawTriangle(shape.pos, shape.pos + glm::vec2(shape.size, 0), shape.pos + glm::vec2(0, shape.size));
+					break;
+				case Shape::Line:
+					ofDrawLine(shape.pos, shape.pos + glm::vec2(shape.size, shape.size));
+					break;
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	auto renderer = std::dynamic_pointer_cast<ofGLProgrammableRenderer>(ofGetCurrentRenderer());
+	if(!renderer){
+		ofDrawBitmapString("batching needs the programmable renderer", 20, 20);
+		return;
+	}
+
+	renderer->setBatching(batching);
+	auto then = ofGetElapsedTimeMicros();
+	drawShapes();
+	renderer->flushBatch();
+	// waits for the GPU so the time includes drawing, not only submitting
+	glFinish();
+	auto drawMillis = (ofGetElapsedTimeMicros() - then) / 1000.;
+	auto drawCalls = renderer->getNumDrawCalls();
+	renderer->setBatching(false);
+
+	auto frame = ofGetFrameNum();
+	bool measuring = (frame >= warmupFrames && frame < warmupFrames + benchmarkFrames) ||
+		(frame >= warmupFrames * 2 + benchmarkFrames && frame < warmupFrames * 2 + benchmarkFrames * 2);
+	if(measuring){
+		auto & measure = measures[batching];
+		measure.frames++;
+		measure.drawMillis += drawMillis;
+		measure.frameMillis += ofGetLastFrameTime() * 1000.;
+		measure.drawCalls = drawCalls;
+	}
+
+	ofSetColor(0, 200);
+	ofDrawRectangle(0, 0, ofGetWidth(), 50);
+	ofSetColor(255);
+	std::stringstream ss;
+	ss << numShapes << " shapes " << (batching ? "batched" : "not batched") << ", "
+	   << drawCalls << " draw calls, " << drawMillis << "ms drawing, "
+	   << ofGetLastFrameTime() * 1000. << "ms per frame" << std::endl;
+	ss << "press any key to toggle batching";
+	ofDrawBitmapString(ss.str(), 10, 20);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	batching = !batching;
+}
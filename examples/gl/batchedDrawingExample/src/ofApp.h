@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+
+		void drawShapes();
+
+		struct Shape{
+			enum Type{
+				Rectangle,
+				Circle,
+				Triangle,
+				Line,
+			} type;
+			glm::vec2 pos;
+			float size;
+		};
+
+		// shapes grouped by color, like the widgets of a dashboard
+		std::vector<std::vector<Shape>> shapesByColor;
+		std::vector<ofColor> colors;
+		bool batching;
+
+		// frames measured with and without batching
+		struct Measure{
+			uint64_t frames = 0;
+			double drawMillis = 0;
+			double frameMillis = 0;
+			size_t drawCalls = 0;
+		} measures[2];
+		bool exitAfterBenchmark = false;
+};
@@ -0,0 +1,85 @@
+#include "ofApp.h"
+
+static const size_t numLabels = 5000;
+
+static std::string modeName(ofApp::Mode mode){
+	switch(mode){
+		case ofApp::Uncached: return "drawString without layout cache";
+		case ofApp::Cached: return "drawString with layout cache";
+		case ofApp::Batched: return "appendStringMeshes, one draw per atlas page";
+		default: return "";
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofBackground(54, 54, 54, 255);
+	// measure the time to draw the labels, not the vertical sync
+	ofSetVerticalSync(false);
+	ofSetFrameRate(0);
+
+	font.load(OF_TTF_SANS, 9, true, true);
+	// every label keeps its layout
+	font.setLayoutCacheSize(numLabels);
+
+	for(size_t i = 0; i < numLabels; i++){
+		labels.push_back("label " + ofToString(i) + " " + ofToString(ofRandom(1000), 2));
+		positions.emplace_back(ofRandom(ofGetWidth()), ofRandom(60, ofGetHeight()));
+	}
+
+	mode = Cached;
+	labelsMicros = 0;
+	frameMillis = 0;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	// smoothed so the numbers are readable
+	frameMillis = ofLerp(frameMillis, ofGetLastFrameTime() * 1000., 0.05);
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofSetColor(225);
+	auto then = ofGetElapsedTimeMicros();
+	switch(mode){
+		case Uncached:
+		case Cached:
+			for(size_t i = 0; i < labels.size(); i++){
+				font.drawString(labels[i], positions[i].x, positions[i].y);
+			}
+			break;
+		case Batched:
+			for(auto & mesh: batch){
+				mesh.clear();
+			}
+			for(size_t i = 0; i < labels.size(); i++){
+				font.appendStringMeshes(batch, labels[i], positions[i].x, positions[i].y);
+			}
+			ofEnableAlphaBlending();
+			for(size_t i = 0; i < batch.size(); i++){
+				font.getAtlasPage(i).bind();
+				batch[i].draw();
+				font.getAtlasPage(i).unbind();
+			}
+			break;
+		default:
+			break;
+	}
+	labelsMicros = ofLerp(labelsMicros, ofGetElapsedTimeMicros() - then, 0.05);
+
+	ofSetColor(0, 200);
+	ofDrawRectangle(0, 0, ofGetWidth(), 50);
+	ofSetColor(255);
+	std::stringstream ss;
+	ss << numLabels << " labels, " << modeName(mode) << std::endl;
+	ss << "labels: " << labelsMicros / 1000. << "ms, frame: " << frameMillis << "ms" << std::endl;
+	ss << "press any key to change mode";
+	ofDrawBitmapString(ss.str(), 10, 15);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	mode = Mode((mode + 1) % NumModes);
+	font.setLayoutCacheSize(mode == Uncached ? 0 : numLabels);
+}
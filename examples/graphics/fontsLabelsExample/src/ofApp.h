@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+
+		enum Mode{
+			Uncached,
+			Cached,
+			Batched,
+			NumModes
+		};
+
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+
+		ofTrueTypeFont font;
+		std::vector<std::string> labels;
+		std::vector<glm::vec2> positions;
+		std::vector<ofMesh> batch;
+		Mode mode;
+		double labelsMicros;
+		double frameMillis;
+};
@@ -0,0 +1,120 @@
+#include "ofApp.h"
+
+// memory used by the atlas textures of a font
+static size_t atlasBytes(const ofTrueTypeFont & font){
+	size_t bytes = 0;
+	for(size_t i = 0; i < font.getNumAtlasPages(); i++){
+		auto & page = font.getAtlasPage(i);
+		if(page.isAllocated()){
+			// luminance and alpha
+			bytes += page.getWidth() * page.getHeight() * 2;
+		}
+	}
+	return bytes;
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofBackground(54, 54, 54, 255);
+	ofTrueTypeFont::setGlobalDpi(72);
+
+	// any font with japanese glyphs works, put one in bin/data or
+	// change the name to one installed in the system
+#if defined(TARGET_OSX)
+	fontName = "Hiragino Sans W3";
+#elif defined(TARGET_WIN32)
+	fontName = "MS Gothic";
+#else
+	fontName = "Noto Sans CJK JP";
+#endif
+
+	text = "吾輩は猫である。名前はまだ無い。\nどこで生れたかとんと見当がつかぬ。\n何でも薄暗いじめじめした所でニャーニャー泣いていた事だけは記憶している。";
+	kanji = randomKanji(40);
+
+	benchmark();
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmark(){
+	ofTrueTypeFontSettings settings(fontName, 24);
+	settings.antialiased = true;
+	settings.addRanges(ofAlphabet::Japanese);
+
+	// the first load rasterizes every glyph and writes the cache,
+	// the second one reads the atlas from the cache
+	settings.cacheFolder = "fontCache";
+	ofDirectory::removeDirectory(settings.cacheFolder, true);
+	ofTrueTypeFont everyGlyph;
+	auto then = ofGetElapsedTimeMillis();
+	if(!everyGlyph.load(settings)){
+		report = "couldn't load " + fontName + ", change the font name in ofApp::setup";
+		return;
+	}
+	auto coldMillis = ofGetElapsedTimeMillis() - then;
+	then = ofGetElapsedTimeMillis();
+	everyGlyph.load(settings);
+	auto cachedMillis = ofGetElapsedTimeMillis() - then;
+
+	settings.cacheFolder = "";
+	settings.onDemand = true;
+	settings.atlasPageSize = 1024;
+	settings.maxAtlasPages = 2;
+	then = ofGetElapsedTimeMillis();
+	japanese.load(settings);
+	auto onDemandMillis = ofGetElapsedTimeMillis() - then;
+	then = ofGetElapsedTimeMillis();
+	japanese.getStringMesh(text, 0, 0);
+	auto firstDrawMillis = ofGetElapsedTimeMillis() - then;
+
+	std::stringstream ss;
+	ss << everyGlyph.getNumCharacters() << " glyphs" << std::endl;
+	ss << "every glyph on load: " << coldMillis << "ms, from the cache: " << cachedMillis << "ms, "
+	   << atlasBytes(everyGlyph) / 1024 / 1024 << "MB of atlas" << std::endl;
+	ss << "on demand: " << onDemandMillis << "ms, first string "
+	   << firstDrawMillis << "ms";
+	report = ss.str();
+	ofLogNotice() << report;
+}
+
+//--------------------------------------------------------------
+std::string ofApp::randomKanji(size_t numGlyphs){
+	std::string str;
+	for(size_t i = 0; i < numGlyphs; i++){
+		ofUTF8Append(str, uint32_t(ofRandom(ofUnicode::CJKUnified.begin, ofUnicode::CJKUnified.end)));
+		if(i % 20 == 19){
+			str += "\n";
+		}
+	}
+	return str;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	ofSetColor(225);
+	ofDrawBitmapString(report, 30, 30);
+	if(!japanese.isLoaded()){
+		return;
+	}
+
+	japanese.drawString(text, 30, 120);
+	ofSetColor(245, 58, 135);
+	japanese.drawString(kanji, 30, 260);
+
+	ofSetColor(225);
+	std::stringstream ss;
+	ss << "on demand: " << japanese.getNumAtlasPages() << " atlas pages, "
+	   << atlasBytes(japanese) / 1024 / 1024 << "MB" << std::endl;
+	ss << "press any key for new random kanji, once the pages are full" << std::endl;
+	ss << "the least recently drawn glyphs are replaced";
+	ofDrawBitmapString(ss.str(), 30, 360);
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	kanji = randomKanji(40);
+}
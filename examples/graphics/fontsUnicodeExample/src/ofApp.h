@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+	public:
+
+		void setup();
+		void update();
+		void draw();
+
+		void keyPressed(int key);
+
+		// loads the font with every glyph in the japanese ranges, without
+		// and with the cache, and with the glyphs loaded on demand and
+		// reports how long each load takes
+		void benchmark();
+		std::string randomKanji(size_t numGlyphs);
+
+		ofTrueTypeFont japanese;
+		std::string fontName;
+		std::string text;
+		std::string kanji;
+		std::string report;
+};
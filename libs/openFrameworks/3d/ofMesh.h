@@ -229,7 +229,16 @@ public:
 	/// of the current mesh's lists.
 	void append(const ofMesh_ & mesh);
 
-	void mergeDuplicateVertices();
+	/// \brief Merges vertices closer than epsilon into one and reindexes the mesh.
+	///
+	/// The merged vertex keeps the position, color, texture coordinate and
+	/// normal of the first of the vertices it replaces. A mesh without indices
+	/// becomes indexed and vertices not used by any index are removed.
+	/// Duplicates are found through a spatial hash in expected linear time.
+	///
+	/// \param epsilon Maximum distance between merged vertices, 0 only merges equal positions.
+	/// \param numThreads Threads used for the per vertex work, 0 uses all the cores.
+	void mergeDuplicateVertices(float epsilon = 0.f, std::size_t numThreads = 1);
 
 	/// \returns a ofVec3f defining the centroid of all the vetices in the mesh.
 	V getCentroid() const;
@@ -307,7 +316,13 @@ public:
 	virtual void disableNormals();
 	virtual bool usingNormals() const;
 
-	void smoothNormals( float angle );
+	/// \brief Sets the normal of every triangle corner to the average of the
+	/// normals of the faces that share it and are within angle degrees of the
+	/// corner's own face. Corners closer than epsilon are considered shared.
+	/// Only works for OF_PRIMITIVE_TRIANGLES, the mesh is rebuilt with one
+	/// vertex per triangle corner.
+	/// \param numThreads Threads used for the per vertex work, 0 uses all the cores.
+	void smoothNormals( float angle, float epsilon = 0.01f, std::size_t numThreads = 1 );
         
         /// \brief Duplicates vertices and updates normals to get a low-poly look.
         void flatNormals();
@@ -587,7 +602,10 @@ public:
 	/// This will replace any existing data within the mesh.
 	///
 	/// It expects that the file will be in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)).
-	/// It will only load meshes saved in the PLY ASCII format; the binary format is not supported.
+	/// ASCII and binary PLY files are supported. The file is memory mapped and
+	/// binary data is copied straight into the mesh attributes. Polygons are
+	/// triangulated and properties ofMesh doesn't use are skipped. If the file
+	/// can't be loaded the mesh is left unchanged.
     void load(const std::filesystem::path& path);
 
 	///  \brief Saves the mesh at the passed path in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)).
@@ -622,6 +640,11 @@ protected:
 
 private:
 
+	/// replaces attributes with the values at sources, if it has one
+	/// value per vertex, used by mergeDuplicateVertices
+	template<class A>
+	static void gatherAttributes(A & attributes, std::size_t numVertices, const std::vector<ofIndexType> & sources, std::size_t numThreads);
+
 	std::vector<V> vertices;
 	std::vector<C> colors;
 	std::vector<N> normals;
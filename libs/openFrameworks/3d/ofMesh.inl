@@ -7,7 +7,687 @@
 #include "ofVectorMath.h"
 #include "ofMath.h"
 #include "ofLog.h"
+#include "ofFileUtils.h"
 #include <map>
+#include <unordered_map>
+#include <numeric>
+#include <limits>
+#include <thread>
+
+namespace of{
+namespace priv{
+	/// cell of the welding grid a position falls in. With epsilon 0 the
+	/// cell holds the bits of the coordinates so only equal positions share it
+	struct WeldCell{
+		int64_t x, y, z;
+
+		bool operator==(const WeldCell & other) const{
+			return x == other.x && y == other.y && z == other.z;
+		}
+	};
+
+	struct WeldCellHash{
+		std::size_t operator()(const WeldCell & cell) const{
+			uint64_t h = uint64_t(cell.x) * 0x9E3779B97F4A7C15ull;
+			h ^= uint64_t(cell.y) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+			h ^= uint64_t(cell.z) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+			return std::size_t(h ^ (h >> 32));
+		}
+	};
+
+	inline int64_t weldCoordinate(float v, float epsilon){
+		if(epsilon > 0){
+			return int64_t(std::floor(v / epsilon));
+		}
+		// adding 0 turns -0 into 0
+		v += 0.f;
+		int32_t bits;
+		memcpy(&bits, &v, sizeof(bits));
+		return bits;
+	}
+
+	/// runs func(begin, end) over [0, size) split in numThreads ranges,
+	/// 0 threads uses all the cores. Small sizes run on the calling thread.
+	template<typename Func>
+	void meshParallelFor(std::size_t size, std::size_t numThreads, Func func){
+		if(numThreads == 0){
+			numThreads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		numThreads = std::min(numThreads, std::max<std::size_t>(1, size / 4096));
+		if(numThreads <= 1){
+			func(0, size);
+			return;
+		}
+		std::size_t rangeSize = (size + numThreads - 1) / numThreads;
+		std::vector<std::thread> threads;
+		for(std::size_t begin = rangeSize; begin < size; begin += rangeSize){
+			threads.emplace_back(func, begin, std::min(size, begin + rangeSize));
+		}
+		func(0, rangeSize);
+		for(auto & thread: threads){
+			thread.join();
+		}
+	}
+
+	/// groups positions closer than epsilon, or equal positions if epsilon
+	/// is 0, using a spatial hash so it takes expected linear time. Cells are
+	/// 2 * epsilon wide so everything within epsilon of a position falls in
+	/// its cell or the 7 neighbours towards the closest corner of the cell.
+	/// Each position is compared against the first position of the clusters
+	/// in those cells.
+	/// \returns the cluster of every position, clusters are numbered in
+	/// order of appearance and representatives gets the first position
+	/// of each of them
+	template<class V>
+	std::vector<ofIndexType> weldPositions(const std::vector<V> & positions, float epsilon, std::size_t numThreads, std::vector<ofIndexType> & representatives){
+		epsilon = std::max(epsilon, 0.f);
+		float cellSize = epsilon * 2;
+		std::vector<WeldCell> cells(positions.size());
+		meshParallelFor(positions.size(), numThreads, [&](std::size_t begin, std::size_t end){
+			for(std::size_t i = begin; i < end; i++){
+				cells[i] = {
+					weldCoordinate(positions[i].x, cellSize),
+					weldCoordinate(positions[i].y, cellSize),
+					weldCoordinate(positions[i].z, cellSize),
+				};
+			}
+		});
+
+		// every cell points to its last cluster and clusters link to the
+		// previous one in the same cell
+		const auto none = std::numeric_limits<ofIndexType>::max();
+		std::unordered_map<WeldCell, ofIndexType, WeldCellHash> cellClusters;
+		cellClusters.reserve(positions.size());
+		std::vector<ofIndexType> nextInCell;
+		std::vector<ofIndexType> clusters(positions.size());
+		representatives.clear();
+		float epsilon2 = epsilon * epsilon;
+		auto findInCell = [&](const WeldCell & cell, const V & p){
+			auto head = cellClusters.find(cell);
+			if(head == cellClusters.end()){
+				return none;
+			}
+			for(auto cluster = head->second; cluster != none; cluster = nextInCell[cluster]){
+				const auto & q = positions[representatives[cluster]];
+				if(epsilon == 0){
+					if(p == q){
+						return cluster;
+					}
+				}else{
+					float dx = p.x - q.x;
+					float dy = p.y - q.y;
+					float dz = p.z - q.z;
+					if(dx * dx + dy * dy + dz * dz <= epsilon2){
+						return cluster;
+					}
+				}
+			}
+			return none;
+		};
+
+		for(std::size_t i = 0; i < positions.size(); i++){
+			const auto & cell = cells[i];
+			auto cluster = findInCell(cell, positions[i]);
+			if(epsilon > 0 && cluster == none){
+				const auto & p = positions[i];
+				int64_t x = p.x / cellSize - cell.x < 0.5f ? -1 : 1;
+				int64_t y = p.y / cellSize - cell.y < 0.5f ? -1 : 1;
+				int64_t z = p.z / cellSize - cell.z < 0.5f ? -1 : 1;
+				for(int neighbour = 1; neighbour < 8 && cluster == none; neighbour++){
+					cluster = findInCell({
+						cell.x + (neighbour & 1 ? x : 0),
+						cell.y + (neighbour & 2 ? y : 0),
+						cell.z + (neighbour & 4 ? z : 0),
+					}, p);
+				}
+			}
+			if(cluster == none){
+				cluster = representatives.size();
+				representatives.push_back(i);
+				auto & head = cellClusters.emplace(cell, none).first->second;
+				nextInCell.push_back(head);
+				head = cluster;
+			}
+			clusters[i] = cluster;
+		}
+		return clusters;
+	}
+
+	enum PlyType{
+		PlyInt8,
+		PlyUInt8,
+		PlyInt16,
+		PlyUInt16,
+		PlyInt32,
+		PlyUInt32,
+		PlyFloat32,
+		PlyFloat64,
+		PlyUnknown,
+	};
+
+	inline PlyType plyType(const std::string & name){
+		if(name == "char" || name == "int8") return PlyInt8;
+		if(name == "uchar" || name == "uint8") return PlyUInt8;
+		if(name == "short" || name == "int16") return PlyInt16;
+		if(name == "ushort" || name == "uint16") return PlyUInt16;
+		if(name == "int" || name == "int32") return PlyInt32;
+		if(name == "uint" || name == "uint32") return PlyUInt32;
+		if(name == "float" || name == "float32") return PlyFloat32;
+		if(name == "double" || name == "float64") return PlyFloat64;
+		return PlyUnknown;
+	}
+
+	inline std::size_t plySize(PlyType type){
+		switch(type){
+			case PlyInt8: case PlyUInt8: return 1;
+			case PlyInt16: case PlyUInt16: return 2;
+			case PlyInt32: case PlyUInt32: case PlyFloat32: return 4;
+			case PlyFloat64: return 8;
+			default: return 0;
+		}
+	}
+
+	struct PlyProperty{
+		std::string name;
+		PlyType type;
+		PlyType countType; ///< type of the number of values for lists, PlyUnknown otherwise
+
+		bool isList() const{
+			return countType != PlyUnknown;
+		}
+	};
+
+	struct PlyElement{
+		std::string name;
+		std::size_t count;
+		std::vector<PlyProperty> properties;
+
+		bool hasLists() const{
+			for(auto & property: properties){
+				if(property.isList()) return true;
+			}
+			return false;
+		}
+
+		/// size of a record in a binary file if it has no lists
+		std::size_t stride() const{
+			std::size_t size = 0;
+			for(auto & property: properties){
+				size += plySize(property.type);
+			}
+			return size;
+		}
+	};
+
+	struct PlyHeader{
+		bool ascii = true;
+		bool bigEndian = false;
+		std::vector<PlyElement> elements;
+	};
+
+	/// parses the header of a ply file
+	/// \returns the start of the data after the header or nullptr on error
+	inline const char * parsePlyHeader(const char * begin, const char * end, PlyHeader & header, std::string & error){
+		const char * pos = begin;
+		bool first = true;
+		while(pos < end){
+			const char * lineEnd = std::find(pos, end, '\n');
+			std::string line(pos, lineEnd);
+			pos = lineEnd < end ? lineEnd + 1 : end;
+			if(!line.empty() && line.back() == '\r'){
+				line.pop_back();
+			}
+			auto words = ofSplitString(line, " ", true, true);
+			if(first){
+				if(line != "ply"){
+					error = "wrong format, expecting 'ply'";
+					return nullptr;
+				}
+				first = false;
+			}else if(words.empty() || words[0] == "comment" || words[0] == "obj_info"){
+				continue;
+			}else if(words[0] == "format" && words.size() == 3){
+				if(words[1] == "ascii"){
+					header.ascii = true;
+				}else if(words[1] == "binary_little_endian"){
+					header.ascii = false;
+					header.bigEndian = false;
+				}else if(words[1] == "binary_big_endian"){
+					header.ascii = false;
+					header.bigEndian = true;
+				}else{
+					error = "unsupported format '" + words[1] + "'";
+					return nullptr;
+				}
+			}else if(words[0] == "element" && words.size() == 3){
+				header.elements.push_back({words[1], ofTo<std::size_t>(words[2]), {}});
+			}else if(words[0] == "property" && !header.elements.empty()){
+				PlyProperty property;
+				if(words.size() == 5 && words[1] == "list"){
+					property = {words[4], plyType(words[3]), plyType(words[2])};
+					if(property.countType == PlyUnknown){
+						error = "unknown type '" + words[2] + "'";
+						return nullptr;
+					}
+				}else if(words.size() == 3){
+					property = {words[2], plyType(words[1]), PlyUnknown};
+				}else{
+					error = "wrong property definition '" + line + "'";
+					return nullptr;
+				}
+				if(property.type == PlyUnknown){
+					error = "unknown type in '" + line + "'";
+					return nullptr;
+				}
+				header.elements.back().properties.push_back(property);
+			}else if(words[0] == "end_header"){
+				return pos;
+			}else{
+				error = "unexpected header line '" + line + "'";
+				return nullptr;
+			}
+		}
+		error = "missing end_header";
+		return nullptr;
+	}
+
+	/// reads the values of the body of an ascii or binary ply file
+	/// one by one, converting them to double
+	class PlyReader{
+	public:
+		PlyReader(const char * begin, const char * end, bool ascii, bool swapBytes)
+		:pos(begin)
+		,end(end)
+		,ascii(ascii)
+		,swapBytes(swapBytes)
+		,good(true){}
+
+		bool isGood() const{
+			return good;
+		}
+
+		double read(PlyType type){
+			if(!good){
+				return 0;
+			}
+			return ascii ? readAscii() : readBinary(type);
+		}
+
+		/// reads the number of values of a list property, a count that
+		/// is negative or that couldn't fit in the remaining data fails
+		/// instead of being used to allocate the list
+		std::size_t readCount(const PlyProperty & property){
+			double count = read(property.countType);
+			std::size_t minValueSize = ascii ? 1 : plySize(property.type);
+			if(!(count >= 0) || count * minValueSize > double(end - pos)){
+				good = false;
+				return 0;
+			}
+			return std::size_t(count);
+		}
+
+		/// skips count records of element
+		void skip(const PlyElement & element, std::size_t count){
+			if(!ascii && !element.hasLists()){
+				std::size_t stride = element.stride();
+				if(stride != 0 && std::size_t(end - pos) / stride < count){
+					good = false;
+				}else{
+					pos += stride * count;
+				}
+				return;
+			}
+			for(std::size_t i = 0; i < count && good; i++){
+				for(auto & property: element.properties){
+					std::size_t numValues = property.isList() ? readCount(property) : 1;
+					for(std::size_t j = 0; j < numValues && good; j++){
+						read(property.type);
+					}
+				}
+			}
+		}
+
+		const char * pos;
+		const char * end;
+		const bool ascii;
+		const bool swapBytes;
+
+	private:
+		double readAscii(){
+			while(pos < end && isspace((unsigned char)*pos)){
+				pos++;
+			}
+			const char * tokenEnd = pos;
+			while(tokenEnd < end && !isspace((unsigned char)*tokenEnd)){
+				tokenEnd++;
+			}
+			std::size_t length = tokenEnd - pos;
+			if(length == 0){
+				good = false;
+				return 0;
+			}
+
+			// plain decimals with up to 15 digits are converted exactly
+			// from an integer mantissa and a power of 10, anything else
+			// goes through strtod
+			static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+				1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+			const char * c = pos;
+			bool negative = *c == '-';
+			if(negative || *c == '+'){
+				c++;
+			}
+			uint64_t mantissa = 0;
+			int numDigits = 0;
+			int exponent = 0;
+			for(; c < tokenEnd && *c >= '0' && *c <= '9'; c++, numDigits++){
+				mantissa = mantissa * 10 + (*c - '0');
+			}
+			if(c < tokenEnd && *c == '.'){
+				for(c++; c < tokenEnd && *c >= '0' && *c <= '9'; c++, numDigits++, exponent--){
+					mantissa = mantissa * 10 + (*c - '0');
+				}
+			}
+			if(c == tokenEnd && numDigits > 0 && numDigits <= 15 && exponent >= -22){
+				double value = exponent < 0 ? mantissa / powersOf10[-exponent] : double(mantissa);
+				pos = tokenEnd;
+				return negative ? -value : value;
+			}
+
+			// the mapped data isn't null terminated so
+			// numbers are copied before parsing them
+			char number[64];
+			if(length >= sizeof(number)){
+				good = false;
+				return 0;
+			}
+			memcpy(number, pos, length);
+			number[length] = 0;
+			char * numberEnd;
+			double value = strtod(number, &numberEnd);
+			if(numberEnd != number + length){
+				good = false;
+				return 0;
+			}
+			pos = tokenEnd;
+			return value;
+		}
+
+		template<typename Type>
+		double readBinaryValue(){
+			Type value;
+			if(std::size_t(end - pos) < sizeof(value)){
+				good = false;
+				return 0;
+			}
+			if(swapBytes){
+				char bytes[sizeof(value)];
+				std::reverse_copy(pos, pos + sizeof(value), bytes);
+				memcpy(&value, bytes, sizeof(value));
+			}else{
+				memcpy(&value, pos, sizeof(value));
+			}
+			pos += sizeof(value);
+			return double(value);
+		}
+
+		double readBinary(PlyType type){
+			switch(type){
+				case PlyInt8: return readBinaryValue<int8_t>();
+				case PlyUInt8: return readBinaryValue<uint8_t>();
+				case PlyInt16: return readBinaryValue<int16_t>();
+				case PlyUInt16: return readBinaryValue<uint16_t>();
+				case PlyInt32: return readBinaryValue<int32_t>();
+				case PlyUInt32: return readBinaryValue<uint32_t>();
+				case PlyFloat32: return readBinaryValue<float>();
+				case PlyFloat64: return readBinaryValue<double>();
+				default: good = false; return 0;
+			}
+		}
+
+		bool good;
+	};
+
+	/// where a vertex property goes in the mesh:
+	/// the float component of the position, color, normal or texcoord
+	struct PlyVertexTarget{
+		float * base; ///< first vertex' component, nullptr to skip the property
+		std::size_t stride; ///< floats between vertices
+		float scale; ///< 8bit colors are normalized
+	};
+
+	/// reads the vertex element of a ply file into the mesh attributes.
+	/// Attributes are assumed to be float vectors, like the rest of ofMesh
+	/// does when loading and saving. Binary little endian files without lists
+	/// copy runs of consecutive float properties straight into the attributes.
+	template<class V, class N, class C, class T>
+	bool readPlyVertices(const PlyElement & element, PlyReader & reader, std::vector<V> & vertices, std::vector<C> & colors, std::vector<N> & normals, std::vector<T> & texCoords, std::string & error){
+		// names each component of an attribute can have
+		typedef std::vector<std::vector<std::string>> Names;
+		static const Names positionNames = {{"x"}, {"y"}, {"z"}};
+		static const Names colorNames = {{"red", "r"}, {"green", "g"}, {"blue", "b"}, {"alpha", "a"}};
+		static const Names normalNames = {{"nx"}, {"ny"}, {"nz"}};
+		static const Names texCoordNames = {{"u", "s", "texture_u", "texture_s"}, {"v", "t", "texture_v", "texture_t"}};
+		auto component = [](const PlyProperty & property, const Names & names){
+			for(std::size_t i = 0; i < names.size() && !property.isList(); i++){
+				if(std::find(names[i].begin(), names[i].end(), property.name) != names[i].end()){
+					return int(i);
+				}
+			}
+			return -1;
+		};
+
+		// the largest element that could fit in the remaining data
+		std::size_t minRecordSize = reader.ascii ? element.properties.size() * 2 : element.stride();
+		if(element.count > std::size_t(reader.end - reader.pos) / std::max<std::size_t>(minRecordSize, 1)){
+			error = "file is shorter than the " + ofToString(element.count) + " vertices in the header";
+			return false;
+		}
+
+		// attributes are only allocated if the file has them
+		std::size_t numColors = 0, numNormals = 0, numTexCoords = 0;
+		for(auto & property: element.properties){
+			if(component(property, colorNames) >= 0) numColors++;
+			if(component(property, normalNames) >= 0) numNormals++;
+			if(component(property, texCoordNames) >= 0) numTexCoords++;
+		}
+		if(numColors != 0 && numColors != 3 && numColors != 4){
+			error = "data has color coordiantes but not correct number of components. Found " + ofToString(numColors) + " expecting 3 or 4";
+			return false;
+		}
+		if(numNormals != 0 && numNormals != 3){
+			error = "data has normal coordiantes but not correct number of components. Found " + ofToString(numNormals) + " expecting 3";
+			return false;
+		}
+		if(element.count == 0){
+			return true;
+		}
+		vertices.resize(element.count);
+		if(numColors) colors.resize(element.count);
+		if(numNormals) normals.resize(element.count);
+		if(numTexCoords) texCoords.resize(element.count);
+
+		std::vector<PlyVertexTarget> targets;
+		for(auto & property: element.properties){
+			PlyVertexTarget target{nullptr, 0, 1};
+			int i;
+			if((i = component(property, positionNames)) >= 0){
+				target = {&vertices[0].x + i, sizeof(V) / sizeof(float), 1};
+			}else if((i = component(property, colorNames)) >= 0){
+				float scale = property.type == PlyUInt8 || property.type == PlyInt8 ? 1 / 255.f : 1;
+				target = {&colors[0].r + i, sizeof(C) / sizeof(float), scale};
+			}else if((i = component(property, normalNames)) >= 0){
+				target = {&normals[0].x + i, sizeof(N) / sizeof(float), 1};
+			}else if((i = component(property, texCoordNames)) >= 0){
+				target = {&texCoords[0].x + i, sizeof(T) / sizeof(float), 1};
+			}
+			targets.push_back(target);
+		}
+
+		if(!reader.ascii && !reader.swapBytes && !element.hasLists()){
+			// runs of consecutive float properties that go to consecutive
+			// components of the same attribute are copied with one memcpy
+			struct Copy{
+				std::size_t offset;
+				std::size_t numFloats;
+				PlyType type;
+				PlyVertexTarget target;
+			};
+			std::vector<Copy> copies;
+			std::size_t offset = 0;
+			for(std::size_t i = 0; i < element.properties.size(); i++){
+				auto type = element.properties[i].type;
+				auto & target = targets[i];
+				if(target.base){
+					bool extendsLast = !copies.empty() && type == PlyFloat32 && copies.back().type == PlyFloat32
+						&& copies.back().offset + copies.back().numFloats * sizeof(float) == offset
+						&& copies.back().target.base + copies.back().numFloats == target.base
+						&& copies.back().target.stride == target.stride;
+					if(extendsLast){
+						copies.back().numFloats++;
+					}else{
+						copies.push_back({offset, 1, type, target});
+					}
+				}
+				offset += plySize(type);
+			}
+			std::size_t stride = element.stride();
+			const char * data = reader.pos;
+			if(copies.size() == 1 && copies[0].type == PlyFloat32 && copies[0].target.base == &vertices[0].x && copies[0].numFloats * 4 == stride && stride == sizeof(V)){
+				// the file only has positions with the same layout as the mesh
+				memcpy(vertices.data(), data, stride * element.count);
+			}else{
+				for(auto & copy: copies){
+					auto src = data + copy.offset;
+					auto dst = copy.target.base;
+					if(copy.type == PlyFloat32){
+						auto size = copy.numFloats * sizeof(float);
+						for(std::size_t v = 0; v < element.count; v++, src += stride, dst += copy.target.stride){
+							memcpy(dst, src, size);
+						}
+					}else{
+						PlyReader values(src, reader.end, false, false);
+						for(std::size_t v = 0; v < element.count; v++, dst += copy.target.stride){
+							values.pos = src + v * stride;
+							*dst = float(values.read(copy.type)) * copy.target.scale;
+						}
+					}
+				}
+			}
+			reader.pos += stride * element.count;
+			return true;
+		}
+
+		for(std::size_t v = 0; v < element.count && reader.isGood(); v++){
+			for(std::size_t i = 0; i < element.properties.size(); i++){
+				auto & property = element.properties[i];
+				if(property.isList()){
+					std::size_t numValues = reader.readCount(property);
+					for(std::size_t j = 0; j < numValues && reader.isGood(); j++){
+						reader.read(property.type);
+					}
+				}else{
+					float value = float(reader.read(property.type));
+					auto & target = targets[i];
+					if(target.base){
+						target.base[v * target.stride] = value * target.scale;
+					}
+				}
+			}
+		}
+		if(!reader.isGood()){
+			error = "couldn't read vertex data";
+			return false;
+		}
+		return true;
+	}
+
+	/// reads the face element of a ply file as triangles,
+	/// polygons with more vertices are triangulated as fans
+	inline bool readPlyFaces(const PlyElement & element, PlyReader & reader, std::vector<ofIndexType> & indices, std::size_t numVertices, std::string & error){
+		auto indicesProperty = std::find_if(element.properties.begin(), element.properties.end(), [](const PlyProperty & property){
+			return property.isList() && (property.name == "vertex_indices" || property.name == "vertex_index");
+		});
+		if(indicesProperty == element.properties.end()){
+			error = "wrong face definition, expecting a vertex_indices list";
+			return false;
+		}
+
+		std::size_t minRecordSize = reader.ascii ? 2 : plySize(indicesProperty->countType);
+		if(element.count > std::size_t(reader.end - reader.pos) / minRecordSize){
+			error = "file is shorter than the " + ofToString(element.count) + " faces in the header";
+			return false;
+		}
+		indices.reserve(indices.size() + element.count * 3);
+		std::size_t maxIndex = 0;
+
+		if(!reader.ascii && !reader.swapBytes && element.properties.size() == 1 && plySize(indicesProperty->countType) == 1
+		   && plySize(indicesProperty->type) == 4 && indicesProperty->type != PlyFloat32){
+			// the common uchar + int list, read directly from the mapped data
+			const char * pos = reader.pos;
+			for(std::size_t f = 0; f < element.count; f++){
+				if(pos >= reader.end){
+					error = "couldn't read face data";
+					return false;
+				}
+				std::size_t numValues = uint8_t(*pos++);
+				if(std::size_t(reader.end - pos) < numValues * 4){
+					error = "couldn't read face data";
+					return false;
+				}
+				if(numValues >= 3){
+					uint32_t face[3];
+					memcpy(face, pos, sizeof(face));
+					for(std::size_t k = 2; k < numValues; k++){
+						memcpy(&face[2], pos + k * 4, 4);
+						indices.insert(indices.end(), {ofIndexType(face[0]), ofIndexType(face[1]), ofIndexType(face[2])});
+						maxIndex = std::max<std::size_t>(maxIndex, std::max(face[0], std::max(face[1], face[2])));
+						face[1] = face[2];
+					}
+				}
+				pos += numValues * 4;
+			}
+			reader.pos = pos;
+		}else{
+			std::vector<std::size_t> face;
+			for(std::size_t f = 0; f < element.count && reader.isGood(); f++){
+				for(auto property = element.properties.begin(); property != element.properties.end(); ++property){
+					std::size_t numValues = property->isList() ? reader.readCount(*property) : 1;
+					if(!reader.isGood()){
+						break;
+					}
+					if(property == indicesProperty){
+						face.resize(numValues);
+						for(auto & index: face){
+							// negative or too big indices end up out of range
+							double value = reader.read(property->type);
+							index = !(value >= 0) || value >= double(numVertices) ? numVertices : std::size_t(value);
+							maxIndex = std::max(maxIndex, index);
+						}
+						for(std::size_t k = 2; k < numValues; k++){
+							indices.insert(indices.end(), {ofIndexType(face[0]), ofIndexType(face[k - 1]), ofIndexType(face[k])});
+						}
+					}else{
+						for(std::size_t j = 0; j < numValues && reader.isGood(); j++){
+							reader.read(property->type);
+						}
+					}
+				}
+			}
+			if(!reader.isGood()){
+				error = "couldn't read face data";
+				return false;
+			}
+		}
+
+		if(!indices.empty() && maxIndex >= numVertices){
+			error = "face index " + ofToString(maxIndex) + " is out of range for " + ofToString(numVertices) + " vertices";
+			return false;
+		}
+		return true;
+	}
+}
+}
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
@@ -1030,242 +1710,75 @@ void ofMesh_<V,N,C,T>::append(const ofMesh_<V,N,C,T> & mesh){
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::load(const std::filesystem::path& path){
-	ofFile is(path, ofFile::ReadOnly);
-	auto & data = *this;
-
-
-	std::string error;
-	ofBuffer buffer(is);
-	auto backup = data;
-
-	int orderVertices=-1;
-	int orderIndices=-1;
-
-	ofIndexType vertexCoordsFound=0;
-	ofIndexType colorCompsFound=0;
-	ofIndexType texCoordsFound=0;
-	ofIndexType normalsCoordsFound=0;
-
-	ofIndexType currentVertex = 0;
-	ofIndexType currentFace = 0;
-
-	bool colorTypeIsUChar = false; /// flag to distinguish between uchar (more common) and float (less common) color format in ply file
-	
-	enum State{
-		Header,
-		VertexDef,
-		FaceDef,
-		Vertices,
-		Normals,
-		Faces
-	};
-
-	
-	enum Attribute {
-		Position,
-		Color,
-		Normal,
-		TexCoord,
-	};
-	
-	std::vector<Attribute> meshDefinition;
-	
-	data.clear();
-	State state = Header;
-
-	int lineNum = 0;
-	ofBuffer::Lines lines = buffer.getLines();
-	ofBuffer::Line line = lines.begin();
-	lineNum++;
-	if(*line!="ply"){
-		error = "wrong format, expecting 'ply'";
-		goto clean;
-	}
-
-	line++;
-	lineNum++;
-	if(*line!="format ascii 1.0"){
-		error = "wrong format, expecting 'format ascii 1.0'";
-		goto clean;
+	// the file is mapped instead of read so binary data can be copied
+	// straight into the attributes and ascii parsed without copies
+	ofMemoryMappedFile file(path);
+	if(!file.isOpen()){
+		ofLogError("ofMesh") << "load(): couldn't open \"" << path << "\"";
+		return;
 	}
+	const char * end = file.getData() + file.size();
 
-	for(;line != lines.end(); ++line){
-		lineNum++;
-		std::string lineStr = *line;
-		if(lineStr.find("comment")==0 || lineStr.empty()){
-			continue;
-		}
-
-		if((state==Header || state==FaceDef) && lineStr.find("element vertex")==0){
-			state = VertexDef;
-			orderVertices = MAX(orderIndices, 0)+1;
-			data.getVertices().resize(ofTo<size_t>(lineStr.substr(15)));
-			continue;
-		}
-
-		if((state==Header || state==VertexDef) && lineStr.find("element face")==0){
-			state = FaceDef;
-			orderIndices = MAX(orderVertices, 0)+1;
-			data.getIndices().resize(ofTo<size_t>(lineStr.substr(13))*3);
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property float x")==0 || lineStr.find("property float y")==0 || lineStr.find("property float z")==0
-                || lineStr.find("property double x")==0 || lineStr.find("property double y")==0 || lineStr.find("property double z")==0)){
-			meshDefinition.push_back(Position);
-			vertexCoordsFound++;
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property float r")==0 || lineStr.find("property float g")==0 || lineStr.find("property float b")==0 || lineStr.find("property float a")==0)){
-			colorCompsFound++;
-			meshDefinition.push_back(Color);
-			data.getColors().resize(data.getVertices().size());
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property uchar red")==0 || lineStr.find("property uchar green")==0 || lineStr.find("property uchar blue")==0 || lineStr.find("property uchar alpha")==0)){
-			colorTypeIsUChar = true;
-			colorCompsFound++;
-			meshDefinition.push_back(Color);
-			data.getColors().resize(data.getVertices().size());
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property float u")==0 || lineStr.find("property float v")==0|| lineStr.find("property float s")==0 || lineStr.find("property float t")==0)){
-			texCoordsFound++;
-			meshDefinition.push_back(TexCoord);
-			data.getTexCoords().resize(data.getVertices().size());
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property float nx")==0 || lineStr.find("property float ny")==0 || lineStr.find("property float nz")==0)){
-			normalsCoordsFound++;
-			meshDefinition.push_back(Normal);
-			if (normalsCoordsFound==3) data.getNormals().resize(data.getVertices().size());
-			continue;
-		}
-
-		if(state==FaceDef && lineStr.find("property list")!=0 && lineStr!="end_header"){
-			error = "wrong face definition";
-			goto clean;
-		}
-
-		if(lineStr=="end_header"){
-			if(data.hasColors() && colorCompsFound!=3 && colorCompsFound!=4){
-				error =  "data has color coordiantes but not correct number of components. Found " + ofToString(colorCompsFound) + " expecting 3 or 4";
-				goto clean;
-			}
-			if(data.hasNormals() && normalsCoordsFound!=3){
-				error = "data has normal coordiantes but not correct number of components. Found " + ofToString(normalsCoordsFound) + " expecting 3";
-				goto clean;
-			}
-			if(!data.hasVertices()){
-				ofLogWarning("ofMesh") << "load(): mesh loaded from \"" << path << "\" has no vertices";
-			}
-			if(orderVertices==-1) orderVertices=9999;
-			if(orderIndices==-1) orderIndices=9999;
-
-			if(orderVertices < orderIndices){
-				state = Vertices;
-			}else {
-				state = Faces;
-			}
-			continue;
-		}
-
-		if(state==Vertices){
-			if(data.getNumVertices()<=currentVertex){
-				error = "found more vertices: " + ofToString(currentVertex+1) + " than specified in header: " + ofToString(data.getNumVertices());
-				goto clean;
-			}
-			std::stringstream sline(lineStr);
-			
-			// read in a line of vertex elements
-			// and split it into attributes,
-			// based attribute order specified in file header
-			ofIndexType vAttr = 0;
-			ofIndexType nAttr = 0;
-			ofIndexType tAttr = 0;
-			ofIndexType cAttr = 0;
-			for(auto s:meshDefinition){
-				switch (s) {
-					case Position:
-						sline >> *(&data.getVertices()[currentVertex].x + (vAttr++)%vertexCoordsFound);
-						break;
-					case Color:
-						if (colorTypeIsUChar){
-							int c = 0;
-							sline >> c;
-							*(&data.getColors()[currentVertex].r + (cAttr++)%colorCompsFound) = c/255.f;
-						} else {
-							sline >> *(&data.getColors()[currentVertex].r + (cAttr++)%colorCompsFound);
-						}
-						break;
-					case Normal:
-						sline >> *(&data.getNormals()[currentVertex].x + (nAttr++)%normalsCoordsFound);
-						break;
-					case TexCoord:
-						sline >> *(&data.getTexCoords()[currentVertex].x + (tAttr++)%texCoordsFound);
-						break;
-					default:
-						break;
+	std::string error;
+	of::priv::PlyHeader header;
+	std::vector<V> newVertices;
+	std::vector<C> newColors;
+	std::vector<N> newNormals;
+	std::vector<T> newTexCoords;
+	std::vector<ofIndexType> newIndices;
+	bool faceFound = false;
+
+	const char * body = of::priv::parsePlyHeader(file.getData(), end, header, error);
+	if(body){
+		const uint16_t endianTest = 1;
+		bool littleEndianHost = *reinterpret_cast<const uint8_t*>(&endianTest) == 1;
+		of::priv::PlyReader reader(body, end, header.ascii, !header.ascii && header.bigEndian == littleEndianHost);
+		for(auto & element: header.elements){
+			if(element.name == "vertex" && newVertices.empty()){
+				if(!of::priv::readPlyVertices(element, reader, newVertices, newColors, newNormals, newTexCoords, error)){
+					break;
 				}
-			}
-			if (vAttr != vertexCoordsFound || cAttr!= colorCompsFound || nAttr!=normalsCoordsFound || tAttr!=texCoordsFound){
-				error = "attribute data does not match definition in header";
-				goto clean;
-			}
-			
-			currentVertex++;
-			if(currentVertex==data.getNumVertices()){
-				if(orderVertices<orderIndices){
-					state = Faces;
-				}else{
-					state = Vertices;
+			}else if(element.name == "face" && !faceFound){
+				// faces can come before the vertices, their indices are
+				// checked against the vertex element in the header
+				auto vertexElement = std::find_if(header.elements.begin(), header.elements.end(), [](const of::priv::PlyElement & element){
+					return element.name == "vertex";
+				});
+				std::size_t numVertices = vertexElement == header.elements.end() ? 0 : vertexElement->count;
+				faceFound = true;
+				if(!of::priv::readPlyFaces(element, reader, newIndices, numVertices, error)){
+					break;
 				}
-			}
-			continue;
-		}
-
-		if(state==Faces){
-			if(data.getNumIndices()/3<currentFace){
-				error = "found more faces than specified in header";
-				goto clean;
-			}
-			std::stringstream sline(lineStr);
-			int numV;
-			sline >> numV;
-			if(numV!=3){
-				error = "face not a triangle";
-				goto clean;
-			}
-			ofIndexType i;
-			sline >> i;
-			data.getIndices()[currentFace*3] = i;
-			sline >> i;
-			data.getIndices()[currentFace*3+1] = i;
-			sline >> i;
-			data.getIndices()[currentFace*3+2] = i;
-
-			currentFace++;
-			if(currentFace==data.getNumIndices()/3){
-				if(orderVertices<orderIndices){
-					state = Vertices;
-				}else{
-					state = Faces;
+			}else{
+				reader.skip(element, element.count);
+				if(!reader.isGood()){
+					error = "couldn't read element '" + element.name + "'";
+					break;
 				}
 			}
-			continue;
 		}
 	}
 
+	if(!error.empty()){
+		ofLogError("ofMesh") << "load(): couldn't load \"" << path << "\": " << error;
+		return;
+	}
+
+	clear();
+	vertices.swap(newVertices);
+	colors.swap(newColors);
+	normals.swap(newNormals);
+	texCoords.swap(newTexCoords);
+	indices.swap(newIndices);
+	bVertsChanged = true;
+	bColorsChanged = true;
+	bNormalsChanged = true;
+	bTexCoordsChanged = true;
+	bIndicesChanged = true;
 
-	return;
-	clean:
-	ofLogError("ofMesh") << "load(): " << lineNum << ":" << error;
-	ofLogError("ofMesh") << "load(): \"" << *line << "\"";
-	data = backup;
+	if(!hasVertices()){
+		ofLogWarning("ofMesh") << "load(): mesh loaded from \"" << path << "\" has no vertices";
+	}
 }
 
 //--------------------------------------------------------------
@@ -1354,8 +1867,9 @@ void ofMesh_<V,N,C,T>::save(const std::filesystem::path& path, bool useBinary) c
 	if(data.getNumIndices()) {
 		for(uint32_t i = 0; i < data.getNumIndices(); i += faceSize) {
 			if(useBinary) {
+				uint32_t indices[] = {data.getIndex(i), data.getIndex(i+1), data.getIndex(i+2)};
 				os.write((char*) &faceSize, sizeof(unsigned char));
-				os.write((char*)&data.getIndices()[i], faceSize);
+				os.write((char*) indices, sizeof(indices));
 			} else {
 				os << (std::size_t) faceSize << " " << data.getIndex(i) << " " << data.getIndex(i+1) << " " << data.getIndex(i+2) << std::endl;
 			}
@@ -1477,97 +1991,63 @@ ofMesh_<V,N,C,T> ofMesh_<V,N,C,T>::getMeshForIndices( ofIndexType startIndex, of
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
-void ofMesh_<V,N,C,T>::mergeDuplicateVertices() {
-
-	std::vector<V> verts = getVertices();
-	std::vector<ofIndexType> indices = getIndices();
-
-	//get indexes to share single point - TODO: try j < i
-	for(ofIndexType i = 0; i < indices.size(); i++) {
-		for(ofIndexType j = 0; j < indices.size(); j++ ) {
-			if(i==j) continue;
-
-			ofIndexType i1 = indices[i];
-			ofIndexType i2 = indices[j];
-			const V & v1 = verts[ i1 ];
-			const V & v2 = verts[ i2 ];
-
-			if( v1 == v2 && i1 != i2) {
-				indices[j] = i1;
-				break;
-			}
-		}
+void ofMesh_<V,N,C,T>::mergeDuplicateVertices(float epsilon, std::size_t numThreads) {
+	if(vertices.empty()){
+		return;
 	}
-
-	//indices array now has list of unique points we need
-	//but we need to delete the old points we're not using and that means the index values will change
-	//so we are going to create a new list of points and new indexes - we will use a map to map old index values to the new ones
-	std::vector <V> newPoints;
-	std::vector <ofIndexType> newIndexes;
-	std::map <ofIndexType, bool> ptCreated;
-	std::map <ofIndexType, ofIndexType> oldIndexNewIndex;
-
-	std::vector<ofFloatColor> newColors;
-	std::vector<ofFloatColor>& colors = getColors();
-	std::vector<T> newTCoords;
-	std::vector<T>& tcoords = getTexCoords();
-	std::vector<N> newNormals;
-	std::vector<N>& normals = getNormals();
-
-	for(ofIndexType i = 0; i < indices.size(); i++){
-		ptCreated[i] = false;
+	if(indices.empty()){
+		indices.resize(vertices.size());
+		std::iota(indices.begin(), indices.end(), 0);
 	}
 
-	for(ofIndexType i = 0; i < indices.size(); i++){
-		ofIndexType index = indices[i];
-		const auto & p = verts[ index ];
-
-		if( ptCreated[index] == false ){
-			oldIndexNewIndex[index] = newPoints.size();
-			newPoints.push_back( p );
-			if(hasColors()) {
-				newColors.push_back(colors[index]);
-			}
-			if(hasTexCoords()) {
-				newTCoords.push_back(tcoords[index]);
-			}
-			if(hasNormals()) {
-				newNormals.push_back(normals[index]);
-			}
+	std::vector<ofIndexType> representatives;
+	auto clusters = of::priv::weldPositions(vertices, epsilon, numThreads, representatives);
 
-			ptCreated[index] = true;
+	// new vertices are numbered in the order the indices first use them,
+	// vertices not used by any index are dropped
+	const auto none = std::numeric_limits<ofIndexType>::max();
+	std::vector<ofIndexType> newIndices(representatives.size(), none);
+	std::vector<ofIndexType> sources;
+	sources.reserve(representatives.size());
+	for(auto & index: indices){
+		auto cluster = clusters[index];
+		if(newIndices[cluster] == none){
+			newIndices[cluster] = sources.size();
+			sources.push_back(representatives[cluster]);
 		}
-
-		//ofLogNotice("ofMesh") << "[" << i << "]: old " << index << " --> " << oldIndexNewIndex[index];
-		newIndexes.push_back( oldIndexNewIndex[index] );
+		index = newIndices[cluster];
 	}
 
-	verts.clear();
-	verts = newPoints;
-
-	indices.clear();
-	indices = newIndexes;
-
-	clearIndices();
-	addIndices(indices);
-	clearVertices();
-	addVertices( verts );
+	// every attribute that has one value per vertex is carried along
+	auto numVertices = vertices.size();
+	gatherAttributes(colors, numVertices, sources, numThreads);
+	gatherAttributes(texCoords, numVertices, sources, numThreads);
+	gatherAttributes(normals, numVertices, sources, numThreads);
+	gatherAttributes(vertices, numVertices, sources, numThreads);
 
-	if(hasColors()) {
-		clearColors();
-		addColors( newColors );
-	}
+	bVertsChanged = true;
+	bColorsChanged = true;
+	bNormalsChanged = true;
+	bTexCoordsChanged = true;
+	bIndicesChanged = true;
+	bFacesDirty = true;
+}
 
-	if(hasTexCoords()) {
-		clearTexCoords();
-		addTexCoords( newTCoords );
-	}
 
-	if(hasNormals()) {
-		clearNormals();
-		addNormals( newNormals );
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+template<class A>
+void ofMesh_<V,N,C,T>::gatherAttributes(A & attributes, std::size_t numVertices, const std::vector<ofIndexType> & sources, std::size_t numThreads){
+	if(attributes.size() != numVertices){
+		return;
 	}
-
+	A merged(sources.size());
+	of::priv::meshParallelFor(sources.size(), numThreads, [&](std::size_t begin, std::size_t end){
+		for(std::size_t i = begin; i < end; i++){
+			merged[i] = attributes[sources[i]];
+		}
+	});
+	attributes.swap(merged);
 }
 
 
@@ -1721,100 +2201,68 @@ void ofMesh_<V,N,C,T>::setFromTriangles( const std::vector<ofMeshFace_<V,N,C,T>>
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
-void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
+void ofMesh_<V,N,C,T>::smoothNormals( float angle, float epsilon, std::size_t numThreads ) {
 
 	if( getMode() == OF_PRIMITIVE_TRIANGLES) {
 		std::vector<ofMeshFace_<V,N,C,T>> triangles = getUniqueFaces();
-		std::vector<V> verts;
-		for(ofIndexType i = 0; i < triangles.size(); i++) {
-			for(ofIndexType j = 0; j < 3; j++) {
-				verts.push_back( triangles[i].getVertex(j) );
-			}
-		}
-
-		std::map<int, int> removeIds;
-
-		float epsilon = .01f;
-		for(ofIndexType i = 0; i < verts.size()-1; i++) {
-			for(ofIndexType j = i+1; j < verts.size(); j++) {
-				if(i != j) {
-					const auto& v1 = toGlm(verts[i]);
-					const auto& v2 = toGlm(verts[j]);
-					if( glm::distance(v1, v2) <= epsilon ) {
-						// average the location //
-						verts[i] = (v1+v2)/2.f;
-						verts[j] = verts[i];
-						removeIds[j] = 1;
-					}
-				}
-			}
+		if(triangles.empty()){
+			return;
 		}
 
-		// string of vertex in 3d space to triangle index //
-		std::map<std::string, std::vector<int> > vertHash;
-
-		//ofLogNotice("ofMesh") << "smoothNormals(): num verts = " << verts.size() << " tris size = " << triangles.size();
-
-		std::string xStr, yStr, zStr;
-
-		for(ofIndexType i = 0; i < verts.size(); i++ ) {
-			xStr = "x"+ofToString(verts[i].x==-0?0:verts[i].x);
-			yStr = "y"+ofToString(verts[i].y==-0?0:verts[i].y);
-			zStr = "z"+ofToString(verts[i].z==-0?0:verts[i].z);
-			std::string vstring = xStr+yStr+zStr;
-			if(vertHash.find(vstring) == vertHash.end()) {
-				for(ofIndexType j = 0; j < triangles.size(); j++) {
-					for(ofIndexType k = 0; k < 3; k++) {
-						if(verts[i].x == triangles[j].getVertex(k).x) {
-							if(verts[i].y == triangles[j].getVertex(k).y) {
-								if(verts[i].z == triangles[j].getVertex(k).z) {
-									vertHash[vstring].push_back( j );
-								}
-							}
-						}
-					}
+		std::vector<V> verts(triangles.size() * 3);
+		std::vector<N> faceNormals(triangles.size());
+		of::priv::meshParallelFor(triangles.size(), numThreads, [&](std::size_t begin, std::size_t end){
+			for(std::size_t i = begin; i < end; i++){
+				for(ofIndexType k = 0; k < 3; k++){
+					verts[i * 3 + k] = triangles[i].getVertex(k);
 				}
+				faceNormals[i] = triangles[i].getFaceNormal();
+			}
+		});
+
+		// corners closer than epsilon share a cluster, list the corners
+		// of every cluster contiguously
+		std::vector<ofIndexType> representatives;
+		auto clusters = of::priv::weldPositions(verts, epsilon, numThreads, representatives);
+		std::vector<std::size_t> clusterStart(representatives.size() + 1, 0);
+		for(auto cluster: clusters){
+			clusterStart[cluster + 1]++;
+		}
+		std::partial_sum(clusterStart.begin(), clusterStart.end(), clusterStart.begin());
+		std::vector<ofIndexType> clusterCorners(verts.size());
+		{
+			auto next = clusterStart;
+			for(std::size_t i = 0; i < clusters.size(); i++){
+				clusterCorners[next[clusters[i]]++] = i;
 			}
 		}
 
-//		for( std::map<std::string, std::vector<int> >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//			//for( std::map<std::string, int >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//			ofLogNotice("ofMesh") << "smoothNormals(): " << it->first << "  num = " << it->second.size();
-//		}
-
-		V vert;
-		N normal;
+		// average the normals of the faces around each corner that are
+		// within angle of the corner's own face
 		float angleCos = cos(angle * DEG_TO_RAD );
-		float numNormals=0;
-
-		for(ofIndexType j = 0; j < triangles.size(); j++) {
-			for(ofIndexType k = 0; k < 3; k++) {
-				vert = triangles[j].getVertex(k);
-				xStr = "x"+ofToString(vert.x==-0?0:vert.x);
-				yStr = "y"+ofToString(vert.y==-0?0:vert.y);
-				zStr = "z"+ofToString(vert.z==-0?0:vert.z);
-
-				std::string vstring = xStr+yStr+zStr;
-				numNormals=0;
-				normal = {0.f,0.f,0.f};
-				if(vertHash.find(vstring) != vertHash.end()) {
-					for(ofIndexType i = 0; i < vertHash[vstring].size(); i++) {
-						auto f1 = triangles[j].getFaceNormal();
-						auto f2 = triangles[vertHash[vstring][i]].getFaceNormal();
-						if(glm::dot(toGlm(f1), toGlm(f2)) >= angleCos ) {
+		of::priv::meshParallelFor(triangles.size(), numThreads, [&](std::size_t begin, std::size_t end){
+			for(std::size_t j = begin; j < end; j++) {
+				const auto & f1 = toGlm(faceNormals[j]);
+				triangles[j].setHasNormals(true);
+				for(ofIndexType k = 0; k < 3; k++) {
+					auto cluster = clusters[j * 3 + k];
+					N normal = {0.f,0.f,0.f};
+					float numNormals = 0;
+					for(auto i = clusterStart[cluster]; i < clusterStart[cluster + 1]; i++) {
+						const auto & f2 = faceNormals[clusterCorners[i] / 3];
+						if(glm::dot(f1, toGlm(f2)) >= angleCos ) {
 							normal += f2;
-							numNormals+=1.f;
+							numNormals += 1.f;
 						}
 					}
-					//normal /= (float)vertHash[vstring].size();
-					normal /= numNormals;
-
-					triangles[j].setNormal(k, normal);
+					if(numNormals > 0){
+						normal /= numNormals;
+						triangles[j].setNormal(k, normal);
+					}
 				}
 			}
-		}
+		});
 
-		//ofLogNotice("ofMesh") << "smoothNormals(): setting from triangles ";
 		setFromTriangles( triangles );
 
 	}
@@ -151,6 +151,8 @@ namespace priv{
 		BaseEvent(const BaseEvent & mom){
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			self->functions = mom.self->functions;
+			self->snapshotDispatch = mom.self->snapshotDispatch;
+			self->updateSnapshot();
 		}
 
 		BaseEvent & operator=(const BaseEvent & mom){
@@ -161,6 +163,8 @@ namespace priv{
 			std::unique_lock<Mutex> lck2(self->mtx);
 			self->functions = mom.self->functions;
 			self->enabled = mom.self->enabled;
+			self->snapshotDispatch = mom.self->snapshotDispatch;
+			self->updateSnapshot();
 			return *this;
 		}
 
@@ -168,6 +172,9 @@ namespace priv{
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			self->functions = std::move(mom.self->functions);
 			self->enabled = std::move(mom.self->enabled);
+			self->snapshotDispatch = mom.self->snapshotDispatch;
+			self->updateSnapshot();
+			mom.self->updateSnapshot();
 		}
 
 		BaseEvent & operator=(BaseEvent && mom){
@@ -178,6 +185,8 @@ namespace priv{
 			std::unique_lock<Mutex> lck2(self->mtx);
 			self->functions = mom.self->functions;
 			self->enabled = mom.self->enabled;
+			self->snapshotDispatch = mom.self->snapshotDispatch;
+			self->updateSnapshot();
 			return *this;
 		}
 
@@ -197,12 +206,64 @@ namespace priv{
 			return self->functions.size();
 		}
 
+		/// \brief Enables or disables snapshot dispatch.
+		///
+		/// By default notify locks the event and copies the list of
+		/// listeners before calling them. With snapshot dispatch enabled
+		/// the event keeps an immutable copy of the listeners that is only
+		/// rebuilt when a listener is added or removed, so notify doesn't
+		/// need to lock or allocate. Useful for events that are notified
+		/// much more often than their listeners change.
+		void setSnapshotDispatch(bool snapshotDispatch){
+			std::unique_lock<Mutex> lck(self->mtx);
+			self->snapshotDispatch = snapshotDispatch;
+			self->updateSnapshot();
+		}
+
+		bool isSnapshotDispatch() const {
+			return self->snapshotDispatch;
+		}
+
 	protected:
+		typedef std::vector<std::shared_ptr<Function>> Functions;
 
 		struct Data{
 			Mutex mtx;
-			std::vector<std::shared_ptr<Function>> functions;
+			Functions functions;
 			bool enabled = true;
+			bool snapshotDispatch = false;
+
+			// current snapshot for notify, owned by snapshotOwner.
+			// replaced snapshots are kept in retiredSnapshots until no
+			// notify is running, since a notify might still be iterating them
+			std::atomic<const Functions*> snapshot{nullptr};
+			std::atomic<int> dispatching{0};
+			std::atomic<bool> hasRetiredSnapshots{false};
+			std::shared_ptr<const Functions> snapshotOwner;
+			std::vector<std::shared_ptr<const Functions>> retiredSnapshots;
+
+			// should be called with mtx locked
+			void updateSnapshot(){
+				std::shared_ptr<const Functions> next;
+				if(snapshotDispatch){
+					next = std::make_shared<Functions>(functions);
+				}
+				snapshot.store(next.get());
+				if(snapshotOwner){
+					retiredSnapshots.push_back(std::move(snapshotOwner));
+					hasRetiredSnapshots = true;
+				}
+				snapshotOwner = std::move(next);
+				clearRetiredSnapshots();
+			}
+
+			// should be called with mtx locked
+			void clearRetiredSnapshots(){
+				if(dispatching.load()==0){
+					retiredSnapshots.clear();
+					hasRetiredSnapshots = false;
+				}
+			}
 
 			void remove(const BaseFunctionId & id){
 				std::unique_lock<Mutex> lck(mtx);
@@ -212,6 +273,7 @@ namespace priv{
 					if(*f->id == id){
 						f->disable();
 						functions.erase(it);
+						updateSnapshot();
 						break;
 					}
 				}
@@ -219,6 +281,42 @@ namespace priv{
 		};
 		std::shared_ptr<Data> self{new Data};
 
+		class DispatchGuard{
+		public:
+			DispatchGuard(Data & data)
+			:data(data){
+				data.dispatching++;
+			}
+
+			// the last notify to finish frees the snapshots replaced while
+			// it was running, the lock is only taken if there are any
+			~DispatchGuard(){
+				if(--data.dispatching==0 && data.hasRetiredSnapshots.load()){
+					std::unique_lock<Mutex> lck(data.mtx);
+					data.clearRetiredSnapshots();
+				}
+			}
+
+		private:
+			Data & data;
+		};
+
+		// notify through the current snapshot, no lock or copy
+		// of the listeners involved
+		template<typename... Args>
+		inline bool notifySnapshot(Args&&... args){
+			DispatchGuard guard(*self);
+			auto functions = self->snapshot.load();
+			if(functions){
+				for(auto & f: *functions){
+					if(f->notify(args...)){
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
 		class EventToken: public AbstractEventToken{
 			public:
 				EventToken() {};
@@ -253,6 +351,7 @@ namespace priv{
 				if((*it)->priority>f->priority) break;
 			}
 			self->functions.emplace(it, f);
+			self->updateSnapshot();
 		}
 
 		template<typename TFunction>
@@ -263,6 +362,7 @@ namespace priv{
 				if((*it)->priority>f->priority) break;
 			}
 			self->functions.emplace(it, f);
+			self->updateSnapshot();
 			return make_token(*f);
 		}
 	};
@@ -556,6 +656,9 @@ public:
 	}
 
 	inline bool notify(const void* sender, T & param){
+		if(ofEvent<T,Mutex>::self->enabled && ofEvent<T,Mutex>::self->snapshotDispatch){
+			return this->notifySnapshot(sender,param);
+		}
 		if(ofEvent<T,Mutex>::self->enabled && !ofEvent<T,Mutex>::self->functions.empty()){
 			std::unique_lock<Mutex> lck(ofEvent<T,Mutex>::self->mtx);
 			auto functions_copy = ofEvent<T,Mutex>::self->functions;
@@ -570,6 +673,9 @@ public:
 	}
 
 	inline bool notify(T & param){
+		if(ofEvent<T,Mutex>::self->enabled && ofEvent<T,Mutex>::self->snapshotDispatch){
+			return this->notifySnapshot(nullptr,param);
+		}
 		if(ofEvent<T,Mutex>::self->enabled && !ofEvent<T,Mutex>::self->functions.empty()){
 			std::unique_lock<Mutex> lck(ofEvent<T,Mutex>::self->mtx);
 			auto functions_copy = ofEvent<T,Mutex>::self->functions;
@@ -714,6 +820,9 @@ public:
 	}
 
 	bool notify(const void* sender){
+		if(ofEvent<void,Mutex>::self->enabled && ofEvent<void,Mutex>::self->snapshotDispatch){
+			return this->notifySnapshot(sender);
+		}
 		if(ofEvent<void,Mutex>::self->enabled && !ofEvent<void,Mutex>::self->functions.empty()){
 			std::unique_lock<Mutex> lck(ofEvent<void,Mutex>::self->mtx);
 			auto functions_copy = ofEvent<void,Mutex>::self->functions;
@@ -728,6 +837,9 @@ public:
 	}
 
 	bool notify(){
+		if(ofEvent<void,Mutex>::self->enabled && ofEvent<void,Mutex>::self->snapshotDispatch){
+			return this->notifySnapshot(nullptr);
+		}
 		if(ofEvent<void,Mutex>::self->enabled && !ofEvent<void,Mutex>::self->functions.empty()){
 			std::unique_lock<Mutex> lck(ofEvent<void,Mutex>::self->mtx);
 			auto functions_copy = ofEvent<void,Mutex>::self->functions;
@@ -3,6 +3,7 @@
 #include "ofAppRunner.h"
 #include "ofPixels.h"
 #include "ofGLUtils.h"
+#include "ofLog.h"
 
 using namespace std;
 
@@ -157,6 +158,27 @@ void ofBufferObject::updateData(GLsizeiptr bytes, const void * data){
 }
 
 #ifndef TARGET_OPENGLES
+void ofBufferObject::allocateStorage(GLsizeiptr bytes, const void * data, GLbitfield flags){
+	allocate();
+	this->data->size = bytes;
+
+#ifdef GLEW_VERSION_4_5
+	if(this->data->isDSA) {
+		glNamedBufferStorage(this->data->id, bytes, data, flags);
+		return;
+	}
+#endif
+
+	/// --------| invariant: direct state access is not available
+#ifdef GLEW_ARB_buffer_storage
+	bind(this->data->lastTarget);
+	glBufferStorage(this->data->lastTarget, bytes, data, flags);
+	unbind(this->data->lastTarget);
+#else
+	ofLogError("ofBufferObject") << "allocateStorage(): buffer storage not supported";
+#endif
+}
+
 void * ofBufferObject::map(GLenum access){
 	if(!this->data) return nullptr;
 
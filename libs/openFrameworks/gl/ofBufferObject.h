@@ -95,6 +95,12 @@ public:
     }
 
 #ifndef TARGET_OPENGLES
+	/// glNamedBufferStorage: https://www.opengl.org/sdk/docs/man4/html/glBufferStorage.xhtml
+	/// allocates immutable storage, with GL_MAP_PERSISTENT_BIT the buffer can stay
+	/// mapped while it's drawn. needs GL 4.4 or ARB_buffer_storage, before GL 4.5
+	/// emulates glNamedBufferStorage by binding to the last known target
+	void allocateStorage(GLsizeiptr bytes, const void * data, GLbitfield flags);
+
 	/// glMapNamedBuffer: https://www.opengl.org/sdk/docs/man4/html/glMapBuffer.xhtml
 	/// before GL 4.5 emulates glMapNamedBuffer by binding to last known target
 	/// for this buffer and mapping that target
@@ -30,6 +30,11 @@ static const string USE_TEXTURE_UNIFORM="usingTexture";
 static const string USE_COLORS_UNIFORM="usingColors";
 static const string BITMAP_STRING_UNIFORM="bitmapText";
 
+// vertices in each of the NUM_BATCH_REGIONS regions of the persistently
+// mapped batch buffer. the regions are written in turn and one is only
+// written again once the GPU has finished drawing it
+static const size_t BATCH_REGION_VERTICES = 1 << 16;
+
 
 const string ofGLProgrammableRenderer::TYPE="ProgrammableGL";
 static bool programmableRendererCreated = false;
@@ -77,12 +82,32 @@ ofGLProgrammableRenderer::ofGLProgrammableRenderer(const ofAppBaseWindow * _wind
 
 	currentFramebufferId = 0;
 	defaultFramebufferId = 0;
+
+	batching = false;
+	batchMapped = nullptr;
+#ifndef TARGET_OPENGLES
+	for(auto & fence: batchFences){
+		fence = nullptr;
+	}
+#endif
+	batchRegion = 0;
+	batchFirst = 0;
+	batchCount = 0;
+	batchMode = GL_TRIANGLES;
+	numDrawCalls = 0;
+
 	path.setMode(ofPath::POLYLINES);
     path.setUseShapeColor(false);
 }
 
+//----------------------------------------------------------
+ofGLProgrammableRenderer::~ofGLProgrammableRenderer(){
+	releaseBatch();
+}
+
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::startRender() {
+	numDrawCalls = 0;
 	currentFramebufferId = defaultFramebufferId;
 	framebufferIdStack.push_back(defaultFramebufferId);
 	matrixStack.setRenderSurface(*window);
@@ -104,6 +129,7 @@ void ofGLProgrammableRenderer::startRender() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::finishRender() {
+	flushBatch();
 	if (!uniqueShader) {
 		glUseProgram(0);
 		if(!usingCustomShader) currentShader = nullptr;
@@ -115,6 +141,7 @@ void ofGLProgrammableRenderer::finishRender() {
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const{
 	if (vertexData.getVertices().empty()) return;
+	flushBatch();
 	
 	
 	// tig: note that for GL3+ we use glPolygonMode to draw wireframes or filled meshes, and not the primitive mode.
@@ -177,6 +204,7 @@ void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode
 	}else{
 		glDrawArrays(drawMode, 0, vertexData.getNumVertices());
 	}
+	numDrawCalls++;
 #else
 	
 
@@ -231,6 +259,7 @@ void ofGLProgrammableRenderer::draw(const ofVboMesh & mesh, ofPolyRenderMode ren
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawInstanced(const ofVboMesh & mesh, ofPolyRenderMode renderType, int primCount) const{
 	if(mesh.getNumVertices()==0) return;
+	flushBatch();
 	GLuint mode = ofGetGLPrimitiveMode(mesh.getMode());
 #ifndef TARGET_OPENGLES
 	glPolygonMode(GL_FRONT_AND_BACK, ofGetGLPolyMode(renderType));
@@ -422,16 +451,19 @@ void ofGLProgrammableRenderer::draw(const ofBaseVideoDraws & video, float x, flo
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofVbo & vbo, GLuint drawMode, int first, int total) const{
 	if(vbo.getUsingVerts()) {
+		flushBatch();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
 		glDrawArrays(drawMode, first, total);
 		vbo.unbind();
+		numDrawCalls++;
 	}
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode, int amt, int offsetelements) const{
 	if(vbo.getUsingVerts()) {
+		flushBatch();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
 #ifdef TARGET_OPENGLES
@@ -440,12 +472,14 @@ void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode,
         glDrawElements(drawMode, amt, GL_UNSIGNED_INT, (void*)(sizeof(ofIndexType) * offsetelements));
 #endif
 		vbo.unbind();
+		numDrawCalls++;
 	}
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode, int first, int total, int primCount) const{
 	if(vbo.getUsingVerts()) {
+		flushBatch();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
 #ifdef TARGET_OPENGLES
@@ -458,12 +492,14 @@ void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode,
 		glDrawArraysInstanced(drawMode, first, total, primCount);
 #endif
 		vbo.unbind();
+		numDrawCalls++;
 	}
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawElementsInstanced(const ofVbo & vbo, GLuint drawMode, int amt, int primCount) const{
 	if(vbo.getUsingVerts()) {
+		flushBatch();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(vbo.getUsingVerts(),vbo.getUsingColors(),vbo.getUsingTexCoords(),vbo.getUsingNormals());
 #ifdef TARGET_OPENGLES
@@ -476,6 +512,7 @@ void ofGLProgrammableRenderer::drawElementsInstanced(const ofVbo & vbo, GLuint d
         glDrawElementsInstanced(drawMode, amt, GL_UNSIGNED_INT, nullptr, primCount);
 #endif
 		vbo.unbind();
+		numDrawCalls++;
 	}
 }
 
@@ -536,6 +573,7 @@ void ofGLProgrammableRenderer::viewport(ofRectangle viewport_){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::viewport(float x, float y, float width, float height, bool vflip) {
+	flushBatch();
 	matrixStack.viewport(x,y,width,height,vflip);
 	ofRectangle nativeViewport = matrixStack.getNativeViewport();
 	glViewport(nativeViewport.x,nativeViewport.y,nativeViewport.width,nativeViewport.height);
@@ -784,6 +822,8 @@ glm::mat4 ofGLProgrammableRenderer::getCurrentNormalMatrix() const{
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::uploadCurrentMatrix(){
 	if(!currentShader) return;
+	// the shader still has the matrix of what's batched
+	flushBatch();
 	// uploads the current matrix to the current shader.
 	switch(matrixStack.getCurrentMatrixMode()){
 	case OF_MATRIX_MODELVIEW:
@@ -848,6 +888,7 @@ void ofGLProgrammableRenderer::setColor(int _r, int _g, int _b){
 void ofGLProgrammableRenderer::setColor(int _r, int _g, int _b, int _a){
 	ofColor newColor(_r,_g,_b,_a);
 	if(newColor!=currentStyle.color){
+		flushBatch();
         currentStyle.color = newColor;
 		if(currentShader){
 			currentShader->setUniform4f(COLOR_UNIFORM,_r/255.,_g/255.,_b/255.,_a/255.);
@@ -875,11 +916,13 @@ void ofGLProgrammableRenderer::setBitmapTextMode(ofDrawBitmapMode mode){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clear(){
+	flushBatch();
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clear(float r, float g, float b, float a) {
+	flushBatch();
 	glClearColor(r / 255., g / 255., b / 255., a / 255.);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -891,6 +934,7 @@ void ofGLProgrammableRenderer::clear(float brightness, float a) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clearAlpha() {
+	flushBatch();
 	glColorMask(0, 0, 0, 1);
 	glClearColor(0, 0, 0, 1);
 	glClear(GL_COLOR_BUFFER_BIT);
@@ -920,6 +964,7 @@ void ofGLProgrammableRenderer::setBackgroundColor(const ofColor & c){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::background(const ofColor & c){
+	flushBatch();
 	setBackgroundColor(c);
 	glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 }
@@ -941,6 +986,7 @@ void ofGLProgrammableRenderer::background(int r, int g, int b, int a){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setFillMode(ofFillFlag fill){
+	flushBatch();
 	currentStyle.bFill = (fill==OF_FILLED);
 	if(currentStyle.bFill){
 		path.setFilled(true);
@@ -995,6 +1041,7 @@ void ofGLProgrammableRenderer::setLineWidth(float lineWidth){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setDepthTest(bool depthTest) {
+	flushBatch();
 	if(depthTest) {
 		glEnable(GL_DEPTH_TEST);
 	} else {
@@ -1019,6 +1066,7 @@ void ofGLProgrammableRenderer::endSmoothing(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setBlendMode(ofBlendMode blendMode){
+	flushBatch();
 	switch (blendMode){
 		case OF_BLENDMODE_DISABLED:
 			glDisable(GL_BLEND);
@@ -1085,6 +1133,7 @@ void ofGLProgrammableRenderer::disablePointSprites(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::enableAntiAliasing(){
+	flushBatch();
 #if !defined(TARGET_PROGRAMMABLE_GL) || !defined(TARGET_OPENGLES)
 	glEnable(GL_MULTISAMPLE);
 #endif
@@ -1092,6 +1141,7 @@ void ofGLProgrammableRenderer::enableAntiAliasing(){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disableAntiAliasing(){
+	flushBatch();
 #if !defined(TARGET_PROGRAMMABLE_GL) || !defined(TARGET_OPENGLES)
 	glDisable(GL_MULTISAMPLE);
 #endif
@@ -1108,6 +1158,7 @@ void ofGLProgrammableRenderer::setAlphaBitmapText(bool bitmapText){
 	bitmapStringEnabled = bitmapText;
 
 	if(wasBitmapStringEnabled!=bitmapText){
+		flushBatch();
 		if(currentShader) currentShader->setUniform1f(BITMAP_STRING_UNIFORM,bitmapText);
 	}
 }
@@ -1184,6 +1235,9 @@ void ofGLProgrammableRenderer::setCurveResolution(int resolution){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setAttributes(bool vertices, bool color, bool tex, bool normals){
+	if(color!=colorsEnabled || tex!=texCoordsEnabled || normals!=normalsEnabled){
+		flushBatch();
+	}
 	bool wasColorsEnabled = colorsEnabled;
 	bool wasUsingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
 
@@ -1206,6 +1260,7 @@ void ofGLProgrammableRenderer::setAttributes(bool vertices, bool color, bool tex
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::enableTextureTarget(const ofTexture & tex, int textureLocation){
+	flushBatch();
 	bool wasUsingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
 	currentTextureTarget = tex.texData.textureTarget;
 
@@ -1225,6 +1280,7 @@ void ofGLProgrammableRenderer::enableTextureTarget(const ofTexture & tex, int te
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disableTextureTarget(int textureTarget, int textureLocation){
+	flushBatch();
 	bool wasUsingTexture = texCoordsEnabled & (currentTextureTarget!=OF_NO_TEXTURE);
 	currentTextureTarget = OF_NO_TEXTURE;
 
@@ -1272,6 +1328,7 @@ void ofGLProgrammableRenderer::bind(const ofShader & shader){
     if(currentShader && *currentShader==shader){
 		return;
     }
+	flushBatch();
 	glUseProgram(shader.getProgram());
 
 	currentShader = &shader;
@@ -1284,6 +1341,7 @@ void ofGLProgrammableRenderer::bind(const ofShader & shader){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofShader & shader){
+	flushBatch();
 	glUseProgram(0);
 	usingCustomShader = false;
 	beginDefaultShader();
@@ -1328,6 +1386,7 @@ void ofGLProgrammableRenderer::bind(const ofFbo & fbo){
 	// I'm keeping it here, so that if we want to do more fancyful
 	// named framebuffers with GL 4.5+, we can have 
 	// different implementations.
+	flushBatch();
 	framebufferIdStack.push_back(currentFramebufferId);
 	currentFramebufferId = fbo.getId();
 	glBindFramebuffer(GL_FRAMEBUFFER, currentFramebufferId);
@@ -1346,6 +1405,7 @@ void ofGLProgrammableRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fbo
 	// I'm keeping it here, so that if we want to do more fancyful
 	// named framebuffers with GL 4.5+, we can have
 	// different implementations.
+	flushBatch();
 	framebufferIdStack.push_back(currentFramebufferId);
 	currentFramebufferId = fboSrc.getId();
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, currentFramebufferId);
@@ -1357,6 +1417,7 @@ void ofGLProgrammableRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fbo
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofFbo & fbo){
+	flushBatch();
 	if(framebufferIdStack.empty()){
 		ofLogError() << "unbalanced fbo bind/unbind binding default framebuffer";
 		currentFramebufferId = defaultFramebufferId;
@@ -1370,6 +1431,7 @@ void ofGLProgrammableRenderer::unbind(const ofFbo & fbo){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofBaseMaterial & material){
+	flushBatch();
     currentMaterial = &material;
     // FIXME: this invalidates the previous shader to avoid that
     // when binding 2 materials one after another, the second won't
@@ -1380,6 +1442,7 @@ void ofGLProgrammableRenderer::bind(const ofBaseMaterial & material){
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofBaseMaterial &){
+	flushBatch();
     currentMaterial = nullptr;
 	beginDefaultShader();
 }
@@ -1474,6 +1537,7 @@ void ofGLProgrammableRenderer::unbind(const ofCamera & camera){
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::uploadMatrices(){
 	if(!currentShader) return;
+	flushBatch();
 	currentShader->setUniformMatrix4f(MODEL_MATRIX_UNIFORM, matrixStack.getModelMatrix());
 	currentShader->setUniformMatrix4f(VIEW_MATRIX_UNIFORM, matrixStack.getViewMatrix());
 	currentShader->setUniformMatrix4f(MODELVIEW_MATRIX_UNIFORM, matrixStack.getModelViewMatrix());
@@ -1580,7 +1644,9 @@ void ofGLProgrammableRenderer::drawLine(float x1, float y1, float z1, float x2,
 	// use smoothness, if requested:
 	if (currentStyle.smoothing) mutThis->startSmoothing();
     
-	draw(lineMesh,OF_MESH_FILL,false,false,false);
+	if(!batch(lineMesh)){
+		draw(lineMesh,OF_MESH_FILL,false,false,false);
+	}
     
 	// use smoothness, if requested:
 	if (currentStyle.smoothing) mutThis->endSmoothing();
@@ -1605,7 +1671,9 @@ void ofGLProgrammableRenderer::drawRectangle(float x, float y, float z, float w,
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
 	rectMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_LOOP);
-	draw(rectMesh,OF_MESH_FILL,false,false,false);
+	if(!batch(rectMesh)){
+		draw(rectMesh,OF_MESH_FILL,false,false,false);
+	}
     
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->endSmoothing();
@@ -1622,7 +1690,9 @@ void ofGLProgrammableRenderer::drawTriangle(float x1, float y1, float z1, float
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
 	triangleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_STRIP : OF_PRIMITIVE_LINE_LOOP);
-	draw(triangleMesh,OF_MESH_FILL,false,false,false);
+	if(!batch(triangleMesh)){
+		draw(triangleMesh,OF_MESH_FILL,false,false,false);
+	}
     
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->endSmoothing();
@@ -1640,7 +1710,9 @@ void ofGLProgrammableRenderer::drawCircle(float x, float y, float z,  float radi
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
 	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
-	draw(circleMesh,OF_MESH_FILL,false,false,false);
+	if(!batch(circleMesh)){
+		draw(circleMesh,OF_MESH_FILL,false,false,false);
+	}
 	
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->endSmoothing();
@@ -1660,12 +1732,199 @@ void ofGLProgrammableRenderer::drawEllipse(float x, float y, float z, float widt
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
 
 	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
-	draw(circleMesh,OF_MESH_FILL,false,false,false);
+	if(!batch(circleMesh)){
+		draw(circleMesh,OF_MESH_FILL,false,false,false);
+	}
     
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->endSmoothing();
 }
 
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::setBatching(bool _batching){
+	if(!_batching){
+		flushBatch();
+	}
+	batching = _batching;
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::isBatching() const{
+	return batching;
+}
+
+//----------------------------------------------------------
+size_t ofGLProgrammableRenderer::getNumDrawCalls() const{
+	return numDrawCalls;
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::batch(const ofMesh & mesh) const{
+	if(!batching) return false;
+	const auto & vertices = mesh.getVertices();
+	size_t n = vertices.size();
+	glm::vec3 * batched;
+	switch(mesh.getMode()){
+	case OF_PRIMITIVE_TRIANGLE_FAN:
+		if(n < 3) return true;
+		batched = beginBatch(GL_TRIANGLES, (n - 2) * 3);
+		if(!batched) return false;
+		for(size_t i = 1; i < n - 1; i++){
+			*batched++ = vertices[0];
+			*batched++ = vertices[i];
+			*batched++ = vertices[i + 1];
+		}
+		return true;
+	case OF_PRIMITIVE_TRIANGLE_STRIP:
+		if(n < 3) return true;
+		batched = beginBatch(GL_TRIANGLES, (n - 2) * 3);
+		if(!batched) return false;
+		for(size_t i = 1; i < n - 1; i++){
+			// keeping the winding of every triangle in the strip
+			*batched++ = vertices[i % 2 ? i - 1 : i];
+			*batched++ = vertices[i % 2 ? i : i - 1];
+			*batched++ = vertices[i + 1];
+		}
+		return true;
+	case OF_PRIMITIVE_LINES:
+		batched = beginBatch(GL_LINES, n / 2 * 2);
+		if(!batched) return false;
+		std::copy(vertices.begin(), vertices.begin() + n / 2 * 2, batched);
+		return true;
+	case OF_PRIMITIVE_LINE_STRIP:
+	case OF_PRIMITIVE_LINE_LOOP:{
+		if(n < 2) return true;
+		bool loop = mesh.getMode() == OF_PRIMITIVE_LINE_LOOP;
+		size_t numSegments = loop ? n : n - 1;
+		batched = beginBatch(GL_LINES, numSegments * 2);
+		if(!batched) return false;
+		for(size_t i = 0; i < numSegments; i++){
+			*batched++ = vertices[i];
+			*batched++ = vertices[(i + 1) % n];
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+//----------------------------------------------------------
+glm::vec3 * ofGLProgrammableRenderer::beginBatch(GLenum mode, size_t numVertices) const{
+	if(numVertices > BATCH_REGION_VERTICES){
+		flushBatch();
+		return nullptr;
+	}
+	// switching to the shader without colors, textures or normals draws
+	// what's batched with the previous one
+	const_cast<ofGLProgrammableRenderer*>(this)->setAttributes(true,false,false,false);
+	if(mode != batchMode){
+		flushBatch();
+		batchMode = mode;
+	}
+	if(!batchBuffer.isAllocated()){
+		allocateBatch(true);
+	}
+
+#ifndef TARGET_OPENGLES
+	if(batchMapped && batchFirst + batchCount + numVertices > (batchRegion + 1) * BATCH_REGION_VERTICES){
+		flushBatch();
+		batchFences[batchRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		batchRegion = (batchRegion + 1) % NUM_BATCH_REGIONS;
+		batchFirst = batchRegion * BATCH_REGION_VERTICES;
+		// the GPU could still be drawing the next region
+		auto & fence = batchFences[batchRegion];
+		if(fence){
+			GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+			GLenum result;
+			do{
+				result = glClientWaitSync(fence, flags, 1000000000);
+				flags = 0;
+			}while(result == GL_TIMEOUT_EXPIRED);
+			glDeleteSync(fence);
+			fence = nullptr;
+			if(result == GL_WAIT_FAILED){
+				ofLogWarning("ofGLProgrammableRenderer") << "couldn't wait for the batched vertices to be drawn, uploading them on every flush instead";
+				releaseBatch();
+				allocateBatch(false);
+			}
+		}
+	}
+	if(batchMapped){
+		auto vertices = batchMapped + batchFirst + batchCount;
+		batchCount += numVertices;
+		return vertices;
+	}
+#endif
+
+	batchVertices.resize(batchCount + numVertices);
+	auto vertices = batchVertices.data() + batchCount;
+	batchCount += numVertices;
+	return vertices;
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::allocateBatch(bool persistent) const{
+	// a buffer with immutable storage can't be allocated again
+	batchBuffer = ofBufferObject();
+	batchMapped = nullptr;
+#if !defined(TARGET_OPENGLES) && defined(GLEW_ARB_buffer_storage)
+	if(persistent && GLEW_ARB_buffer_storage){
+		GLsizeiptr bytes = BATCH_REGION_VERTICES * NUM_BATCH_REGIONS * sizeof(glm::vec3);
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		batchBuffer.allocateStorage(bytes, nullptr, flags);
+		batchMapped = batchBuffer.mapRange<glm::vec3>(0, bytes, flags);
+		batchBuffer.unbind(GL_ARRAY_BUFFER);
+	}
+#endif
+	if(!batchMapped){
+		// streamed on every flush instead
+		batchBuffer.allocate();
+	}
+	batchVbo.setVertexBuffer(batchBuffer, 3, sizeof(glm::vec3));
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::releaseBatch() const{
+#ifndef TARGET_OPENGLES
+	for(auto & fence: batchFences){
+		if(fence){
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+	if(batchMapped){
+		batchBuffer.unmap();
+		batchMapped = nullptr;
+	}
+#endif
+	batchRegion = 0;
+	batchFirst = 0;
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::flushBatch() const{
+	if(batchCount == 0) return;
+	// reset first, drawing can't flush again
+	auto first = batchFirst;
+	auto count = batchCount;
+	batchCount = 0;
+#ifndef TARGET_OPENGLES
+	if(batchMapped){
+		batchFirst += count;
+	}else
+#endif
+	{
+		batchBuffer.setData(count * sizeof(glm::vec3), batchVertices.data(), GL_STREAM_DRAW);
+		batchVertices.clear();
+	}
+
+	batchVbo.bind();
+	glDrawArrays(batchMode, first, count);
+	batchVbo.unbind();
+	numDrawCalls++;
+}
+
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawString(string textString, float x, float y, float z) const{
 	ofGLProgrammableRenderer * mutThis = const_cast<ofGLProgrammableRenderer*>(this);
@@ -1826,9 +2085,14 @@ void ofGLProgrammableRenderer::drawString(const ofTrueTypeFont & font, string te
 
 	mutThis->setBlendMode(OF_BLENDMODE_ALPHA);
 
-	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
-	mutThis->unbind(font.getFontTexture(),0);
+	// fonts loading glyphs on demand have one mesh per atlas page
+	const auto & meshes = font.getStringMeshes(text,x,y,isVFlipped());
+	for(size_t i = 0; i < meshes.size(); i++){
+		if(meshes[i].getNumIndices() == 0) continue;
+		mutThis->bind(font.getAtlasPage(i),0);
+		draw(meshes[i],OF_MESH_FILL);
+		mutThis->unbind(font.getAtlasPage(i),0);
+	}
 
 	mutThis->setBlendMode(blendMode);
 }
@@ -2631,6 +2895,7 @@ void ofGLProgrammableRenderer::saveFullViewport(ofPixels & pixels){
 }
 
 void ofGLProgrammableRenderer::saveScreen(int x, int y, int w, int h, ofPixels & pixels){
+	flushBatch();
     int sh = getViewportHeight();
 
 
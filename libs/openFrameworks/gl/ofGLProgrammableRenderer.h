@@ -18,6 +18,7 @@ static const int OF_NO_TEXTURE=-1;
 class ofGLProgrammableRenderer: public ofBaseGLRenderer{
 public:
     ofGLProgrammableRenderer(const ofAppBaseWindow * window);
+    ~ofGLProgrammableRenderer();
 
 	void setup(int glVersionMajor, int glVersionMinor);
 
@@ -166,6 +167,21 @@ public:
 	void drawString(std::string text, float x, float y, float z) const;
 	void drawString(const ofTrueTypeFont & font, std::string text, float x, float y) const;
 
+	/// \brief Batch lines, rectangles, triangles, circles and ellipses.
+	///
+	/// While batching, consecutive primitives drawn with the same style,
+	/// matrices and shader are written to a streaming buffer, persistently
+	/// mapped when GL 4.4 or ARB_buffer_storage is available, and drawn with
+	/// a single draw call once any of those change or anything else is drawn.
+	/// Outlines are drawn as separate line segments. Call flushBatch before
+	/// using OpenGL directly.
+	void setBatching(bool batching);
+	bool isBatching() const;
+	void flushBatch() const;
+
+	/// \returns the draw calls since the frame started
+	std::size_t getNumDrawCalls() const;
+
 
 	void enableTextureTarget(const ofTexture & tex, int textureLocation);
 	void disableTextureTarget(int textureTarget, int textureLocation);
@@ -245,6 +261,34 @@ private:
 	mutable ofMesh lineMesh;
 	mutable ofVbo meshVbo;
 
+	// adds the mesh of a primitive to the batch, false if it has to be drawn
+	bool batch(const ofMesh & mesh) const;
+	// where to write the vertices of the next batched primitive, nullptr
+	// if it has to be drawn on its own
+	glm::vec3 * beginBatch(GLenum mode, std::size_t numVertices) const;
+	// maps the buffer persistently if persistent and it's supported
+	void allocateBatch(bool persistent) const;
+	// deletes the fences and unmaps the buffer
+	void releaseBatch() const;
+
+	// regions of the mapped batch buffer, one is written while the GPU
+	// can still be drawing the others
+	static const std::size_t NUM_BATCH_REGIONS = 3;
+
+	bool batching;
+	mutable ofVbo batchVbo;
+	mutable ofBufferObject batchBuffer;
+	mutable glm::vec3 * batchMapped; // nullptr if the buffer can't be mapped persistently
+	mutable std::vector<glm::vec3> batchVertices; // uploaded on flush if it can't
+#ifndef TARGET_OPENGLES
+	mutable GLsync batchFences[NUM_BATCH_REGIONS]; // by region of the mapped buffer
+#endif
+	mutable std::size_t batchRegion;
+	mutable std::size_t batchFirst;
+	mutable std::size_t batchCount;
+	mutable GLenum batchMode;
+	mutable std::size_t numDrawCalls;
+
 	void uploadCurrentMatrix();
 
 
@@ -1691,9 +1691,14 @@ void ofGLRenderer::drawString(const ofTrueTypeFont & font, string text, float x,
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
-	mutThis->unbind(font.getFontTexture(),0);
+	// fonts loading glyphs on demand have one mesh per atlas page
+	const auto & meshes = font.getStringMeshes(text,x,y,isVFlipped());
+	for(size_t i = 0; i < meshes.size(); i++){
+		if(meshes[i].getNumIndices() == 0) continue;
+		mutThis->bind(font.getAtlasPage(i),0);
+		draw(meshes[i],OF_MESH_FILL);
+		mutThis->unbind(font.getAtlasPage(i),0);
+	}
 
 	if(!blendEnabled){
 		glDisable(GL_BLEND);
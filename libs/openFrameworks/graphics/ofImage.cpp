@@ -5,6 +5,7 @@
 
 #include "ofURLFileLoader.h"
 #include "uriparser/Uri.h"
+#include <mutex>
 
 #if defined(TARGET_ANDROID)
 #include "ofxAndroidUtils.h"
@@ -17,6 +18,10 @@ void ofInitFreeImage(bool deinit=false){
 	// need a new bool to avoid c++ "deinitialization order fiasco":
 	// http://www.parashift.com/c++-faq-lite/ctors.html#faq-10.15
 	static bool	* bFreeImageInited = new bool(false);
+	// images can be loaded from several threads at once, like the workers
+	// of ofxThreadedImageLoader
+	static std::mutex * initMutex = new std::mutex;
+	std::unique_lock<std::mutex> lock(*initMutex);
 	if(!*bFreeImageInited && !deinit){
 		FreeImage_Initialise();
 		*bFreeImageInited = true;
@@ -94,10 +99,10 @@ FIBITMAP* getBmpFromPixels(const ofPixels_<PixelType> &pix){
 }
 
 //----------------------------------------------------
+// returns a copy of bmp converted to a type that can be copied into
+// ofPixels_<PixelType> or nullptr if it can already be copied as it is
 template<typename PixelType>
-void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLittleEndian = true) {
-
-	// convert to correct type depending on type of input bmp and PixelType
+FIBITMAP* convertBmpForPixels(FIBITMAP * bmp) {
 	FIBITMAP* bmpConverted = nullptr;
 	FREE_IMAGE_TYPE imgType = FreeImage_GetImageType(bmp);
 	if(sizeof(PixelType)==1 &&
@@ -108,20 +113,29 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLitt
 		} else {
 			bmpConverted = FreeImage_ConvertTo24Bits(bmp);
 		}
-		bmp = bmpConverted;
 	}else if(sizeof(PixelType)==2 && imgType!=FIT_UINT16 && imgType!=FIT_RGB16 && imgType!=FIT_RGBA16){
 		if(FreeImage_IsTransparent(bmp)) {
 			bmpConverted = FreeImage_ConvertToType(bmp,FIT_RGBA16);
 		} else {
 			bmpConverted = FreeImage_ConvertToType(bmp,FIT_RGB16);
 		}
-		bmp = bmpConverted;
 	}else if(sizeof(PixelType)==4 && imgType!=FIT_FLOAT && imgType!=FIT_RGBF && imgType!=FIT_RGBAF){
 		if(FreeImage_IsTransparent(bmp)) {
 			bmpConverted = FreeImage_ConvertToType(bmp,FIT_RGBAF);
 		} else {
 			bmpConverted = FreeImage_ConvertToType(bmp,FIT_RGBF);
 		}
+	}
+	return bmpConverted;
+}
+
+//----------------------------------------------------
+template<typename PixelType>
+void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLittleEndian = true) {
+
+	// convert to correct type depending on type of input bmp and PixelType
+	FIBITMAP* bmpConverted = convertBmpForPixels<PixelType>(bmp);
+	if(bmpConverted != nullptr) {
 		bmp = bmpConverted;
 	}
 
@@ -166,6 +180,105 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLitt
     }
 }
 
+//----------------------------------------------------
+// copies bmp into pix which has to be already allocated with the same size,
+// flipping it and rearranging the channels to the format of pix in one pass
+// without reallocating pix
+template<typename PixelType>
+bool copyBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix) {
+	FIBITMAP* bmpConverted = convertBmpForPixels<PixelType>(bmp);
+	if(bmpConverted != nullptr) {
+		bmp = bmpConverted;
+	}
+
+	size_t width = FreeImage_GetWidth(bmp);
+	size_t height = FreeImage_GetHeight(bmp);
+	size_t srcChannels = (FreeImage_GetBPP(bmp) / sizeof(PixelType)) / 8;
+	size_t dstChannels = pix.getNumChannels();
+
+	// position of each of R, G, B and A in the source pixels
+	size_t srcR = 0, srcG = 1, srcB = 2, srcA = 3;
+#ifdef TARGET_LITTLE_ENDIAN
+	if(sizeof(PixelType) == 1 && srcChannels >= 3) {
+		srcR = 2;
+		srcB = 0;
+	}
+#endif
+	if(srcChannels == 1) {
+		srcG = srcB = 0;
+	}
+
+	// source channel for each destination channel, npos is opaque alpha
+	const size_t npos = std::numeric_limits<size_t>::max();
+	size_t channelMap[4] = {npos, npos, npos, npos};
+	switch(pix.getPixelFormat()) {
+		case OF_PIXELS_GRAY:
+			if(srcChannels == 1) channelMap[0] = 0;
+			break;
+		case OF_PIXELS_RGB:
+		case OF_PIXELS_RGBA:
+			channelMap[0] = srcR;
+			channelMap[1] = srcG;
+			channelMap[2] = srcB;
+			break;
+		case OF_PIXELS_BGR:
+		case OF_PIXELS_BGRA:
+			channelMap[0] = srcB;
+			channelMap[1] = srcG;
+			channelMap[2] = srcR;
+			break;
+		default:
+			break;
+	}
+	if(srcChannels == 4 && dstChannels == 4) {
+		channelMap[3] = srcA;
+	}
+
+	bool ok = true;
+	if(width != pix.getWidth() || height != pix.getHeight()) {
+		ofLogError("ofImage") << "loadImage(): image is " << width << "x" << height
+			<< " but pixels are allocated as " << pix.getWidth() << "x" << pix.getHeight();
+		ok = false;
+	} else if(channelMap[0] == npos || (srcChannels != 1 && srcChannels != 3 && srcChannels != 4)) {
+		ofLogError("ofImage") << "loadImage(): can't load an image with " << srcChannels
+			<< " channels into pixels with format " << ofToString(pix.getPixelFormat());
+		ok = false;
+	} else if(FreeImage_GetBits(bmp) == nullptr) {
+		ofLogError("ofImage") << "loadImage(): unable to get the pixels from FIBITMAP";
+		ok = false;
+	}
+
+	if(ok) {
+		bool identity = srcChannels == dstChannels;
+		for(size_t c = 0; c < dstChannels; c++) {
+			identity &= channelMap[c] == c;
+		}
+		const PixelType alpha = ofColor_<PixelType>::limit();
+		size_t dstStride = pix.getBytesStride() / sizeof(PixelType);
+		PixelType * dstRow = pix.getData();
+		for(size_t y = 0; y < height; y++, dstRow += dstStride) {
+			// ofPixels are top left, FIBITMAP is bottom left
+			const PixelType * srcRow = (const PixelType*)FreeImage_GetScanLine(bmp, height - 1 - y);
+			if(identity) {
+				memcpy(dstRow, srcRow, width * dstChannels * sizeof(PixelType));
+				continue;
+			}
+			const PixelType * src = srcRow;
+			PixelType * dst = dstRow;
+			for(size_t x = 0; x < width; x++, src += srcChannels, dst += dstChannels) {
+				for(size_t c = 0; c < dstChannels; c++) {
+					dst[c] = channelMap[c] == npos ? alpha : src[channelMap[c]];
+				}
+			}
+		}
+	}
+
+	if(bmpConverted != nullptr) {
+		FreeImage_Unload(bmpConverted);
+	}
+	return ok;
+}
+
 /// internal
 static int getJpegOptionFromImageLoadSetting(const ofImageLoadSettings &settings) {
 	int option = 0;
@@ -177,9 +290,17 @@ static int getJpegOptionFromImageLoadSetting(const ofImageLoadSettings &settings
 }
 
 template<typename PixelType>
-static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _fileName, const ofImageLoadSettings& settings){
+static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings, bool intoAllocated);
+
+template<typename PixelType>
+static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _fileName, const ofImageLoadSettings& settings, bool intoAllocated){
 	ofInitFreeImage();
 
+	if(intoAllocated && !pix.isAllocated()){
+		ofLogError("ofImage") << "loadImage(): couldn't load " << _fileName << " into pixels that are not allocated";
+		return false;
+	}
+
 	auto uriStr = _fileName.string();
 	UriUriA uri;
 	UriParserStateA state;
@@ -203,7 +324,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _
 	uriFreeUriMembersA(&uri);
 
 	if(scheme == "http" || scheme == "https"){
-		return ofLoadImage(pix, ofLoadURL(_fileName.string()).data);
+		return loadImage(pix, ofLoadURL(_fileName.string()).data, settings, intoAllocated);
 	}
 
 	std::string fileName = ofToDataPath(_fileName, true);
@@ -232,7 +353,11 @@ static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _
 	//-----------------------------
 
 	if ( bLoaded ){
-		putBmpIntoPixels(bmp,pix);
+		if(intoAllocated){
+			bLoaded = copyBmpIntoPixels(bmp,pix);
+		}else{
+			putBmpIntoPixels(bmp,pix);
+		}
 	}
 
 	if (bmp != nullptr){
@@ -243,8 +368,13 @@ static bool loadImage(ofPixels_<PixelType> & pix, const std::filesystem::path& _
 }
 
 template<typename PixelType>
-static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings){
+static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings, bool intoAllocated){
 	ofInitFreeImage();
+
+	if(intoAllocated && !pix.isAllocated()){
+		ofLogError("ofImage") << "loadImage(): couldn't load image from ofBuffer into pixels that are not allocated";
+		return false;
+	}
 	bool bLoaded = false;
 	FIBITMAP* bmp = nullptr;
 	FIMEMORY* hmem = nullptr;
@@ -279,7 +409,11 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const
 	//-----------------------------
 
 	if (bLoaded){
-		putBmpIntoPixels(bmp,pix);
+		if(intoAllocated){
+			bLoaded = copyBmpIntoPixels(bmp,pix);
+		}else{
+			putBmpIntoPixels(bmp,pix);
+		}
 	}
 
 	if (bmp != nullptr){
@@ -295,32 +429,62 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const
 
 //----------------------------------------------------------------
 bool ofLoadImage(ofPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings) {
-	return loadImage(pix, path, settings);
+	return loadImage(pix, path, settings, false);
 }
 
 //----------------------------------------------------------------
 bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings) {
-	return loadImage(pix, buffer, settings);
+	return loadImage(pix, buffer, settings, false);
 }
 
 //----------------------------------------------------------------
 bool ofLoadImage(ofShortPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings) {
-	return loadImage(pix, path, settings);
+	return loadImage(pix, path, settings, false);
 }
 
 //----------------------------------------------------------------
 bool ofLoadImage(ofShortPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings) {
-	return loadImage(pix, buffer, settings);
+	return loadImage(pix, buffer, settings, false);
 }
 
 //----------------------------------------------------------------
 bool ofLoadImage(ofFloatPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings) {
-	return loadImage(pix, path, settings);
+	return loadImage(pix, path, settings, false);
 }
 
 //----------------------------------------------------------------
 bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings) {
-	return loadImage(pix, buffer, settings);
+	return loadImage(pix, buffer, settings, false);
+}
+
+//----------------------------------------------------------------
+bool ofLoadImageInto(ofPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings) {
+	return loadImage(pix, path, settings, true);
+}
+
+//----------------------------------------------------------------
+bool ofLoadImageInto(ofPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings) {
+	return loadImage(pix, buffer, settings, true);
+}
+
+//----------------------------------------------------------------
+bool ofLoadImageInto(ofShortPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings) {
+	return loadImage(pix, path, settings, true);
+}
+
+//----------------------------------------------------------------
+bool ofLoadImageInto(ofShortPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings) {
+	return loadImage(pix, buffer, settings, true);
+}
+
+//----------------------------------------------------------------
+bool ofLoadImageInto(ofFloatPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings) {
+	return loadImage(pix, path, settings, true);
+}
+
+//----------------------------------------------------------------
+bool ofLoadImageInto(ofFloatPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings) {
+	return loadImage(pix, buffer, settings, true);
 }
 
 //----------------------------------------------------------------
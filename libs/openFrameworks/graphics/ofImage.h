@@ -140,6 +140,27 @@ bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer, const ofImageLoad
 bool ofLoadImage(ofShortPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings = ofImageLoadSettings());
 bool ofLoadImage(ofShortPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings = ofImageLoadSettings());
 
+/// \brief Load an image into pixels that are already allocated.
+///
+/// Unlike ofLoadImage() this never reallocates the pixels: the image is
+/// flipped and its channels rearranged to the format of pix in the same pass
+/// that copies it out of the decoded FreeImage bitmap, with no extra converted
+/// bitmap when the decoded type already matches the pixel type. Useful to load
+/// sequences of images of the same size into the same memory.
+///
+/// pix has to be allocated as OF_PIXELS_GRAY, RGB, BGR, RGBA or BGRA. Gray
+/// images can be loaded into color pixels and alpha is added or dropped as
+/// needed.
+///
+/// \returns false and logs an error if the image can't be loaded or
+/// its dimensions don't match the ones of pix.
+bool ofLoadImageInto(ofPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings = ofImageLoadSettings());
+bool ofLoadImageInto(ofPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings = ofImageLoadSettings());
+bool ofLoadImageInto(ofFloatPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings = ofImageLoadSettings());
+bool ofLoadImageInto(ofFloatPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings = ofImageLoadSettings());
+bool ofLoadImageInto(ofShortPixels & pix, const std::filesystem::path& path, const ofImageLoadSettings &settings = ofImageLoadSettings());
+bool ofLoadImageInto(ofShortPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings &settings = ofImageLoadSettings());
+
 /// \todo Needs documentation.
 bool ofLoadImage(ofTexture & tex, const std::filesystem::path& path, const ofImageLoadSettings &settings = ofImageLoadSettings());
 bool ofLoadImage(ofTexture & tex, const ofBuffer & buffer, const ofImageLoadSettings &settings = ofImageLoadSettings());
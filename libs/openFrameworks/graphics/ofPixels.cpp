@@ -2,9 +2,1302 @@
 #include "ofGraphicsConstants.h"
 #include "glm/common.hpp"
 #include <cstring>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 
+//----------------------------------------------------------------------
+// SIMD kernels
+//
+// SSE2 is always available on x86_64 so it's used as the baseline there,
+// AVX2 is only used if the CPU supports it, which is checked at runtime.
+// NEON is used when compiling for ARM with NEON enabled.
+//
+// the kernels do the same float operations in the same order as the scalar
+// code so the results are the same whether SIMD is enabled or not
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define OF_PIXELS_SSE2
+	#include <emmintrin.h>
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define OF_PIXELS_TARGET_AVX2
+	#else
+		#define OF_PIXELS_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define OF_PIXELS_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace{
+	enum SIMDLevel{
+		SIMD_NONE,
+		SIMD_SSE2,
+		SIMD_AVX2,
+		SIMD_NEON,
+	};
+
+	SIMDLevel supportedSIMDLevel(){
+#if defined(OF_PIXELS_SSE2)
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if(info[0] >= 7){
+			__cpuid(info, 1);
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool avx = (info[2] & (1 << 28)) != 0;
+			if(osxsave && avx && (_xgetbv(0) & 6) == 6){
+				__cpuidex(info, 7, 0);
+				if(info[1] & (1 << 5)){
+					return SIMD_AVX2;
+				}
+			}
+		}
+	#else
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx2")){
+			return SIMD_AVX2;
+		}
+	#endif
+		return SIMD_SSE2;
+#elif defined(OF_PIXELS_NEON)
+		return SIMD_NEON;
+#else
+		return SIMD_NONE;
+#endif
+	}
+
+	std::atomic<bool> useSIMD{true};
+
+	SIMDLevel simdLevel(){
+		static const SIMDLevel supported = supportedSIMDLevel();
+		return useSIMD ? supported : SIMD_NONE;
+	}
+
+	//------------------------------------------------------------------
+	// swapRgb, swaps the first and third channel of every pixel in place.
+	// the SIMD versions return how many pixels they processed, the rest
+	// are done with the scalar loop
+	template<typename PixelType>
+	void swapRgbScalar(PixelType * pixels, size_t first, size_t numPixels, size_t channels){
+		for(size_t i = first; i < numPixels; i++){
+			std::swap(pixels[i * channels], pixels[i * channels + 2]);
+		}
+	}
+
+#if defined(OF_PIXELS_SSE2)
+	size_t swapRgba8SSE2(unsigned char * pixels, size_t numPixels){
+		const __m128i keep = _mm_set1_epi32((int)0xFF00FF00);
+		const __m128i low = _mm_set1_epi32(0xFF);
+		size_t i = 0;
+		for(; i + 4 <= numPixels; i += 4){
+			__m128i * p = (__m128i*)(pixels + i * 4);
+			__m128i v = _mm_loadu_si128(p);
+			__m128i r = _mm_and_si128(_mm_srli_epi32(v, 16), low);
+			__m128i b = _mm_slli_epi32(_mm_and_si128(v, low), 16);
+			_mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(v, keep), _mm_or_si128(r, b)));
+		}
+		return i;
+	}
+
+	OF_PIXELS_TARGET_AVX2
+	size_t swapRgba8AVX2(unsigned char * pixels, size_t numPixels){
+		const __m256i keep = _mm256_set1_epi32((int)0xFF00FF00);
+		const __m256i low = _mm256_set1_epi32(0xFF);
+		size_t i = 0;
+		for(; i + 8 <= numPixels; i += 8){
+			__m256i * p = (__m256i*)(pixels + i * 4);
+			__m256i v = _mm256_loadu_si256(p);
+			__m256i r = _mm256_and_si256(_mm256_srli_epi32(v, 16), low);
+			__m256i b = _mm256_slli_epi32(_mm256_and_si256(v, low), 16);
+			_mm256_storeu_si256(p, _mm256_or_si256(_mm256_and_si256(v, keep), _mm256_or_si256(r, b)));
+		}
+		return i;
+	}
+
+	size_t swapRgba16SSE2(unsigned short * pixels, size_t numPixels){
+		size_t i = 0;
+		for(; i + 2 <= numPixels; i += 2){
+			__m128i * p = (__m128i*)(pixels + i * 4);
+			__m128i v = _mm_loadu_si128(p);
+			v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(3,0,1,2));
+			v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(3,0,1,2));
+			_mm_storeu_si128(p, v);
+		}
+		return i;
+	}
+
+	OF_PIXELS_TARGET_AVX2
+	size_t swapRgba16AVX2(unsigned short * pixels, size_t numPixels){
+		size_t i = 0;
+		for(; i + 4 <= numPixels; i += 4){
+			__m256i * p = (__m256i*)(pixels + i * 4);
+			__m256i v = _mm256_loadu_si256(p);
+			v = _mm256_shufflelo_epi16(v, _MM_SHUFFLE(3,0,1,2));
+			v = _mm256_shufflehi_epi16(v, _MM_SHUFFLE(3,0,1,2));
+			_mm256_storeu_si256(p, v);
+		}
+		return i;
+	}
+
+	size_t swapRgbaFloatSSE2(float * pixels, size_t numPixels){
+		for(size_t i = 0; i < numPixels; i++){
+			__m128 v = _mm_loadu_ps(pixels + i * 4);
+			_mm_storeu_ps(pixels + i * 4, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3,0,1,2)));
+		}
+		return numPixels;
+	}
+
+	OF_PIXELS_TARGET_AVX2
+	size_t swapRgbaFloatAVX2(float * pixels, size_t numPixels){
+		size_t i = 0;
+		for(; i + 2 <= numPixels; i += 2){
+			__m256 v = _mm256_loadu_ps(pixels + i * 4);
+			_mm256_storeu_ps(pixels + i * 4, _mm256_permute_ps(v, _MM_SHUFFLE(3,0,1,2)));
+		}
+		return i;
+	}
+#endif
+
+#if defined(OF_PIXELS_NEON)
+	size_t swapRgb8NEON(unsigned char * pixels, size_t numPixels, size_t channels){
+		size_t i = 0;
+		if(channels == 4){
+			for(; i + 16 <= numPixels; i += 16){
+				uint8x16x4_t v = vld4q_u8(pixels + i * 4);
+				std::swap(v.val[0], v.val[2]);
+				vst4q_u8(pixels + i * 4, v);
+			}
+		}else{
+			for(; i + 16 <= numPixels; i += 16){
+				uint8x16x3_t v = vld3q_u8(pixels + i * 3);
+				std::swap(v.val[0], v.val[2]);
+				vst3q_u8(pixels + i * 3, v);
+			}
+		}
+		return i;
+	}
+
+	size_t swapRgb16NEON(unsigned short * pixels, size_t numPixels, size_t channels){
+		size_t i = 0;
+		if(channels == 4){
+			for(; i + 8 <= numPixels; i += 8){
+				uint16x8x4_t v = vld4q_u16(pixels + i * 4);
+				std::swap(v.val[0], v.val[2]);
+				vst4q_u16(pixels + i * 4, v);
+			}
+		}else{
+			for(; i + 8 <= numPixels; i += 8){
+				uint16x8x3_t v = vld3q_u16(pixels + i * 3);
+				std::swap(v.val[0], v.val[2]);
+				vst3q_u16(pixels + i * 3, v);
+			}
+		}
+		return i;
+	}
+
+	size_t swapRgbFloatNEON(float * pixels, size_t numPixels, size_t channels){
+		size_t i = 0;
+		if(channels == 4){
+			for(; i + 4 <= numPixels; i += 4){
+				float32x4x4_t v = vld4q_f32(pixels + i * 4);
+				std::swap(v.val[0], v.val[2]);
+				vst4q_f32(pixels + i * 4, v);
+			}
+		}else{
+			for(; i + 4 <= numPixels; i += 4){
+				float32x4x3_t v = vld3q_f32(pixels + i * 3);
+				std::swap(v.val[0], v.val[2]);
+				vst3q_f32(pixels + i * 3, v);
+			}
+		}
+		return i;
+	}
+#endif
+
+	template<typename PixelType>
+	bool swapRgbSIMD(PixelType *, size_t, size_t){
+		return false;
+	}
+
+	bool swapRgbSIMD(unsigned char * pixels, size_t numPixels, size_t channels){
+		size_t done = 0;
+		switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+		case SIMD_AVX2:
+			if(channels != 4) return false;
+			done = swapRgba8AVX2(pixels, numPixels);
+			break;
+		case SIMD_SSE2:
+			if(channels != 4) return false;
+			done = swapRgba8SSE2(pixels, numPixels);
+			break;
+#elif defined(OF_PIXELS_NEON)
+		case SIMD_NEON:
+			done = swapRgb8NEON(pixels, numPixels, channels);
+			break;
+#endif
+		default:
+			return false;
+		}
+		swapRgbScalar(pixels, done, numPixels, channels);
+		return true;
+	}
+
+	bool swapRgbSIMD(unsigned short * pixels, size_t numPixels, size_t channels){
+		size_t done = 0;
+		switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+		case SIMD_AVX2:
+			if(channels != 4) return false;
+			done = swapRgba16AVX2(pixels, numPixels);
+			break;
+		case SIMD_SSE2:
+			if(channels != 4) return false;
+			done = swapRgba16SSE2(pixels, numPixels);
+			break;
+#elif defined(OF_PIXELS_NEON)
+		case SIMD_NEON:
+			done = swapRgb16NEON(pixels, numPixels, channels);
+			break;
+#endif
+		default:
+			return false;
+		}
+		swapRgbScalar(pixels, done, numPixels, channels);
+		return true;
+	}
+
+	bool swapRgbSIMD(float * pixels, size_t numPixels, size_t channels){
+		size_t done = 0;
+		switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+		case SIMD_AVX2:
+			if(channels != 4) return false;
+			done = swapRgbaFloatAVX2(pixels, numPixels);
+			break;
+		case SIMD_SSE2:
+			if(channels != 4) return false;
+			done = swapRgbaFloatSSE2(pixels, numPixels);
+			break;
+#elif defined(OF_PIXELS_NEON)
+		case SIMD_NEON:
+			done = swapRgbFloatNEON(pixels, numPixels, channels);
+			break;
+#endif
+		default:
+			return false;
+		}
+		swapRgbScalar(pixels, done, numPixels, channels);
+		return true;
+	}
+
+	//------------------------------------------------------------------
+	// blendInto, blends one row of numPixels pixels. with 1 or 3 channels
+	// it's a clamped add which for integer types is a saturated add.
+	// with 2 or 4 channels the destination is scaled by the source alpha:
+	// dst = clamp(src + dst / limit * (limit - srcAlpha), 0, limit)
+	template<typename PixelType>
+	void blendRowScalar(const PixelType * src, PixelType * dst, size_t first, size_t numPixels, size_t channels){
+		const float limit = ofColor_<PixelType>::limit();
+		if(channels == 1 || channels == 3){
+			for(size_t i = first * channels; i < numPixels * channels; i++){
+				dst[i] = glm::clamp((float)src[i] + (float)dst[i], 0.f, limit);
+			}
+		}else{
+			for(size_t i = first; i < numPixels; i++){
+				const PixelType * s = src + i * channels;
+				PixelType * d = dst + i * channels;
+				const PixelType alpha = s[channels - 1];
+				for(size_t k = 0; k < channels; k++){
+					d[k] = glm::clamp((float)s[k] + (float)(d[k] / limit * (limit - alpha)), 0.f, limit);
+				}
+			}
+		}
+	}
+
+#if defined(OF_PIXELS_SSE2)
+	template<bool grayAlpha>
+	inline __m128 blendAlphaSSE2(__m128 src, __m128 dst, __m128 limit){
+		// with 2 channels every register holds 2 pixels
+		__m128 alpha = grayAlpha ?
+			_mm_shuffle_ps(src, src, _MM_SHUFFLE(3,3,1,1)) :
+			_mm_shuffle_ps(src, src, _MM_SHUFFLE(3,3,3,3));
+		__m128 r = _mm_add_ps(src, _mm_mul_ps(_mm_div_ps(dst, limit), _mm_sub_ps(limit, alpha)));
+		return _mm_min_ps(_mm_max_ps(r, _mm_setzero_ps()), limit);
+	}
+
+	inline void unpack8SSE2(__m128i v, __m128 * f){
+		const __m128i zero = _mm_setzero_si128();
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+		f[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero));
+		f[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero));
+		f[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero));
+		f[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero));
+	}
+
+	// values have to be in 0..255
+	inline __m128i pack8SSE2(const __m128 * f){
+		__m128i lo = _mm_packs_epi32(_mm_cvttps_epi32(f[0]), _mm_cvttps_epi32(f[1]));
+		__m128i hi = _mm_packs_epi32(_mm_cvttps_epi32(f[2]), _mm_cvttps_epi32(f[3]));
+		return _mm_packus_epi16(lo, hi);
+	}
+
+	inline void unpack16SSE2(__m128i v, __m128 * f){
+		const __m128i zero = _mm_setzero_si128();
+		f[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero));
+		f[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero));
+	}
+
+	// values have to be in 0..65535, there's no unsigned 32 to 16 bits
+	// pack in SSE2 so the values are moved to the signed range and back
+	inline __m128i pack16SSE2(const __m128 * f){
+		const __m128i offset = _mm_set1_epi32(32768);
+		__m128i lo = _mm_sub_epi32(_mm_cvttps_epi32(f[0]), offset);
+		__m128i hi = _mm_sub_epi32(_mm_cvttps_epi32(f[1]), offset);
+		return _mm_xor_si128(_mm_packs_epi32(lo, hi), _mm_set1_epi16((short)0x8000));
+	}
+
+	size_t blendRow8SSE2(const unsigned char * src, unsigned char * dst, size_t numPixels, size_t channels){
+		size_t bytes = numPixels * channels;
+		size_t i = 0;
+		if(channels == 1 || channels == 3){
+			// 3 channels needs a multiple of 3 pixels per iteration
+			for(; i + 48 <= bytes; i += 48){
+				for(int j = 0; j < 48; j += 16){
+					__m128i s = _mm_loadu_si128((const __m128i*)(src + i + j));
+					__m128i d = _mm_loadu_si128((const __m128i*)(dst + i + j));
+					_mm_storeu_si128((__m128i*)(dst + i + j), _mm_adds_epu8(s, d));
+				}
+			}
+		}else{
+			const __m128 limit = _mm_set1_ps(255.f);
+			__m128 s[4], d[4];
+			for(; i + 16 <= bytes; i += 16){
+				unpack8SSE2(_mm_loadu_si128((const __m128i*)(src + i)), s);
+				unpack8SSE2(_mm_loadu_si128((const __m128i*)(dst + i)), d);
+				for(int j = 0; j < 4; j++){
+					d[j] = channels == 2 ? blendAlphaSSE2<true>(s[j], d[j], limit) : blendAlphaSSE2<false>(s[j], d[j], limit);
+				}
+				_mm_storeu_si128((__m128i*)(dst + i), pack8SSE2(d));
+			}
+		}
+		return i / channels;
+	}
+
+	OF_PIXELS_TARGET_AVX2
+	size_t blendRow8AVX2(const unsigned char * src, unsigned char * dst, size_t numPixels, size_t channels){
+		if(channels == 2 || channels == 4){
+			return blendRow8SSE2(src, dst, numPixels, channels);
+		}
+		size_t bytes = numPixels * channels;
+		size_t i = 0;
+		for(; i + 96 <= bytes; i += 96){
+			for(int j = 0; j < 96; j += 32){
+				__m256i s = _mm256_loadu_si256((const __m256i*)(src + i + j));
+				__m256i d = _mm256_loadu_si256((const __m256i*)(dst + i + j));
+				_mm256_storeu_si256((__m256i*)(dst + i + j), _mm256_adds_epu8(s, d));
+			}
+		}
+		return i / channels;
+	}
+
+	size_t blendRow16SSE2(const unsigned short * src, unsigned short * dst, size_t numPixels, size_t channels){
+		size_t values = numPixels * channels;
+		size_t i = 0;
+		if(channels == 1 || channels == 3){
+			// 3 channels needs a multiple of 3 pixels per iteration
+			for(; i + 24 <= values; i += 24){
+				for(int j = 0; j < 24; j += 8){
+					__m128i s = _mm_loadu_si128((const __m128i*)(src + i + j));
+					__m128i d = _mm_loadu_si128((const __m128i*)(dst + i + j));
+					_mm_storeu_si128((__m128i*)(dst + i + j), _mm_adds_epu16(s, d));
+				}
+			}
+		}else{
+			const __m128 limit = _mm_set1_ps(65535.f);
+			__m128 s[2], d[2];
+			for(; i + 8 <= values; i += 8){
+				unpack16SSE2(_mm_loadu_si128((const __m128i*)(src + i)), s);
+				unpack16SSE2(_mm_loadu_si128((const __m128i*)(dst + i)), d);
+				for(int j = 0; j < 2; j++){
+					d[j] = channels == 2 ? blendAlphaSSE2<true>(s[j], d[j], limit) : blendAlphaSSE2<false>(s[j], d[j], limit);
+				}
+				_mm_storeu_si128((__m128i*)(dst + i), pack16SSE2(d));
+			}
+		}
+		return i / channels;
+	}
+
+	size_t blendRowFloatSSE2(const float * src, float * dst, size_t numPixels, size_t channels){
+		size_t values = numPixels * channels;
+		size_t i = 0;
+		const __m128 limit = _mm_set1_ps(1.f);
+		if(channels == 1 || channels == 3){
+			for(; i + 12 <= values; i += 12){
+				for(int j = 0; j < 12; j += 4){
+					__m128 r = _mm_add_ps(_mm_loadu_ps(src + i + j), _mm_loadu_ps(dst + i + j));
+					_mm_storeu_ps(dst + i + j, _mm_min_ps(_mm_max_ps(r, _mm_setzero_ps()), limit));
+				}
+			}
+		}else{
+			for(; i + 4 <= values; i += 4){
+				__m128 s = _mm_loadu_ps(src + i);
+				__m128 d = _mm_loadu_ps(dst + i);
+				d = channels == 2 ? blendAlphaSSE2<true>(s, d, limit) : blendAlphaSSE2<false>(s, d, limit);
+				_mm_storeu_ps(dst + i, d);
+			}
+		}
+		return i / channels;
+	}
+#endif
+
+#if defined(OF_PIXELS_NEON)
+	size_t blendRow8NEON(const unsigned char * src, unsigned char * dst, size_t numPixels, size_t channels){
+		if(channels == 2 || channels == 4){
+			return 0;
+		}
+		size_t bytes = numPixels * channels;
+		size_t i = 0;
+		for(; i + 48 <= bytes; i += 48){
+			for(int j = 0; j < 48; j += 16){
+				vst1q_u8(dst + i + j, vqaddq_u8(vld1q_u8(src + i + j), vld1q_u8(dst + i + j)));
+			}
+		}
+		return i / channels;
+	}
+
+	size_t blendRow16NEON(const unsigned short * src, unsigned short * dst, size_t numPixels, size_t channels){
+		if(channels == 2 || channels == 4){
+			return 0;
+		}
+		size_t values = numPixels * channels;
+		size_t i = 0;
+		for(; i + 24 <= values; i += 24){
+			for(int j = 0; j < 24; j += 8){
+				vst1q_u16(dst + i + j, vqaddq_u16(vld1q_u16(src + i + j), vld1q_u16(dst + i + j)));
+			}
+		}
+		return i / channels;
+	}
+
+	size_t blendRowFloatNEON(const float * src, float * dst, size_t numPixels, size_t channels){
+		if(channels == 2 || channels == 4){
+			return 0;
+		}
+		size_t values = numPixels * channels;
+		size_t i = 0;
+		const float32x4_t zero = vdupq_n_f32(0.f);
+		const float32x4_t limit = vdupq_n_f32(1.f);
+		for(; i + 12 <= values; i += 12){
+			for(int j = 0; j < 12; j += 4){
+				float32x4_t r = vaddq_f32(vld1q_f32(src + i + j), vld1q_f32(dst + i + j));
+				vst1q_f32(dst + i + j, vminq_f32(vmaxq_f32(r, zero), limit));
+			}
+		}
+		return i / channels;
+	}
+#endif
+
+	template<typename PixelType>
+	bool blendRowSIMD(const PixelType *, PixelType *, size_t, size_t){
+		return false;
+	}
+
+	bool blendRowSIMD(const unsigned char * src, unsigned char * dst, size_t numPixels, size_t channels){
+		size_t done = 0;
+		switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+		case SIMD_AVX2:
+			done = blendRow8AVX2(src, dst, numPixels, channels);
+			break;
+		case SIMD_SSE2:
+			done = blendRow8SSE2(src, dst, numPixels, channels);
+			break;
+#elif defined(OF_PIXELS_NEON)
+		case SIMD_NEON:
+			done = blendRow8NEON(src, dst, numPixels, channels);
+			break;
+#endif
+		default:
+			return false;
+		}
+		blendRowScalar(src, dst, done, numPixels, channels);
+		return true;
+	}
+
+	bool blendRowSIMD(const unsigned short * src, unsigned short * dst, size_t numPixels, size_t channels){
+		size_t done = 0;
+		switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+		case SIMD_AVX2:
+		case SIMD_SSE2:
+			done = blendRow16SSE2(src, dst, numPixels, channels);
+			break;
+#elif defined(OF_PIXELS_NEON)
+		case SIMD_NEON:
+			done = blendRow16NEON(src, dst, numPixels, channels);
+			break;
+#endif
+		default:
+			return false;
+		}
+		blendRowScalar(src, dst, done, numPixels, channels);
+		return true;
+	}
+
+	bool blendRowSIMD(const float * src, float * dst, size_t numPixels, size_t channels){
+		size_t done = 0;
+		switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+		case SIMD_AVX2:
+		case SIMD_SSE2:
+			done = blendRowFloatSSE2(src, dst, numPixels, channels);
+			break;
+#elif defined(OF_PIXELS_NEON)
+		case SIMD_NEON:
+			done = blendRowFloatNEON(src, dst, numPixels, channels);
+			break;
+#endif
+		default:
+			return false;
+		}
+		blendRowScalar(src, dst, done, numPixels, channels);
+		return true;
+	}
+
+	//------------------------------------------------------------------
+	// mirrorTo, copies a row reversing the order of the pixels
+	template<typename PixelType>
+	void mirrorRowScalar(const PixelType * src, PixelType * dst, size_t first, size_t width, size_t channels){
+		for(size_t x = first; x < width; x++){
+			const PixelType * s = src + (width - 1 - x) * channels;
+			PixelType * d = dst + x * channels;
+			for(size_t k = 0; k < channels; k++){
+				d[k] = s[k];
+			}
+		}
+	}
+
+#if defined(OF_PIXELS_SSE2)
+	size_t mirrorRow8SSE2(const unsigned char * src, unsigned char * dst, size_t width, size_t channels){
+		size_t x = 0;
+		if(channels == 4){
+			for(; x + 4 <= width; x += 4){
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + (width - x - 4) * 4));
+				_mm_storeu_si128((__m128i*)(dst + x * 4), _mm_shuffle_epi32(v, _MM_SHUFFLE(0,1,2,3)));
+			}
+		}else if(channels == 1){
+			for(; x + 16 <= width; x += 16){
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + width - x - 16));
+				v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0,1,2,3));
+				v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1));
+				v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2,3,0,1));
+				v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+				_mm_storeu_si128((__m128i*)(dst + x), v);
+			}
+		}
+		return x;
+	}
+
+	OF_PIXELS_TARGET_AVX2
+	size_t mirrorRow8AVX2(const unsigned char * src, unsigned char * dst, size_t width, size_t channels){
+		size_t x = 0;
+		if(channels == 4){
+			const __m256i reverse = _mm256_setr_epi32(7,6,5,4,3,2,1,0);
+			for(; x + 8 <= width; x += 8){
+				__m256i v = _mm256_loadu_si256((const __m256i*)(src + (width - x - 8) * 4));
+				_mm256_storeu_si256((__m256i*)(dst + x * 4), _mm256_permutevar8x32_epi32(v, reverse));
+			}
+		}else if(channels == 1){
+			const __m256i reverse = _mm256_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0,
+													 15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
+			for(; x + 32 <= width; x += 32){
+				__m256i v = _mm256_loadu_si256((const __m256i*)(src + width - x - 32));
+				v = _mm256_shuffle_epi8(v, reverse);
+				_mm256_storeu_si256((__m256i*)(dst + x), _mm256_permute2x128_si256(v, v, 1));
+			}
+		}
+		return x;
+	}
+#endif
+
+#if defined(OF_PIXELS_NEON)
+	size_t mirrorRow8NEON(const unsigned char * src, unsigned char * dst, size_t width, size_t channels){
+		size_t x = 0;
+		if(channels == 4){
+			for(; x + 4 <= width; x += 4){
+				uint32x4_t v = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(src + (width - x - 4) * 4)));
+				vst1q_u8(dst + x * 4, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(v), vget_low_u32(v))));
+			}
+		}else if(channels == 1){
+			for(; x + 16 <= width; x += 16){
+				uint8x16_t v = vrev64q_u8(vld1q_u8(src + width - x - 16));
+				vst1q_u8(dst + x, vcombine_u8(vget_high_u8(v), vget_low_u8(v)));
+			}
+		}
+		return x;
+	}
+#endif
+
+	template<typename PixelType>
+	void mirrorRow(const PixelType * src, PixelType * dst, size_t width, size_t channels){
+		mirrorRowScalar(src, dst, 0, width, channels);
+	}
+
+	void mirrorRow(const unsigned char * src, unsigned char * dst, size_t width, size_t channels){
+		size_t done = 0;
+		switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+		case SIMD_AVX2:
+			done = mirrorRow8AVX2(src, dst, width, channels);
+			break;
+		case SIMD_SSE2:
+			done = mirrorRow8SSE2(src, dst, width, channels);
+			break;
+#elif defined(OF_PIXELS_NEON)
+		case SIMD_NEON:
+			done = mirrorRow8NEON(src, dst, width, channels);
+			break;
+#endif
+		default:
+			break;
+		}
+		mirrorRowScalar(src, dst, done, width, channels);
+	}
+
+	//------------------------------------------------------------------
+	// bicubic resize, evaluates the polynomial for all the channels of a
+	// pixel at once. PixelValues is float or a SIMD register of 4 floats
+	template<typename PixelValues>
+	inline PixelValues bicubicPolynomial(const PixelValues * patch, PixelValues x, PixelValues y, PixelValues x2, PixelValues y2, PixelValues x3, PixelValues y3){
+		// adapted from http://www.paulinternet.nl/?page=bicubic
+		PixelValues p00 = patch[ 0];
+		PixelValues p10 = patch[ 4];
+		PixelValues p20 = patch[ 8];
+		PixelValues p30 = patch[12];
+
+		PixelValues p01 = patch[ 1];
+		PixelValues p11 = patch[ 5];
+		PixelValues p21 = patch[ 9];
+		PixelValues p31 = patch[13];
+
+		PixelValues p02 = patch[ 2];
+		PixelValues p12 = patch[ 6];
+		PixelValues p22 = patch[10];
+		PixelValues p32 = patch[14];
+
+		PixelValues p03 = patch[ 3];
+		PixelValues p13 = patch[ 7];
+		PixelValues p23 = patch[11];
+		PixelValues p33 = patch[15];
+
+		PixelValues a00 =    p11;
+		PixelValues a01 =   -p10 +   p12;
+		PixelValues a02 =  2.0f*p10 - 2.0f*p11 +   p12 -   p13;
+		PixelValues a03 =   -p10 +   p11 -   p12 +   p13;
+		PixelValues a10 =   -p01 +   p21;
+		PixelValues a11 =    p00 -   p02 -   p20 +   p22;
+		PixelValues a12 = -2.0f*p00 + 2.0f*p01 -   p02 +   p03 + 2.0f*p20 - 2.0f*p21 +   p22 -   p23;
+		PixelValues a13 =    p00 -   p01 +   p02 -   p03 -   p20 +   p21 -   p22 +   p23;
+		PixelValues a20 =  2.0f*p01 - 2.0f*p11 +   p21 -   p31;
+		PixelValues a21 = -2.0f*p00 + 2.0f*p02 + 2.0f*p10 - 2.0f*p12 -   p20 +   p22 +   p30 -   p32;
+		PixelValues a22 =  4.0f*p00 - 4.0f*p01 + 2.0f*p02 - 2.0f*p03 - 4.0f*p10 + 4.0f*p11 - 2.0f*p12 + 2.0f*p13 + 2.0f*p20 - 2.0f*p21 + p22 - p23 - 2.0f*p30 + 2.0f*p31 - p32 + p33;
+		PixelValues a23 = -2.0f*p00 + 2.0f*p01 - 2.0f*p02 + 2.0f*p03 + 2.0f*p10 - 2.0f*p11 + 2.0f*p12 - 2.0f*p13 -   p20 +   p21 - p22 + p23 +   p30 -   p31 + p32 - p33;
+		PixelValues a30 =   -p01 +   p11 -   p21 +   p31;
+		PixelValues a31 =    p00 -   p02 -   p10 +   p12 +   p20 -   p22 -   p30 +   p32;
+		PixelValues a32 = -2.0f*p00 + 2.0f*p01 -   p02 +   p03 + 2.0f*p10 - 2.0f*p11 +   p12 -   p13 - 2.0f*p20 + 2.0f*p21 - p22 + p23 + 2.0f*p30 - 2.0f*p31 + p32 - p33;
+		PixelValues a33 =    p00 -   p01 +   p02 -   p03 -   p10 +   p11 -   p12 +   p13 +   p20 -   p21 + p22 - p23 -   p30 +   p31 - p32 + p33;
+
+		return
+		a00      + a01 * y      + a02 * y2      + a03 * y3 +
+		a10 * x  + a11 * x  * y + a12 * x  * y2 + a13 * x  * y3 +
+		a20 * x2 + a21 * x2 * y + a22 * x2 * y2 + a23 * x2 * y3 +
+		a30 * x3 + a31 * x3 * y + a32 * x3 * y2 + a33 * x3 * y3;
+	}
+
+#if defined(OF_PIXELS_SSE2) || defined(OF_PIXELS_NEON)
+	// 4 floats with the arithmetic operators needed by bicubicPolynomial
+	struct Float4{
+#if defined(OF_PIXELS_SSE2)
+		__m128 v;
+		Float4(){}
+		Float4(__m128 v):v(v){}
+		Float4(float f):v(_mm_set1_ps(f)){}
+#else
+		float32x4_t v;
+		Float4(){}
+		Float4(float32x4_t v):v(v){}
+		Float4(float f):v(vdupq_n_f32(f)){}
+#endif
+	};
+
+#if defined(OF_PIXELS_SSE2)
+	inline Float4 operator+(Float4 a, Float4 b){ return _mm_add_ps(a.v, b.v); }
+	inline Float4 operator-(Float4 a, Float4 b){ return _mm_sub_ps(a.v, b.v); }
+	inline Float4 operator*(Float4 a, Float4 b){ return _mm_mul_ps(a.v, b.v); }
+	inline Float4 operator-(Float4 a){ return _mm_xor_ps(a.v, _mm_set1_ps(-0.f)); }
+#else
+	inline Float4 operator+(Float4 a, Float4 b){ return vaddq_f32(a.v, b.v); }
+	inline Float4 operator-(Float4 a, Float4 b){ return vsubq_f32(a.v, b.v); }
+	inline Float4 operator*(Float4 a, Float4 b){ return vmulq_f32(a.v, b.v); }
+	inline Float4 operator-(Float4 a){ return vnegq_f32(a.v); }
+#endif
+
+	// loads the channels of an 8 bit pixel, with 3 channels the 4th value
+	// belongs to the next pixel and is ignored
+	inline Float4 loadPixel8(const unsigned char * pixel){
+		int32_t value;
+		memcpy(&value, pixel, 4);
+#if defined(OF_PIXELS_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		__m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero);
+		return _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero));
+#else
+		uint16x8_t v = vmovl_u8(vreinterpret_u8_s32(vdup_n_s32(value)));
+		return vcvtq_f32_u32(vmovl_u16(vget_low_u16(v)));
+#endif
+	}
+
+	// clamps to 0..255 and stores the first channels values
+	inline void storePixel8(Float4 values, unsigned char * pixel, size_t channels){
+#if defined(OF_PIXELS_SSE2)
+		__m128 clamped = _mm_min_ps(_mm_max_ps(values.v, _mm_setzero_ps()), _mm_set1_ps(255.f));
+		__m128i v = _mm_cvttps_epi32(clamped);
+		v = _mm_packs_epi32(v, v);
+		int32_t value = _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+#else
+		float32x4_t clamped = vminq_f32(vmaxq_f32(values.v, vdupq_n_f32(0.f)), vdupq_n_f32(255.f));
+		uint16x4_t v = vmovn_u32(vcvtq_u32_f32(clamped));
+		int32_t value = vget_lane_s32(vreinterpret_s32_u8(vmovn_u16(vcombine_u16(v, v))), 0);
+#endif
+		memcpy(pixel, &value, channels);
+	}
+
+	void resizeBicubicPixel8(const unsigned char * srcPixel, size_t srcRowBytes, size_t channels, float x, float y, float x2, float y2, float x3, float y3, unsigned char * dstPixel){
+		Float4 patch[16];
+		for (size_t dy=0; dy<4; dy++) {
+			const unsigned char * patchRow = srcPixel + dy * srcRowBytes - srcRowBytes;
+			for (size_t dx=0; dx<4; dx++) {
+				patch[dx*4 + dy] = loadPixel8(patchRow + dx * channels - channels);
+			}
+		}
+		storePixel8(bicubicPolynomial<Float4>(patch, x, y, x2, y2, x3, y3), dstPixel, channels);
+	}
+#endif
+
+	template<typename PixelType>
+	bool canResizeBicubicSIMD(const PixelType *, size_t){
+		return false;
+	}
+
+	bool canResizeBicubicSIMD(const unsigned char *, size_t channels){
+#if defined(OF_PIXELS_SSE2) || defined(OF_PIXELS_NEON)
+		return simdLevel() != SIMD_NONE && (channels == 3 || channels == 4);
+#else
+		return false;
+#endif
+	}
+
+	template<typename PixelType>
+	void resizeBicubicPixelSIMD(const PixelType *, size_t, size_t, float, float, float, float, float, float, PixelType *){
+	}
+
+	void resizeBicubicPixelSIMD(const unsigned char * srcPixel, size_t srcRowBytes, size_t channels, float x, float y, float x2, float y2, float x3, float y3, unsigned char * dstPixel){
+#if defined(OF_PIXELS_SSE2) || defined(OF_PIXELS_NEON)
+		resizeBicubicPixel8(srcPixel, srcRowBytes, channels, x, y, x2, y2, x3, y3, dstPixel);
+#endif
+	}
+}
+
+//----------------------------------------------------------------------
+// conversions used by ofPixels_::copyFrom to convert between types,
+// dst = src * dstMax / srcMax, clamping the source to 0..1 for floats
+namespace{
+	template<typename SrcType, typename DstType>
+	void convertPixelsScalar(const SrcType * src, DstType * dst, size_t first, size_t size){
+		const float srcMax = ( (sizeof(SrcType) == sizeof(float) ) ? 1.f : std::numeric_limits<SrcType>::max() );
+		const float dstMax = ( (sizeof(DstType) == sizeof(float) ) ? 1.f : std::numeric_limits<DstType>::max() );
+		const float factor = dstMax / srcMax;
+		if(sizeof(SrcType) == sizeof(float)) {
+			for(size_t i = first; i < size; i++){
+				dst[i] = ofClamp(src[i], 0, 1) * factor;
+			}
+		}else{
+			for(size_t i = first; i < size; i++){
+				dst[i] = src[i] * factor;
+			}
+		}
+	}
+
+#if defined(OF_PIXELS_SSE2)
+	size_t convert8ToFloatSSE2(const unsigned char * src, float * dst, size_t size){
+		const __m128 factor = _mm_set1_ps(1.f / 255.f);
+		__m128 f[4];
+		size_t i = 0;
+		for(; i + 16 <= size; i += 16){
+			unpack8SSE2(_mm_loadu_si128((const __m128i*)(src + i)), f);
+			for(int j = 0; j < 4; j++){
+				_mm_storeu_ps(dst + i + j * 4, _mm_mul_ps(f[j], factor));
+			}
+		}
+		return i;
+	}
+
+	OF_PIXELS_TARGET_AVX2
+	size_t convert8ToFloatAVX2(const unsigned char * src, float * dst, size_t size){
+		const __m256 factor = _mm256_set1_ps(1.f / 255.f);
+		size_t i = 0;
+		for(; i + 8 <= size; i += 8){
+			__m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)));
+			_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), factor));
+		}
+		return i;
+	}
+
+	size_t convertFloatTo8SSE2(const float * src, unsigned char * dst, size_t size){
+		const __m128 factor = _mm_set1_ps(255.f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		__m128 f[4];
+		size_t i = 0;
+		for(; i + 16 <= size; i += 16){
+			for(int j = 0; j < 4; j++){
+				__m128 v = _mm_loadu_ps(src + i + j * 4);
+				f[j] = _mm_mul_ps(_mm_min_ps(_mm_max_ps(v, zero), one), factor);
+			}
+			_mm_storeu_si128((__m128i*)(dst + i), pack8SSE2(f));
+		}
+		return i;
+	}
+
+	size_t convert8To16SSE2(const unsigned char * src, unsigned short * dst, size_t size){
+		// v * 65535 / 255 is v * 257 which is the byte repeated
+		size_t i = 0;
+		for(; i + 16 <= size; i += 16){
+			__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(v, v));
+			_mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(v, v));
+		}
+		return i;
+	}
+
+	OF_PIXELS_TARGET_AVX2
+	size_t convert8To16AVX2(const unsigned char * src, unsigned short * dst, size_t size){
+		size_t i = 0;
+		for(; i + 16 <= size; i += 16){
+			__m256i v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(src + i)));
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_or_si256(v, _mm256_slli_epi16(v, 8)));
+		}
+		return i;
+	}
+
+	size_t convert16To8SSE2(const unsigned short * src, unsigned char * dst, size_t size){
+		const __m128 factor = _mm_set1_ps(255.f / 65535.f);
+		__m128 f[4];
+		size_t i = 0;
+		for(; i + 16 <= size; i += 16){
+			unpack16SSE2(_mm_loadu_si128((const __m128i*)(src + i)), f);
+			unpack16SSE2(_mm_loadu_si128((const __m128i*)(src + i + 8)), f + 2);
+			for(int j = 0; j < 4; j++){
+				f[j] = _mm_mul_ps(f[j], factor);
+			}
+			_mm_storeu_si128((__m128i*)(dst + i), pack8SSE2(f));
+		}
+		return i;
+	}
+
+	size_t convert16ToFloatSSE2(const unsigned short * src, float * dst, size_t size){
+		const __m128 factor = _mm_set1_ps(1.f / 65535.f);
+		__m128 f[2];
+		size_t i = 0;
+		for(; i + 8 <= size; i += 8){
+			unpack16SSE2(_mm_loadu_si128((const __m128i*)(src + i)), f);
+			_mm_storeu_ps(dst + i, _mm_mul_ps(f[0], factor));
+			_mm_storeu_ps(dst + i + 4, _mm_mul_ps(f[1], factor));
+		}
+		return i;
+	}
+
+	OF_PIXELS_TARGET_AVX2
+	size_t convert16ToFloatAVX2(const unsigned short * src, float * dst, size_t size){
+		const __m256 factor = _mm256_set1_ps(1.f / 65535.f);
+		size_t i = 0;
+		for(; i + 8 <= size; i += 8){
+			__m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i)));
+			_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), factor));
+		}
+		return i;
+	}
+
+	size_t convertFloatTo16SSE2(const float * src, unsigned short * dst, size_t size){
+		const __m128 factor = _mm_set1_ps(65535.f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		__m128 f[2];
+		size_t i = 0;
+		for(; i + 8 <= size; i += 8){
+			for(int j = 0; j < 2; j++){
+				__m128 v = _mm_loadu_ps(src + i + j * 4);
+				f[j] = _mm_mul_ps(_mm_min_ps(_mm_max_ps(v, zero), one), factor);
+			}
+			_mm_storeu_si128((__m128i*)(dst + i), pack16SSE2(f));
+		}
+		return i;
+	}
+#endif
+
+#if defined(OF_PIXELS_NEON)
+	size_t convert8ToFloatNEON(const unsigned char * src, float * dst, size_t size){
+		const float32x4_t factor = vdupq_n_f32(1.f / 255.f);
+		size_t i = 0;
+		for(; i + 8 <= size; i += 8){
+			uint16x8_t v = vmovl_u8(vld1_u8(src + i));
+			vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))), factor));
+			vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v))), factor));
+		}
+		return i;
+	}
+
+	size_t convertFloatTo8NEON(const float * src, unsigned char * dst, size_t size){
+		const float32x4_t factor = vdupq_n_f32(255.f);
+		const float32x4_t zero = vdupq_n_f32(0.f);
+		const float32x4_t one = vdupq_n_f32(1.f);
+		size_t i = 0;
+		for(; i + 8 <= size; i += 8){
+			float32x4_t lo = vmulq_f32(vminq_f32(vmaxq_f32(vld1q_f32(src + i), zero), one), factor);
+			float32x4_t hi = vmulq_f32(vminq_f32(vmaxq_f32(vld1q_f32(src + i + 4), zero), one), factor);
+			uint16x8_t v = vcombine_u16(vmovn_u32(vcvtq_u32_f32(lo)), vmovn_u32(vcvtq_u32_f32(hi)));
+			vst1_u8(dst + i, vmovn_u16(v));
+		}
+		return i;
+	}
+
+	size_t convert8To16NEON(const unsigned char * src, unsigned short * dst, size_t size){
+		size_t i = 0;
+		for(; i + 16 <= size; i += 16){
+			uint8x16x2_t v;
+			v.val[0] = v.val[1] = vld1q_u8(src + i);
+			vst2q_u8((uint8_t*)(dst + i), v);
+		}
+		return i;
+	}
+
+	size_t convert16To8NEON(const unsigned short * src, unsigned char * dst, size_t size){
+		const float32x4_t factor = vdupq_n_f32(255.f / 65535.f);
+		size_t i = 0;
+		for(; i + 8 <= size; i += 8){
+			uint16x8_t v = vld1q_u16(src + i);
+			float32x4_t lo = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))), factor);
+			float32x4_t hi = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v))), factor);
+			vst1_u8(dst + i, vmovn_u16(vcombine_u16(vmovn_u32(vcvtq_u32_f32(lo)), vmovn_u32(vcvtq_u32_f32(hi)))));
+		}
+		return i;
+	}
+
+	size_t convert16ToFloatNEON(const unsigned short * src, float * dst, size_t size){
+		const float32x4_t factor = vdupq_n_f32(1.f / 65535.f);
+		size_t i = 0;
+		for(; i + 8 <= size; i += 8){
+			uint16x8_t v = vld1q_u16(src + i);
+			vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))), factor));
+			vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v))), factor));
+		}
+		return i;
+	}
+
+	size_t convertFloatTo16NEON(const float * src, unsigned short * dst, size_t size){
+		const float32x4_t factor = vdupq_n_f32(65535.f);
+		const float32x4_t zero = vdupq_n_f32(0.f);
+		const float32x4_t one = vdupq_n_f32(1.f);
+		size_t i = 0;
+		for(; i + 4 <= size; i += 4){
+			float32x4_t v = vmulq_f32(vminq_f32(vmaxq_f32(vld1q_f32(src + i), zero), one), factor);
+			vst1_u16(dst + i, vmovn_u32(vcvtq_u32_f32(v)));
+		}
+		return i;
+	}
+#endif
+}
+
+bool of::priv::convertPixelsSIMD(const unsigned char * src, float * dst, size_t size){
+	size_t done = 0;
+	switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+	case SIMD_AVX2:
+		done = convert8ToFloatAVX2(src, dst, size);
+		break;
+	case SIMD_SSE2:
+		done = convert8ToFloatSSE2(src, dst, size);
+		break;
+#elif defined(OF_PIXELS_NEON)
+	case SIMD_NEON:
+		done = convert8ToFloatNEON(src, dst, size);
+		break;
+#endif
+	default:
+		return false;
+	}
+	convertPixelsScalar(src, dst, done, size);
+	return true;
+}
+
+bool of::priv::convertPixelsSIMD(const float * src, unsigned char * dst, size_t size){
+	size_t done = 0;
+	switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+	case SIMD_AVX2:
+	case SIMD_SSE2:
+		done = convertFloatTo8SSE2(src, dst, size);
+		break;
+#elif defined(OF_PIXELS_NEON)
+	case SIMD_NEON:
+		done = convertFloatTo8NEON(src, dst, size);
+		break;
+#endif
+	default:
+		return false;
+	}
+	convertPixelsScalar(src, dst, done, size);
+	return true;
+}
+
+bool of::priv::convertPixelsSIMD(const unsigned char * src, unsigned short * dst, size_t size){
+	size_t done = 0;
+	switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+	case SIMD_AVX2:
+		done = convert8To16AVX2(src, dst, size);
+		break;
+	case SIMD_SSE2:
+		done = convert8To16SSE2(src, dst, size);
+		break;
+#elif defined(OF_PIXELS_NEON)
+	case SIMD_NEON:
+		done = convert8To16NEON(src, dst, size);
+		break;
+#endif
+	default:
+		return false;
+	}
+	convertPixelsScalar(src, dst, done, size);
+	return true;
+}
+
+bool of::priv::convertPixelsSIMD(const unsigned short * src, unsigned char * dst, size_t size){
+	size_t done = 0;
+	switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+	case SIMD_AVX2:
+	case SIMD_SSE2:
+		done = convert16To8SSE2(src, dst, size);
+		break;
+#elif defined(OF_PIXELS_NEON)
+	case SIMD_NEON:
+		done = convert16To8NEON(src, dst, size);
+		break;
+#endif
+	default:
+		return false;
+	}
+	convertPixelsScalar(src, dst, done, size);
+	return true;
+}
+
+bool of::priv::convertPixelsSIMD(const unsigned short * src, float * dst, size_t size){
+	size_t done = 0;
+	switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+	case SIMD_AVX2:
+		done = convert16ToFloatAVX2(src, dst, size);
+		break;
+	case SIMD_SSE2:
+		done = convert16ToFloatSSE2(src, dst, size);
+		break;
+#elif defined(OF_PIXELS_NEON)
+	case SIMD_NEON:
+		done = convert16ToFloatNEON(src, dst, size);
+		break;
+#endif
+	default:
+		return false;
+	}
+	convertPixelsScalar(src, dst, done, size);
+	return true;
+}
+
+bool of::priv::convertPixelsSIMD(const float * src, unsigned short * dst, size_t size){
+	size_t done = 0;
+	switch(simdLevel()){
+#if defined(OF_PIXELS_SSE2)
+	case SIMD_AVX2:
+	case SIMD_SSE2:
+		done = convertFloatTo16SSE2(src, dst, size);
+		break;
+#elif defined(OF_PIXELS_NEON)
+	case SIMD_NEON:
+		done = convertFloatTo16NEON(src, dst, size);
+		break;
+#endif
+	default:
+		return false;
+	}
+	convertPixelsScalar(src, dst, done, size);
+	return true;
+}
+
+//----------------------------------------------------------------------
+// row tiles, the bulk operations split the rows of the image in tiles
+// which run in parallel on a pool of threads shared by all the ofPixels
+namespace{
+	std::atomic<size_t> pixelsNumThreads{1};
+
+	class RowTilesPool{
+	public:
+		static RowTilesPool & get(){
+			static RowTilesPool pool;
+			return pool;
+		}
+
+		~RowTilesPool(){
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				exit = true;
+			}
+			condition.notify_all();
+			for(auto & thread: threads){
+				thread.join();
+			}
+		}
+
+		// runs all the tiles using up to numThreads threads including the
+		// calling one, returns once all of them are done
+		void run(size_t numTiles, size_t numThreads, const std::function<void(size_t)> & tile){
+			// if another thread is already using the pool run on this one
+			std::unique_lock<std::mutex> runLock(runMutex, std::try_to_lock);
+			if(!runLock.owns_lock()){
+				for(size_t i = 0; i < numTiles; i++){
+					tile(i);
+				}
+				return;
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				while(threads.size() < numThreads - 1){
+					threads.emplace_back(&RowTilesPool::threadedFunction, this);
+				}
+				job = &tile;
+				jobNumTiles = numTiles;
+				jobMaxWorkers = numThreads - 1;
+				nextTile = 0;
+				jobId++;
+			}
+			condition.notify_all();
+
+			runTiles(tile, numTiles);
+
+			std::unique_lock<std::mutex> lock(mutex);
+			job = nullptr;
+			done.wait(lock, [this]{ return activeWorkers == 0; });
+		}
+
+	private:
+		RowTilesPool(){}
+
+		void runTiles(const std::function<void(size_t)> & tile, size_t numTiles){
+			for(size_t i = nextTile++; i < numTiles; i = nextTile++){
+				tile(i);
+			}
+		}
+
+		void threadedFunction(){
+			std::unique_lock<std::mutex> lock(mutex);
+			size_t lastJobId = jobId;
+			while(true){
+				condition.wait(lock, [&]{ return exit || (job && jobId != lastJobId); });
+				if(exit){
+					return;
+				}
+				lastJobId = jobId;
+				if(activeWorkers >= jobMaxWorkers){
+					continue;
+				}
+				activeWorkers++;
+				auto currentJob = job;
+				auto numTiles = jobNumTiles;
+				lock.unlock();
+				runTiles(*currentJob, numTiles);
+				lock.lock();
+				activeWorkers--;
+				if(activeWorkers == 0){
+					done.notify_all();
+				}
+			}
+		}
+
+		std::mutex runMutex;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::condition_variable done;
+		std::vector<std::thread> threads;
+		const std::function<void(size_t)> * job = nullptr;
+		size_t jobNumTiles = 0;
+		size_t jobMaxWorkers = 0;
+		size_t jobId = 0;
+		size_t activeWorkers = 0;
+		std::atomic<size_t> nextTile{0};
+		bool exit = false;
+	};
+
+	// calls rows(first, last) for tiles of rows covering [0, numRows), in
+	// parallel if more than one thread is enabled and the image is big enough
+	template<typename RowsFunc>
+	void forEachRowTile(size_t numRows, size_t rowBytes, RowsFunc rows){
+		// smaller tiles don't compensate for the synchronization
+		const size_t minTileBytes = 64 * 1024;
+		size_t numThreads = ofGetPixelsNumThreads();
+		size_t numTiles = std::min(numThreads * 4, numRows);
+		numTiles = std::min(numTiles, numRows * rowBytes / minTileBytes);
+		if(numThreads <= 1 || numTiles <= 1){
+			rows(0, numRows);
+			return;
+		}
+		RowTilesPool::get().run(numTiles, numThreads, [&](size_t tile){
+			rows(numRows * tile / numTiles, numRows * (tile + 1) / numTiles);
+		});
+	}
+}
+
+//----------------------------------------------------------------------
+void ofSetPixelsUsingSIMD(bool simd){
+	useSIMD = simd;
+}
+
+//----------------------------------------------------------------------
+bool ofGetPixelsUsingSIMD(){
+	return simdLevel() != SIMD_NONE;
+}
+
+//----------------------------------------------------------------------
+void ofSetPixelsNumThreads(size_t numThreads){
+	if(numThreads == 0){
+		numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	pixelsNumThreads = numThreads;
+}
+
+//----------------------------------------------------------------------
+size_t ofGetPixelsNumThreads(){
+	return pixelsNumThreads;
+}
+
 static ofImageType getImageTypeFromChannels(size_t channels){
 	switch(channels){
 	case 1:
@@ -552,8 +1845,10 @@ void ofPixels_<PixelType>::swapRgb(){
 	case OF_PIXELS_BGR:
 	case OF_PIXELS_RGBA:
 	case OF_PIXELS_BGRA:{
-		for(auto pixel: getPixelsIter()){
-			std::swap(pixel[0],pixel[2]);
+		if(!swapRgbSIMD(pixels, width * height, getNumChannels())){
+			for(auto pixel: getPixelsIter()){
+				std::swap(pixel[0],pixel[2]);
+			}
 		}
 	}
 	break;
@@ -1005,10 +2300,17 @@ ofPixels_<PixelType> ofPixels_<PixelType>::getChannel(size_t channel) const{
 
 	channelPixels.allocate(width,height,1);
 	channel = glm::clamp(channel, size_t(0), channels-1);
-	iterator channelPixel = channelPixels.begin();
-	for(auto p: getConstPixelsIter()){
-		*channelPixel++ = p[channel];
-	}
+	size_t stride = getBytesStride() / sizeof(PixelType);
+	PixelType * dstPixels = channelPixels.getData();
+	forEachRowTile(height, getBytesStride(), [&](size_t first, size_t last){
+		for(size_t y = first; y < last; y++){
+			const PixelType * src = pixels + y * stride + channel;
+			PixelType * dst = dstPixels + y * width;
+			for(size_t x = 0; x < width; x++){
+				dst[x] = src[x * channels];
+			}
+		}
+	});
 	return channelPixels;
 }
 
@@ -1018,11 +2320,17 @@ void ofPixels_<PixelType>::setChannel(size_t channel, const ofPixels_<PixelType>
 	if(channels==0) return;
 
 	channel = glm::clamp(channel, size_t(0), channels-1);
-	const_iterator channelPixel = channelPixels.begin();
-	for(auto p: getPixelsIter()){
-		p[channel] = *channelPixel++;
-	}
-
+	size_t stride = getBytesStride() / sizeof(PixelType);
+	const PixelType * srcPixels = channelPixels.getData();
+	forEachRowTile(height, getBytesStride(), [&](size_t first, size_t last){
+		for(size_t y = first; y < last; y++){
+			const PixelType * src = srcPixels + y * width;
+			PixelType * dst = pixels + y * stride + channel;
+			for(size_t x = 0; x < width; x++){
+				dst[x * channels] = src[x];
+			}
+		}
+	});
 }
 
 //From ofPixelsUtils
@@ -1102,37 +2410,43 @@ void ofPixels_<PixelType>::rotate90To(ofPixels_<PixelType> & dst, int nClockwise
 	// otherwise, we will need to do some new allocaiton.
 	dst.allocate(height,width,getImageType());
 
-	size_t strideSrc = width * channels;
-	size_t strideDst = dst.width * channels;
+	size_t strideSrc = getBytesStride() / sizeof(PixelType);
+	size_t strideDst = dst.getBytesStride() / sizeof(PixelType);
 
 	if(rotation == 1){
-		PixelType * srcPixels = pixels;
-		PixelType * startPixels = dst.getData() + strideDst;
-		for (size_t i = 0; i < height; ++i){
-			startPixels -= channels;
-			PixelType * dstPixels = startPixels;
-			for (size_t j = 0; j < width; ++j){
-				for (size_t k = 0; k < channels; ++k){
-					dstPixels[k] = srcPixels[k];
+		// every source row is a destination column
+		forEachRowTile(height, getBytesStride(), [&](size_t first, size_t last){
+			PixelType * srcPixels = pixels + first * strideSrc;
+			PixelType * startPixels = dst.getData() + strideDst - first * channels;
+			for (size_t i = first; i < last; ++i){
+				startPixels -= channels;
+				PixelType * dstPixels = startPixels;
+				for (size_t j = 0; j < width; ++j){
+					for (size_t k = 0; k < channels; ++k){
+						dstPixels[k] = srcPixels[k];
+					}
+					srcPixels += channels;
+					dstPixels += strideDst;
 				}
-				srcPixels += channels;
-				dstPixels += strideDst;
 			}
-		}
+		});
 	} else if(rotation == 3){
-		PixelType * dstPixels = dst.pixels;
-		PixelType * startPixels = pixels + strideSrc;
-		for (size_t i = 0; i < dst.height; ++i){
-			startPixels -= channels;
-			PixelType * srcPixels = startPixels;
-			for (size_t j = 0; j < dst.width; ++j){
-				for (size_t k = 0; k < channels; ++k){
-					dstPixels[k] = srcPixels[k];
+		// every destination row is a source column
+		forEachRowTile(dst.height, dst.getBytesStride(), [&](size_t first, size_t last){
+			PixelType * dstPixels = dst.pixels + first * strideDst;
+			PixelType * startPixels = pixels + strideSrc - first * channels;
+			for (size_t i = first; i < last; ++i){
+				startPixels -= channels;
+				PixelType * srcPixels = startPixels;
+				for (size_t j = 0; j < dst.width; ++j){
+					for (size_t k = 0; k < channels; ++k){
+						dstPixels[k] = srcPixels[k];
+					}
+					srcPixels += strideSrc;
+					dstPixels += channels;
 				}
-				srcPixels += strideSrc;
-				dstPixels += channels;
 			}
-		}
+		});
 	}
 }
 
@@ -1222,38 +2536,33 @@ void ofPixels_<PixelType>::mirrorTo(ofPixels_<PixelType> & dst, bool vertically,
 		return;
 	}
 
-	size_t bytesPerPixel = getNumChannels();
 	dst.allocate(width, height, getPixelFormat());
 
-	if(vertically && !horizontal){
-		auto dstLines = dst.getLines();
-		auto lineSrc = getConstLines().begin();
-		auto line = --dstLines.end();
-		auto stride = line.getStride();
-
-		for(; line>=dstLines.begin(); --line, ++lineSrc){
-			memcpy(line.begin(), lineSrc.begin(), stride);
+	if(getNumPlanes() > 1){
+		// planar formats are mirrored plane by plane
+		auto & src = const_cast<ofPixels_<PixelType>&>(*this);
+		for(size_t i = 0; i < getNumPlanes(); i++){
+			auto dstPlane = dst.getPlane(i);
+			src.getPlane(i).mirrorTo(dstPlane, vertically, horizontal);
 		}
-	}else if (!vertically && horizontal){
-		size_t wToDo = width/2;
-		size_t hToDo = height;
-		for (size_t i = 0; i < wToDo; i++){
-			for (size_t j = 0; j < hToDo; j++){
-				size_t pixelb = j*width + (width - 1 - i);
-				size_t pixela = j*width + i;
-				for (size_t k = 0; k < bytesPerPixel; k++){
-					dst[pixela*bytesPerPixel + k] = pixels[pixelb*bytesPerPixel + k];
-					dst[pixelb*bytesPerPixel + k] = pixels[pixela*bytesPerPixel + k];
+		return;
+	}
 
-				}
+	// row by row so memory is accessed sequentially, mirroring
+	// both ways is a horizontal mirror into the opposite row
+	size_t bytesPerPixel = getNumChannels();
+	size_t stride = getBytesStride() / sizeof(PixelType);
+	PixelType * dstPixels = dst.getData();
+	forEachRowTile(height, getBytesStride(), [&](size_t first, size_t last){
+		for (size_t y = first; y < last; y++){
+			size_t dstY = vertically ? height - 1 - y : y;
+			if(horizontal){
+				mirrorRow(pixels + y * stride, dstPixels + dstY * stride, width, bytesPerPixel);
+			}else{
+				memcpy(dstPixels + dstY * stride, pixels + y * stride, getBytesStride());
 			}
 		}
-	} else {
-		// I couldn't think of a good way to do this in place.  I'm sure there is.
-		mirrorTo(dst,true, false);
-		dst.mirror(false, true);
-	}
-
+	});
 }
 
 //----------------------------------------------------------------------
@@ -1279,54 +2588,10 @@ bool ofPixels_<PixelType>::resize(size_t dstWidth, size_t dstHeight, ofInterpola
 //----------------------------------------------------------------------
 template<typename PixelType>
 float ofPixels_<PixelType>::bicubicInterpolate (const float *patch, float x,float y, float x2,float y2, float x3,float y3) {
-	// adapted from http://www.paulinternet.nl/?page=bicubic
 	// Note that this code can produce values outside of 0...255, due to cubic overshoot.
-	// The ofClamp() prevents this from happening.
-
-	float p00 = patch[ 0];
-	float p10 = patch[ 4];
-	float p20 = patch[ 8];
-	float p30 = patch[12];
-
-	float p01 = patch[ 1];
-	float p11 = patch[ 5];
-	float p21 = patch[ 9];
-	float p31 = patch[13];
-
-	float p02 = patch[ 2];
-	float p12 = patch[ 6];
-	float p22 = patch[10];
-	float p32 = patch[14];
-
-	float p03 = patch[ 3];
-	float p13 = patch[ 7];
-	float p23 = patch[11];
-	float p33 = patch[15];
-
-	float a00 =    p11;
-	float a01 =   -p10 +   p12;
-	float a02 =  2.0f*p10 - 2.0f*p11 +   p12 -   p13;
-	float a03 =   -p10 +   p11 -   p12 +   p13;
-	float a10 =   -p01 +   p21;
-	float a11 =    p00 -   p02 -   p20 +   p22;
-	float a12 = -2.0f*p00 + 2.0f*p01 -   p02 +   p03 + 2.0f*p20 - 2.0f*p21 +   p22 -   p23;
-	float a13 =    p00 -   p01 +   p02 -   p03 -   p20 +   p21 -   p22 +   p23;
-	float a20 =  2.0f*p01 - 2.0f*p11 +   p21 -   p31;
-	float a21 = -2.0f*p00 + 2.0f*p02 + 2.0f*p10 - 2.0f*p12 -   p20 +   p22 +   p30 -   p32;
-	float a22 =  4*p00 - 4*p01 + 2.0f*p02 - 2.0f*p03 - 4*p10 + 4*p11 - 2.0f*p12 + 2.0f*p13 + 2.0f*p20 - 2.0f*p21 + p22 - p23 - 2.0f*p30 + 2.0f*p31 - p32 + p33;
-	float a23 = -2.0f*p00 + 2.0f*p01 - 2.0f*p02 + 2.0f*p03 + 2.0f*p10 - 2.0f*p11 + 2.0f*p12 - 2.0f*p13 -   p20 +   p21 - p22 + p23 +   p30 -   p31 + p32 - p33;
-	float a30 =   -p01 +   p11 -   p21 +   p31;
-	float a31 =    p00 -   p02 -   p10 +   p12 +   p20 -   p22 -   p30 +   p32;
-	float a32 = -2.0f*p00 + 2.0f*p01 -   p02 +   p03 + 2.0f*p10 - 2.0f*p11 +   p12 -   p13 - 2.0f*p20 + 2.0f*p21 - p22 + p23 + 2.0f*p30 - 2.0f*p31 + p32 - p33;
-	float a33 =    p00 -   p01 +   p02 -   p03 -   p10 +   p11 -   p12 +   p13 +   p20 -   p21 + p22 - p23 -   p30 +   p31 - p32 + p33;
-
-	float out =
-	a00      + a01 * y      + a02 * y2      + a03 * y3 +
-	a10 * x  + a11 * x  * y + a12 * x  * y2 + a13 * x  * y3 +
-	a20 * x2 + a21 * x2 * y + a22 * x2 * y2 + a23 * x2 * y3 +
-	a30 * x3 + a31 * x3 * y + a32 * x3 * y2 + a33 * x3 * y3;
-
-	return std::min(static_cast<size_t>(255), std::max(static_cast<size_t>(out), static_cast<size_t>(0)));
+	// The clamp prevents this from happening.
+	float out = bicubicPolynomial(patch, x,y, x2,y2, x3,y3);
+	return std::min(255.f, std::max(out, 0.f));
 }
 
 //----------------------------------------------------------------------
@@ -1338,11 +2603,22 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 
 	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel()) return false;
 
+	if (getNumPlanes() > 1 && dst.getPixelFormat() == getPixelFormat()){
+		// planar formats are resized plane by plane
+		auto & src = const_cast<ofPixels_<PixelType>&>(*this);
+		for (size_t i = 0; i < getNumPlanes(); i++){
+			auto dstPlane = dst.getPlane(i);
+			if (!src.getPlane(i).resizeTo(dstPlane, interpMethod)) return false;
+		}
+		return true;
+	}
+
 	size_t srcWidth      = getWidth();
 	size_t srcHeight     = getHeight();
 	size_t dstWidth	  = dst.getWidth();
 	size_t dstHeight	  = dst.getHeight();
-	size_t bytesPerPixel = getBytesPerPixel();
+	size_t bytesPerPixel = getBytesPerPixel() / sizeof(PixelType);
+	size_t dstRowBytes   = dst.getBytesStride();
 
 
 	PixelType * dstPixels = dst.getData();
@@ -1351,24 +2627,31 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 
 			//----------------------------------------
 		case OF_INTERPOLATE_NEAREST_NEIGHBOR:{
-			size_t dstIndex = 0;
 			float srcxFactor = (float)srcWidth/dstWidth;
 			float srcyFactor = (float)srcHeight/dstHeight;
-			float srcy = 0.5;
-			for (size_t dsty=0; dsty<dstHeight; dsty++){
-				float srcx = 0.5;
-				size_t srcIndex = static_cast<size_t>(srcy) * srcWidth;
-				for (size_t dstx=0; dstx<dstWidth; dstx++){
-					size_t pixelIndex = static_cast<size_t>(srcIndex + srcx) * bytesPerPixel;
-					for (size_t k=0; k<bytesPerPixel; k++){
-						dstPixels[dstIndex] = pixels[pixelIndex];
-						dstIndex++;
-						pixelIndex++;
+			forEachRowTile(dstHeight, dstRowBytes, [&](size_t firstRow, size_t lastRow){
+				// accumulate the same way for every tile so the result
+				// doesn't depend on the number of threads
+				float srcy = 0.5;
+				for (size_t dsty=0; dsty<firstRow; dsty++){
+					srcy+=srcyFactor;
+				}
+				size_t dstIndex = firstRow * dstWidth * bytesPerPixel;
+				for (size_t dsty=firstRow; dsty<lastRow; dsty++){
+					float srcx = 0.5;
+					size_t srcIndex = static_cast<size_t>(srcy) * srcWidth;
+					for (size_t dstx=0; dstx<dstWidth; dstx++){
+						size_t pixelIndex = static_cast<size_t>(srcIndex + srcx) * bytesPerPixel;
+						for (size_t k=0; k<bytesPerPixel; k++){
+							dstPixels[dstIndex] = pixels[pixelIndex];
+							dstIndex++;
+							pixelIndex++;
+						}
+						srcx+=srcxFactor;
 					}
-					srcx+=srcxFactor;
+					srcy+=srcyFactor;
 				}
-				srcy+=srcyFactor;
-			}
+			});
 		}break;
 
 			//----------------------------------------
@@ -1379,58 +2662,94 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 
 			//----------------------------------------
 		case OF_INTERPOLATE_BICUBIC:
-			float px1, py1;
-			float px2, py2;
-			float px3, py3;
-
-			float srcColor = 0;
-			float interpCol;
-			size_t patchRow;
-			size_t patchIndex;
-			float patch[16];
-
 			size_t srcRowBytes = srcWidth*bytesPerPixel;
 			size_t loIndex = (srcRowBytes)+1;
 			size_t hiIndex = (srcWidth*srcHeight*bytesPerPixel)-(srcRowBytes)-1;
-
-			for (size_t dsty=0; dsty<dstHeight; dsty++){
-				for (size_t dstx=0; dstx<dstWidth; dstx++){
-
-					size_t   dstIndex0 = (dsty*dstWidth + dstx) * bytesPerPixel;
-					float srcxf = srcWidth  * (float)dstx/(float)dstWidth;
-					float srcyf = srcHeight * (float)dsty/(float)dstHeight;
-					size_t   srcx = static_cast<size_t>(std::min(srcWidth-1, static_cast<size_t>(srcxf)));
-					size_t   srcy = static_cast<size_t>(std::min(srcHeight-1, static_cast<size_t>(srcyf)));
-					size_t   srcIndex0 = (srcy*srcWidth + srcx) * bytesPerPixel;
-
-					px1 = srcxf - srcx;
-					py1 = srcyf - srcy;
-					px2 = px1 * px1;
-					px3 = px2 * px1;
-					py2 = py1 * py1;
-					py3 = py2 * py1;
-
-					for (size_t k=0; k<bytesPerPixel; k++){
-						size_t   dstIndex = dstIndex0+k;
-						size_t   srcIndex = srcIndex0+k;
-
-						for (size_t dy=0; dy<4; dy++) {
-							patchRow = srcIndex + ((dy-1)*srcRowBytes);
-							for (size_t dx=0; dx<4; dx++) {
-								patchIndex = patchRow + (dx-1)*bytesPerPixel;
+			bool simd = canResizeBicubicSIMD(pixels, bytesPerPixel);
+
+			auto srcIndexFor = [&](size_t dstx, size_t dsty, float & px1, float & py1){
+				float srcxf = srcWidth  * (float)dstx/(float)dstWidth;
+				float srcyf = srcHeight * (float)dsty/(float)dstHeight;
+				size_t   srcx = static_cast<size_t>(std::min(srcWidth-1, static_cast<size_t>(srcxf)));
+				size_t   srcy = static_cast<size_t>(std::min(srcHeight-1, static_cast<size_t>(srcyf)));
+				px1 = srcxf - srcx;
+				py1 = srcyf - srcy;
+				return (srcy*srcWidth + srcx) * bytesPerPixel;
+			};
+
+			forEachRowTile(dstHeight, dstRowBytes, [&](size_t firstRow, size_t lastRow){
+				float px1, py1;
+				float px2, py2;
+				float px3, py3;
+
+				float srcColor = 0;
+				float interpCol;
+				size_t patchRow;
+				size_t patchIndex;
+				float patch[16];
+
+				// patch values outside of the image repeat the last value read
+				// so look for it in the previous pixels to start every tile
+				// with the same value as if all the rows ran in order
+				bool found = false;
+				for (size_t dstIndex=firstRow*dstWidth; dstIndex>0 && !found; dstIndex--){
+					size_t srcIndex0 = srcIndexFor((dstIndex-1)%dstWidth, (dstIndex-1)/dstWidth, px1, py1);
+					for (size_t k=bytesPerPixel; k>0 && !found; k--){
+						for (size_t dy=4; dy>0 && !found; dy--) {
+							patchRow = srcIndex0 + k-1 + ((dy-2)*srcRowBytes);
+							for (size_t dx=4; dx>0 && !found; dx--) {
+								patchIndex = patchRow + (dx-2)*bytesPerPixel;
 								if ((patchIndex >= loIndex) && (patchIndex < hiIndex)) {
 									srcColor = pixels[patchIndex];
+									found = true;
 								}
-								patch[dx*4 + dy] = srcColor;
 							}
 						}
-
-						interpCol = (PixelType)bicubicInterpolate(patch, px1,py1, px2,py2, px3,py3);
-						dstPixels[dstIndex] = interpCol;
 					}
+				}
+
+				for (size_t dsty=firstRow; dsty<lastRow; dsty++){
+					for (size_t dstx=0; dstx<dstWidth; dstx++){
+
+						size_t   dstIndex0 = (dsty*dstWidth + dstx) * bytesPerPixel;
+						size_t   srcIndex0 = srcIndexFor(dstx, dsty, px1, py1);
+
+						px2 = px1 * px1;
+						px3 = px2 * px1;
+						py2 = py1 * py1;
+						py3 = py2 * py1;
+
+						// if the whole patch is inside the image all the channels
+						// can be interpolated at once
+						size_t lastPatchIndex = srcIndex0 + bytesPerPixel - 1 + 2*srcRowBytes + 2*bytesPerPixel;
+						if (simd && srcIndex0 >= loIndex + srcRowBytes + bytesPerPixel && lastPatchIndex < hiIndex){
+							resizeBicubicPixelSIMD(pixels + srcIndex0, srcRowBytes, bytesPerPixel, px1,py1, px2,py2, px3,py3, dstPixels + dstIndex0);
+							srcColor = pixels[lastPatchIndex];
+							continue;
+						}
+
+						for (size_t k=0; k<bytesPerPixel; k++){
+							size_t   dstIndex = dstIndex0+k;
+							size_t   srcIndex = srcIndex0+k;
+
+							for (size_t dy=0; dy<4; dy++) {
+								patchRow = srcIndex + ((dy-1)*srcRowBytes);
+								for (size_t dx=0; dx<4; dx++) {
+									patchIndex = patchRow + (dx-1)*bytesPerPixel;
+									if ((patchIndex >= loIndex) && (patchIndex < hiIndex)) {
+										srcColor = pixels[patchIndex];
+									}
+									patch[dx*4 + dy] = srcColor;
+								}
+							}
+
+							interpCol = (PixelType)bicubicInterpolate(patch, px1,py1, px2,py2, px3,py3);
+							dstPixels[dstIndex] = interpCol;
+						}
 
+					}
 				}
-			}
+			});
 			break;
 	}
 
@@ -1442,72 +2761,57 @@ template<typename PixelType>
 bool ofPixels_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, size_t xTo, size_t yTo) const{
 	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel() || xTo + getWidth()>dst.getWidth() || yTo + getHeight()>dst.getHeight()) return false;
 
+	if (getNumPlanes() > 1){
+		// planar formats are pasted plane by plane, the position is
+		// scaled for the subsampled planes
+		if (dst.getPixelFormat() != getPixelFormat()) return false;
+		auto & src = const_cast<ofPixels_<PixelType>&>(*this);
+		for (size_t i = 0; i < getNumPlanes(); i++){
+			auto srcPlane = src.getPlane(i);
+			auto dstPlane = dst.getPlane(i);
+			size_t planeXTo = xTo * dstPlane.getWidth() / dst.getWidth();
+			size_t planeYTo = yTo * dstPlane.getHeight() / dst.getHeight();
+			if (!srcPlane.pasteInto(dstPlane, planeXTo, planeYTo)) return false;
+		}
+		return true;
+	}
+
 	size_t bytesToCopyPerRow = (xTo + getWidth()<=dst.getWidth() ? getWidth() : dst.getWidth()-xTo) * getBytesPerPixel();
 	size_t columnsToCopy = yTo + getHeight() <= dst.getHeight() ? getHeight() : dst.getHeight()-yTo;
-	PixelType * dstPix = dst.getData() + ((xTo + yTo*dst.getWidth())*dst.getBytesPerPixel());
-	const PixelType * srcPix = getData();
-	size_t srcStride = getWidth()*getBytesPerPixel();
-	size_t dstStride = dst.getWidth()*dst.getBytesPerPixel();
-
-	for(size_t y=0;y<columnsToCopy; y++){
-		memcpy(dstPix,srcPix,bytesToCopyPerRow);
-		dstPix += dstStride;
-		srcPix += srcStride;
-	}
+	size_t srcStride = getBytesStride();
+	size_t dstStride = dst.getBytesStride();
+	unsigned char * dstPix = reinterpret_cast<unsigned char*>(dst.getData()) + yTo*dstStride + xTo*dst.getBytesPerPixel();
+	const unsigned char * srcPix = reinterpret_cast<const unsigned char*>(getData());
+
+	forEachRowTile(columnsToCopy, bytesToCopyPerRow, [&](size_t first, size_t last){
+		for(size_t y=first;y<last; y++){
+			memcpy(dstPix + y*dstStride, srcPix + y*srcStride, bytesToCopyPerRow);
+		}
+	});
 
 	return true;
 }
 
 
-template<typename A, typename B>
-inline A clampedAdd(const A& a, const B& b) {
-	return glm::clamp((float) a + (float) b, 0.f, ofColor_<A>::limit());
-}
-
-
 //----------------------------------------------------------------------
 template<typename PixelType>
 bool ofPixels_<PixelType>::blendInto(ofPixels_<PixelType> &dst, size_t xTo, size_t yTo) const{
 	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel() || xTo + getWidth()>dst.getWidth() || yTo + getHeight()>dst.getHeight() || getNumChannels()==0) return false;
 
-	std::function<void(const ConstPixel&,Pixel&)> blendFunc;
-	switch(getNumChannels()){
-	case 1:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
-			dst[0] = clampedAdd(src[0], dst[0]);
-		};
-		break;
-	case 2:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
-			dst[0] = clampedAdd(src[0], dst[0] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[1]));
-			dst[1] = clampedAdd(src[1], dst[1] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[1]));
-		};
-		break;
-	case 3:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
-			dst[0] = clampedAdd(src[0], dst[0]);
-			dst[1] = clampedAdd(src[1], dst[1]);
-			dst[2] = clampedAdd(src[2], dst[2]);
-		};
-		break;
-	case 4:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
-			dst[0] = clampedAdd(src[0], dst[0] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
-			dst[1] = clampedAdd(src[1], dst[1] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
-			dst[2] = clampedAdd(src[2], dst[2] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
-			dst[3] = clampedAdd(src[3], dst[3] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
-		};
-		break;
-	}
-	auto dstLine = dst.getLine(yTo);
-	for(auto line: getConstLines()){
-		auto dstPixel = dstLine.getPixels().begin() + xTo;
-		for(auto p: line.getPixels()){
-			blendFunc(p,dstPixel);
-			dstPixel++;
+	size_t channels = getNumChannels();
+	size_t srcStride = getBytesStride() / sizeof(PixelType);
+	size_t dstStride = dst.getBytesStride() / sizeof(PixelType);
+	const PixelType * srcPixels = getData();
+	PixelType * dstPixels = dst.getData() + yTo * dstStride + xTo * channels;
+	forEachRowTile(getHeight(), getBytesStride(), [&](size_t first, size_t last){
+		for(size_t y = first; y < last; y++){
+			const PixelType * srcPix = srcPixels + y * srcStride;
+			PixelType * dstPix = dstPixels + y * dstStride;
+			if(!blendRowSIMD(srcPix, dstPix, getWidth(), channels)){
+				blendRowScalar(srcPix, dstPix, 0, getWidth(), channels);
+			}
 		}
-		dstLine++;
-	}
+	});
 
 	return true;
 }
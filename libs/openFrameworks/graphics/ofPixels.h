@@ -667,6 +667,52 @@ typedef ofPixels& ofPixelsRef;
 typedef ofFloatPixels& ofFloatPixelsRef;
 typedef ofShortPixels& ofShortPixelsRef;
 
+/// \brief Enable or disable the SIMD (SSE2, AVX2 or NEON) versions of some
+/// ofPixels operations like resize, swapRgb, blendInto, mirrorTo and the
+/// conversions between pixel types.
+///
+/// They are enabled by default when the CPU supports them, AVX2 is detected
+/// at runtime. Disabling them can be useful to compare results or timings
+/// with the plain C++ versions.
+void ofSetPixelsUsingSIMD(bool useSIMD);
+
+/// \returns true if the SIMD versions are enabled and supported by the CPU
+bool ofGetPixelsUsingSIMD();
+
+/// \brief Set the number of threads used by ofPixels bulk operations.
+///
+/// resizeTo, rotate90To, mirrorTo, setChannel, getChannel, blendInto and
+/// pasteInto split the image in tiles of rows which run on a pool of worker
+/// threads shared by all the ofPixels. The default is 1 which runs everything
+/// in the calling thread, 0 uses as many threads as cores. Small images are
+/// always processed in the calling thread. Planar formats are processed plane
+/// by plane.
+///
+/// The results are the same for any number of threads.
+void ofSetPixelsNumThreads(size_t numThreads);
+
+/// \returns the number of threads used by ofPixels bulk operations
+size_t ofGetPixelsNumThreads();
+
+/// \cond INTERNAL
+namespace of{
+namespace priv{
+	// vectorized conversions for copyFrom, return false if there's no
+	// SIMD version for these types or SIMD is disabled
+	template<typename SrcType, typename DstType>
+	inline bool convertPixelsSIMD(const SrcType *, DstType *, size_t){
+		return false;
+	}
+	bool convertPixelsSIMD(const unsigned char * src, float * dst, size_t size);
+	bool convertPixelsSIMD(const float * src, unsigned char * dst, size_t size);
+	bool convertPixelsSIMD(const unsigned char * src, unsigned short * dst, size_t size);
+	bool convertPixelsSIMD(const unsigned short * src, unsigned char * dst, size_t size);
+	bool convertPixelsSIMD(const unsigned short * src, float * dst, size_t size);
+	bool convertPixelsSIMD(const float * src, unsigned short * dst, size_t size);
+}
+}
+/// \endcond
+
 // sorry for these ones, being templated functions inside a template i needed to do it in the .h
 // they allow to do things like:
 //
@@ -700,6 +746,10 @@ void ofPixels_<PixelType>::copyFrom(const ofPixels_<SrcType> & mom){
 	if(mom.isAllocated()){
 		allocate(mom.getWidth(),mom.getHeight(),mom.getNumChannels());
 
+		if(of::priv::convertPixelsSIMD(mom.getData(), pixels, mom.size())){
+			return;
+		}
+
 		const float srcMax = ( (sizeof(SrcType) == sizeof(float) ) ? 1.f : std::numeric_limits<SrcType>::max() );
 		const float dstMax = ( (sizeof(PixelType) == sizeof(float) ) ? 1.f : std::numeric_limits<PixelType>::max() );
 		const float factor = dstMax / srcMax;
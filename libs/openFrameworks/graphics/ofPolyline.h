@@ -407,6 +407,9 @@ public:
 	/// \{
 
 	/// \brief Tests whether the x,y coordinates are within a closed ofPolyline.
+	///
+	/// If the polyline has a spatial index only the edges near y are
+	/// tested instead of every edge, see buildSpatialIndex().
 	static bool inside(float x, float y, const ofPolyline_ & polyline);
 	/// \brief Tests whether the x,y coordinates are within a closed ofPolyline.
 	bool inside(float x, float y) const;
@@ -434,8 +437,31 @@ public:
 	/// \brief Gets the point on the line closest to the target. You can also
 	/// optionally pass a pointer to/address of an unsigned int to get the
 	/// index of the closest vertex
+	///
+	/// As with inside(), if the polyline has a spatial index only the
+	/// segments around the target are tested.
 	T getClosestPoint(const T& target, unsigned int* nearestIndex = nullptr) const;
 
+	/// \brief Builds a spatial index of the segments used by inside() and
+	/// getClosestPoint() so they don't need to test every segment.
+	///
+	/// Worth it for polylines with many vertices that are queried many
+	/// times. Polylines with less than 128 vertices are as fast to scan so
+	/// no index is built for them. Queries don't modify the index so they
+	/// can run from several threads at the same time.
+	///
+	/// Any non const access to the vertices, including begin(), end(),
+	/// operator[] and getVertices() even if nothing is written, silently
+	/// drops the index and inside() and getClosestPoint() go back to
+	/// testing every segment. Call this again after modifying the
+	/// polyline, or after writing to vertices through a reference or
+	/// iterator obtained before building it.
+	void buildSpatialIndex();
+
+	/// \brief Returns true if inside() and getClosestPoint() use a spatial
+	/// index, see buildSpatialIndex().
+	bool hasSpatialIndex() const;
+
 
 	/// \}
 	/// \name Other Functions
@@ -547,6 +573,30 @@ private:
 	mutable T centroid2D;
 	mutable float area;
 
+	// spatial index used by inside() and getClosestPoint(), stores the
+	// segments (points[i], points[(i+1) % size()]) overlapping each grid
+	// cell and each horizontal band, in compressed row form
+	struct SpatialIndex{
+		float minX = 0;
+		float minY = 0;
+		float cellWidth = 1;
+		float cellHeight = 1;
+		float bandHeight = 1;
+		size_t cols = 0;
+		size_t rows = 0;
+		size_t bands = 0;
+		std::vector<unsigned int> cellStart;
+		std::vector<unsigned int> cellSegments;
+		std::vector<unsigned int> bandStart;
+		std::vector<unsigned int> bandSegments;
+
+		size_t col(float x) const;
+		size_t row(float y) const;
+		size_t band(float y) const;
+	};
+	SpatialIndex spatialIndex;
+	bool bHasSpatialIndex;
+
 
 	std::deque<T> curveVertices;
 	std::vector<T> circlePoints;
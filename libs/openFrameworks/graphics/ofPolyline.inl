@@ -167,6 +167,7 @@ template<class T>
 void ofPolyline_<T>::flagHasChanged() {
     bHasChanged = true;
     bCacheIsDirty = true;
+    bHasSpatialIndex = false;
 }
 
 //----------------------------------------------------------
@@ -576,6 +577,24 @@ inline T getClosestPointUtil(const T& p1, const T& p2, const T& p3, float* norma
 	return glm::mix(toGlm(p1), toGlm(p2), u);
 }
 
+//----------------------------------------------------------
+// returns true if the segment p1-p2 crosses the horizontal ray from x,y to +x
+template<class T>
+inline bool insideCrossingUtil(float x, float y, const T& p1, const T& p2) {
+	if (y > MIN(p1.y,p2.y)) {
+		if (y <= MAX(p1.y,p2.y)) {
+			if (x <= MAX(p1.x,p2.x)) {
+				if (p1.y != p2.y) {
+					double xinters = (y-p1.y)*(p2.x-p1.x)/(p2.y-p1.y)+p1.x;
+					if (p1.x == p2.x || x <= xinters)
+						return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
 //----------------------------------------------------------
 template<class T>
 // a much faster but less accurate version would check distances to vertices first,
@@ -598,20 +617,103 @@ T ofPolyline_<T>::getClosestPoint(const T& target, unsigned int* nearestIndex) c
 	if(polyline.isClosed()) {
 		lastPosition++;
 	}
-	for(int i = 0; i < (int) lastPosition; i++) {
-		bool repeatNext = i == (int) (polyline.size() - 1);
-		
-		const auto& cur = polyline[i];
-		const auto& next = repeatNext ? polyline[0] : polyline[i + 1];
-		
-		float curNormalizedPosition = 0;
-		auto curNearestPoint = getClosestPointUtil(cur, next, target, &curNormalizedPosition);
-		float curDistance = glm::distance(toGlm(curNearestPoint), toGlm(target));
-		if(i == 0 || curDistance < distance) {
-			distance = curDistance;
-			nearest = i;
-			nearestPoint = curNearestPoint;
-			normalizedPosition = curNormalizedPosition;
+
+	if(hasSpatialIndex()) {
+		// visit the grid in rings of cells around the target until the
+		// closest cell of the next ring is further than the nearest point.
+		// segments spanning several cells might be tested more than once
+		// but ties are resolved by index so the result is the same as
+		// testing every segment in order
+		const auto & index = spatialIndex;
+		bool found = false;
+		auto testCell = [&](size_t col, size_t row) {
+			auto cell = row * index.cols + col;
+			for(auto j = index.cellStart[cell]; j < index.cellStart[cell + 1]; j++) {
+				auto i = index.cellSegments[j];
+				if(i >= lastPosition) {
+					continue;
+				}
+				const auto& cur = points[i];
+				const auto& next = points[(i + 1) % points.size()];
+				float curNormalizedPosition = 0;
+				auto curNearestPoint = getClosestPointUtil(cur, next, target, &curNormalizedPosition);
+				float curDistance = glm::distance(toGlm(curNearestPoint), toGlm(target));
+				if(!found || curDistance < distance || (curDistance == distance && i < nearest)) {
+					found = true;
+					distance = curDistance;
+					nearest = i;
+					nearestPoint = curNearestPoint;
+					normalizedPosition = curNormalizedPosition;
+				}
+			}
+		};
+
+		// distance from the target to a column / row of cells
+		auto axisDistance = [](float v, float min, float size) {
+			return std::max(0.f, std::max(min - v, v - (min + size)));
+		};
+		auto gridDistanceX = axisDistance(target.x, index.minX, index.cols * index.cellWidth);
+		auto gridDistanceY = axisDistance(target.y, index.minY, index.rows * index.cellHeight);
+
+		long cols = index.cols;
+		long rows = index.rows;
+		long targetCol = index.col(target.x);
+		long targetRow = index.row(target.y);
+		long maxRing = std::max(cols, rows);
+		for(long r = 0; r <= maxRing; r++) {
+			if(found && r > 0) {
+				// lower bound of the distance to any cell in this ring or further
+				float bound = std::numeric_limits<float>::max();
+				for(auto col: {targetCol - r, targetCol + r}) {
+					if(col >= 0 && col < cols) {
+						float dx = axisDistance(target.x, index.minX + col * index.cellWidth, index.cellWidth);
+						bound = std::min(bound, std::sqrt(dx * dx + gridDistanceY * gridDistanceY));
+					}
+				}
+				for(auto row: {targetRow - r, targetRow + r}) {
+					if(row >= 0 && row < rows) {
+						float dy = axisDistance(target.y, index.minY + row * index.cellHeight, index.cellHeight);
+						bound = std::min(bound, std::sqrt(dy * dy + gridDistanceX * gridDistanceX));
+					}
+				}
+				// leave some slack since the point returned by getClosestPointUtil
+				// can fall slightly out of the segment bounds due to rounding
+				if(bound > distance + (index.cellWidth + index.cellHeight) * 0.001f) {
+					break;
+				}
+			}
+
+			for(long row = std::max(0l, targetRow - r); row <= std::min(rows - 1, targetRow + r); row++) {
+				if(std::abs(row - targetRow) == r) {
+					for(long col = std::max(0l, targetCol - r); col <= std::min(cols - 1, targetCol + r); col++) {
+						testCell(col, row);
+					}
+				} else {
+					if(targetCol - r >= 0) {
+						testCell(targetCol - r, row);
+					}
+					if(targetCol + r < cols) {
+						testCell(targetCol + r, row);
+					}
+				}
+			}
+		}
+	} else {
+		for(int i = 0; i < (int) lastPosition; i++) {
+			bool repeatNext = i == (int) (polyline.size() - 1);
+
+			const auto& cur = polyline[i];
+			const auto& next = repeatNext ? polyline[0] : polyline[i + 1];
+
+			float curNormalizedPosition = 0;
+			auto curNearestPoint = getClosestPointUtil(cur, next, target, &curNormalizedPosition);
+			float curDistance = glm::distance(toGlm(curNearestPoint), toGlm(target));
+			if(i == 0 || curDistance < distance) {
+				distance = curDistance;
+				nearest = i;
+				nearestPoint = curNearestPoint;
+				normalizedPosition = curNormalizedPosition;
+			}
 		}
 	}
 	
@@ -639,24 +741,28 @@ template<class T>
 bool ofPolyline_<T>::inside(float x, float y, const ofPolyline_ & polyline){
 	int counter = 0;
 	int i;
-	double xinters;
 	T p1,p2;
     
 	int N = polyline.size();
+
+	if(polyline.hasSpatialIndex()){
+		// only the edges overlapping the band that contains y can cross the ray
+		const auto & index = polyline.spatialIndex;
+		auto band = index.band(y);
+		for(auto j = index.bandStart[band]; j < index.bandStart[band + 1]; j++){
+			auto segment = index.bandSegments[j];
+			if(insideCrossingUtil(x, y, polyline[segment], polyline[(segment + 1) % N])){
+				counter++;
+			}
+		}
+		return counter % 2 != 0;
+	}
     
 	p1 = polyline[0];
 	for (i=1;i<=N;i++) {
 		p2 = polyline[i % N];
-		if (y > MIN(p1.y,p2.y)) {
-            if (y <= MAX(p1.y,p2.y)) {
-                if (x <= MAX(p1.x,p2.x)) {
-                    if (p1.y != p2.y) {
-                        xinters = (y-p1.y)*(p2.x-p1.x)/(p2.y-p1.y)+p1.x;
-                        if (p1.x == p2.x || x <= xinters)
-                            counter++;
-                    }
-                }
-            }
+		if (insideCrossingUtil(x, y, p1, p2)) {
+			counter++;
 		}
 		p1 = p2;
 	}
@@ -1134,6 +1240,147 @@ void ofPolyline_<T>::getInterpolationParams(float findex, int &i1, int &i2, floa
     i2 = getWrappedIndex(i1 + 1);
 }
 
+//--------------------------------------------------
+template<class T>
+size_t ofPolyline_<T>::SpatialIndex::col(float x) const {
+	float col = (x - minX) / cellWidth;
+	return col <= 0 ? 0 : std::min(cols - 1, size_t(std::min(col, float(cols))));
+}
+
+//--------------------------------------------------
+template<class T>
+size_t ofPolyline_<T>::SpatialIndex::row(float y) const {
+	float row = (y - minY) / cellHeight;
+	return row <= 0 ? 0 : std::min(rows - 1, size_t(std::min(row, float(rows))));
+}
+
+//--------------------------------------------------
+template<class T>
+size_t ofPolyline_<T>::SpatialIndex::band(float y) const {
+	float band = (y - minY) / bandHeight;
+	return band <= 0 ? 0 : std::min(bands - 1, size_t(std::min(band, float(bands))));
+}
+
+//--------------------------------------------------
+template<class T>
+void ofPolyline_<T>::buildSpatialIndex() {
+	// below this many vertices a linear scan is as fast as the index
+	const size_t minSizeForSpatialIndex = 128;
+	bHasSpatialIndex = points.size() >= minSizeForSpatialIndex;
+	if(!bHasSpatialIndex) {
+		return;
+	}
+
+	auto & index = spatialIndex;
+	size_t numSegments = points.size();
+	auto bounds = getBoundingBox();
+	float width = bounds.getWidth();
+	float height = bounds.getHeight();
+	index.minX = bounds.getMinX();
+	index.minY = bounds.getMinY();
+
+	// long segments are stored in every cell they overlap so the size of
+	// the grid is reduced until the index is at most a few times the
+	// number of segments
+	const size_t maxEntriesPerSegment = 8;
+
+	// grid of roughly 2 segments per cell following the aspect ratio
+	// of the bounding box
+	float numCells = numSegments / 2.f;
+	float aspect = (width > 0 && height > 0) ? width / height : 1;
+	size_t cols = width > 0 ? std::max(1.f, std::round(std::sqrt(numCells * aspect))) : 1;
+	size_t rows = height > 0 ? std::max(1.f, std::round(numCells / cols)) : 1;
+	while(true) {
+		index.cols = cols;
+		index.rows = rows;
+		index.cellWidth = width > 0 ? width / cols : 1;
+		index.cellHeight = height > 0 ? height / rows : 1;
+		index.cellStart.assign(cols * rows + 1, 0);
+		size_t entries = 0;
+		for(size_t i = 0; i < numSegments; i++) {
+			const auto & p1 = points[i];
+			const auto & p2 = points[(i + 1) % numSegments];
+			auto col1 = index.col(std::min(p1.x, p2.x));
+			auto col2 = index.col(std::max(p1.x, p2.x));
+			auto row1 = index.row(std::min(p1.y, p2.y));
+			auto row2 = index.row(std::max(p1.y, p2.y));
+			for(auto row = row1; row <= row2; row++) {
+				for(auto col = col1; col <= col2; col++) {
+					index.cellStart[row * cols + col + 1]++;
+				}
+			}
+			entries += (row2 - row1 + 1) * (col2 - col1 + 1);
+		}
+		if(entries <= numSegments * maxEntriesPerSegment || (cols == 1 && rows == 1)) {
+			break;
+		}
+		cols = std::max<size_t>(1, cols / 2);
+		rows = std::max<size_t>(1, rows / 2);
+	}
+	for(size_t cell = 0; cell < index.cols * index.rows; cell++) {
+		index.cellStart[cell + 1] += index.cellStart[cell];
+	}
+	index.cellSegments.resize(index.cellStart.back());
+	auto cellEnd = index.cellStart;
+	for(size_t i = 0; i < numSegments; i++) {
+		const auto & p1 = points[i];
+		const auto & p2 = points[(i + 1) % numSegments];
+		auto col1 = index.col(std::min(p1.x, p2.x));
+		auto col2 = index.col(std::max(p1.x, p2.x));
+		auto row1 = index.row(std::min(p1.y, p2.y));
+		auto row2 = index.row(std::max(p1.y, p2.y));
+		for(auto row = row1; row <= row2; row++) {
+			for(auto col = col1; col <= col2; col++) {
+				index.cellSegments[cellEnd[row * index.cols + col]++] = i;
+			}
+		}
+	}
+
+	// horizontal bands for inside(), the ray from a point only crosses
+	// edges in its own band
+	size_t bands = height > 0 ? std::min<size_t>(std::max<size_t>(1, numSegments / 4), 4096) : 1;
+	while(true) {
+		index.bands = bands;
+		index.bandHeight = height > 0 ? height / bands : 1;
+		index.bandStart.assign(bands + 1, 0);
+		size_t entries = 0;
+		for(size_t i = 0; i < numSegments; i++) {
+			const auto & p1 = points[i];
+			const auto & p2 = points[(i + 1) % numSegments];
+			auto band1 = index.band(std::min(p1.y, p2.y));
+			auto band2 = index.band(std::max(p1.y, p2.y));
+			for(auto band = band1; band <= band2; band++) {
+				index.bandStart[band + 1]++;
+			}
+			entries += band2 - band1 + 1;
+		}
+		if(entries <= numSegments * maxEntriesPerSegment || bands == 1) {
+			break;
+		}
+		bands = std::max<size_t>(1, bands / 2);
+	}
+	for(size_t band = 0; band < index.bands; band++) {
+		index.bandStart[band + 1] += index.bandStart[band];
+	}
+	index.bandSegments.resize(index.bandStart.back());
+	auto bandEnd = index.bandStart;
+	for(size_t i = 0; i < numSegments; i++) {
+		const auto & p1 = points[i];
+		const auto & p2 = points[(i + 1) % numSegments];
+		auto band1 = index.band(std::min(p1.y, p2.y));
+		auto band2 = index.band(std::max(p1.y, p2.y));
+		for(auto band = band1; band <= band2; band++) {
+			index.bandSegments[bandEnd[band]++] = i;
+		}
+	}
+}
+
+//--------------------------------------------------
+template<class T>
+bool ofPolyline_<T>::hasSpatialIndex() const {
+	return bHasSpatialIndex;
+}
+
 //--------------------------------------------------
 template<class T>
 void ofPolyline_<T>::updateCache(bool bForceUpdate) const {
@@ -1206,12 +1453,14 @@ void ofPolyline_<T>::updateCache(bool bForceUpdate) const {
 //--------------------------------------------------
 template<class T>
 typename std::vector<T>::iterator ofPolyline_<T>::begin(){
+	flagHasChanged();
 	return points.begin();
 }
 
 //--------------------------------------------------
 template<class T>
 typename std::vector<T>::iterator ofPolyline_<T>::end(){
+	flagHasChanged();
 	return points.end();
 }
 
@@ -1230,12 +1479,14 @@ typename std::vector<T>::const_iterator ofPolyline_<T>::end() const{
 //--------------------------------------------------
 template<class T>
 typename std::vector<T>::reverse_iterator ofPolyline_<T>::rbegin(){
+	flagHasChanged();
 	return points.rbegin();
 }
 
 //--------------------------------------------------
 template<class T>
 typename std::vector<T>::reverse_iterator ofPolyline_<T>::rend(){
+	flagHasChanged();
 	return points.rend();
 }
 
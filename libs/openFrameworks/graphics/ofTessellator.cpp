@@ -2,6 +2,11 @@
 #include "tesselator.h"
 #include "ofPolyline.h"
 #include "ofMesh.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 
 using namespace std;
 
@@ -55,21 +60,109 @@ void memFree( void *userData, void *ptr ){
 	free (ptr);
 }
 
+//----------------------------------------------------------
+struct ofTessellator::BatchWorker{
+	BatchWorker(TESSalloc * allocator)
+	:tess(tessNewTess(allocator)){}
+
+	~BatchWorker(){
+		tessDeleteTess(tess);
+	}
+
+	TESStesselator * tess;
+	vector<ofDefaultVertexType> vertices;
+	vector<ofIndexType> indices;
+};
+
+//----------------------------------------------------------
+// numThreads - 1 threads waiting for jobs, the calling thread is the
+// first worker of each job
+struct ofTessellator::BatchPool{
+	BatchPool(size_t numThreads){
+		for(size_t i = 1; i < numThreads; i++){
+			threads.emplace_back(&BatchPool::threadLoop, this, i);
+		}
+	}
+
+	~BatchPool(){
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			stop = true;
+		}
+		jobAvailable.notify_all();
+		for(auto & thread: threads){
+			thread.join();
+		}
+	}
+
+	size_t size() const{
+		return threads.size() + 1;
+	}
+
+	// calls job(i) for every worker index and returns when all are done
+	void run(const std::function<void(size_t)> & job){
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			currentJob = &job;
+			pending = threads.size();
+			generation++;
+		}
+		jobAvailable.notify_all();
+		job(0);
+		std::unique_lock<std::mutex> lock(mutex);
+		jobDone.wait(lock, [this]{ return pending == 0; });
+		currentJob = nullptr;
+	}
+
+	void threadLoop(size_t index){
+		uint64_t lastGeneration = 0;
+		while(true){
+			const std::function<void(size_t)> * job;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				jobAvailable.wait(lock, [&]{ return stop || generation != lastGeneration; });
+				if(stop){
+					return;
+				}
+				lastGeneration = generation;
+				job = currentJob;
+			}
+			(*job)(index);
+			std::unique_lock<std::mutex> lock(mutex);
+			if(--pending == 0){
+				jobDone.notify_one();
+			}
+		}
+	}
+
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable jobAvailable;
+	std::condition_variable jobDone;
+	const std::function<void(size_t)> * currentJob = nullptr;
+	uint64_t generation = 0;
+	size_t pending = 0;
+	bool stop = false;
+};
+
 //----------------------------------------------------------
 ofTessellator::ofTessellator()
   : cacheTess(nullptr)
+  , numThreads(1)
 {
 	init();
 }
 
 //----------------------------------------------------------
 ofTessellator::~ofTessellator(){
+	batchPool.reset();
 	tessDeleteTess(cacheTess);
 }
 
 //----------------------------------------------------------
 ofTessellator::ofTessellator(const ofTessellator & mom)
   : cacheTess(nullptr)
+  , numThreads(mom.numThreads)
 {
 	if(&mom != this){
 		if(cacheTess) tessDeleteTess(cacheTess);
@@ -82,6 +175,9 @@ ofTessellator & ofTessellator::operator=(const ofTessellator & mom){
 	if(&mom != this){
 		if(cacheTess) tessDeleteTess(cacheTess);
 		init();
+		batchPool.reset();
+		batchWorkers.clear();
+		numThreads = mom.numThreads;
 	}
 	return *this;
 }
@@ -126,6 +222,146 @@ void ofTessellator::tessellateToMesh( const vector<ofPolyline>& src, ofPolyWindi
 	performTessellation( polyWindingMode, dstmesh, bIs2D );
 }
 
+//----------------------------------------------------------
+void ofTessellator::setNumThreads(size_t numThreads){
+	this->numThreads = numThreads;
+}
+
+//----------------------------------------------------------
+size_t ofTessellator::getNumThreads() const{
+	return numThreads;
+}
+
+//----------------------------------------------------------
+void ofTessellator::tessellateToMesh( const vector<vector<ofPolyline>>& shapes, ofPolyWindingMode polyWindingMode, ofMesh & dstmesh, vector<ShapeRange> & ranges, bool bIs2D ) {
+
+	// clear keeps the memory of the mesh so it can be reused as an arena
+	dstmesh.clear();
+	auto & vertices = dstmesh.getVertices();
+	auto & indices = dstmesh.getIndices();
+	ranges.assign(shapes.size(), ShapeRange());
+	dstmesh.setMode(OF_PRIMITIVE_TRIANGLES);
+
+	// the output usually has as many vertices as the contours
+	// plus a few intersections and around 3 indices per vertex
+	size_t expectedVertices = 0;
+	for(auto & contours: shapes){
+		for(auto & polyline: contours){
+			expectedVertices += polyline.size();
+		}
+	}
+	if(vertices.capacity() < expectedVertices){
+		vertices.reserve(expectedVertices);
+	}
+	if(indices.capacity() < expectedVertices * 3){
+		indices.reserve(expectedVertices * 3);
+	}
+
+	// returns false if the shape is empty or tessellation fails
+	auto tessellateShape = [polyWindingMode, bIs2D](TESStesselator * tess, const vector<ofPolyline> & contours){
+		bool empty = true;
+		for(auto & polyline: contours){
+			if(polyline.size() > 0){
+				tessAddContour(tess, bIs2D ? 2 : 3, &polyline.getVertices()[0].x, sizeof(glm::vec3), polyline.size());
+				empty = false;
+			}
+		}
+		if(empty){
+			return false;
+		}
+		if(!tessTesselate(tess, polyWindingMode, TESS_POLYGONS, 3, 3, 0)){
+			ofLogError("ofTessellator") << "tessellateToMesh(): mesh polygon tessellation failed, winding mode " << polyWindingMode;
+			return false;
+		}
+		return true;
+	};
+
+	// below this many vertices per thread waking the threads
+	// costs more than what they save
+	const size_t minVerticesPerThread = 2048;
+	size_t threads = numThreads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : numThreads;
+	threads = std::min(threads, shapes.size());
+	threads = std::min(threads, expectedVertices / minVerticesPerThread);
+
+	if(threads <= 1){
+		// append every shape straight to the destination mesh
+		for(size_t i = 0; i < shapes.size(); i++){
+			if(tessellateShape(cacheTess, shapes[i])){
+				auto verts = (const ofDefaultVertexType*)tessGetVertices(cacheTess);
+				auto elems = tessGetElements(cacheTess);
+				auto & range = ranges[i];
+				range.vertexOffset = vertices.size();
+				range.numVertices = tessGetVertexCount(cacheTess);
+				range.indexOffset = indices.size();
+				range.numIndices = tessGetElementCount(cacheTess) * 3;
+				vertices.insert(vertices.end(), verts, verts + range.numVertices);
+				for(size_t j = 0; j < range.numIndices; j++){
+					indices.push_back(elems[j] + range.vertexOffset);
+				}
+			}
+		}
+		return;
+	}
+
+	// each thread takes the next shape that hasn't been tessellated yet
+	// and appends the results to its own buffers, ranges are relative
+	// to those buffers until they are merged in the destination mesh
+	while(batchWorkers.size() < threads){
+		batchWorkers.emplace_back(new BatchWorker(&tessAllocator));
+	}
+	batchShapeWorker.resize(shapes.size());
+	std::atomic<size_t> nextShape{0};
+	std::function<void(size_t)> work = [&](size_t workerIndex){
+		auto & worker = *batchWorkers[workerIndex];
+		worker.vertices.clear();
+		worker.indices.clear();
+		for(auto i = nextShape++; i < shapes.size(); i = nextShape++){
+			batchShapeWorker[i] = workerIndex;
+			if(tessellateShape(worker.tess, shapes[i])){
+				auto verts = (const ofDefaultVertexType*)tessGetVertices(worker.tess);
+				auto elems = tessGetElements(worker.tess);
+				auto & range = ranges[i];
+				range.vertexOffset = worker.vertices.size();
+				range.numVertices = tessGetVertexCount(worker.tess);
+				range.indexOffset = worker.indices.size();
+				range.numIndices = tessGetElementCount(worker.tess) * 3;
+				worker.vertices.insert(worker.vertices.end(), verts, verts + range.numVertices);
+				worker.indices.insert(worker.indices.end(), elems, elems + range.numIndices);
+			}
+		}
+	};
+	if(!batchPool || batchPool->size() != threads){
+		batchPool.reset();
+		batchPool.reset(new BatchPool(threads));
+	}
+	batchPool->run(work);
+
+	size_t numVertices = 0;
+	size_t numIndices = 0;
+	for(auto & range: ranges){
+		numVertices += range.numVertices;
+		numIndices += range.numIndices;
+	}
+	vertices.resize(numVertices);
+	indices.resize(numIndices);
+	size_t vertexOffset = 0;
+	size_t indexOffset = 0;
+	for(size_t i = 0; i < shapes.size(); i++){
+		auto & range = ranges[i];
+		auto & worker = *batchWorkers[batchShapeWorker[i]];
+		std::copy(worker.vertices.begin() + range.vertexOffset,
+				  worker.vertices.begin() + range.vertexOffset + range.numVertices,
+				  vertices.begin() + vertexOffset);
+		for(size_t j = 0; j < range.numIndices; j++){
+			indices[indexOffset + j] = worker.indices[range.indexOffset + j] + vertexOffset;
+		}
+		range.vertexOffset = vertexOffset;
+		range.indexOffset = indexOffset;
+		vertexOffset += range.numVertices;
+		indexOffset += range.numIndices;
+	}
+}
+
 //----------------------------------------------------------
 void ofTessellator::tessellateToPolylines( const ofPolyline& src,  ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D){
 
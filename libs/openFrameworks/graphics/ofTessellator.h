@@ -49,6 +49,42 @@ public:
 	/// \brief Tessellate multiple polylines into a single polyline.
 	void tessellateToPolylines( const ofPolyline & src, ofPolyWindingMode polyWindingMode, std::vector<ofPolyline>& dstpoly, bool bIs2D=false );
 
+	/// \brief Position of one shape inside a mesh tessellated in a batch.
+	struct ShapeRange{
+		std::size_t vertexOffset = 0;
+		std::size_t numVertices = 0;
+		std::size_t indexOffset = 0;
+		std::size_t numIndices = 0;
+	};
+
+	/// \brief Tessellates many independent shapes, each one a vector of
+	/// contours, into a single ofMesh.
+	///
+	/// Every shape is tessellated separately using the winding mode set in
+	/// ofPolyWindingMode and its vertices and indices are appended to
+	/// dstmesh, indices already offset to point to the shape's vertices.
+	/// ranges returns where each shape ended up, empty shapes or shapes that
+	/// fail to tessellate get an empty range.
+	///
+	/// dstmesh and ranges are meant to be reused from frame to frame, their
+	/// memory is kept so once they've grown enough no more allocations happen.
+	///
+	/// \sa setNumThreads()
+	void tessellateToMesh( const std::vector<std::vector<ofPolyline>>& shapes, ofPolyWindingMode polyWindingMode, ofMesh & dstmesh, std::vector<ShapeRange> & ranges, bool bIs2D=false );
+
+	/// \brief Sets the number of threads used to tessellate batches of shapes.
+	///
+	/// Each thread uses its own tessellator so independent shapes are
+	/// tessellated in parallel. Defaults to 1 which tessellates every shape
+	/// in the calling thread, 0 uses as many threads as hardware cores.
+	///
+	/// The threads are started by the first batch that uses them and wait
+	/// for the next batch until the tessellator is destroyed. Batches with
+	/// few vertices use less threads, or only the calling thread, since
+	/// waking a thread costs about as much as tessellating a small shape.
+	void setNumThreads(std::size_t numThreads);
+	std::size_t getNumThreads() const;
+
 private:
 	
 	void performTessellation( ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D );
@@ -57,6 +93,17 @@ private:
 
 	TESStesselator * cacheTess;
 	TESSalloc tessAllocator;
+
+	// one tessellator per thread for batches and the buffers
+	// where each thread writes its shapes before merging them
+	struct BatchWorker;
+	std::vector<std::unique_ptr<BatchWorker>> batchWorkers;
+	std::vector<std::size_t> batchShapeWorker;
+
+	// threads that run the batches, kept between calls
+	struct BatchPool;
+	std::unique_ptr<BatchPool> batchPool;
+	std::size_t numThreads;
 };
 
 
@@ -14,8 +14,11 @@
 
 #include <algorithm>
 #include <numeric>
+#include <list>
+#include <fstream>
 
 #include "ofGraphics.h"
+#include "ofGLUtils.h"
 #include "utf8.h"
 
 using namespace std;
@@ -158,12 +161,195 @@ const ofTrueTypeFont::glyphProps ofTrueTypeFont::invalidProps{
 };
 
 const size_t TAB_WIDTH = 4; /// Number of spaces per tab
+const int ATLAS_BORDER = 1; /// Empty pixels around each glyph in the atlas
 
 static bool printVectorInfo = false;
 static int ttfGlobalDpi = 96;
 static bool librariesInitialized = false;
 static FT_Library library;
 
+//--------------------------------------------------------
+// Glyphs of a font loading them on demand. Every atlas page is a grid of
+// cells as big as the bounding box of the font so any glyph fits in any
+// free cell, evicting the least recently used glyph makes room for the
+// next one without repacking the page.
+struct ofTrueTypeFont::glyphAtlas{
+	struct entry{
+		glyphProps props = invalidProps;
+		bool resident = false; // props has the texture coordinates of the glyph
+		bool hasCell = false; // empty glyphs like spaces don't use a cell
+		size_t page = 0;
+		size_t cell = 0;
+		uint64_t lastUsed = 0;
+		std::list<size_t>::iterator lru;
+	};
+
+	glyphAtlas(const ofTrueTypeFont & font, size_t numGlyphs)
+	:numGlyphs(numGlyphs){
+		int maxSize;
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+		pageSize = std::max(1, std::min(font.settings.atlasPageSize, maxSize));
+		maxPages = std::max(size_t(1), font.settings.maxAtlasPages);
+		linearFilter = font.settings.antialiased && font.settings.fontSize>20;
+		cellWidth = std::min(pageSize, int(ceil(font.glyphBBox.width)) + 1 + ATLAS_BORDER * 2);
+		cellHeight = std::min(pageSize, int(ceil(font.glyphBBox.height)) + 1 + ATLAS_BORDER * 2);
+		columns = pageSize / cellWidth;
+		rows = pageSize / cellHeight;
+		cellPixels.allocate(cellWidth, cellHeight, OF_PIXELS_GRAY_ALPHA);
+		glyphs.reserve(1024);
+	}
+
+	// metrics of a glyph, loading them the first time
+	entry & get(const ofTrueTypeFont & font, uint32_t glyph){
+		auto index = font.indexForGlyph(glyph);
+		auto it = glyphs.find(index);
+		if(it == glyphs.end()){
+			auto loaded = font.loadGlyph(glyph);
+			loaded.props.characterIndex = index;
+			it = glyphs.emplace(index, entry()).first;
+			it->second.props = loaded.props;
+		}
+		return it->second;
+	}
+
+	// makes a glyph resident in a page and the most recently used one,
+	// returns false if every cell is in use by the current string
+	bool use(const ofTrueTypeFont & font, uint32_t glyph){
+		auto index = font.indexForGlyph(glyph);
+		auto & e = glyphs[index];
+		if(e.resident){
+			touch(e);
+			return true;
+		}
+
+		auto loaded = font.loadGlyph(glyph);
+		loaded.props.characterIndex = index;
+		e.props = loaded.props;
+		if(!loaded.pixels.isAllocated()){
+			e.resident = true;
+			return true;
+		}
+		if(!allocateCell(e.page, e.cell)){
+			return false;
+		}
+		upload(loaded.pixels, e);
+		e.resident = true;
+		e.hasCell = true;
+		e.lastUsed = generation;
+		lru.push_front(index);
+		e.lru = lru.begin();
+		return true;
+	}
+
+	// makes a resident glyph the most recently used one
+	void touch(entry & e){
+		if(e.hasCell){
+			e.lastUsed = generation;
+			lru.splice(lru.begin(), lru, e.lru);
+		}
+	}
+
+	bool allocateCell(size_t & page, size_t & cell){
+		if(freeCells.empty() && pages.size() < maxPages){
+			addPage();
+		}
+		if(freeCells.empty() && !lru.empty()){
+			auto & evicted = glyphs[lru.back()];
+			if(evicted.lastUsed != generation){
+				evicted.resident = false;
+				evicted.hasCell = false;
+				freeCells.emplace_back(evicted.page, evicted.cell);
+				lru.pop_back();
+				version++;
+			}
+		}
+		if(freeCells.empty()){
+			return false;
+		}
+		page = freeCells.back().first;
+		cell = freeCells.back().second;
+		freeCells.pop_back();
+		return true;
+	}
+
+	void addPage(){
+		ofPixels pixels;
+		pixels.allocate(pageSize, pageSize, OF_PIXELS_GRAY_ALPHA);
+		pixels.set(0,255);
+		pixels.set(1,0);
+		pages.emplace_back();
+		auto & texture = pages.back();
+		texture.allocate(pixels,false);
+		texture.setRGToRGBASwizzles(true);
+		if(linearFilter){
+			texture.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
+		}else{
+			texture.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+		}
+		texture.loadData(pixels);
+		// in reverse so the first cells are used first
+		for(size_t cell = columns * rows; cell > 0; cell--){
+			freeCells.emplace_back(pages.size() - 1, cell - 1);
+		}
+	}
+
+	// copies the glyph to its cell, clearing what an evicted glyph left
+	void upload(const ofPixels & glyphPixels, entry & e){
+		cellPixels.set(0,255);
+		cellPixels.set(1,0);
+		auto maxWidth = cellWidth - ATLAS_BORDER * 2;
+		auto maxHeight = cellHeight - ATLAS_BORDER * 2;
+		if(glyphPixels.getWidth() > size_t(maxWidth) || glyphPixels.getHeight() > size_t(maxHeight)){
+			ofPixels cropped;
+			glyphPixels.cropTo(cropped, 0, 0, std::min<size_t>(glyphPixels.getWidth(), maxWidth), std::min<size_t>(glyphPixels.getHeight(), maxHeight));
+			cropped.pasteInto(cellPixels, ATLAS_BORDER, ATLAS_BORDER);
+			e.props.tW = std::min<float>(e.props.tW, maxWidth);
+			e.props.tH = std::min<float>(e.props.tH, maxHeight);
+		}else{
+			glyphPixels.pasteInto(cellPixels, ATLAS_BORDER, ATLAS_BORDER);
+		}
+
+		int x = (e.cell % columns) * cellWidth;
+		int y = (e.cell / columns) * cellHeight;
+		const auto & texData = pages[e.page].getTextureData();
+		ofSetPixelStoreiAlignment(GL_UNPACK_ALIGNMENT, cellPixels.getBytesStride());
+		glBindTexture(texData.textureTarget, (GLuint)texData.textureID);
+		glTexSubImage2D(texData.textureTarget, 0, x, y, cellWidth, cellHeight, ofGetGLFormat(cellPixels), ofGetGLType(cellPixels), cellPixels.getData());
+		glBindTexture(texData.textureTarget, 0);
+
+		e.props.t1 = float(x + ATLAS_BORDER) / float(pageSize);
+		e.props.v1 = float(y + ATLAS_BORDER) / float(pageSize);
+		e.props.t2 = float(x + ATLAS_BORDER + e.props.tW) / float(pageSize);
+		e.props.v2 = float(y + ATLAS_BORDER + e.props.tH) / float(pageSize);
+	}
+
+	// drops the pages keeping the metrics, glyphs are uploaded again when drawn
+	void clear(){
+		pages.clear();
+		freeCells.clear();
+		lru.clear();
+		version++;
+		for(auto & glyph: glyphs){
+			glyph.second.resident = false;
+			glyph.second.hasCell = false;
+		}
+	}
+
+	size_t numGlyphs;
+	int pageSize;
+	size_t maxPages;
+	bool linearFilter;
+	int cellWidth, cellHeight;
+	int columns, rows;
+	std::vector<ofTexture> pages;
+	std::unordered_map<size_t, entry> glyphs; // by character index, only the glyphs loaded so far
+	std::list<size_t> lru; // glyphs with a cell, most recently used first
+	std::vector<std::pair<size_t, size_t>> freeCells; // page and cell
+	uint64_t generation = 0; // incremented per string, glyphs used by the current string aren't evicted
+	uint64_t version = 0; // incremented when a glyph is evicted, moving the texture coordinates of its cell
+	ofPixels cellPixels;
+};
+
 //--------------------------------------------------------
 void ofTrueTypeShutdown(){
 #ifdef TARGET_LINUX
@@ -360,11 +546,11 @@ static std::string linuxFontPathByName(const std::string& fontname){
 #endif
 
 //-----------------------------------------------------------
-static bool loadFontFace(const std::filesystem::path& _fontname, FT_Face & face, std::filesystem::path & filename){
+static bool findFontFile(const std::filesystem::path& _fontname, std::filesystem::path & filename, int & fontID){
 	std::filesystem::path fontname = _fontname;
 	filename = ofToDataPath(_fontname,true);
 	ofFile fontFile(filename,ofFile::Reference);
-	int fontID = 0;
+	fontID = 0;
 	if(!fontFile.exists()){
 #ifdef TARGET_LINUX
         filename = linuxFontPathByName(fontname.string());
@@ -398,19 +584,157 @@ static bool loadFontFace(const std::filesystem::path& _fontname, FT_Face & face,
 		}
 		ofLogVerbose("ofTrueTypeFont") << "loadFontFace(): \"" << fontname << "\" not a file in data loading system font from \"" << filename << "\"";
 	}
+	return true;
+}
+
+//-----------------------------------------------------------
+static bool loadFontFace(const std::filesystem::path& filename, int fontID, FT_Face & face){
 	FT_Error err;
     err = FT_New_Face( library, filename.string().c_str(), fontID, &face );
 	if (err) {
 		// simple error table in lieu of full table (see fterrors.h)
 		string errorString = "unknown freetype";
 		if(err == 1) errorString = "INVALID FILENAME";
-		ofLogError("ofTrueTypeFont") << "loadFontFace(): couldn't create new face for \"" << fontname << "\": FT_Error " << err << " " << errorString;
+		ofLogError("ofTrueTypeFont") << "loadFontFace(): couldn't create new face for \"" << filename << "\": FT_Error " << err << " " << errorString;
+		return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------
+static bool uploadAtlas(ofTexture & texAtlas, const ofPixels & atlasPixels, const ofTrueTypeFontSettings & settings){
+	int maxSize;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+	auto w = atlasPixels.getWidth();
+	auto h = atlasPixels.getHeight();
+	if(w > size_t(maxSize) || h > size_t(maxSize)){
+		ofLogError("ofTruetypeFont") << "Trying to allocate texture of " << w << "x" << h << " which is bigger than supported in current platform: " << maxSize;
 		return false;
 	}
+	texAtlas.allocate(atlasPixels,false);
+	texAtlas.setRGToRGBASwizzles(true);
 
+	if(settings.antialiased && settings.fontSize>20){
+		texAtlas.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
+	}else{
+		texAtlas.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+	}
+	texAtlas.loadData(atlasPixels);
 	return true;
 }
 
+//-----------------------------------------------------------
+// atlas cache files start with the magic and the key of the font they were
+// made from, followed by the metrics, glyph properties, kerning, contour
+// commands and the atlas pixels
+static const char fontCacheMagic[8] = {'o','f','A','t','l','a','s','1'};
+
+// kerning pairs are cached for fonts with up to this many glyphs, checking
+// every pair of bigger fonts would take too long so they open the face the
+// first time a string needs kerning
+static const size_t maxCachedKerningGlyphs = 512;
+
+//-----------------------------------------------------------
+static uint64_t hashFontCache(const char * data, size_t size){
+	// FNV-1a over 8 byte words, fast enough to hash a whole font file on load
+	uint64_t hash = 14695981039346656037ull ^ size;
+	size_t i = 0;
+	for(; i + 8 <= size; i += 8){
+		uint64_t word;
+		memcpy(&word, data + i, 8);
+		hash = (hash ^ word) * 1099511628211ull;
+		hash ^= hash >> 29;
+	}
+	for(; i < size; i++){
+		hash = (hash ^ uint8_t(data[i])) * 1099511628211ull;
+	}
+	return hash;
+}
+
+//-----------------------------------------------------------
+// everything that changes the cached data, an empty key if the font file
+// can't be read
+static std::string fontCacheKey(const ofTrueTypeFontSettings & settings, size_t glyphPropsSize){
+	ofMemoryMappedFile fontFile(settings.fontName);
+	if(!fontFile.isOpen()){
+		return "";
+	}
+	std::stringstream key;
+	key << "font " << ofToHex(hashFontCache(fontFile.getData(), fontFile.size())) << " " << fontFile.size()
+		<< " size " << settings.fontSize
+		<< " dpi " << settings.dpi
+		<< " antialiased " << settings.antialiased
+		<< " contours " << settings.contours
+		<< " simplify " << settings.simplifyAmt
+		<< " props " << glyphPropsSize
+		<< " ranges";
+	for(auto & range: settings.ranges){
+		key << " " << range.begin << "-" << range.end;
+	}
+	return key.str();
+}
+
+//-----------------------------------------------------------
+static std::filesystem::path fontCachePath(const ofTrueTypeFontSettings & settings, const std::string & key){
+	auto name = settings.fontName.stem().string() + "_" + ofToHex(hashFontCache(key.data(), key.size())) + ".ofatlas";
+	return std::filesystem::path(ofToDataPath(settings.cacheFolder, true)) / name;
+}
+
+namespace{
+	// reads a cache file checking that it doesn't read past its end
+	struct fontCacheReader{
+		const char * data;
+		size_t size;
+		size_t pos = 0;
+		bool valid = true;
+
+		const char * skip(size_t bytes){
+			if(!valid || bytes > size - pos){
+				valid = false;
+				return nullptr;
+			}
+			auto current = data + pos;
+			pos += bytes;
+			return current;
+		}
+
+		template<typename T>
+		T read(){
+			T value{};
+			auto bytes = skip(sizeof(T));
+			if(bytes){
+				memcpy(&value, bytes, sizeof(T));
+			}
+			return value;
+		}
+
+		void align(size_t alignment){
+			skip((alignment - pos % alignment) % alignment);
+		}
+	};
+
+	struct fontCacheWriter{
+		std::ofstream & file;
+		size_t pos = 0;
+
+		void write(const void * data, size_t bytes){
+			file.write(static_cast<const char*>(data), bytes);
+			pos += bytes;
+		}
+
+		template<typename T>
+		void write(const T & value){
+			write(&value, sizeof(T));
+		}
+
+		void align(size_t alignment){
+			static const char zeros[16] = {0};
+			write(zeros, (alignment - pos % alignment) % alignment);
+		}
+	};
+}
+
 //--------------------------------------------------------
 void ofTrueTypeFont::setGlobalDpi(int newDpi){
 	ttfGlobalDpi = newDpi;
@@ -453,10 +777,12 @@ ofTrueTypeFont::ofTrueTypeFont()
 	letterSpacing = 1;
 	spaceSize = 1;
 	fontUnitScale = 1;
-	stringQuads.setMode(OF_PRIMITIVE_TRIANGLES);
 	ascenderHeight = 0;
 	descenderHeight = 0;
 	lineHeight = 0;
+	faceIndex = 0;
+	kerningCached = false;
+	layoutCacheSize = 1024;
 }
 
 //------------------------------------------------------------------
@@ -495,7 +821,12 @@ ofTrueTypeFont::ofTrueTypeFont(const ofTrueTypeFont& mom)
 	settings = mom.settings;
 	glyphIndexMap = mom.glyphIndexMap;
 	texAtlas = mom.texAtlas;
+	atlas = mom.atlas;
 	face = mom.face;
+	faceIndex = mom.faceIndex;
+	kerningCached = mom.kerningCached;
+	kerningPairs = mom.kerningPairs;
+	layoutCacheSize = mom.layoutCacheSize;
 }
 
 //------------------------------------------------------------------
@@ -527,7 +858,13 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(const ofTrueTypeFont& mom){
 	settings = mom.settings;
 	glyphIndexMap = mom.glyphIndexMap;
 	texAtlas = mom.texAtlas;
+	atlas = mom.atlas;
 	face = mom.face;
+	faceIndex = mom.faceIndex;
+	kerningCached = mom.kerningCached;
+	kerningPairs = mom.kerningPairs;
+	layoutCacheSize = mom.layoutCacheSize;
+	clearLayoutCache();
 
 	return *this;
 }
@@ -560,7 +897,12 @@ ofTrueTypeFont::ofTrueTypeFont(ofTrueTypeFont&& mom)
 	settings = mom.settings;
 	glyphIndexMap = std::move(mom.glyphIndexMap);
 	texAtlas = mom.texAtlas;
+	atlas = mom.atlas;
 	face = mom.face;
+	faceIndex = mom.faceIndex;
+	kerningCached = mom.kerningCached;
+	kerningPairs = mom.kerningPairs;
+	layoutCacheSize = mom.layoutCacheSize;
 }
 
 //------------------------------------------------------------------
@@ -591,7 +933,13 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(ofTrueTypeFont&& mom){
 	settings = mom.settings;
 	glyphIndexMap = std::move(mom.glyphIndexMap);
 	texAtlas = mom.texAtlas;
+	atlas = mom.atlas;
 	face = mom.face;
+	faceIndex = mom.faceIndex;
+	kerningCached = mom.kerningCached;
+	kerningPairs = mom.kerningPairs;
+	layoutCacheSize = mom.layoutCacheSize;
+	clearLayoutCache();
 	return *this;
 }
 
@@ -599,6 +947,9 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(ofTrueTypeFont&& mom){
 void ofTrueTypeFont::unloadTextures(){
 	if(!bLoadedOk) return;
 	texAtlas.clear();
+	if(atlas){
+		atlas->clear();
+	}
 }
 
 //-----------------------------------------------------------
@@ -612,11 +963,23 @@ bool ofTrueTypeFont::loadFont(string filename, int fontSize, bool bAntiAliased,
 }
 
 //-----------------------------------------------------------
-ofTrueTypeFont::glyph ofTrueTypeFont::loadGlyph(uint32_t utf8) const{
-	glyph aGlyph;
+bool ofTrueTypeFont::loadGlyphOutline(uint32_t utf8) const{
+	if(!loadFace()){
+		return false;
+	}
 	auto err = FT_Load_Glyph( face.get(), FT_Get_Char_Index( face.get(), utf8 ), settings.antialiased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
 	if(err){
 		ofLogError("ofTrueTypeFont") << "loadFont(): FT_Load_Glyph failed for utf8 code " << utf8 << ": FT_Error " << err;
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------
+ofTrueTypeFont::glyph ofTrueTypeFont::loadGlyph(uint32_t utf8) const{
+	glyph aGlyph;
+	aGlyph.props = invalidProps;
+	if(!loadGlyphOutline(utf8)){
 		return aGlyph;
 	}
 
@@ -704,6 +1067,7 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 	#endif
 
 	initLibraries();
+	clearLayoutCache();
 	settings = _settings;
 	if( settings.dpi == 0 ){
 		settings.dpi = ttfGlobalDpi;
@@ -711,20 +1075,39 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 
 	bLoadedOk = false;
 
-	//--------------- load the library and typeface
-	FT_Face loadFace;
-    if(!loadFontFace(settings.fontName, loadFace, settings.fontName)){
+	//--------------- find the font file
+	std::filesystem::path filename;
+	if(!findFontFile(settings.fontName, filename, faceIndex)){
 		return false;
 	}
-	face = std::shared_ptr<struct FT_FaceRec_>(loadFace,FT_Done_Face);
+	settings.fontName = filename;
+	face.reset();
+	kerningCached = false;
+	kerningPairs.clear();
 
 	if(settings.ranges.empty()){
 		settings.ranges.push_back(ofUnicode::Latin1Supplement);
 	}
-	int border = 1;
+	int border = ATLAS_BORDER;
+
+	std::string cacheKey;
+	std::filesystem::path cachePath;
+	if(!settings.cacheFolder.empty() && !settings.onDemand){
+		cacheKey = fontCacheKey(settings, sizeof(glyphProps));
+		if(!cacheKey.empty()){
+			cachePath = fontCachePath(settings, cacheKey);
+			if(loadCache(cachePath, cacheKey)){
+				bLoadedOk = true;
+				return true;
+			}
+		}
+	}
 
+	//--------------- load the library and typeface
+	if(!loadFace()){
+		return false;
+	}
 
-	FT_Set_Char_Size( face.get(), settings.fontSize << 6, settings.fontSize << 6, settings.dpi, settings.dpi);
 	fontUnitScale = (float(settings.fontSize * settings.dpi)) / (72 * face->units_per_EM);
 	lineHeight = face->height * fontUnitScale;
 	ascenderHeight = face->ascender * fontUnitScale;
@@ -739,7 +1122,16 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 			[](uint32_t acc, ofUnicode::range range){
 				return acc + range.getNumGlyphs();
 			});
-	cps.resize(nGlyphs);
+	glyphIndexMap.clear();
+	glyphIndexMap.reserve(nGlyphs);
+	if(settings.onDemand){
+		cps.clear();
+		texAtlas.clear();
+		atlas = std::make_shared<glyphAtlas>(*this, nGlyphs);
+	}else{
+		cps.resize(nGlyphs);
+		atlas.reset();
+	}
 	if(settings.contours){
 		charOutlines.resize(nGlyphs);
 		charOutlinesNonVFlipped.resize(nGlyphs);
@@ -757,11 +1149,21 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 	auto i = 0u;
 	for(auto & range: settings.ranges){
 		for (uint32_t g = range.begin; g <= range.end; g++, i++){
-			all_glyphs.push_back(loadGlyph(g));
-			all_glyphs[i].props.characterIndex	= i;
 			glyphIndexMap[g] = i;
-			cps[i] = all_glyphs[i].props;
-			areaSum += (cps[i].tW+border*2)*(cps[i].tH+border*2);
+			long height = 0;
+			if(settings.onDemand){
+				// the contours only need the outline of the glyph, it's
+				// rasterized into the atlas the first time it's drawn
+				if(settings.contours && loadGlyphOutline(g)){
+					height = face->glyph->metrics.height>>6;
+				}
+			}else{
+				all_glyphs.push_back(loadGlyph(g));
+				all_glyphs[i].props.characterIndex	= i;
+				cps[i] = all_glyphs[i].props;
+				areaSum += (cps[i].tW+border*2)*(cps[i].tH+border*2);
+				height = cps[i].height;
+			}
 
 			if(settings.contours){
 				if(printVectorInfo){
@@ -771,29 +1173,16 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 				}
 
 				//int character = i + NUM_CHARACTER_TO_START;
-				charOutlines[i] = makeContoursForCharacter( face.get() );
-				charOutlinesContour[i] = charOutlines[i];
-				charOutlinesContour[i].setFilled(false);
-				charOutlinesContour[i].setStrokeWidth(1);
-
-				charOutlinesNonVFlipped[i] = charOutlines[i];
-				charOutlinesNonVFlipped[i].translate({0,cps[i].height,0.f});
-				charOutlinesNonVFlipped[i].scale(1,-1);
-				charOutlinesNonVFlippedContour[i] = charOutlines[i];
-				charOutlinesNonVFlippedContour[i].setFilled(false);
-				charOutlinesNonVFlippedContour[i].setStrokeWidth(1);
-
-
-				if(settings.simplifyAmt>0){
-					charOutlines[i].simplify(settings.simplifyAmt);
-					charOutlinesNonVFlipped[i].simplify(settings.simplifyAmt);
-					charOutlinesContour[i].simplify(settings.simplifyAmt);
-					charOutlinesNonVFlippedContour[i].simplify(settings.simplifyAmt);
-				}
+				makeOutlines(i, makeContoursForCharacter( face.get() ), height);
 			}
 		}
 	}
 
+	if(settings.onDemand){
+		bLoadedOk = true;
+		return true;
+	}
+
 	vector<ofTrueTypeFont::glyphProps> sortedCopy = cps;
 	sort(sortedCopy.begin(),sortedCopy.end(),[](const ofTrueTypeFont::glyphProps & c1, const ofTrueTypeFont::glyphProps & c2){
 		if(c1.tH == c2.tH) return c1.tW > c2.tW;
@@ -860,23 +1249,266 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 		x+= glyph.tW + border*2;
 	}
 
-	int maxSize;
-	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
-	if(w > maxSize || h > maxSize){
-		ofLogError("ofTruetypeFont") << "Trying to allocate texture of " << w << "x" << h << " which is bigger than supported in current platform: " << maxSize;
+	if(!uploadAtlas(texAtlas, atlasPixelsLuminanceAlpha, settings)){
 		return false;
+	}
+	if(!cachePath.empty()){
+		saveCache(cachePath, cacheKey, atlasPixelsLuminanceAlpha);
+	}
+	bLoadedOk = true;
+	return true;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::loadFace() const{
+	if(face){
+		return true;
+	}
+	if(!initLibraries()){
+		return false;
+	}
+	FT_Face loadFace;
+	if(!loadFontFace(settings.fontName, faceIndex, loadFace)){
+		return false;
+	}
+	face = std::shared_ptr<struct FT_FaceRec_>(loadFace,FT_Done_Face);
+	FT_Set_Char_Size( face.get(), settings.fontSize << 6, settings.fontSize << 6, settings.dpi, settings.dpi);
+	return true;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::makeOutlines(size_t i, const ofPath & outline, long height){
+	charOutlines[i] = outline;
+	charOutlinesContour[i] = charOutlines[i];
+	charOutlinesContour[i].setFilled(false);
+	charOutlinesContour[i].setStrokeWidth(1);
+
+	charOutlinesNonVFlipped[i] = charOutlines[i];
+	charOutlinesNonVFlipped[i].translate({0,height,0.f});
+	charOutlinesNonVFlipped[i].scale(1,-1);
+	charOutlinesNonVFlippedContour[i] = charOutlines[i];
+	charOutlinesNonVFlippedContour[i].setFilled(false);
+	charOutlinesNonVFlippedContour[i].setStrokeWidth(1);
+
+
+	if(settings.simplifyAmt>0){
+		charOutlines[i].simplify(settings.simplifyAmt);
+		charOutlinesNonVFlipped[i].simplify(settings.simplifyAmt);
+		charOutlinesContour[i].simplify(settings.simplifyAmt);
+		charOutlinesNonVFlippedContour[i].simplify(settings.simplifyAmt);
+	}
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::loadCache(const std::filesystem::path & cachePath, const std::string & key){
+	if(!ofFile::doesFileExist(cachePath, false)){
+		return false;
+	}
+	ofMemoryMappedFile cache(cachePath);
+	if(!cache.isOpen()){
+		return false;
+	}
+
+	fontCacheReader reader{cache.getData(), cache.size()};
+	auto magic = reader.skip(sizeof(fontCacheMagic));
+	auto keySize = reader.read<uint32_t>();
+	auto cachedKey = reader.skip(keySize);
+	if(!reader.valid || memcmp(magic, fontCacheMagic, sizeof(fontCacheMagic)) != 0 || std::string(cachedKey, keySize) != key){
+		ofLogWarning("ofTrueTypeFont") << "loadCache(): " << cachePath << " is not a cache for this font, loading it again";
+		return false;
+	}
+
+	auto cachedLineHeight = reader.read<float>();
+	auto cachedAscenderHeight = reader.read<float>();
+	auto cachedDescenderHeight = reader.read<float>();
+	auto cachedFontUnitScale = reader.read<float>();
+	ofRectangle cachedBBox;
+	cachedBBox.x = reader.read<float>();
+	cachedBBox.y = reader.read<float>();
+	cachedBBox.width = reader.read<float>();
+	cachedBBox.height = reader.read<float>();
+
+	auto nGlyphs = reader.read<uint32_t>();
+	auto expectedGlyphs = std::accumulate(settings.ranges.begin(), settings.ranges.end(), 0u,
+			[](uint32_t acc, ofUnicode::range range){
+				return acc + range.getNumGlyphs();
+			});
+	vector<glyphProps> cachedProps;
+	auto props = reader.skip(size_t(nGlyphs) * sizeof(glyphProps));
+	if(props && nGlyphs == expectedGlyphs){
+		cachedProps.resize(nGlyphs);
+		memcpy(cachedProps.data(), props, nGlyphs * sizeof(glyphProps));
 	}else{
-		texAtlas.allocate(atlasPixelsLuminanceAlpha,false);
-		texAtlas.setRGToRGBASwizzles(true);
+		reader.valid = false;
+	}
 
-		if(settings.antialiased && settings.fontSize>20){
-			texAtlas.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
-		}else{
-			texAtlas.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+	auto cachedKerning = reader.read<uint8_t>() != 0;
+	auto numPairs = reader.read<uint32_t>();
+	std::unordered_map<uint64_t,int> cachedPairs;
+	for(uint32_t i = 0; i < numPairs && reader.valid; i++){
+		auto pair = reader.read<uint64_t>();
+		cachedPairs[pair] = reader.read<int32_t>();
+	}
+
+	vector<ofPath> outlines;
+	if(settings.contours){
+		outlines.reserve(cachedProps.size());
+		for(uint32_t i = 0; i < nGlyphs && reader.valid; i++){
+			outlines.emplace_back();
+			auto & outline = outlines.back();
+			outline.setUseShapeColor(false);
+			outline.setPolyWindingMode(OF_POLY_WINDING_NONZERO);
+			auto numCommands = reader.read<uint32_t>();
+			for(uint32_t j = 0; j < numCommands && reader.valid; j++){
+				auto type = reader.read<uint8_t>();
+				glm::vec3 to, cp1, cp2;
+				for(auto p: {&to, &cp1, &cp2}){
+					p->x = reader.read<float>();
+					p->y = reader.read<float>();
+					p->z = reader.read<float>();
+				}
+				switch(type){
+				case ofPath::Command::moveTo: outline.moveTo(to); break;
+				case ofPath::Command::lineTo: outline.lineTo(to); break;
+				case ofPath::Command::bezierTo: outline.bezierTo(cp1, cp2, to); break;
+				case ofPath::Command::quadBezierTo: outline.quadBezierTo(cp1, cp2, to); break;
+				case ofPath::Command::close: outline.close(); break;
+				default: break;
+				}
+			}
 		}
-		texAtlas.loadData(atlasPixelsLuminanceAlpha);
-		bLoadedOk = true;
-		return true;
+	}
+
+	auto w = reader.read<uint32_t>();
+	auto h = reader.read<uint32_t>();
+	reader.align(16);
+	auto pixels = reader.skip(size_t(w) * h * 2);
+	if(!reader.valid || w == 0 || h == 0){
+		ofLogWarning("ofTrueTypeFont") << "loadCache(): " << cachePath << " is truncated, loading the font again";
+		return false;
+	}
+
+	// the pixels are uploaded straight from the mapped file
+	ofPixels atlasPixels;
+	atlasPixels.setFromExternalPixels(const_cast<unsigned char*>(reinterpret_cast<const unsigned char*>(pixels)), w, h, OF_PIXELS_GRAY_ALPHA);
+	if(!uploadAtlas(texAtlas, atlasPixels, settings)){
+		return false;
+	}
+
+	lineHeight = cachedLineHeight;
+	ascenderHeight = cachedAscenderHeight;
+	descenderHeight = cachedDescenderHeight;
+	fontUnitScale = cachedFontUnitScale;
+	glyphBBox = cachedBBox;
+	cps = std::move(cachedProps);
+	kerningCached = cachedKerning;
+	kerningPairs = std::move(cachedPairs);
+	atlas.reset();
+
+	glyphIndexMap.clear();
+	glyphIndexMap.reserve(nGlyphs);
+	auto i = 0u;
+	for(auto & range: settings.ranges){
+		for(uint32_t g = range.begin; g <= range.end; g++, i++){
+			glyphIndexMap[g] = i;
+		}
+	}
+
+	if(settings.contours){
+		charOutlines.resize(nGlyphs);
+		charOutlinesNonVFlipped.resize(nGlyphs);
+		charOutlinesContour.resize(nGlyphs);
+		charOutlinesNonVFlippedContour.resize(nGlyphs);
+		for(size_t i = 0; i < nGlyphs; i++){
+			makeOutlines(i, outlines[i], cps[i].height);
+		}
+	}else{
+		charOutlines.resize(1);
+	}
+	return true;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::saveCache(const std::filesystem::path & cachePath, const std::string & key, const ofPixels & atlasPixels){
+	// kerning of every pair of glyphs, only for fonts with few of them
+	if(!FT_HAS_KERNING( face )){
+		kerningCached = true;
+	}else if(cps.size() <= maxCachedKerningGlyphs){
+		vector<std::pair<uint32_t, FT_UInt>> glyphs;
+		for(auto & range: settings.ranges){
+			for(uint32_t g = range.begin; g <= range.end; g++){
+				glyphs.emplace_back(g, FT_Get_Char_Index(face.get(), g));
+			}
+		}
+		for(auto & left: glyphs){
+			for(auto & right: glyphs){
+				FT_Vector kerning;
+				FT_Get_Kerning(face.get(), left.second, right.second, FT_KERNING_UNFITTED, &kerning);
+				if(kerning.x >> 6 != 0){
+					kerningPairs[uint64_t(left.first) << 32 | right.first] = kerning.x >> 6;
+				}
+			}
+		}
+		kerningCached = true;
+	}
+
+	ofDirectory::createDirectory(cachePath.parent_path(), false, true);
+	auto tmpPath = cachePath.string() + ".tmp";
+	std::ofstream file(tmpPath, std::ios::binary);
+	if(!file){
+		ofLogWarning("ofTrueTypeFont") << "saveCache(): couldn't write " << cachePath;
+		return;
+	}
+
+	fontCacheWriter writer{file};
+	writer.write(fontCacheMagic, sizeof(fontCacheMagic));
+	writer.write(uint32_t(key.size()));
+	writer.write(key.data(), key.size());
+
+	writer.write(lineHeight);
+	writer.write(ascenderHeight);
+	writer.write(descenderHeight);
+	writer.write(fontUnitScale);
+	writer.write(glyphBBox.x);
+	writer.write(glyphBBox.y);
+	writer.write(glyphBBox.width);
+	writer.write(glyphBBox.height);
+
+	writer.write(uint32_t(cps.size()));
+	writer.write(cps.data(), cps.size() * sizeof(glyphProps));
+
+	writer.write(uint8_t(kerningCached));
+	writer.write(uint32_t(kerningPairs.size()));
+	for(auto & pair: kerningPairs){
+		writer.write(pair.first);
+		writer.write(int32_t(pair.second));
+	}
+
+	if(settings.contours){
+		for(size_t i = 0; i < cps.size(); i++){
+			// the outlines before being simplified
+			auto & commands = charOutlines[i].getCommands();
+			writer.write(uint32_t(commands.size()));
+			for(auto & command: commands){
+				writer.write(uint8_t(command.type));
+				for(auto & p: {command.to, command.cp1, command.cp2}){
+					writer.write(p.x);
+					writer.write(p.y);
+					writer.write(p.z);
+				}
+			}
+		}
+	}
+
+	writer.write(uint32_t(atlasPixels.getWidth()));
+	writer.write(uint32_t(atlasPixels.getHeight()));
+	writer.align(16);
+	writer.write(atlasPixels.getData(), atlasPixels.getTotalBytes());
+	file.close();
+
+	if(!file || !ofFile::moveFromTo(tmpPath, cachePath, false, true)){
+		ofLogWarning("ofTrueTypeFont") << "saveCache(): couldn't write " << cachePath;
+		ofFile::removeFile(tmpPath, false);
 	}
 }
 
@@ -903,6 +1535,7 @@ int ofTrueTypeFont::getSize() const{
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLineHeight(float _newLineHeight) {
 	lineHeight = _newLineHeight;
+	clearLayoutCache();
 }
 
 //-----------------------------------------------------------
@@ -928,6 +1561,7 @@ const ofRectangle & ofTrueTypeFont::getGlyphBBox() const {
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLetterSpacing(float _newletterSpacing) {
 	letterSpacing = _newletterSpacing;
+	clearLayoutCache();
 }
 
 //-----------------------------------------------------------
@@ -938,6 +1572,7 @@ float ofTrueTypeFont::getLetterSpacing() const{
 //-----------------------------------------------------------
 void ofTrueTypeFont::setSpaceSize(float _newspaceSize) {
 	spaceSize = _newspaceSize;
+	clearLayoutCache();
 }
 
 //-----------------------------------------------------------
@@ -971,58 +1606,29 @@ ofPath ofTrueTypeFont::getCharacterAsPoints(uint32_t character, bool vflip, bool
 }
 
 //-----------------------------------------------------------
-void ofTrueTypeFont::drawChar(uint32_t c, float x, float y, bool vFlipped) const{
-
-	if (!isValidGlyph(c)){
-		//ofLogError("ofTrueTypeFont") << "drawChar(): char " << c + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
-		return;
+void ofTrueTypeFont::loadGlyphsOnDemand(const std::string & str) const{
+	bool full = false;
+	try{
+		for(auto c: ofUTF8Iterator(str)){
+			if(c != '\n' && isValidGlyph(c)){
+				full |= !atlas->use(*this, c);
+			}
+		}
+	}catch(...){
 	}
-
-
-	long xmin, ymin, xmax, ymax;
-	float t1, v1, t2, v2;
-	auto props = getGlyphProperties(c);
-	t1		= props.t1;
-	t2		= props.t2;
-	v2		= props.v2;
-	v1		= props.v1;
-
-	xmin		= long(props.xmin+x);
-	ymin		= props.ymin;
-	xmax		= long(props.xmax+x);
-	ymax		= props.ymax;
-
-	if(!vFlipped){
-	   ymin *= -1;
-	   ymax *= -1;
+	if(full){
+		ofLogWarning("ofTrueTypeFont") << "loadGlyphsOnDemand(): atlas full, some glyphs won't be drawn, "
+			<< "increase maxAtlasPages or atlasPageSize to draw more different glyphs at once";
 	}
-
-	ymin += y;
-	ymax += y;
-
-	ofIndexType firstIndex = stringQuads.getVertices().size();
-
-	stringQuads.addVertex(glm::vec3(xmin,ymin,0.f));
-	stringQuads.addVertex(glm::vec3(xmax,ymin,0.f));
-	stringQuads.addVertex(glm::vec3(xmax,ymax,0.f));
-	stringQuads.addVertex(glm::vec3(xmin,ymax,0.f));
-
-	stringQuads.addTexCoord(glm::vec2(t1,v1));
-	stringQuads.addTexCoord(glm::vec2(t2,v1));
-	stringQuads.addTexCoord(glm::vec2(t2,v2));
-	stringQuads.addTexCoord(glm::vec2(t1,v2));
-
-	stringQuads.addIndex(firstIndex);
-	stringQuads.addIndex(firstIndex+1);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+3);
-	stringQuads.addIndex(firstIndex);
 }
 
 //-----------------------------------------------------------
 int ofTrueTypeFont::getKerning(uint32_t leftC, uint32_t rightC) const{
-	if(FT_HAS_KERNING( face )){
+	if(kerningCached){
+		auto kerning = kerningPairs.find(uint64_t(leftC) << 32 | rightC);
+		return kerning == kerningPairs.end() ? 0 : kerning->second;
+	}
+	if(loadFace() && FT_HAS_KERNING( face )){
 		FT_Vector kerning;
 		FT_Get_Kerning(face.get(), FT_Get_Char_Index(face.get(), leftC), FT_Get_Char_Index(face.get(), rightC), FT_KERNING_UNFITTED, &kerning);
 		return kerning.x >> 6;
@@ -1093,6 +1699,7 @@ void ofTrueTypeFont::iterateString(const string & str, float x, float y, bool vF
 //-----------------------------------------------------------
 void ofTrueTypeFont::setDirection(ofTrueTypeFontDirection direction){
 	settings.direction = direction;
+	clearLayoutCache();
 }
 
 //-----------------------------------------------------------
@@ -1125,6 +1732,9 @@ size_t ofTrueTypeFont::indexForGlyph(uint32_t glyph) const{
 
 const ofTrueTypeFont::glyphProps & ofTrueTypeFont::getGlyphProperties(uint32_t glyph) const{
 	if(isValidGlyph(glyph)){
+		if(atlas){
+			return atlas->get(*this, glyph).props;
+		}
 		return cps[indexForGlyph(glyph)];
 	}else{
 		return invalidProps;
@@ -1204,21 +1814,198 @@ float ofTrueTypeFont::stringHeight(const std::string& c) const{
 }
 
 //-----------------------------------------------------------
-void ofTrueTypeFont::createStringMesh(const std::string& str, float x, float y, bool vflip) const{
-	iterateString(str,x,y,vflip,[&](uint32_t c, glm::vec2 pos){
-		drawChar(c, pos.x, pos.y, vflip);
+const vector<ofTrueTypeFont::glyphQuad> & ofTrueTypeFont::getStringLayout(const std::string& str, bool vflip, bool newBatch) const{
+	if(atlas && newBatch){
+		atlas->generation++;
+	}
+
+	auto & cache = layouts[vflip];
+	auto cached = cache.find(str);
+	if(cached != cache.end() && (!atlas || cached->second.atlasVersion == atlas->version)){
+		auto & layout = cached->second;
+		if(atlas){
+			// every glyph is still resident, keep them from being evicted
+			for(auto & quad: layout.quads){
+				atlas->touch(atlas->glyphs[quad.characterIndex]);
+			}
+		}
+		layoutsLRU.splice(layoutsLRU.begin(), layoutsLRU, layout.lru);
+		return layout.quads;
+	}
+
+	if(atlas){
+		loadGlyphsOnDemand(str);
+	}
+	bool complete = true;
+	uncachedLayout.clear();
+	iterateString(str,0,0,vflip,[&](uint32_t c, glm::vec2 pos){
+		if(!isValidGlyph(c)){
+			return;
+		}
+		glyphQuad quad;
+		if(!getGlyphQuad(c, pos, vflip, quad)){
+			complete = false;
+			return;
+		}
+		uncachedLayout.push_back(quad);
 	});
+	if(!complete || layoutCacheSize == 0){
+		return uncachedLayout;
+	}
+
+	if(cached == cache.end()){
+		if(layoutsLRU.size() >= layoutCacheSize){
+			auto & oldest = layoutsLRU.back();
+			auto & oldestCache = layouts[oldest.first];
+			oldestCache.erase(oldestCache.find(*oldest.second));
+			layoutsLRU.pop_back();
+		}
+		cached = cache.emplace(str, stringLayout()).first;
+		layoutsLRU.emplace_front(vflip, &cached->first);
+		cached->second.lru = layoutsLRU.begin();
+	}else{
+		layoutsLRU.splice(layoutsLRU.begin(), layoutsLRU, cached->second.lru);
+	}
+	auto & layout = cached->second;
+	layout.quads.swap(uncachedLayout);
+	layout.atlasVersion = atlas ? atlas->version : 0;
+	return layout.quads;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::appendStringMeshes(vector<ofMesh> & meshes, const std::string& str, float x, float y, bool vflip) const{
+	bool newBatch = std::all_of(meshes.begin(), meshes.end(), [](const ofMesh & mesh){
+		return mesh.getNumVertices() == 0;
+	});
+	const auto & quads = getStringLayout(str, vflip, newBatch);
+	auto numPages = std::max(getNumAtlasPages(), size_t(1));
+	while(meshes.size() < numPages){
+		meshes.emplace_back();
+		meshes.back().setMode(OF_PRIMITIVE_TRIANGLES);
+	}
+
+	for(auto & quad: quads){
+		appendGlyphQuad(meshes[quad.page], quad, x, y);
+	}
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::getGlyphQuad(uint32_t c, glm::vec2 pos, bool vflip, glyphQuad & quad) const{
+	quad.page = 0;
+	quad.characterIndex = indexForGlyph(c);
+	if(atlas){
+		// glyphs that didn't fit in the atlas aren't drawn
+		auto & entry = atlas->get(*this, c);
+		if(!entry.resident){
+			return false;
+		}
+		quad.page = entry.page;
+	}
+	const auto & props = getGlyphProperties(c);
+	// the position of the string is added before rounding to
+	// whole pixels, in appendGlyphQuad
+	quad.xmin = props.xmin + pos.x;
+	quad.xmax = props.xmax + pos.x;
+	quad.ymin = (vflip ? props.ymin : -props.ymin) + pos.y;
+	quad.ymax = (vflip ? props.ymax : -props.ymax) + pos.y;
+	quad.t1 = props.t1;
+	quad.v1 = props.v1;
+	quad.t2 = props.t2;
+	quad.v2 = props.v2;
+	return true;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::appendGlyphQuad(ofMesh & mesh, const glyphQuad & quad, float x, float y){
+	float xmin = long(quad.xmin + x);
+	float xmax = long(quad.xmax + x);
+	float ymin = long(quad.ymin + y);
+	float ymax = long(quad.ymax + y);
+
+	ofIndexType firstIndex = mesh.getNumVertices();
+
+	mesh.addVertex(glm::vec3(xmin,ymin,0.f));
+	mesh.addVertex(glm::vec3(xmax,ymin,0.f));
+	mesh.addVertex(glm::vec3(xmax,ymax,0.f));
+	mesh.addVertex(glm::vec3(xmin,ymax,0.f));
+
+	mesh.addTexCoord(glm::vec2(quad.t1,quad.v1));
+	mesh.addTexCoord(glm::vec2(quad.t2,quad.v1));
+	mesh.addTexCoord(glm::vec2(quad.t2,quad.v2));
+	mesh.addTexCoord(glm::vec2(quad.t1,quad.v2));
+
+	mesh.addIndex(firstIndex);
+	mesh.addIndex(firstIndex+1);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+3);
+	mesh.addIndex(firstIndex);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::drawChar(uint32_t c, float x, float y, bool vFlipped) const{
+	if(!isValidGlyph(c)){
+		return;
+	}
+	// glyphs that don't fit in the atlas aren't drawn
+	if(atlas && !atlas->use(*this, c)){
+		return;
+	}
+	glyphQuad quad;
+	if(!getGlyphQuad(c, {0.f, 0.f}, vFlipped, quad)){
+		return;
+	}
+	while(pageQuads.size() <= quad.page){
+		pageQuads.emplace_back();
+		pageQuads.back().setMode(OF_PRIMITIVE_TRIANGLES);
+	}
+	appendGlyphQuad(pageQuads[quad.page], quad, x, y);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::createStringMesh(const std::string& str, float x, float y, bool vflip) const{
+	for(auto & quads: pageQuads){
+		quads.clear();
+	}
+	appendStringMeshes(pageQuads, str, x, y, vflip);
 }
 
 //-----------------------------------------------------------
 const ofMesh & ofTrueTypeFont::getStringMesh(const std::string& c, float x, float y, bool vFlipped) const{
-	stringQuads.clear();
 	createStringMesh(c,x,y,vFlipped);
-	return stringQuads;
+	// the mesh is drawn with getFontTexture, glyphs in other pages can't
+	// be drawn with it
+	auto used = std::count_if(pageQuads.begin() + 1, pageQuads.end(), [](const ofMesh & quads){
+		return quads.getNumVertices() > 0;
+	});
+	if(used > 0){
+		ofLogWarning("ofTrueTypeFont") << "getStringMesh(): \"" << c << "\" uses more than one atlas page, "
+			<< "only the glyphs in the font texture are returned, use getStringMeshes instead";
+	}
+	return pageQuads[0];
+}
+
+//-----------------------------------------------------------
+const vector<ofMesh> & ofTrueTypeFont::getStringMeshes(const std::string& c, float x, float y, bool vFlipped) const{
+	createStringMesh(c,x,y,vFlipped);
+	return pageQuads;
 }
 
 //-----------------------------------------------------------
 const ofTexture & ofTrueTypeFont::getFontTexture() const{
+	return getAtlasPage(0);
+}
+
+//-----------------------------------------------------------
+size_t ofTrueTypeFont::getNumAtlasPages() const{
+	return atlas ? atlas->pages.size() : 1;
+}
+
+//-----------------------------------------------------------
+const ofTexture & ofTrueTypeFont::getAtlasPage(size_t page) const{
+	if(atlas && page < atlas->pages.size()){
+		return atlas->pages[page];
+	}
 	return texAtlas;
 }
 
@@ -1352,5 +2139,31 @@ void ofTrueTypeFont::drawStringAsShapes(const std::string& str, float x, float y
 
 //-----------------------------------------------------------
 std::size_t ofTrueTypeFont::getNumCharacters() const{
+	if(atlas){
+		return atlas->numGlyphs;
+	}
 	return cps.size();
 }
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::setLayoutCacheSize(size_t numStrings){
+	layoutCacheSize = numStrings;
+	while(layoutsLRU.size() > layoutCacheSize){
+		auto & oldest = layoutsLRU.back();
+		auto & cache = layouts[oldest.first];
+		cache.erase(cache.find(*oldest.second));
+		layoutsLRU.pop_back();
+	}
+}
+
+//-----------------------------------------------------------
+size_t ofTrueTypeFont::getLayoutCacheSize() const{
+	return layoutCacheSize;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::clearLayoutCache(){
+	layouts[0].clear();
+	layouts[1].clear();
+	layoutsLRU.clear();
+}
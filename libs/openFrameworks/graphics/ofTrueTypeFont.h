@@ -2,6 +2,7 @@
 
 #include "ofConstants.h"
 #include <unordered_map>
+#include <list>
 #include "ofRectangle.h"
 #include "ofPath.h"
 #include "ofTexture.h"
@@ -134,6 +135,22 @@ struct ofTrueTypeFontSettings{
     ofTrueTypeFontDirection direction = OF_TTF_LEFT_TO_RIGHT;
     std::vector<ofUnicode::range> ranges;
 
+    /// rasterize each glyph the first time it's drawn instead of every glyph
+    /// in ranges on load, useful for big ranges like ofUnicode::CJKUnified.
+    /// contours are still created for every glyph on load, from their
+    /// outlines without rasterizing them
+    bool                      onDemand = false;
+    /// width and height of each atlas texture when loading glyphs on demand
+    int                       atlasPageSize = 1024;
+    /// once every page is full the least recently drawn glyphs are evicted
+    size_t                    maxAtlasPages = 4;
+
+    /// folder to cache the rasterized atlas, metrics and contours in, the
+    /// first load writes a file that later loads of the same font file with
+    /// the same settings read instead of using freetype. empty disables the
+    /// cache, fonts loading glyphs on demand aren't cached
+    std::filesystem::path     cacheFolder;
+
     ofTrueTypeFontSettings(const std::filesystem::path & name, int size)
     :fontName(name)
     ,fontSize(size){}
@@ -227,6 +244,16 @@ public:
 	/// \returns Number of characters in loaded character set.
 	std::size_t	getNumCharacters() const;
 
+	/// \brief Set how many strings keep their layout.
+	///
+	/// Drawing a string decodes it and looks up the kerning of every pair
+	/// of glyphs. The quads of the most recently drawn strings are kept
+	/// so drawing them again only moves them to the new position.
+	///
+	/// \param numStrings Strings to keep, 1024 by default, 0 disables the cache.
+	void setLayoutCacheSize(std::size_t numStrings);
+	std::size_t getLayoutCacheSize() const;
+
 	/// \}
 	/// \name Font Size
 	/// \{
@@ -355,6 +382,27 @@ public:
 	std::vector<ofPath> getStringAsPoints(const std::string &  str, bool vflip=true, bool filled=true) const;
 	const ofMesh & getStringMesh(const std::string &  s, float x, float y, bool vflip=true) const;
 	const ofTexture & getFontTexture() const;
+
+	/// \brief Get the meshes to draw a string with each atlas page.
+	///
+	/// Fonts loading glyphs on demand spread them over several atlas
+	/// textures, the mesh at each index has to be drawn with the texture
+	/// returned by getAtlasPage for the same index. Fonts loading every
+	/// glyph on load have a single page, the font texture.
+	///
+	/// \returns one mesh per page, empty for pages the string doesn't use
+	const std::vector<ofMesh> & getStringMeshes(const std::string & s, float x, float y, bool vflip=true) const;
+	std::size_t getNumAtlasPages() const;
+	const ofTexture & getAtlasPage(std::size_t page) const;
+
+	/// \brief Append the quads of a string to the meshes of each atlas page.
+	///
+	/// Appending many strings and drawing each mesh with getAtlasPage draws
+	/// all of them with one draw call per page instead of one per string.
+	/// Fonts loading glyphs on demand keep every glyph appended since the
+	/// meshes were cleared in the atlas.
+	void appendStringMeshes(std::vector<ofMesh> & meshes, const std::string & s, float x, float y, bool vflip=true) const;
+
 	ofTexture getStringTexture(const std::string &  s, bool vflip=true) const;
 	glm::vec2 getFirstGlyphPosForTexture(const std::string & str, bool vflip) const;
 	bool isValidGlyph(uint32_t) const;
@@ -400,20 +448,52 @@ protected:
 
 	std::vector<glyphProps> cps; // properties for each character
 
+	// pages and glyphs loaded on demand, shared by copies of the font
+	struct glyphAtlas;
+	std::shared_ptr<glyphAtlas> atlas;
+
 	ofTrueTypeFontSettings settings;
 	std::unordered_map<uint32_t,size_t> glyphIndexMap;
 
 	int getKerning(uint32_t leftC, uint32_t rightC) const;
-	void drawChar(uint32_t c, float x, float y, bool vFlipped) const;
+	/// appends the quad of a glyph at x, y to the mesh of its page in
+	/// pageQuads, which createStringMesh clears
+	OF_DEPRECATED_MSG("Use appendStringMeshes instead", void drawChar(uint32_t c, float x, float y, bool vFlipped) const);
+	void loadGlyphsOnDemand(const std::string & s) const;
 	void drawCharAsShape(uint32_t c, float x, float y, bool vFlipped, bool filled) const;
 	void createStringMesh(const std::string & s, float x, float y, bool vFlipped) const;
+	bool loadGlyphOutline(uint32_t utf8) const;
 	glyph loadGlyph(uint32_t utf8) const;
 	const glyphProps & getGlyphProperties(uint32_t glyph) const;
 	void iterateString(const std::string & str, float x, float y, bool vFlipped, std::function<void(uint32_t, glm::vec2)> f) const;
 	size_t indexForGlyph(uint32_t glyph) const;
 
+	// quad of a glyph in a string laid out at 0,0
+	struct glyphQuad{
+		float xmin, xmax, ymin, ymax;
+		float t1, v1, t2, v2;
+		std::size_t page;
+		std::size_t characterIndex;
+	};
+
+	struct stringLayout{
+		std::vector<glyphQuad> quads;
+		uint64_t atlasVersion; // quads of fonts loading glyphs on demand are stale once a glyph is evicted
+		std::list<std::pair<bool, const std::string*>>::iterator lru;
+	};
+
+	const std::vector<glyphQuad> & getStringLayout(const std::string & s, bool vFlipped, bool newBatch) const;
+	// false if the glyph isn't resident in the atlas
+	bool getGlyphQuad(uint32_t c, glm::vec2 pos, bool vFlipped, glyphQuad & quad) const;
+	static void appendGlyphQuad(ofMesh & mesh, const glyphQuad & quad, float x, float y);
+	void clearLayoutCache();
+
 	ofTexture texAtlas;
-	mutable ofMesh stringQuads;
+	mutable std::vector<ofMesh> pageQuads;
+	mutable std::unordered_map<std::string, stringLayout> layouts[2]; // by vflip
+	mutable std::list<std::pair<bool, const std::string*>> layoutsLRU; // most recently drawn first
+	mutable std::vector<glyphQuad> uncachedLayout;
+	std::size_t layoutCacheSize;
 
 	/// \endcond
 
@@ -422,8 +502,18 @@ private:
 	friend void ofUnloadAllFontTextures();
 	friend void ofReloadAllFontTextures();
 #endif
-	std::shared_ptr<struct FT_FaceRec_>	face;
+	// fonts loaded from the cache only open the face when they need it
+	mutable std::shared_ptr<struct FT_FaceRec_>	face;
+	int faceIndex;
+	// kerning loaded from the cache, by left << 32 | right glyph. only pairs
+	// of fonts with few glyphs are cached, others use the face
+	bool kerningCached;
+	std::unordered_map<uint64_t,int> kerningPairs;
 	static const glyphProps invalidProps;
+	bool		loadFace() const;
+	void		makeOutlines(std::size_t index, const ofPath & outline, long height);
+	bool		loadCache(const std::filesystem::path & cachePath, const std::string & key);
+	void		saveCache(const std::filesystem::path & cachePath, const std::string & key, const ofPixels & atlasPixels);
 	void		unloadTextures();
 	void		reloadTextures();
 	static bool	initLibraries();
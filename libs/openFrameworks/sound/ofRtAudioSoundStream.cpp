@@ -278,36 +278,41 @@ int ofRtAudioSoundStream::rtAudioCallback(void *outputBuffer, void *inputBuffer,
 	// 	we choose float
 	float * fPtrOut = (float *)outputBuffer;
 	float * fPtrIn = (float *)inputBuffer;
-	// [zach] memset output to zero before output call
-	// this is because of how rtAudio works: duplex w/ one callback
-	// you need to cut in the middle. if the simpleApp
-	// doesn't produce audio, we pass silence instead of duplex...
+	// the sound buffers wrap rtAudio's memory so the callbacks read
+	// and write it in place instead of copying every block
 
 	size_t nInputChannels  = rtStreamPtr->getNumInputChannels();
 	size_t nOutputChannels = rtStreamPtr->getNumOutputChannels();
 
 	if (nInputChannels > 0) {
 		if (rtStreamPtr->settings.inCallback) {
-			rtStreamPtr->inputBuffer.copyFrom(fPtrIn, nFramesPerBuffer, nInputChannels, rtStreamPtr->getSampleRate());
+			rtStreamPtr->inputBuffer.setFromExternalBuffer(fPtrIn, nFramesPerBuffer, nInputChannels, rtStreamPtr->getSampleRate());
 			rtStreamPtr->inputBuffer.setTickCount(rtStreamPtr->tickCount);
 			rtStreamPtr->settings.inCallback(rtStreamPtr->inputBuffer);
+			// stop wrapping the input, it's only valid during the callback
+			rtStreamPtr->inputBuffer.clear();
 		}
 		// [damian] not sure what this is for? assuming it's for underruns? or for when the sound system becomes broken?
 		memset(fPtrIn, 0, nFramesPerBuffer * nInputChannels * sizeof(float));
 	}
 
 	if (nOutputChannels > 0) {
+		// [zach] memset output to zero before output call
+		// this is because of how rtAudio works: duplex w/ one callback
+		// you need to cut in the middle. if the simpleApp
+		// doesn't produce audio, we pass silence instead of duplex...
+		memset(fPtrOut, 0, nFramesPerBuffer * nOutputChannels * sizeof(float));
 		if (rtStreamPtr->settings.outCallback) {
-
-			if (rtStreamPtr->outputBuffer.size() != nFramesPerBuffer*nOutputChannels || rtStreamPtr->outputBuffer.getNumChannels() != nOutputChannels) {
-				rtStreamPtr->outputBuffer.setNumChannels(nOutputChannels);
-				rtStreamPtr->outputBuffer.resize(nFramesPerBuffer*nOutputChannels);
-			}
+			rtStreamPtr->outputBuffer.setFromExternalBuffer(fPtrOut, nFramesPerBuffer, nOutputChannels, rtStreamPtr->getSampleRate());
 			rtStreamPtr->outputBuffer.setTickCount(rtStreamPtr->tickCount);
 			rtStreamPtr->settings.outCallback(rtStreamPtr->outputBuffer);
+			if (rtStreamPtr->outputBuffer.isBufferOwner()) {
+				// the callback resized the buffer or asked for its vector
+				// so the samples were copied out of rtAudio's memory
+				rtStreamPtr->outputBuffer.copyTo(fPtrOut, nFramesPerBuffer, nOutputChannels, 0);
+			}
+			rtStreamPtr->outputBuffer.clear();
 		}
-		rtStreamPtr->outputBuffer.copyTo(fPtrOut, nFramesPerBuffer, nOutputChannels, 0);
-		rtStreamPtr->outputBuffer.set(0);
 	}
 
 	// increment tick count
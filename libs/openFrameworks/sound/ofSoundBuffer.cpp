@@ -10,9 +10,221 @@
 #include "ofLog.h"
 #include <limits>
 #include "glm/trigonometric.hpp"
+#include <atomic>
 
 using namespace std;
 
+//----------------------------------------------------------------------
+// SIMD kernels
+//
+// SSE2 is always available on x86_64 and NEON is used when compiling for
+// ARM with NEON enabled. each kernel returns how many samples it processed
+// and the scalar code does the rest. they do the same float operations as
+// the scalar code so the results are the same, except for the RMS which
+// adds the squares in a different order
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define OF_SOUND_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define OF_SOUND_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace{
+	std::atomic<bool> useSIMD{true};
+
+	bool simdEnabled(){
+#if defined(OF_SOUND_SSE2) || defined(OF_SOUND_NEON)
+		return useSIMD;
+#else
+		return false;
+#endif
+	}
+
+	// samples[i] *= gain
+	size_t scaleSIMD(float * samples, size_t size, float gain){
+		size_t i = 0;
+#if defined(OF_SOUND_SSE2)
+		const __m128 g = _mm_set1_ps(gain);
+		for(; i + 4 <= size; i += 4){
+			_mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), g));
+		}
+#elif defined(OF_SOUND_NEON)
+		const float32x4_t g = vdupq_n_f32(gain);
+		for(; i + 4 <= size; i += 4){
+			vst1q_f32(samples + i, vmulq_f32(vld1q_f32(samples + i), g));
+		}
+#endif
+		return i;
+	}
+
+	// multiplies the left samples of interleaved stereo by left and the right ones by right
+	size_t stereoPanSIMD(float * samples, size_t numFrames, float left, float right){
+		size_t i = 0;
+#if defined(OF_SOUND_SSE2)
+		const __m128 g = _mm_setr_ps(left, right, left, right);
+		for(; i + 2 <= numFrames; i += 2){
+			_mm_storeu_ps(samples + i * 2, _mm_mul_ps(_mm_loadu_ps(samples + i * 2), g));
+		}
+#elif defined(OF_SOUND_NEON)
+		const float gains[4] = {left, right, left, right};
+		const float32x4_t g = vld1q_f32(gains);
+		for(; i + 2 <= numFrames; i += 2){
+			vst1q_f32(samples + i * 2, vmulq_f32(vld1q_f32(samples + i * 2), g));
+		}
+#endif
+		return i;
+	}
+
+	// dst[i] += src[i]
+	size_t addSIMD(float * dst, const float * src, size_t size){
+		size_t i = 0;
+#if defined(OF_SOUND_SSE2)
+		for(; i + 4 <= size; i += 4){
+			_mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+		}
+#elif defined(OF_SOUND_NEON)
+		for(; i + 4 <= size; i += 4){
+			vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+		}
+#endif
+		return i;
+	}
+
+	// acc[i] += src[i] * coefficient
+	size_t multiplyAddSIMD(float * acc, const float * src, float coefficient, size_t size){
+		size_t i = 0;
+#if defined(OF_SOUND_SSE2)
+		const __m128 c = _mm_set1_ps(coefficient);
+		for(; i + 4 <= size; i += 4){
+			_mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(_mm_loadu_ps(src + i), c)));
+		}
+#elif defined(OF_SOUND_NEON)
+		const float32x4_t c = vdupq_n_f32(coefficient);
+		for(; i + 4 <= size; i += 4){
+			vst1q_f32(acc + i, vaddq_f32(vld1q_f32(acc + i), vmulq_f32(vld1q_f32(src + i), c)));
+		}
+#endif
+		return i;
+	}
+
+	// writes or adds every mono sample of src to both channels of a stereo dst, returns frames
+	template<bool add>
+	size_t monoToStereoSIMD(float * dst, const float * src, size_t numFrames){
+		size_t i = 0;
+#if defined(OF_SOUND_SSE2)
+		for(; i + 4 <= numFrames; i += 4){
+			__m128 mono = _mm_loadu_ps(src + i);
+			__m128 lo = _mm_unpacklo_ps(mono, mono);
+			__m128 hi = _mm_unpackhi_ps(mono, mono);
+			if(add){
+				lo = _mm_add_ps(_mm_loadu_ps(dst + i * 2), lo);
+				hi = _mm_add_ps(_mm_loadu_ps(dst + i * 2 + 4), hi);
+			}
+			_mm_storeu_ps(dst + i * 2, lo);
+			_mm_storeu_ps(dst + i * 2 + 4, hi);
+		}
+#elif defined(OF_SOUND_NEON)
+		for(; i + 4 <= numFrames; i += 4){
+			float32x4_t mono = vld1q_f32(src + i);
+			float32x4x2_t stereo = vzipq_f32(mono, mono);
+			if(add){
+				stereo.val[0] = vaddq_f32(vld1q_f32(dst + i * 2), stereo.val[0]);
+				stereo.val[1] = vaddq_f32(vld1q_f32(dst + i * 2 + 4), stereo.val[1]);
+			}
+			vst1q_f32(dst + i * 2, stereo.val[0]);
+			vst1q_f32(dst + i * 2 + 4, stereo.val[1]);
+		}
+#endif
+		return i;
+	}
+
+	// dst[i] = src[i] * 32767, truncated and saturated to short
+	size_t toShortSIMD(const float * src, short * dst, size_t size){
+		size_t i = 0;
+#if defined(OF_SOUND_SSE2)
+		const __m128 scale = _mm_set1_ps(float(numeric_limits<short>::max()));
+		for(; i + 8 <= size; i += 8){
+			__m128i a = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i), scale));
+			__m128i b = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale));
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(a, b));
+		}
+#elif defined(OF_SOUND_NEON)
+		const float32x4_t scale = vdupq_n_f32(float(numeric_limits<short>::max()));
+		for(; i + 8 <= size; i += 8){
+			int32x4_t a = vcvtq_s32_f32(vmulq_f32(vld1q_f32(src + i), scale));
+			int32x4_t b = vcvtq_s32_f32(vmulq_f32(vld1q_f32(src + i + 4), scale));
+			vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+		}
+#endif
+		return i;
+	}
+
+	// dst[i] = src[i] / 32767
+	size_t fromShortSIMD(const short * src, float * dst, size_t size){
+		size_t i = 0;
+#if defined(OF_SOUND_SSE2)
+		const __m128 scale = _mm_set1_ps(float(numeric_limits<short>::max()));
+		for(; i + 8 <= size; i += 8){
+			__m128i shorts = _mm_loadu_si128((const __m128i*)(src + i));
+			// sign extend by unpacking into the high half and shifting down
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(shorts, shorts), 16);
+			_mm_storeu_ps(dst + i, _mm_div_ps(_mm_cvtepi32_ps(lo), scale));
+			_mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(hi), scale));
+		}
+#elif defined(OF_SOUND_NEON) && defined(__aarch64__)
+		// armv7 NEON has no division
+		const float32x4_t scale = vdupq_n_f32(float(numeric_limits<short>::max()));
+		for(; i + 8 <= size; i += 8){
+			int16x8_t shorts = vld1q_s16(src + i);
+			vst1q_f32(dst + i, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(shorts))), scale));
+			vst1q_f32(dst + i + 4, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(shorts))), scale));
+		}
+#endif
+		return i;
+	}
+
+	// adds the squares of the samples in double precision
+	size_t sumSquaresSIMD(const float * src, size_t size, double & acc){
+		size_t i = 0;
+#if defined(OF_SOUND_SSE2)
+		__m128d sum0 = _mm_setzero_pd();
+		__m128d sum1 = _mm_setzero_pd();
+		for(; i + 4 <= size; i += 4){
+			__m128 x = _mm_loadu_ps(src + i);
+			__m128 squares = _mm_mul_ps(x, x);
+			sum0 = _mm_add_pd(sum0, _mm_cvtps_pd(squares));
+			sum1 = _mm_add_pd(sum1, _mm_cvtps_pd(_mm_movehl_ps(squares, squares)));
+		}
+		double sums[2];
+		_mm_storeu_pd(sums, _mm_add_pd(sum0, sum1));
+		acc += sums[0] + sums[1];
+#elif defined(OF_SOUND_NEON) && defined(__aarch64__)
+		float64x2_t sum0 = vdupq_n_f64(0);
+		float64x2_t sum1 = vdupq_n_f64(0);
+		for(; i + 4 <= size; i += 4){
+			float32x4_t x = vld1q_f32(src + i);
+			float32x4_t squares = vmulq_f32(x, x);
+			sum0 = vaddq_f64(sum0, vcvt_f64_f32(vget_low_f32(squares)));
+			sum1 = vaddq_f64(sum1, vcvt_f64_f32(vget_high_f32(squares)));
+		}
+		acc += vaddvq_f64(vaddq_f64(sum0, sum1));
+#endif
+		return i;
+	}
+}
+
+//----------------------------------------------------------------------
+void ofSetSoundBufferUsingSIMD(bool simd){
+	useSIMD = simd;
+}
+
+//----------------------------------------------------------------------
+bool ofGetSoundBufferUsingSIMD(){
+	return simdEnabled();
+}
+
 #if !defined(TARGET_ANDROID) && !defined(TARGET_IPHONE) && !defined(TARGET_LINUX_ARM)
 ofSoundBuffer::InterpolationAlgorithm ofSoundBuffer::defaultAlgorithm = ofSoundBuffer::Hermite;
 #else
@@ -20,7 +232,9 @@ ofSoundBuffer::InterpolationAlgorithm ofSoundBuffer::defaultAlgorithm = ofSoundB
 #endif
 
 ofSoundBuffer::ofSoundBuffer()
-:channels(1)
+:externalBuffer(nullptr)
+,externalSize(0)
+,channels(1)
 ,samplerate(44100)
 ,tickCount(0)
 ,soundStreamDeviceID(0){
@@ -28,17 +242,87 @@ ofSoundBuffer::ofSoundBuffer()
 }
 
 ofSoundBuffer::ofSoundBuffer(short * shortBuffer, std::size_t numFrames, std::size_t numChannels, unsigned int sampleRate)
-:tickCount(0)
+:externalBuffer(nullptr)
+,externalSize(0)
+,tickCount(0)
 ,soundStreamDeviceID(0) {
 	copyFrom(shortBuffer, numFrames, numChannels, sampleRate);
 	checkSizeAndChannelsConsistency("constructor");
 }
 
+ofSoundBuffer::ofSoundBuffer(const ofSoundBuffer & other)
+:buffer(other.getData(), other.getData() + other.size())
+,externalBuffer(nullptr)
+,externalSize(0)
+,channels(other.channels)
+,samplerate(other.samplerate)
+,tickCount(other.tickCount)
+,soundStreamDeviceID(other.soundStreamDeviceID){
+
+}
+
+ofSoundBuffer::ofSoundBuffer(ofSoundBuffer && other)
+:externalBuffer(nullptr)
+,externalSize(0)
+,channels(other.channels)
+,samplerate(other.samplerate)
+,tickCount(other.tickCount)
+,soundStreamDeviceID(other.soundStreamDeviceID){
+	other.ownBuffer();
+	buffer = std::move(other.buffer);
+}
+
+ofSoundBuffer & ofSoundBuffer::operator=(const ofSoundBuffer & other){
+	if(&other != this){
+		externalBuffer = nullptr;
+		externalSize = 0;
+		buffer.assign(other.getData(), other.getData() + other.size());
+		channels = other.channels;
+		samplerate = other.samplerate;
+		tickCount = other.tickCount;
+		soundStreamDeviceID = other.soundStreamDeviceID;
+	}
+	return *this;
+}
+
+ofSoundBuffer & ofSoundBuffer::operator=(ofSoundBuffer && other){
+	if(&other != this){
+		other.ownBuffer();
+		externalBuffer = nullptr;
+		externalSize = 0;
+		buffer = std::move(other.buffer);
+		channels = other.channels;
+		samplerate = other.samplerate;
+		tickCount = other.tickCount;
+		soundStreamDeviceID = other.soundStreamDeviceID;
+	}
+	return *this;
+}
+
+void ofSoundBuffer::setFromExternalBuffer(float * floatBuffer, std::size_t numFrames, std::size_t numChannels, unsigned int _sampleRate){
+	// the owned samples are kept so a later copy doesn't need to allocate
+	externalBuffer = floatBuffer;
+	externalSize = numFrames * numChannels;
+	channels = numChannels;
+	setSampleRate(_sampleRate);
+}
+
+void ofSoundBuffer::ownBuffer() const{
+	if(externalBuffer){
+		buffer.assign(externalBuffer, externalBuffer + externalSize);
+		externalBuffer = nullptr;
+		externalSize = 0;
+	}
+}
+
 void ofSoundBuffer::copyFrom(const short * shortBuffer, std::size_t numFrames, std::size_t numChannels, unsigned int _sampleRate) {
 	this->channels = numChannels;
 	setSampleRate(_sampleRate);
+	externalBuffer = nullptr;
+	externalSize = 0;
 	buffer.resize(numFrames * numChannels);
-	for(std::size_t i = 0; i < size(); i++){
+	std::size_t i = simdEnabled() ? fromShortSIMD(shortBuffer, buffer.data(), size()) : 0;
+	for(; i < size(); i++){
 		buffer[i] = shortBuffer[i]/float(numeric_limits<short>::max());
 	}
 	checkSizeAndChannelsConsistency("copyFrom");
@@ -47,6 +331,8 @@ void ofSoundBuffer::copyFrom(const short * shortBuffer, std::size_t numFrames, s
 void ofSoundBuffer::copyFrom(const float * floatBuffer, std::size_t numFrames, std::size_t numChannels, unsigned int _sampleRate) {
 	this->channels = numChannels;
 	setSampleRate(_sampleRate);
+	externalBuffer = nullptr;
+	externalSize = 0;
 	buffer.assign(floatBuffer, floatBuffer + (numFrames * numChannels));
 	checkSizeAndChannelsConsistency("copyFrom");
 }
@@ -61,22 +347,24 @@ void ofSoundBuffer::copyFrom(const vector<float> & floatBuffer, std::size_t numC
 
 void ofSoundBuffer::toShortPCM(vector<short> & dst) const{
 	dst.resize(size());
-	for(std::size_t i = 0; i < size(); i++){
-		dst[i] = buffer[i]*float(numeric_limits<short>::max());
-	}
+	toShortPCM(dst.data());
 }
 
 void ofSoundBuffer::toShortPCM(short * dst) const{
-	for(std::size_t i = 0; i < size(); i++){
-		dst[i] = buffer[i]*float(numeric_limits<short>::max());
+	const float * samples = getData();
+	std::size_t i = simdEnabled() ? toShortSIMD(samples, dst, size()) : 0;
+	for(; i < size(); i++){
+		dst[i] = samples[i]*float(numeric_limits<short>::max());
 	}
 }
 
 vector<float> & ofSoundBuffer::getBuffer(){
+	ownBuffer();
 	return buffer;
 }
 
 const vector<float> & ofSoundBuffer::getBuffer() const{
+	ownBuffer();
 	return buffer;
 }
 
@@ -107,16 +395,23 @@ void ofSoundBuffer::allocate(size_t numSamples, size_t numChannels){
 }
 
 void ofSoundBuffer::resize(std::size_t samples, float val){
+	if(externalBuffer && samples == externalSize){
+		// keep wrapping the external memory if the size doesn't change
+		return;
+	}
+	ownBuffer();
 	buffer.resize(samples, val);
 	checkSizeAndChannelsConsistency("resize(samples,val)");
 }
 
 void ofSoundBuffer::clear(){
+	externalBuffer = nullptr;
+	externalSize = 0;
 	buffer.clear();
 }
 
 void ofSoundBuffer::set(float value){
-	buffer.assign(buffer.size(), value);
+	std::fill(getData(), getData() + size(), value);
 	checkSizeAndChannelsConsistency("set");
 }
 
@@ -134,22 +429,26 @@ bool ofSoundBuffer::checkSizeAndChannelsConsistency(const std::string& _function
 }
 
 float & ofSoundBuffer::operator[](std::size_t pos){
-	return buffer[pos];
+	return getData()[pos];
 }
 
 const float & ofSoundBuffer::operator[](std::size_t pos) const{
-	return buffer[pos];
+	return getData()[pos];
 }
 
 float & ofSoundBuffer::getSample(std::size_t frameIndex, std::size_t channel){
-	return buffer[(frameIndex * channels) + channel];
+	return getData()[(frameIndex * channels) + channel];
 }
 
 const float & ofSoundBuffer::getSample(std::size_t frameIndex, std::size_t channel) const {
-	return buffer[(frameIndex * channels) + channel];
+	return getData()[(frameIndex * channels) + channel];
 }
 
 void ofSoundBuffer::swap(ofSoundBuffer & buffer){
+	// swapping the vectors of external memory would make the other
+	// buffer wrap it, so both are made to own their samples first
+	this->ownBuffer();
+	buffer.ownBuffer();
 	std::swap(this->channels, buffer.channels);
 	std::swap(this->samplerate, buffer.samplerate);
 	std::swap(this->tickCount, buffer.tickCount);
@@ -164,8 +463,10 @@ ofSoundBuffer ofSoundBuffer::operator*(float value){
 }
 
 ofSoundBuffer & ofSoundBuffer::operator*=(float value){
-	for(std::size_t i=0;i<buffer.size();i++){
-		buffer[i] *= value;
+	float * samples = getData();
+	std::size_t i = simdEnabled() ? scaleSIMD(samples, size(), value) : 0;
+	for(;i<size();i++){
+		samples[i] *= value;
 	}
 	return *this;
 }
@@ -175,8 +476,9 @@ void ofSoundBuffer::stereoPan(float left, float right){
 		ofLogWarning("ofSoundBuffer") << "stereoPan called on a buffer with " << channels << " channels, only works with 2 channels";
 		return;
 	}
-	float * bufferPtr = &buffer[0];
-	for(std::size_t i=0;i<getNumFrames();i++){
+	std::size_t i = simdEnabled() ? stereoPanSIMD(getData(), getNumFrames(), left, right) : 0;
+	float * bufferPtr = getData() + i * 2;
+	for(;i<getNumFrames();i++){
 		*bufferPtr++ *= left;
 		*bufferPtr++ *= right;
 	}
@@ -188,24 +490,24 @@ void ofSoundBuffer::copyTo(ofSoundBuffer & soundBuffer, std::size_t nFrames, std
 	soundBuffer.setSampleRate(samplerate);
 	soundBuffer.setTickCount(this->getTickCount());
 	soundBuffer.setDeviceID(this->getDeviceID());
-	copyTo(&soundBuffer[0], nFrames, outChannels, fromFrame, loop);
+	copyTo(soundBuffer.getData(), nFrames, outChannels, fromFrame, loop);
 }
 
 void ofSoundBuffer::copyTo(ofSoundBuffer & outBuffer, std::size_t fromFrame, bool loop) const{
 	outBuffer.setTickCount(this->getTickCount());
 	outBuffer.setDeviceID(this->getDeviceID());
-	copyTo(&outBuffer[0], outBuffer.getNumFrames(), outBuffer.getNumChannels(), fromFrame, loop);
+	copyTo(outBuffer.getData(), outBuffer.getNumFrames(), outBuffer.getNumChannels(), fromFrame, loop);
 }
 
 void ofSoundBuffer::addTo(ofSoundBuffer & soundBuffer, std::size_t nFrames, std::size_t outChannels,std::size_t fromFrame, bool loop) const {
 	soundBuffer.resize(nFrames*outChannels);
 	soundBuffer.setNumChannels(outChannels);
 	soundBuffer.setSampleRate(samplerate);
-	addTo(&soundBuffer.getBuffer()[0], nFrames, outChannels, fromFrame, loop);
+	addTo(soundBuffer.getData(), nFrames, outChannels, fromFrame, loop);
 }
 
 void ofSoundBuffer::addTo(ofSoundBuffer & outBuffer, std::size_t fromFrame, bool loop) const{
-	addTo(&outBuffer[0], outBuffer.getNumFrames(), outBuffer.getNumChannels(), fromFrame, loop);
+	addTo(outBuffer.getData(), outBuffer.getNumFrames(), outBuffer.getNumChannels(), fromFrame, loop);
 }
 
 void ofSoundBuffer::copyTo(float * outBuffer, std::size_t nFrames, std::size_t outChannels, std::size_t fromFrame, bool loop) const{
@@ -215,7 +517,7 @@ void ofSoundBuffer::copyTo(float * outBuffer, std::size_t nFrames, std::size_t o
 		nFramesToCopy = this->getNumFrames() - fromFrame;
 	}
 		
-	const float * buffPtr = &buffer[fromFrame * channels];
+	const float * buffPtr = getData() + fromFrame * channels;
 	// if channels count matches we can just memcpy
 	if(channels == outChannels){
 		memcpy(outBuffer, buffPtr, nFramesToCopy * channels * sizeof(float));
@@ -234,7 +536,13 @@ void ofSoundBuffer::copyTo(float * outBuffer, std::size_t nFrames, std::size_t o
 		// we have fewer channels than output is requesting. so replicate as many channels as possible then loop.
 		// if we have 2 channels and output wants 5, data is copied from our channels in the following in order:
 		// 1 2 1 2 1
-		for(std::size_t i = 0; i < nFramesToCopy; i++){
+		std::size_t i = 0;
+		if(channels == 1 && outChannels == 2 && simdEnabled()){
+			i = monoToStereoSIMD<false>(outBuffer, buffPtr, nFramesToCopy);
+			outBuffer += i * outChannels;
+			buffPtr += i * channels;
+		}
+		for(; i < nFramesToCopy; i++){
 			for(std::size_t j = 0; j < outChannels; j++){
 				*outBuffer++ = buffPtr[(j%channels)];
 			}
@@ -264,10 +572,11 @@ void ofSoundBuffer::addTo(float * outBuffer, std::size_t nFrames, std::size_t ou
 		nFramesToCopy = this->getNumFrames() - fromFrame;
 	}
 
-	const float * buffPtr = &buffer[fromFrame * channels];
+	const float * buffPtr = getData() + fromFrame * channels;
 	// if channels count matches it is easy
 	if(channels == outChannels){
-		for(std::size_t i = 0; i < (nFramesToCopy * outChannels); i++){
+		std::size_t i = simdEnabled() ? addSIMD(outBuffer, buffPtr, nFramesToCopy * outChannels) : 0;
+		for(; i < (nFramesToCopy * outChannels); i++){
 			outBuffer[i] += buffPtr[i];
 		}
 		outBuffer += nFramesToCopy * outChannels;
@@ -285,7 +594,13 @@ void ofSoundBuffer::addTo(float * outBuffer, std::size_t nFrames, std::size_t ou
 		// we have fewer channels than output is requesting. so replicate as many channels as possible then loop.
 		// if we have 2 channels and output wants 5, data is copied from our channels in the following in order:
 		// 1 2 1 2 1
-		for(std::size_t i = 0; i < nFramesToCopy; i++){
+		std::size_t i = 0;
+		if(channels == 1 && outChannels == 2 && simdEnabled()){
+			i = monoToStereoSIMD<true>(outBuffer, buffPtr, nFramesToCopy);
+			outBuffer += i * outChannels;
+			buffPtr += i * channels;
+		}
+		for(; i < nFramesToCopy; i++){
 			for(std::size_t j = 0; j < outChannels; j++){
 				*outBuffer++ += buffPtr[(j%channels)];
 			}
@@ -307,13 +622,14 @@ void ofSoundBuffer::append(ofSoundBuffer & other){
 		ofLogError() << "can't append sound buffers with different num channels";
 		return;
 	}
-	buffer.insert(buffer.end(),other.buffer.begin(),other.buffer.end());
+	ownBuffer();
+	buffer.insert(buffer.end(),other.getData(),other.getData()+other.size());
 }
 
 static bool prepareBufferForResampling(const ofSoundBuffer &in, ofSoundBuffer &out, std::size_t numFrames) {
 	std::size_t totalOutBufferSize = numFrames * in.getNumChannels();
 	
-	if(totalOutBufferSize < out.getBuffer().max_size()) {
+	if(totalOutBufferSize < std::vector<float>().max_size()) {
 		out.resize(totalOutBufferSize,0);
 	} else {
 		ofLogError("ofSoundUtils") << "resampling would create a buffer size of " << totalOutBufferSize << " (too large for std::vector)";
@@ -329,6 +645,7 @@ static bool prepareBufferForResampling(const ofSoundBuffer &in, ofSoundBuffer &o
 // might lose 1 or 2 samples when it reaches the end of the buffer
 void ofSoundBuffer::linearResampleTo(ofSoundBuffer &outBuffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const {
 	
+	const float * samples = getData();
 	std::size_t inChannels = getNumChannels();
 	std::size_t inFrames = getNumFrames();
 	bool bufferReady = prepareBufferForResampling(*this, outBuffer, numFrames);
@@ -361,8 +678,8 @@ void ofSoundBuffer::linearResampleTo(ofSoundBuffer &outBuffer, std::size_t fromF
 	for(std::size_t i=0;i<to;i++){
 		intPosition *= inChannels;
 		for(std::size_t j=0;j<inChannels;j++){
-			a = buffer[intPosition+j];
-			b = buffer[intPosition+inChannels+j];
+			a = samples[intPosition+j];
+			b = samples[intPosition+inChannels+j];
 			*resBufferPtr++ = ofLerp(a,b,remainder);
 		}
 		position += increment;
@@ -376,8 +693,8 @@ void ofSoundBuffer::linearResampleTo(ofSoundBuffer &outBuffer, std::size_t fromF
 			for(std::size_t i=0;i<to;i++){
 				intPosition *= inChannels;
 				for(std::size_t j=0;j<inChannels;j++){
-					a = buffer[intPosition+j];
-					b = buffer[intPosition+inChannels+j];
+					a = samples[intPosition+j];
+					b = samples[intPosition+inChannels+j];
 					*resBufferPtr++ = ofLerp(a,b,remainder);
 				}
 				position += increment;
@@ -393,6 +710,7 @@ void ofSoundBuffer::linearResampleTo(ofSoundBuffer &outBuffer, std::size_t fromF
 // might lose 1 to 3 samples when it reaches the end of the buffer
 void ofSoundBuffer::hermiteResampleTo(ofSoundBuffer &outBuffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const {
 	
+	const float * samples = getData();
 	std::size_t inChannels = getNumChannels();
 	std::size_t inFrames = getNumFrames();
 	bool bufferReady = prepareBufferForResampling(*this, outBuffer, numFrames);
@@ -426,10 +744,10 @@ void ofSoundBuffer::hermiteResampleTo(ofSoundBuffer &outBuffer, std::size_t from
 	while(intPosition==0){
 		intPosition *= inChannels;
 		for(std::size_t j=0;j<inChannels;++j){
-			a=loop?buffer[j]:0;
-			b=buffer[intPosition+j];
-			c=buffer[intPosition+j+inChannels];
-			d=buffer[intPosition+j+inChannels*2];
+			a=loop?samples[j]:0;
+			b=samples[intPosition+j];
+			c=samples[intPosition+j+inChannels];
+			d=samples[intPosition+j+inChannels*2];
 			*resBufferPtr++ = ofInterpolateHermite(a, b, c, d, remainder);
 		}
 		position += increment;
@@ -441,10 +759,10 @@ void ofSoundBuffer::hermiteResampleTo(ofSoundBuffer &outBuffer, std::size_t from
 	for(std::size_t i=from;i<to;++i){
 		intPosition *= inChannels;
 		for(std::size_t j=0;j<inChannels;++j){
-			a=buffer[intPosition+j-inChannels];
-			b=buffer[intPosition+j];
-			c=buffer[intPosition+j+inChannels];
-			d=buffer[intPosition+j+inChannels*2];
+			a=samples[intPosition+j-inChannels];
+			b=samples[intPosition+j];
+			c=samples[intPosition+j+inChannels];
+			d=samples[intPosition+j+inChannels*2];
 			*resBufferPtr++ = ofInterpolateHermite(a, b, c, d, remainder);
 		}
 		position += increment;
@@ -458,10 +776,10 @@ void ofSoundBuffer::hermiteResampleTo(ofSoundBuffer &outBuffer, std::size_t from
 			intPosition %= size();
 			for(std::size_t i=0;i<to;++i){
 				for(std::size_t j=0;j<inChannels;++j){
-					a=buffer[intPosition+j-inChannels];
-					b=buffer[intPosition+j];
-					c=buffer[intPosition+j+inChannels];
-					d=buffer[intPosition+j+inChannels*2];
+					a=samples[intPosition+j-inChannels];
+					b=samples[intPosition+j];
+					c=samples[intPosition+j+inChannels];
+					d=samples[intPosition+j+inChannels*2];
 					*resBufferPtr++ = ofInterpolateHermite(a, b, c, d, remainder);
 				}
 				position += increment;
@@ -475,6 +793,157 @@ void ofSoundBuffer::hermiteResampleTo(ofSoundBuffer &outBuffer, std::size_t from
 	}
 }
 
+namespace{
+	// kaiser windowed sinc low pass filters sampled at numPhases
+	// fractional positions between two input frames
+	struct PolyphaseFilter{
+		static const size_t numTaps = 64;
+		static const size_t numPhases = 256;
+
+		PolyphaseFilter(double cutoff){
+			// ~85dB of stopband attenuation
+			const double beta = 8.6;
+			const double halfTaps = numTaps / 2;
+			coefficients.resize((numPhases + 1) * numTaps);
+			// the last phase is the first one delayed by a frame so every
+			// phase can be interpolated with the next one
+			for(size_t phase = 0; phase <= numPhases; phase++){
+				float * row = &coefficients[phase * numTaps];
+				double sum = 0;
+				for(size_t tap = 0; tap < numTaps; tap++){
+					double distance = double(tap) - (halfTaps - 1) - double(phase) / numPhases;
+					double x = cutoff * distance * glm::pi<double>();
+					double sinc = x == 0 ? 1 : sin(x) / x;
+					double window = distance / halfTaps;
+					window = window * window < 1 ? besselI0(beta * sqrt(1 - window * window)) / besselI0(beta) : 0;
+					row[tap] = cutoff * sinc * window;
+					sum += row[tap];
+				}
+				// unity gain at DC
+				for(size_t tap = 0; tap < numTaps; tap++){
+					row[tap] /= sum;
+				}
+			}
+		}
+
+		static double besselI0(double x){
+			double sum = 1, term = 1;
+			for(int k = 1; k < 50 && term > sum * 1e-12; k++){
+				term *= (x / (2 * k)) * (x / (2 * k));
+				sum += term;
+			}
+			return sum;
+		}
+
+		vector<float> coefficients;
+	};
+
+	// filters are shared by every buffer, one per cutoff rounded to 1/1000.
+	// this runs on the audio thread so, once a cutoff has been used, getting
+	// its filter is a single atomic load. filters are never freed
+	const int maxPolyphaseCutoff = 910;
+	std::atomic<const PolyphaseFilter*> polyphaseFilters[maxPolyphaseCutoff + 1];
+
+	const PolyphaseFilter & getPolyphaseFilter(float speed){
+		// some margin below nyquist for the transition band
+		int cutoff = int(std::min(1.f, 1.f / std::abs(speed)) * 0.91f * 1000 + 0.5f);
+		cutoff = std::max(1, std::min(cutoff, maxPolyphaseCutoff));
+		auto & cached = polyphaseFilters[cutoff];
+		const PolyphaseFilter * filter = cached.load(std::memory_order_acquire);
+		if(!filter){
+			// first use of this cutoff, if another thread creates it at the
+			// same time keep theirs
+			const PolyphaseFilter * created = new PolyphaseFilter(cutoff / 1000.);
+			if(cached.compare_exchange_strong(filter, created, std::memory_order_acq_rel)){
+				filter = created;
+			}else{
+				delete created;
+			}
+		}
+		return *filter;
+	}
+
+	// acc[i] += src[i] * coefficient for every channel of a frame
+	inline void multiplyAdd(float * acc, const float * src, float coefficient, size_t channels){
+		size_t i = simdEnabled() ? multiplyAddSIMD(acc, src, coefficient, channels) : 0;
+		for(; i < channels; i++){
+			acc[i] += src[i] * coefficient;
+		}
+	}
+}
+
+void ofSoundBuffer::polyphaseResampleTo(ofSoundBuffer & outBuffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const {
+	const size_t numTaps = PolyphaseFilter::numTaps;
+	const size_t numPhases = PolyphaseFilter::numPhases;
+
+	std::size_t inChannels = getNumChannels();
+	std::size_t inFrames = getNumFrames();
+	bool bufferReady = prepareBufferForResampling(*this, outBuffer, numFrames);
+
+	if(!bufferReady) {
+		outBuffer = *this;
+		return;
+	}
+
+	auto & filter = getPolyphaseFilter(speed);
+	const float * samples = getData();
+	float * resBufferPtr = outBuffer.getData();
+	float coefficients[numTaps];
+
+	for(std::size_t i=0;i<numFrames;i++){
+		float * outFrame = resBufferPtr + i * inChannels;
+		std::fill(outFrame, outFrame + inChannels, 0.f);
+		if(inFrames == 0){
+			continue;
+		}
+
+		// interpolate the filter for the fractional position between two phases
+		double position = fromFrame + i * double(speed);
+		double intPosition = floor(position);
+		double phase = (position - intPosition) * numPhases;
+		std::size_t intPhase = std::min(std::size_t(phase), numPhases - 1);
+		float remainder = phase - intPhase;
+		const float * phase0 = &filter.coefficients[intPhase * numTaps];
+		const float * phase1 = phase0 + numTaps;
+		for(std::size_t tap=0;tap<numTaps;tap++){
+			coefficients[tap] = phase0[tap] + (phase1[tap] - phase0[tap]) * remainder;
+		}
+
+		int64_t firstFrame = int64_t(intPosition) - int64_t(numTaps / 2 - 1);
+		if(firstFrame >= 0 && firstFrame + int64_t(numTaps) <= int64_t(inFrames)){
+			const float * inFrame = samples + firstFrame * inChannels;
+			if(inChannels < 4){
+				for(std::size_t tap=0;tap<numTaps;tap++){
+					for(std::size_t j=0;j<inChannels;j++){
+						outFrame[j] += inFrame[j] * coefficients[tap];
+					}
+					inFrame += inChannels;
+				}
+			}else{
+				for(std::size_t tap=0;tap<numTaps;tap++){
+					multiplyAdd(outFrame, inFrame, coefficients[tap], inChannels);
+					inFrame += inChannels;
+				}
+			}
+		}else{
+			// taps before the beginning or after the end of the buffer are
+			// silence or wrap around when looping
+			for(std::size_t tap=0;tap<numTaps;tap++){
+				int64_t frame = firstFrame + tap;
+				if(loop){
+					frame %= int64_t(inFrames);
+					if(frame < 0){
+						frame += inFrames;
+					}
+				}else if(frame < 0 || frame >= int64_t(inFrames)){
+					continue;
+				}
+				multiplyAdd(outFrame, samples + frame * inChannels, coefficients[tap], inChannels);
+			}
+		}
+	}
+}
+
 void ofSoundBuffer::resampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop, InterpolationAlgorithm algorithm) const {
 	switch(algorithm){
 		case Linear:
@@ -483,6 +952,9 @@ void ofSoundBuffer::resampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, st
 		case Hermite:
 			hermiteResampleTo(buffer, fromFrame, numFrames, speed, loop);
 			break;
+		case Polyphase:
+			polyphaseResampleTo(buffer, fromFrame, numFrames, speed, loop);
+			break;
 	}
 }
 
@@ -508,7 +980,7 @@ void ofSoundBuffer::getChannel(ofSoundBuffer & targetBuffer, std::size_t sourceC
 	}else{
 		// fetch samples from only one channel
 		targetBuffer.resize(getNumFrames());
-		const float * bufferPtr = &this->buffer[sourceChannel];
+		const float * bufferPtr = getData() + sourceChannel;
 		for(std::size_t i = 0; i < targetBuffer.getNumFrames(); i++){
 			targetBuffer[i] = *bufferPtr;
 			bufferPtr += channels;
@@ -520,8 +992,8 @@ void ofSoundBuffer::setChannel(const ofSoundBuffer & inBuffer, std::size_t targe
 	// resize ourself to match inBuffer
 	resize(inBuffer.getNumFrames() * channels);
 	// copy from inBuffer to targetChannel
-	float * bufferPtr = &this->buffer[targetChannel];
-	const float * inBufferPtr = &(inBuffer[0]);
+	float * bufferPtr = getData() + targetChannel;
+	const float * inBufferPtr = inBuffer.getData();
 	for(std::size_t i = 0; i < getNumFrames(); i++){
 		*bufferPtr = *inBufferPtr;
 		bufferPtr += channels;
@@ -531,11 +1003,13 @@ void ofSoundBuffer::setChannel(const ofSoundBuffer & inBuffer, std::size_t targe
 }
 
 float ofSoundBuffer::getRMSAmplitude() const {
+	const float * samples = getData();
 	double acc = 0;
-	for(size_t i = 0; i < buffer.size(); i++){
-		acc += buffer[i] * buffer[i];
+	size_t i = simdEnabled() ? sumSquaresSIMD(samples, size(), acc) : 0;
+	for(; i < size(); i++){
+		acc += samples[i] * samples[i];
 	}
-	return sqrt(acc / (double)buffer.size());
+	return sqrt(acc / (double)size());
 }
 
 float ofSoundBuffer::getRMSAmplitudeChannel(std::size_t channel) const {
@@ -552,17 +1026,19 @@ float ofSoundBuffer::getRMSAmplitudeChannel(std::size_t channel) const {
 }
 
 void ofSoundBuffer::normalize(float level){
+	float * samples = getData();
 	float maxAmplitude = 0;
 	for(std::size_t i = 0; i < size(); i++) {
-		maxAmplitude = max(maxAmplitude, abs(buffer[i]));
+		maxAmplitude = max(maxAmplitude, abs(samples[i]));
 	}
 	float normalizationFactor = level/maxAmplitude;
 	for(std::size_t i = 0; i < size(); i++) {
-		buffer[i] *= normalizationFactor;
+		samples[i] *= normalizationFactor;
 	}
 }
 
 bool ofSoundBuffer::trimSilence(float threshold, bool trimStart, bool trimEnd) {
+	ownBuffer();
 	if(buffer.empty()) {
 		ofLogVerbose("ofSoundBuffer") << "attempted to trim empty buffer";
 		return true;
@@ -597,17 +1073,19 @@ bool ofSoundBuffer::trimSilence(float threshold, bool trimStart, bool trimEnd) {
 }
 
 void ofSoundBuffer::fillWithNoise(float amplitude){
+	float * samples = getData();
 	for (std::size_t i=0; i<size(); i++ ) {
-		buffer[i] = ofRandom(-amplitude, amplitude);
+		samples[i] = ofRandom(-amplitude, amplitude);
 	}
 }
 
 float ofSoundBuffer::fillWithTone( float pitchHz, float phase ){
 	float step = glm::two_pi<float>()*(pitchHz/samplerate);
+	float * samples = getData();
 	for (std::size_t i=0; i<size()/channels; i++ ) {
 		std::size_t base = i*channels;
 		for (std::size_t j=0; j<channels; j++)
-			buffer[base+j] = sinf(phase);
+			samples[base+j] = sinf(phase);
 		phase += step;
 	}
 	return phase;
@@ -86,9 +86,16 @@ public:
 	ofSoundBuffer();
 	ofSoundBuffer(short * shortBuffer, std::size_t numFrames, std::size_t numChannels, unsigned int sampleRate);
 
+	/// copies of a buffer always own their samples, even if the original wraps external memory
+	ofSoundBuffer(const ofSoundBuffer & other);
+	ofSoundBuffer(ofSoundBuffer && other);
+	ofSoundBuffer & operator=(const ofSoundBuffer & other);
+	ofSoundBuffer & operator=(ofSoundBuffer && other);
+
 	enum InterpolationAlgorithm{
 		Linear,
-		Hermite
+		Hermite,
+		Polyphase ///< band-limited windowed sinc, slower but without aliasing, for sample rate conversion
 	};
 	static InterpolationAlgorithm defaultAlgorithm;  //defaults to Linear for mobile, Hermite for desktop
 
@@ -148,6 +155,15 @@ public:
 	
 	void copyFrom(const std::vector<float> & floatBuffer, std::size_t numChannels, unsigned int sampleRate);
 
+	/// wrap numFrames of interleaved samples owned by someone else, like the memory of a sound device, without copying them.
+	/// reading and writing the buffer accesses that memory directly. anything that changes the size of the buffer
+	/// or asks for the underlying vector first copies the samples into memory owned by the buffer.
+	/// the samples have to stay valid while the buffer wraps them, to keep them for longer make a copy of the buffer.
+	void setFromExternalBuffer(float * floatBuffer, std::size_t numFrames, std::size_t numChannels, unsigned int sampleRate);
+
+	/// false if the buffer wraps external memory set with setFromExternalBuffer
+	bool isBufferOwner() const { return externalBuffer == nullptr; }
+
 	void toShortPCM(std::vector<short> & dst) const;
 	void toShortPCM(short * dst) const;
 
@@ -188,6 +204,9 @@ public:
 	
 	void linearResampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const;
 	void hermiteResampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const;
+	/// resample with a 64 tap kaiser windowed sinc filter interpolated from 256 phases. when speed > 1 the cutoff is lowered
+	/// to the new nyquist frequency so downsampling, for example from 48000 to 44100Hz with a speed of 48000/44100., doesn't alias.
+	void polyphaseResampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const;
 	
 	/// fills the buffer with random noise between -amplitude and amplitude. useful for debugging.
 	void fillWithNoise(float amplitude = 1.0f);
@@ -202,7 +221,7 @@ public:
 	bool trimSilence(float threshold = 0.0001f, bool trimStart = true, bool trimEnd = true);
 	
 	/// return the total number of samples in this buffer (==getNumFrames()*getNumChannels())
-	std::size_t size() const { return buffer.size(); }
+	std::size_t size() const { return externalBuffer ? externalSize : buffer.size(); }
 	/// resize this buffer to exactly this many samples. it's up to you make sure samples matches the channel count.
 	void resize(std::size_t numSamples, float val = float());
 	/// remove all samples, preserving channel count and sample rate.
@@ -213,15 +232,25 @@ public:
 	void set(float value);
 	
 	/// return the underlying buffer. careful!
+	/// if the buffer wraps external memory, the samples are copied to memory owned by the buffer first.
 	std::vector<float> & getBuffer();
 	const std::vector<float> & getBuffer() const;
 
+	/// return a pointer to the samples, the external memory if the buffer wraps it.
+	float * getData() { return externalBuffer ? externalBuffer : buffer.data(); }
+	const float * getData() const { return externalBuffer ? externalBuffer : buffer.data(); }
+
 protected:
 
 	// checks that size() and number of channels are consistent, logs a warning if not. returns consistency check result.
 	bool checkSizeAndChannelsConsistency(const std::string& function="" );
 
-	std::vector<float> buffer;
+	// copies the samples of a wrapped external memory into buffer so they can be resized
+	void ownBuffer() const;
+
+	mutable std::vector<float> buffer;
+	mutable float * externalBuffer;
+	mutable std::size_t externalSize;
 	std::size_t channels;
 	unsigned int samplerate;
 
@@ -229,6 +258,16 @@ protected:
 	int soundStreamDeviceID;
 };
 
+/// \brief Enable or disable the SIMD (SSE2 or NEON) versions of the ofSoundBuffer
+/// gain, pan, mixing, short conversion and RMS operations.
+///
+/// They are enabled by default when the CPU supports them. Disabling them can
+/// be useful to compare results or timings with the plain C++ versions.
+void ofSetSoundBufferUsingSIMD(bool useSIMD);
+
+/// \returns true if the SIMD versions are enabled and supported by the CPU
+bool ofGetSoundBufferUsingSIMD();
+
 namespace std{
 	void swap(ofSoundBuffer & src, ofSoundBuffer & dst);
 }
@@ -147,3 +147,59 @@ void ofParameter<void>::setParent(ofParameterGroup & parent){
 size_t ofParameter<void>::getNumListeners() const{
 	return obj->changedE.size();
 }
+
+void ofParameterChangeQueue::add(ofAbstractParameter & parameter){
+	if(parameter.type() == typeid(ofParameterGroup).name()){
+		auto & group = parameter.castGroup();
+		for(size_t i = 0; i < group.size(); i++){
+			add(group.get(i));
+		}
+	}else{
+		parameters.push_back(parameter.newReference());
+	}
+}
+
+void ofParameterChangeQueue::remove(ofAbstractParameter & parameter){
+	if(parameter.type() == typeid(ofParameterGroup).name()){
+		auto & group = parameter.castGroup();
+		for(size_t i = 0; i < group.size(); i++){
+			remove(group.get(i));
+		}
+	}else{
+		parameters.erase(std::remove_if(parameters.begin(), parameters.end(), [&](const shared_ptr<ofAbstractParameter> & p){
+			return p->isReferenceTo(parameter);
+		}), parameters.end());
+	}
+}
+
+void ofParameterChangeQueue::clear(){
+	parameters.clear();
+}
+
+size_t ofParameterChangeQueue::notify(){
+	size_t numNotified = 0;
+	for(auto & parameter: parameters){
+		if(parameter->notifyPendingChange()){
+			numNotified++;
+		}
+	}
+	return numNotified;
+}
+
+void ofParameterChangeQueue::setNotifyOnUpdate(bool notifyOnUpdate){
+	if(notifyOnUpdate == this->notifyOnUpdate){
+		return;
+	}
+	this->notifyOnUpdate = notifyOnUpdate;
+	if(notifyOnUpdate){
+		updateListener = ofEvents().update.newListener([this](ofEventArgs &){
+			notify();
+		}, OF_EVENT_ORDER_BEFORE_APP);
+	}else{
+		updateListener.unsubscribe();
+	}
+}
+
+bool ofParameterChangeQueue::isNotifyingOnUpdate() const{
+	return notifyOnUpdate;
+}
@@ -7,6 +7,9 @@
 #include "ofColor.h"
 #include "ofLog.h"
 #include <map>
+#include <array>
+#include <atomic>
+#include <cstring>
 
 template<typename ParameterType>
 class ofParameter;
@@ -68,6 +71,11 @@ public:
 	virtual bool isReferenceTo(const ofAbstractParameter& other) const;
 
 protected:
+	/// notifies the listeners of a change made with setAtomic from another
+	/// thread, returns false if there wasn't any
+	virtual bool notifyPendingChange(){ return false; }
+	friend class ofParameterChangeQueue;
+
 	virtual const ofParameterGroup getFirstParent() const = 0;
 	virtual void setSerializable(bool serializable)=0;
 	virtual std::string escape(const std::string& str) const;
@@ -471,6 +479,88 @@ namespace priv{
 		throw std::exception();
 
 	}
+
+	//----------------------------------------------------------------------
+	// std::is_trivially_copyable is missing from libstdc++ before gcc 5
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5
+	template<typename T>
+	struct is_trivially_copyable: std::integral_constant<bool,
+		__has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T)>{};
+#else
+	template<typename T>
+	using is_trivially_copyable = std::is_trivially_copyable<T>;
+#endif
+
+	//----------------------------------------------------------------------
+	// Copy of the value of a thread safe parameter that any thread can read
+	// and write without locks. Values that fit in a word are stored in an
+	// atomic word, bigger ones behind a sequence lock: writers make the
+	// sequence odd while they copy the value and readers retry if it was odd
+	// or changed while they were reading.
+	template<typename T, bool Supported = of::priv::is_trivially_copyable<T>::value>
+	class AtomicValue{
+	public:
+		static constexpr bool supported = true;
+
+		AtomicValue(const T & v){
+			store(v);
+		}
+
+		T load() const{
+			std::array<Word, NumWords> copy;
+			if(NumWords == 1){
+				copy[0] = words[0].load(std::memory_order_acquire);
+			}else{
+				uint32_t before, after;
+				do{
+					before = sequence.load(std::memory_order_acquire);
+					for(size_t i = 0; i < NumWords; i++){
+						copy[i] = words[i].load(std::memory_order_relaxed);
+					}
+					std::atomic_thread_fence(std::memory_order_acquire);
+					after = sequence.load(std::memory_order_relaxed);
+				}while(before != after || (before & 1));
+			}
+			T v;
+			memcpy(&v, copy.data(), sizeof(T));
+			return v;
+		}
+
+		void store(const T & v){
+			std::array<Word, NumWords> copy{};
+			memcpy(copy.data(), &v, sizeof(T));
+			if(NumWords == 1){
+				words[0].store(copy[0], std::memory_order_release);
+				return;
+			}
+			// concurrent writers wait for each other to make the sequence even
+			auto current = sequence.load(std::memory_order_relaxed);
+			do{
+				current &= ~1u;
+			}while(!sequence.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed));
+			std::atomic_thread_fence(std::memory_order_release);
+			for(size_t i = 0; i < NumWords; i++){
+				words[i].store(copy[i], std::memory_order_relaxed);
+			}
+			sequence.store(current + 2, std::memory_order_release);
+		}
+
+	private:
+		typedef std::uintptr_t Word;
+		static constexpr size_t NumWords = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+		std::atomic<uint32_t> sequence{0};
+		std::array<std::atomic<Word>, NumWords> words;
+	};
+
+	// Types that can't be copied with memcpy can't be thread safe
+	template<typename T>
+	class AtomicValue<T, false>{
+	public:
+		static constexpr bool supported = false;
+		AtomicValue(const T &){}
+		T load() const{ return T(); }
+		void store(const T &){}
+	};
 }
 }
 /*! \endcond */
@@ -571,6 +661,29 @@ public:
 
 	ofParameter<ParameterType> & setWithoutEventNotifications(const ParameterType & v);
 
+	/// \brief Allows reading and writing the value from any thread with
+	/// getAtomic and setAtomic.
+	///
+	/// Only types that can be copied with memcpy, like numbers, vectors or
+	/// colors, can be thread safe. Change it before other threads use the
+	/// parameter.
+	void setThreadSafe(bool threadSafe);
+	bool isThreadSafe() const;
+
+	/// \brief Returns the last value set from any thread, can be called from
+	/// any thread if the parameter is thread safe.
+	///
+	/// Values that fit in a pointer, like floats, ints or bools, are read
+	/// wait-free so it can be used from the audio callback.
+	ParameterType getAtomic() const;
+
+	/// \brief Sets the value from any thread if the parameter is thread safe.
+	///
+	/// get() and the listeners don't see the new value until the
+	/// ofParameterChangeQueue the parameter was added to notifies it, in the
+	/// thread that calls ofParameterChangeQueue::notify.
+	ofParameter<ParameterType> & setAtomic(const ParameterType & v);
+
 	void setMin(const ParameterType & min);
 	void setMax(const ParameterType & max);
 
@@ -634,6 +747,8 @@ private:
 		bool bInNotify;
 		bool serializable;
 		std::vector<std::weak_ptr<ofParameterGroup::Value>> parents;
+		std::unique_ptr<of::priv::AtomicValue<ParameterType>> atomicValue;
+		std::atomic<bool> changedAtomically{false};
 	};
 
 	std::shared_ptr<Value> obj;
@@ -641,6 +756,8 @@ private:
 
 	void eventsSetValue(const ParameterType & v);
 	void noEventsSetValue(const ParameterType & v);
+	void notifyChanged();
+	bool notifyPendingChange();
 
 	template<typename T, typename F>
 	friend class ofReadOnlyParameter;
@@ -736,38 +853,101 @@ inline void ofParameter<ParameterType>::eventsSetValue(const ParameterType & v){
 		obj->bInNotify = true;
 
 		// Set the value.
-		obj->value = v;
-
-		// Notify any local subscribers.
-		ofNotifyEvent(obj->changedE,obj->value,this);
-
-		// Notify all parents, if there are any.
-		if(!obj->parents.empty())
-		{
-			// Erase each invalid parent
-			obj->parents.erase(std::remove_if(obj->parents.begin(),
-											  obj->parents.end(),
-											  [this](const std::weak_ptr<ofParameterGroup::Value> & p){ return p.expired(); }),
-							   obj->parents.end());
-
-			// notify all leftover (valid) parents of this object's changed value.
-			// this can't happen in the same iterator as above, because a notified listener
-			// might perform similar cleanups that would corrupt our iterator
-			// (which appens for example if the listener calls getFirstParent on us)
-			for(auto & parent: obj->parents){
-				auto p = parent.lock();
-				if(p){
-					p->notifyParameterChanged(*this);
-				}
+		noEventsSetValue(v);
+
+		notifyChanged();
+		obj->bInNotify = false;
+	}
+}
+
+template<typename ParameterType>
+inline void ofParameter<ParameterType>::notifyChanged(){
+	// Notify any local subscribers.
+	ofNotifyEvent(obj->changedE,obj->value,this);
+
+	// Notify all parents, if there are any.
+	if(!obj->parents.empty())
+	{
+		// Erase each invalid parent
+		obj->parents.erase(std::remove_if(obj->parents.begin(),
+										  obj->parents.end(),
+										  [this](const std::weak_ptr<ofParameterGroup::Value> & p){ return p.expired(); }),
+						   obj->parents.end());
+
+		// notify all leftover (valid) parents of this object's changed value.
+		// this can't happen in the same iterator as above, because a notified listener
+		// might perform similar cleanups that would corrupt our iterator
+		// (which appens for example if the listener calls getFirstParent on us)
+		for(auto & parent: obj->parents){
+			auto p = parent.lock();
+			if(p){
+				p->notifyParameterChanged(*this);
 			}
 		}
-		obj->bInNotify = false;
 	}
 }
 
 template<typename ParameterType>
 inline void ofParameter<ParameterType>::noEventsSetValue(const ParameterType & v){
 	obj->value = v;
+	if(obj->atomicValue){
+		obj->atomicValue->store(v);
+	}
+}
+
+template<typename ParameterType>
+void ofParameter<ParameterType>::setThreadSafe(bool threadSafe){
+	if(!threadSafe){
+		obj->atomicValue.reset();
+	}else if(!of::priv::AtomicValue<ParameterType>::supported){
+		ofLogError("ofParameter") << "setThreadSafe(): parameter \"" << getName() << "\" can't be thread safe, its type can't be copied with memcpy";
+	}else if(!obj->atomicValue){
+		obj->atomicValue.reset(new of::priv::AtomicValue<ParameterType>(obj->value));
+	}
+}
+
+template<typename ParameterType>
+bool ofParameter<ParameterType>::isThreadSafe() const{
+	return obj->atomicValue != nullptr;
+}
+
+template<typename ParameterType>
+inline ParameterType ofParameter<ParameterType>::getAtomic() const{
+	if(obj->atomicValue){
+		return obj->atomicValue->load();
+	}else{
+		return obj->value;
+	}
+}
+
+template<typename ParameterType>
+inline ofParameter<ParameterType> & ofParameter<ParameterType>::setAtomic(const ParameterType & v){
+	if(obj->atomicValue){
+		obj->atomicValue->store(v);
+		obj->changedAtomically.store(true, std::memory_order_release);
+	}else{
+		ofLogError("ofParameter") << "setAtomic(): parameter \"" << getName() << "\" is not thread safe, call setThreadSafe(true) first";
+		set(v);
+	}
+	return *this;
+}
+
+template<typename ParameterType>
+bool ofParameter<ParameterType>::notifyPendingChange(){
+	if(!obj->atomicValue
+	   || !obj->changedAtomically.load(std::memory_order_relaxed)
+	   || !obj->changedAtomically.exchange(false, std::memory_order_acquire)){
+		return false;
+	}
+	// the value stored in the atomic copy is already the last one, setting
+	// it again could overwrite a newer value set by another thread meanwhile
+	obj->value = obj->atomicValue->load();
+	if(!obj->bInNotify){
+		obj->bInNotify = true;
+		notifyChanged();
+		obj->bInNotify = false;
+	}
+	return true;
 }
 
 
@@ -1070,6 +1250,54 @@ private:
 
 
 
+/// \brief ofParameterChangeQueue notifies the changes made from other threads
+/// with ofParameter::setAtomic in the thread that calls notify.
+///
+/// Setting a parameter from the audio, OSC or any other thread with setAtomic
+/// doesn't call its listeners in that thread, it only marks the parameter as
+/// changed. notify then calls the listeners of every parameter in the queue
+/// that changed since the last call, once with its last value, so writing a
+/// parameter never waits for the thread that notifies it.
+///
+/// ~~~~{.cpp}
+/// volume.setThreadSafe(true);
+/// changes.add(volume);
+/// changes.setNotifyOnUpdate(true);
+///
+/// // in the audio thread
+/// float gain = volume.getAtomic();
+/// // in the osc thread, volume's listeners are called before the next update
+/// volume.setAtomic(message.getArgAsFloat(0));
+/// ~~~~
+///
+/// add, remove and notify have to be called from the same thread.
+class ofParameterChangeQueue{
+public:
+	ofParameterChangeQueue(){}
+	ofParameterChangeQueue(const ofParameterChangeQueue &) = delete;
+	ofParameterChangeQueue & operator=(const ofParameterChangeQueue &) = delete;
+
+	/// adds a parameter, or every parameter a group contains when it is added
+	void add(ofAbstractParameter & parameter);
+	void remove(ofAbstractParameter & parameter);
+	void clear();
+
+	/// notifies the parameters that changed since the last call
+	/// \returns the number of parameters notified
+	std::size_t notify();
+
+	/// calls notify from the main thread before every update
+	void setNotifyOnUpdate(bool notifyOnUpdate);
+	bool isNotifyingOnUpdate() const;
+
+private:
+	std::vector<std::shared_ptr<ofAbstractParameter>> parameters;
+	ofEventListener updateListener;
+	bool notifyOnUpdate = false;
+};
+
+
+
 /// \brief ofReadOnlyParameter holds a value and notifies its listeners when it changes.
 ///
 /// ofReadOnlyParameter is a "read only" version of `ofPareameter`.  "Friend"
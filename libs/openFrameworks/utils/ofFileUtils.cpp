@@ -2,6 +2,9 @@
 #ifndef TARGET_WIN32
 	#include <pwd.h>
 	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
 #endif
 
 #include "ofUtils.h"
@@ -411,6 +414,153 @@ bool ofBufferToFile(const std::filesystem::path & path, const ofBuffer& buffer,
 	return buffer.writeTo(f);
 }
 
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+// -- ofMemoryMappedFile
+//------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------
+ofMemoryMappedFile::ofMemoryMappedFile()
+:data(nullptr)
+,dataSize(0)
+,opened(false)
+#ifdef TARGET_WIN32
+,file(INVALID_HANDLE_VALUE)
+,mapping(nullptr)
+#endif
+{
+}
+
+//--------------------------------------------------
+ofMemoryMappedFile::ofMemoryMappedFile(const std::filesystem::path & path)
+:ofMemoryMappedFile(){
+	open(path);
+}
+
+//--------------------------------------------------
+ofMemoryMappedFile::~ofMemoryMappedFile(){
+	close();
+}
+
+//--------------------------------------------------
+ofMemoryMappedFile::ofMemoryMappedFile(ofMemoryMappedFile && other)
+:ofMemoryMappedFile(){
+	*this = std::move(other);
+}
+
+//--------------------------------------------------
+ofMemoryMappedFile & ofMemoryMappedFile::operator=(ofMemoryMappedFile && other){
+	if(this != &other){
+		close();
+		std::swap(data, other.data);
+		std::swap(dataSize, other.dataSize);
+		std::swap(opened, other.opened);
+#ifdef TARGET_WIN32
+		std::swap(file, other.file);
+		std::swap(mapping, other.mapping);
+#endif
+	}
+	return *this;
+}
+
+//--------------------------------------------------
+bool ofMemoryMappedFile::open(const std::filesystem::path & path){
+	close();
+	auto absolutePath = ofToDataPath(path, true);
+#ifdef TARGET_WIN32
+	file = CreateFileW(std::filesystem::path(absolutePath).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE){
+		ofLogError("ofMemoryMappedFile") << "open(): couldn't open \"" << absolutePath << "\"";
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(file, &fileSize)){
+		ofLogError("ofMemoryMappedFile") << "open(): couldn't get size of \"" << absolutePath << "\"";
+		close();
+		return false;
+	}
+	dataSize = fileSize.QuadPart;
+	if(dataSize > 0){
+		mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if(mapping){
+			data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		}
+		if(!data){
+			ofLogError("ofMemoryMappedFile") << "open(): couldn't map \"" << absolutePath << "\"";
+			close();
+			return false;
+		}
+	}
+#else
+	int fd = ::open(absolutePath.c_str(), O_RDONLY);
+	if(fd == -1){
+		ofLogError("ofMemoryMappedFile") << "open(): couldn't open \"" << absolutePath << "\"";
+		return false;
+	}
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) == -1){
+		ofLogError("ofMemoryMappedFile") << "open(): couldn't get size of \"" << absolutePath << "\"";
+		::close(fd);
+		return false;
+	}
+	dataSize = fileStat.st_size;
+	if(dataSize > 0){
+		// the mapping stays valid after closing the file descriptor
+		void * mapped = mmap(nullptr, dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(mapped == MAP_FAILED){
+			ofLogError("ofMemoryMappedFile") << "open(): couldn't map \"" << absolutePath << "\"";
+			::close(fd);
+			dataSize = 0;
+			return false;
+		}
+		data = static_cast<const char*>(mapped);
+	}
+	::close(fd);
+#endif
+	opened = true;
+	return true;
+}
+
+//--------------------------------------------------
+void ofMemoryMappedFile::close(){
+#ifdef TARGET_WIN32
+	if(data){
+		UnmapViewOfFile(data);
+	}
+	if(mapping){
+		CloseHandle(mapping);
+		mapping = nullptr;
+	}
+	if(file != INVALID_HANDLE_VALUE){
+		CloseHandle(file);
+		file = INVALID_HANDLE_VALUE;
+	}
+#else
+	if(data){
+		munmap(const_cast<char*>(data), dataSize);
+	}
+#endif
+	data = nullptr;
+	dataSize = 0;
+	opened = false;
+}
+
+//--------------------------------------------------
+bool ofMemoryMappedFile::isOpen() const{
+	return opened;
+}
+
+//--------------------------------------------------
+const char * ofMemoryMappedFile::getData() const{
+	return data;
+}
+
+//--------------------------------------------------
+std::size_t ofMemoryMappedFile::size() const{
+	return dataSize;
+}
+
 //------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------
 // -- ofFile
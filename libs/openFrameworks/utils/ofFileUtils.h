@@ -289,6 +289,55 @@ ofBuffer ofBufferFromFile(const std::filesystem::path & path, bool binary=true);
 /// split at endline characters automatically
 bool ofBufferToFile(const std::filesystem::path & path, const ofBuffer& buffer, bool binary=true);
 
+//--------------------------------------------------
+/// \class ofMemoryMappedFile
+///
+/// Read only view of a whole file mapped into memory.
+///
+/// The contents are paged in by the OS as they are accessed instead of
+/// being copied into a buffer, which makes parsing large files faster.
+/// The data is not null terminated.
+///
+class ofMemoryMappedFile{
+public:
+	ofMemoryMappedFile();
+
+	/// Map the file at path, check isOpen() to know if it succeeded.
+	ofMemoryMappedFile(const std::filesystem::path & path);
+	~ofMemoryMappedFile();
+
+	ofMemoryMappedFile(const ofMemoryMappedFile &) = delete;
+	ofMemoryMappedFile & operator=(const ofMemoryMappedFile &) = delete;
+	ofMemoryMappedFile(ofMemoryMappedFile && other);
+	ofMemoryMappedFile & operator=(ofMemoryMappedFile && other);
+
+	/// Map the file at path, relative paths are relative to the data folder.
+	///
+	/// \returns true if the file could be opened and mapped
+	bool open(const std::filesystem::path & path);
+
+	/// Unmap the file.
+	void close();
+
+	/// \returns true if a file is mapped, empty files are open but have no data
+	bool isOpen() const;
+
+	/// \returns pointer to the start of the file or nullptr if it's empty
+	const char * getData() const;
+
+	/// \returns size of the file in bytes
+	std::size_t size() const;
+
+private:
+	const char * data;
+	std::size_t dataSize;
+	bool opened;
+#ifdef TARGET_WIN32
+	HANDLE file;
+	HANDLE mapping;
+#endif
+};
+
 //--------------------------------------------------
 /// \class ofFilePath
 ///
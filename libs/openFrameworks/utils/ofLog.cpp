@@ -1,25 +1,52 @@
 #include "ofLog.h"
 #include "ofConstants.h"
 #include <ofUtils.h>
+#include "ofThreadChannel.h"
 #include <map>
 #include <cstdarg>
+#include <algorithm>
 #ifdef TARGET_ANDROID
 	#include "ofxAndroidLogChannel.h"
 #endif
 
 using namespace std;
 
-static ofLogLevel currentLogLevel =  OF_LOG_NOTICE;
-
 bool ofLog::bAutoSpace = false;
 string & ofLog::getPadding() {
 	static string * padding = new string;
 	return *padding;
 }
 
-static map<string,ofLogLevel> & getModules(){
-	static map<string,ofLogLevel> * modules = new map<string,ofLogLevel>;
-	return *modules;
+namespace{
+	struct LogLevels{
+		LogLevels()
+		:level(OF_LOG_NOTICE)
+		,minLevel(OF_LOG_NOTICE)
+		,maxLevel(OF_LOG_NOTICE){}
+
+		// the lowest and highest of the global and module levels, messages
+		// outside of them are accepted or filtered without a module lookup
+		void updateBounds(){
+			ofLogLevel minimum = level, maximum = level;
+			for(auto & module: modules){
+				minimum = std::min(minimum, module.second);
+				maximum = std::max(maximum, module.second);
+			}
+			minLevel.store(minimum, std::memory_order_relaxed);
+			maxLevel.store(maximum, std::memory_order_relaxed);
+		}
+
+		std::mutex mutex;
+		map<string,ofLogLevel> modules;
+		std::atomic<ofLogLevel> level;
+		std::atomic<ofLogLevel> minLevel;
+		std::atomic<ofLogLevel> maxLevel;
+	};
+}
+
+static LogLevels & getLevels(){
+	static LogLevels * levels = new LogLevels;
+	return *levels;
 }
 
 static void noopDeleter(ofBaseLoggerChannel*){}
@@ -38,25 +65,34 @@ shared_ptr<ofBaseLoggerChannel> & ofLog::channel(){
 
 //--------------------------------------------------
 void ofSetLogLevel(ofLogLevel level){
-	currentLogLevel = level;
+	auto & levels = getLevels();
+	std::unique_lock<std::mutex> lock(levels.mutex);
+	levels.level.store(level, std::memory_order_relaxed);
+	levels.updateBounds();
 }
 
 //--------------------------------------------------
 void ofSetLogLevel(string module, ofLogLevel level){
-	getModules()[module] = level;
+	auto & levels = getLevels();
+	std::unique_lock<std::mutex> lock(levels.mutex);
+	levels.modules[module] = level;
+	levels.updateBounds();
 }
 
 //--------------------------------------------------
 ofLogLevel ofGetLogLevel(){
-	return currentLogLevel;
+	return getLevels().level.load(std::memory_order_relaxed);
 }
 
 //--------------------------------------------------
 ofLogLevel ofGetLogLevel(string module){
-	if (getModules().find(module) == getModules().end()) {
-		return currentLogLevel;
+	auto & levels = getLevels();
+	std::unique_lock<std::mutex> lock(levels.mutex);
+	auto it = levels.modules.find(module);
+	if (it == levels.modules.end()) {
+		return levels.level.load(std::memory_order_relaxed);
 	} else {
-		return getModules()[module];
+		return it->second;
 	}
 }
 
@@ -77,27 +113,29 @@ void ofLogToDebugView() {
 #endif
 
 //--------------------------------------------------
-ofLog::ofLog(){
-	level = OF_LOG_NOTICE;
-	module = "";
-	bPrinted = false;
+ofLog::ofLog()
+:bMessage(false){
+	init(OF_LOG_NOTICE, "");
 }
 		
 //--------------------------------------------------
-ofLog::ofLog(ofLogLevel _level){
-	level = _level;
-	module = "";
-	bPrinted = false;
+ofLog::ofLog(ofLogLevel _level)
+:bMessage(false){
+	init(_level, "");
 }
 
 //--------------------------------------------------
-ofLog::ofLog(ofLogLevel level, const string & message){
+ofLog::ofLog(ofLogLevel level, const string & message)
+:bActive(false)
+,bMessage(false){
 	_log(level,"",message);
 	bPrinted = true;
 }
 
 //--------------------------------------------------
-ofLog::ofLog(ofLogLevel level, const char* format, ...){
+ofLog::ofLog(ofLogLevel level, const char* format, ...)
+:bActive(false)
+,bMessage(false){
 	if(checkLog(level,"")){
 		va_list args;
 		va_start( args, format );
@@ -107,6 +145,33 @@ ofLog::ofLog(ofLogLevel level, const char* format, ...){
 	bPrinted = true;
 }
 
+//--------------------------------------------------
+ofLog::ofLog(Deferred)
+:bActive(false)
+,bMessage(false){
+	level = OF_LOG_NOTICE;
+	bPrinted = false;
+}
+
+//--------------------------------------------------
+void ofLog::init(ofLogLevel _level, const string & _module){
+	level = _level;
+	bPrinted = false;
+	bActive = checkLog(_level, _module);
+	if(bActive){
+		module = _module;
+	}
+}
+
+//--------------------------------------------------
+std::stringstream & ofLog::getMessage(){
+	if(!bMessage){
+		new (&messageStorage) std::stringstream;
+		bMessage = true;
+	}
+	return *reinterpret_cast<std::stringstream*>(&messageStorage);
+}
+
 //--------------------------------------------------
 void ofLog::setAutoSpace(bool autoSpace){
 	bAutoSpace = autoSpace;
@@ -120,19 +185,30 @@ void ofLog::setAutoSpace(bool autoSpace){
 
 //-------------------------------------------------------
 ofLog::~ofLog(){
-	// don't log if we printed in the constructor already
-	if(!bPrinted){
-		_log(level,module,message.str());
+	// don't log if we printed in the constructor already or the
+	// message was filtered when it was created
+	if(!bPrinted && bActive){
+		channel()->log(level, module, bMessage ? getMessage().str() : string());
+	}
+	if(bMessage){
+		typedef std::stringstream stream;
+		getMessage().~stream();
 	}
 }
 
 bool ofLog::checkLog(ofLogLevel level, const string & module){
-	if(getModules().find(module)==getModules().end()){
-		if(level >= currentLogLevel) return true;
+	auto & levels = getLevels();
+	// most messages are decided without locking by the levels bounds,
+	// only levels between the lowest and highest need to find the module
+	if(level < levels.minLevel.load(std::memory_order_relaxed)) return false;
+	if(level >= levels.maxLevel.load(std::memory_order_relaxed)) return true;
+	std::unique_lock<std::mutex> lock(levels.mutex);
+	auto it = levels.modules.find(module);
+	if(it == levels.modules.end()){
+		return level >= levels.level.load(std::memory_order_relaxed);
 	}else{
-		if(level >= getModules()[module]) return true;
+		return level >= it->second;
 	}
-	return false;
 }
 
 //-------------------------------------------------------
@@ -143,18 +219,19 @@ void ofLog::_log(ofLogLevel level, const string & module, const string & message
 }
 
 //--------------------------------------------------
-ofLogVerbose::ofLogVerbose(const string & _module){
-	level = OF_LOG_VERBOSE;
-	module = _module;
-	bPrinted=false;
+ofLogVerbose::ofLogVerbose(const string & _module)
+:ofLog(Deferred()){
+	init(OF_LOG_VERBOSE, _module);
 }
 
-ofLogVerbose::ofLogVerbose(const string & _module, const string & _message){
+ofLogVerbose::ofLogVerbose(const string & _module, const string & _message)
+:ofLog(Deferred()){
 	_log(OF_LOG_VERBOSE,_module,_message);
 	bPrinted = true;
 }
 
-ofLogVerbose::ofLogVerbose(const string & module, const char* format, ...){
+ofLogVerbose::ofLogVerbose(const string & module, const char* format, ...)
+:ofLog(Deferred()){
 	if(checkLog(OF_LOG_VERBOSE, module)){
 		va_list args;
 		va_start(args, format);
@@ -165,18 +242,19 @@ ofLogVerbose::ofLogVerbose(const string & module, const char* format, ...){
 }
 
 //--------------------------------------------------
-ofLogNotice::ofLogNotice(const string & _module){
-	level = OF_LOG_NOTICE;
-	module = _module;
-	bPrinted=false;
+ofLogNotice::ofLogNotice(const string & _module)
+:ofLog(Deferred()){
+	init(OF_LOG_NOTICE, _module);
 }
 
-ofLogNotice::ofLogNotice(const string & _module, const string & _message){
+ofLogNotice::ofLogNotice(const string & _module, const string & _message)
+:ofLog(Deferred()){
 	_log(OF_LOG_NOTICE,_module,_message);
 	bPrinted = true;
 }
 
-ofLogNotice::ofLogNotice(const string & module, const char* format, ...){
+ofLogNotice::ofLogNotice(const string & module, const char* format, ...)
+:ofLog(Deferred()){
 	if(checkLog(OF_LOG_NOTICE, module)){
 		va_list args;
 		va_start(args, format);
@@ -187,18 +265,19 @@ ofLogNotice::ofLogNotice(const string & module, const char* format, ...){
 }
 
 //--------------------------------------------------
-ofLogWarning::ofLogWarning(const string & _module){
-	level = OF_LOG_WARNING;
-	module = _module;
-	bPrinted=false;
+ofLogWarning::ofLogWarning(const string & _module)
+:ofLog(Deferred()){
+	init(OF_LOG_WARNING, _module);
 }
 
-ofLogWarning::ofLogWarning(const string & _module, const string & _message){
+ofLogWarning::ofLogWarning(const string & _module, const string & _message)
+:ofLog(Deferred()){
 	_log(OF_LOG_WARNING,_module,_message);
 	bPrinted = true;
 }
 
-ofLogWarning::ofLogWarning(const string & module, const char* format, ...){
+ofLogWarning::ofLogWarning(const string & module, const char* format, ...)
+:ofLog(Deferred()){
 	if(checkLog(OF_LOG_WARNING, module)){
 		va_list args;
 		va_start(args, format);
@@ -209,18 +288,19 @@ ofLogWarning::ofLogWarning(const string & module, const char* format, ...){
 }
 
 //--------------------------------------------------
-ofLogError::ofLogError(const string & _module){
-	level = OF_LOG_ERROR;
-	module = _module;
-	bPrinted=false;
+ofLogError::ofLogError(const string & _module)
+:ofLog(Deferred()){
+	init(OF_LOG_ERROR, _module);
 }
 
-ofLogError::ofLogError(const string & _module, const string & _message){
+ofLogError::ofLogError(const string & _module, const string & _message)
+:ofLog(Deferred()){
 	_log(OF_LOG_ERROR,_module,_message);
 	bPrinted = true;
 }
 
-ofLogError::ofLogError(const string & module, const char* format, ...){
+ofLogError::ofLogError(const string & module, const char* format, ...)
+:ofLog(Deferred()){
 	if(checkLog(OF_LOG_ERROR, module)){
 		va_list args;
 		va_start(args, format);
@@ -231,18 +311,19 @@ ofLogError::ofLogError(const string & module, const char* format, ...){
 }
 
 //--------------------------------------------------
-ofLogFatalError::ofLogFatalError(const string &  _module){
-	level = OF_LOG_FATAL_ERROR;
-	module = _module;
-	bPrinted=false;
+ofLogFatalError::ofLogFatalError(const string &  _module)
+:ofLog(Deferred()){
+	init(OF_LOG_FATAL_ERROR, _module);
 }
 
-ofLogFatalError::ofLogFatalError(const string & _module, const string & _message){
+ofLogFatalError::ofLogFatalError(const string & _module, const string & _message)
+:ofLog(Deferred()){
 	_log(OF_LOG_FATAL_ERROR,_module,_message);
 	bPrinted = true;
 }
 
-ofLogFatalError::ofLogFatalError(const string & module, const char* format, ...){
+ofLogFatalError::ofLogFatalError(const string & module, const char* format, ...)
+:ofLog(Deferred()){
 	if(checkLog(OF_LOG_FATAL_ERROR, module)){
 		va_list args;
 		va_start(args, format);
@@ -399,3 +480,218 @@ void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const cha
 	}
 	file << ofVAArgsToString(format,args) << endl;
 }
+
+//--------------------------------------------------
+namespace of{
+namespace priv{
+	struct LogMessage{
+		ofLogLevel level = OF_LOG_NOTICE;
+		uint64_t sequence = 0;
+		string module;
+		string message;
+	};
+
+	// the messages of one thread to one channel
+	struct LogQueue{
+		LogQueue(uint64_t channelId, std::size_t size, ofThreadChannelPolicy policy)
+		:channelId(channelId)
+		,threadId(std::this_thread::get_id())
+		,messages(size, policy)
+		,orphaned(false)
+		,channelClosed(false){}
+
+		uint64_t channelId;
+		std::thread::id threadId;
+		ofSPSCThreadChannel<LogMessage> messages;
+		std::atomic<bool> orphaned; // the thread that logged to it finished
+		std::atomic<bool> channelClosed;
+	};
+}
+}
+
+#if HAS_TLS
+namespace{
+	// the queues a thread has logged to, marked as orphaned when
+	// the thread finishes so the writer can release them
+	struct ThreadLogQueues{
+		~ThreadLogQueues(){
+			for(auto & queue: queues){
+				queue->orphaned.store(true, std::memory_order_release);
+			}
+		}
+		vector<shared_ptr<of::priv::LogQueue>> queues;
+	};
+}
+#endif
+
+ofAsyncLoggerChannel::ofAsyncLoggerChannel(shared_ptr<ofBaseLoggerChannel> _channel, std::size_t queueSize, bool blockWhenFull)
+:channel(_channel ? _channel : ofLog::getChannel())
+,queueSize(queueSize)
+,blockWhenFull(blockWhenFull)
+,sequence(0)
+,dropped(0)
+,writerWaiting(false)
+,flushRequested(0)
+,flushDone(0)
+,closed(false){
+	static std::atomic<uint64_t> nextId(0);
+	id = nextId++;
+	writer = std::thread(&ofAsyncLoggerChannel::writerFunction, this);
+}
+
+ofAsyncLoggerChannel::~ofAsyncLoggerChannel(){
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		closed = true;
+		condition.notify_all();
+	}
+	writer.join();
+	for(auto & queue: queues){
+		queue->channelClosed.store(true, std::memory_order_release);
+		queue->messages.close();
+	}
+}
+
+of::priv::LogQueue & ofAsyncLoggerChannel::getQueue(){
+#if HAS_TLS
+	thread_local ThreadLogQueues threadQueues;
+	auto & threadLocal = threadQueues.queues;
+	for(auto & queue: threadLocal){
+		if(queue->channelId == id){
+			return *queue;
+		}
+	}
+	// forget the queues of channels that were destroyed
+	threadLocal.erase(std::remove_if(threadLocal.begin(), threadLocal.end(), [](const shared_ptr<of::priv::LogQueue> & queue){
+		return queue->channelClosed.load(std::memory_order_acquire);
+	}), threadLocal.end());
+	auto policy = blockWhenFull ? OF_THREAD_CHANNEL_BLOCK : OF_THREAD_CHANNEL_DROP_NEWEST;
+	auto queue = std::make_shared<of::priv::LogQueue>(id, queueSize, policy);
+	threadLocal.push_back(queue);
+	std::unique_lock<std::mutex> lock(mutex);
+	queues.push_back(queue);
+	return *queue;
+#else
+	std::unique_lock<std::mutex> lock(mutex);
+	auto threadId = std::this_thread::get_id();
+	for(auto & queue: queues){
+		if(queue->threadId == threadId){
+			return *queue;
+		}
+	}
+	auto policy = blockWhenFull ? OF_THREAD_CHANNEL_BLOCK : OF_THREAD_CHANNEL_DROP_NEWEST;
+	queues.push_back(std::make_shared<of::priv::LogQueue>(id, queueSize, policy));
+	return *queues.back();
+#endif
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const string & message){
+	if(std::this_thread::get_id() == writer.get_id()){
+		// logged by the wrapped channel, queueing it could block the writer
+		channel->log(level, module, message);
+		return;
+	}
+	of::priv::LogMessage entry;
+	entry.level = level;
+	entry.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+	entry.module = module;
+	entry.message = message;
+	if(!getQueue().messages.send(std::move(entry))){
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	// pairs with the fence in the writer, either it sees the new message
+	// or we see that it's waiting and wake it up
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if(writerWaiting.load(std::memory_order_relaxed)){
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.notify_one();
+	}
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const char* format, ...){
+	va_list args;
+	va_start(args, format);
+	log(level, module, format, args);
+	va_end(args);
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const char* format, va_list args){
+	// the arguments are only valid during this call so format them here
+	log(level, module, ofVAArgsToString(format, args));
+}
+
+void ofAsyncLoggerChannel::flush(){
+	if(std::this_thread::get_id() == writer.get_id()){
+		return;
+	}
+	std::unique_lock<std::mutex> lock(mutex);
+	auto request = ++flushRequested;
+	condition.notify_one();
+	flushed.wait(lock, [&]{
+		return flushDone >= request || closed;
+	});
+}
+
+uint64_t ofAsyncLoggerChannel::getNumDropped() const{
+	return dropped.load(std::memory_order_relaxed);
+}
+
+shared_ptr<ofBaseLoggerChannel> ofAsyncLoggerChannel::getChannel() const{
+	return channel;
+}
+
+void ofAsyncLoggerChannel::writerFunction(){
+	vector<shared_ptr<of::priv::LogQueue>> current;
+	vector<of::priv::LogMessage> batch;
+	of::priv::LogMessage entry;
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true){
+		auto request = flushRequested;
+		current = queues;
+		lock.unlock();
+
+		// drain every queue and write the batch in the order the
+		// messages were logged
+		for(auto & queue: current){
+			while(queue->messages.tryReceive(entry)){
+				batch.push_back(std::move(entry));
+			}
+		}
+		std::sort(batch.begin(), batch.end(), [](const of::priv::LogMessage & a, const of::priv::LogMessage & b){
+			return a.sequence < b.sequence;
+		});
+		for(auto & message: batch){
+			channel->log(message.level, message.module, message.message);
+		}
+		bool wrote = !batch.empty();
+		batch.clear();
+
+		lock.lock();
+		// release the queues of finished threads once they are empty
+		queues.erase(std::remove_if(queues.begin(), queues.end(), [](const shared_ptr<of::priv::LogQueue> & queue){
+			return queue->orphaned.load(std::memory_order_acquire) && queue->messages.empty();
+		}), queues.end());
+		if(flushDone < request){
+			flushDone = request;
+			flushed.notify_all();
+		}
+		if(wrote || flushDone < flushRequested){
+			continue;
+		}
+		if(closed){
+			break;
+		}
+
+		writerWaiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		bool pending = std::any_of(queues.begin(), queues.end(), [](const shared_ptr<of::priv::LogQueue> & queue){
+			return !queue->messages.empty();
+		});
+		if(!pending){
+			condition.wait_for(lock, std::chrono::milliseconds(100));
+		}
+		writerWaiting.store(false, std::memory_order_relaxed);
+	}
+	flushed.notify_all();
+}
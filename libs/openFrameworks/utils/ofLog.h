@@ -3,6 +3,10 @@
 #include "ofConstants.h"
 #include "ofFileUtils.h"
 #include <sstream>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 /// \file
 /// ofLog provides an interface for writing text output from your app.
@@ -477,7 +481,11 @@ class ofLog{
 		/// \returns A reference to itself.
 		template <class T> 
 		ofLog& operator<<(const T& value){
-			message << value << getPadding();
+			// the level is checked on construction so filtered
+			// messages are never formatted
+			if(bActive){
+				getMessage() << value << getPadding();
+			}
 			return *this;
 		}
 	
@@ -489,7 +497,9 @@ class ofLog{
 		/// \param func A function pointer that takes a std::ostream as an argument.
 		/// \returns A reference to itself.
 		ofLog& operator<<(std::ostream& (*func)(std::ostream&)){
-			func(message);
+			if(bActive){
+				func(getMessage());
+			}
 			return *this;
 		}
 	
@@ -503,6 +513,7 @@ class ofLog{
 
 		ofLogLevel level; ///< Log level.
 		bool bPrinted;	  ///< Has the message been printed in the constructor?
+		bool bActive;	  ///< Will the streamed message be printed?
 		std::string module;    ///< The destination module for this message.
 		
 		/// \brief Print a log line.
@@ -521,8 +532,31 @@ class ofLog{
 	
 		/// \endcond
 	
+		/// \brief Tag for the constructor used by the derived classes.
+		struct Deferred{};
+
+		/// \brief Create a log without checking its level.
+		///
+		/// The derived classes set their level and module with init() or
+		/// log in their constructor instead.
+		ofLog(Deferred);
+
+		/// \brief Check the level and start streaming a message.
+		///
+		/// Called by the stream style constructors, if the message is
+		/// filtered anything streamed to it is ignored.
+		///
+		/// \param level The log level.
+		/// \param module The target module.
+		void init(ofLogLevel level, const std::string & module);
+
 	private:
-		std::stringstream message;	///< Temporary buffer.
+		/// \brief The buffer for the streamed message, it is only
+		/// constructed when the first value is streamed into an active log.
+		std::stringstream & getMessage();
+
+		typename std::aligned_storage<sizeof(std::stringstream), alignof(std::stringstream)>::type messageStorage;	///< Temporary buffer.
+		bool bMessage;	///< Has the buffer been constructed?
 		
 		static bool bAutoSpace; ///< Should space be added between messages?
 		
@@ -720,4 +754,70 @@ private:
 	
 };
 
+namespace of{
+namespace priv{
+	struct LogQueue;
+}
+}
+
+/// \brief A logger channel that writes its messages to another channel from
+/// a background thread.
+///
+/// Logging to it only formats the message and pushes it into a lock-free
+/// queue owned by the calling thread, so threads that can't wait for the
+/// console or a file, like audio or video callbacks, can log too. A writer
+/// thread collects the messages of every thread in batches and passes them
+/// to the wrapped channel in the order they were logged.
+///
+/// ~~~~{.cpp}
+/// ofSetLoggerChannel(std::make_shared<ofAsyncLoggerChannel>(std::make_shared<ofFileLoggerChannel>("log.txt", false)));
+/// ~~~~
+class ofAsyncLoggerChannel: public ofBaseLoggerChannel{
+public:
+	/// \brief Create an ofAsyncLoggerChannel.
+	/// \param channel The channel messages are written to, if null the
+	/// current logger channel is used.
+	/// \param queueSize The maximum number of messages waiting per thread.
+	/// \param blockWhenFull True to wait for the writer when a thread's queue
+	/// is full, by default messages are dropped instead.
+	ofAsyncLoggerChannel(std::shared_ptr<ofBaseLoggerChannel> channel = nullptr, std::size_t queueSize = 1024, bool blockWhenFull = false);
+
+	/// \brief Write every pending message and stop the writer thread.
+	virtual ~ofAsyncLoggerChannel();
+
+	void log(ofLogLevel level, const std::string & module, const std::string & message);
+	void log(ofLogLevel level, const std::string & module, const char* format, ...) OF_PRINTF_ATTR(4, 5);
+	void log(ofLogLevel level, const std::string & module, const char* format, va_list args);
+
+	/// \brief Wait until the messages logged before this call are written.
+	void flush();
+
+	/// \returns The number of messages dropped because their queue was full.
+	uint64_t getNumDropped() const;
+
+	/// \returns The channel messages are written to.
+	std::shared_ptr<ofBaseLoggerChannel> getChannel() const;
+
+private:
+	of::priv::LogQueue & getQueue();
+	void writerFunction();
+
+	std::shared_ptr<ofBaseLoggerChannel> channel;
+	std::size_t queueSize;
+	bool blockWhenFull;
+	uint64_t id; ///< Identifies the queues of this channel in each thread.
+	std::atomic<uint64_t> sequence; ///< Orders the messages of every thread.
+	std::atomic<uint64_t> dropped;
+	std::atomic<bool> writerWaiting;
+
+	mutable std::mutex mutex;
+	std::condition_variable condition; ///< Wakes up the writer.
+	std::condition_variable flushed; ///< Signals a finished batch to flush.
+	std::vector<std::shared_ptr<of::priv::LogQueue>> queues;
+	uint64_t flushRequested;
+	uint64_t flushDone;
+	bool closed;
+	std::thread writer;
+};
+
 /// \endcond
@@ -4,6 +4,10 @@
 #include <mutex>
 #include <queue>
 #include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <chrono>
 
 
 /// \brief Safely send data between threads without additional synchronization.
@@ -292,3 +296,284 @@ private:
 	bool closed;
 
 };
+
+
+/// \brief What an ofSPSCThreadChannel does when sending to a full channel.
+enum ofThreadChannelPolicy{
+	/// \brief Block the sending thread until the receiver makes space.
+	OF_THREAD_CHANNEL_BLOCK,
+	/// \brief Discard the oldest value waiting in the channel.
+	OF_THREAD_CHANNEL_DROP_OLDEST,
+	/// \brief Discard the value being sent.
+	OF_THREAD_CHANNEL_DROP_NEWEST,
+};
+
+/// \brief A bounded ofThreadChannel for exactly one sending and one receiving thread.
+///
+/// ofSPSCThreadChannel has the same send / receive / tryReceive / close
+/// interface as ofThreadChannel but stores the values in a fixed size ring
+/// allocated on construction, and sending and receiving don't take any lock
+/// unless a thread has to sleep waiting for the other one. This makes it
+/// much cheaper for high frequency data like audio buffers, video frames or
+/// network messages, as long as only one thread sends and only one thread
+/// receives.
+///
+/// Since the channel can't grow, the ofThreadChannelPolicy passed on
+/// construction decides what happens when sending while it's full: wait for
+/// the receiver, drop the oldest value or drop the value being sent.
+///
+/// ~~~~{.cpp}
+/// // keep at most 4 frames, the receiver always gets the most recent ones
+/// ofSPSCThreadChannel<ofPixels> frames(4, OF_THREAD_CHANNEL_DROP_OLDEST);
+/// ~~~~
+///
+/// As with ofThreadChannel, received values are swapped with the slot in the
+/// channel so a receiver that keeps reusing the same value and a sender that
+/// moves values in don't reallocate in the steady state.
+///
+/// \tparam T The data type sent by the channel, must be default constructible.
+template<typename T>
+class ofSPSCThreadChannel{
+public:
+	/// \brief Create a channel that can hold up to capacity values.
+	///
+	/// \param capacity The maximum number of values waiting in the channel,
+	/// rounded up to a power of two.
+	/// \param policy What to do when sending to a full channel.
+	ofSPSCThreadChannel(std::size_t capacity = 64, ofThreadChannelPolicy policy = OF_THREAD_CHANNEL_BLOCK)
+	:policy(policy)
+	,closed(false)
+	,receiverWaiting(false)
+	,senderWaiting(false)
+	,dropped(0){
+		std::size_t size = 1;
+		while(size < capacity) size *= 2;
+		slots = std::vector<Slot>(size);
+		for(std::size_t i = 0; i < size; i++){
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		mask = size - 1;
+		head.value.store(0, std::memory_order_relaxed);
+		tail.value.store(0, std::memory_order_relaxed);
+	}
+
+	ofSPSCThreadChannel(const ofSPSCThreadChannel &) = delete;
+	ofSPSCThreadChannel & operator=(const ofSPSCThreadChannel &) = delete;
+
+	/// \brief Block the receiving thread until a new sent value is available.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \returns True if a new value was received or false if the channel was closed.
+	bool receive(T & sentValue){
+		while(!closed.load(std::memory_order_acquire)){
+			if(pop(sentValue)){
+				return true;
+			}
+			waitFor(receiverWaiting, [this]{ return readable(); }, -1);
+		}
+		return false;
+	}
+
+	/// \brief If available, receive a new sent value without blocking.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \returns True if a new value was received, false if there was no new
+	/// data or the channel was closed.
+	bool tryReceive(T & sentValue){
+		if(closed.load(std::memory_order_acquire)){
+			return false;
+		}
+		return pop(sentValue);
+	}
+
+	/// \brief If available, receive a new sent value or wait for a user-specified duration.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \param timeoutMs The number of milliseconds to wait for new data before continuing.
+	/// \returns True if a new value was received, false if there was no new
+	/// data or the channel was closed.
+	bool tryReceive(T & sentValue, int64_t timeoutMs){
+		if(closed.load(std::memory_order_acquire)){
+			return false;
+		}
+		if(pop(sentValue)){
+			return true;
+		}
+		waitFor(receiverWaiting, [this]{ return readable(); }, timeoutMs);
+		return !closed.load(std::memory_order_acquire) && pop(sentValue);
+	}
+
+	/// \brief Send a value to the receiver by making a copy.
+	///
+	/// \returns true if the value was sent, false if the channel was closed
+	/// or the value was dropped because the channel was full and the policy
+	/// is OF_THREAD_CHANNEL_DROP_NEWEST.
+	bool send(const T & value){
+		T copy(value);
+		return send(std::move(copy));
+	}
+
+	/// \brief Send a value to the receiver without making a copy.
+	///
+	/// The original value is invalidated even if the send fails.
+	///
+	/// \returns true if the value was sent, false if the channel was closed
+	/// or the value was dropped because the channel was full and the policy
+	/// is OF_THREAD_CHANNEL_DROP_NEWEST.
+	bool send(T && value){
+		while(!closed.load(std::memory_order_acquire)){
+			std::size_t position = tail.value.load(std::memory_order_relaxed);
+			Slot & slot = slots[position & mask];
+			if(slot.sequence.load(std::memory_order_acquire) != position && !dropOldest(position)){
+				// full
+				if(policy == OF_THREAD_CHANNEL_DROP_NEWEST){
+					dropped.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				if(policy == OF_THREAD_CHANNEL_BLOCK){
+					waitFor(senderWaiting, [this]{ return writable(); }, -1);
+				}else{
+					// the receiver is reading the oldest value, let it finish
+					std::this_thread::yield();
+				}
+				continue;
+			}
+			slot.value = std::move(value);
+			slot.sequence.store(position + 1, std::memory_order_release);
+			tail.value.store(position + 1, std::memory_order_relaxed);
+			wake(receiverWaiting);
+			return true;
+		}
+		return false;
+	}
+
+	/// \brief Close the channel.
+	///
+	/// No new values can be sent or received after closing, threads waiting
+	/// to send or receive are woken up and return false.
+	void close(){
+		std::unique_lock<std::mutex> lock(mutex);
+		closed.store(true, std::memory_order_release);
+		condition.notify_all();
+	}
+
+	/// \brief Queries empty channel.
+	///
+	/// This call is only an approximation, since values come from a different
+	/// thread.
+	bool empty() const{
+		return !readable();
+	}
+
+	/// \returns the maximum number of values waiting in the channel.
+	std::size_t capacity() const{
+		return slots.size();
+	}
+
+	/// \returns how many values have been dropped because the channel was full.
+	uint64_t getNumDropped() const{
+		return dropped.load(std::memory_order_relaxed);
+	}
+
+private:
+	// each slot has a sequence number: equal to the position it will be
+	// written at when free and to that position + 1 once written
+	struct Slot{
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	// keeps the producer and consumer indices in different cache lines
+	struct alignas(64) PaddedIndex{
+		std::atomic<std::size_t> value;
+		char padding[64 - sizeof(std::atomic<std::size_t>)];
+	};
+
+	bool readable() const{
+		std::size_t position = head.value.load(std::memory_order_relaxed);
+		return slots[position & mask].sequence.load(std::memory_order_acquire) == position + 1;
+	}
+
+	bool writable() const{
+		std::size_t position = tail.value.load(std::memory_order_relaxed);
+		return slots[position & mask].sequence.load(std::memory_order_acquire) == position;
+	}
+
+	bool pop(T & sentValue){
+		std::size_t position = head.value.load(std::memory_order_relaxed);
+		while(true){
+			Slot & slot = slots[position & mask];
+			if(slot.sequence.load(std::memory_order_acquire) != position + 1){
+				return false;
+			}
+			if(policy == OF_THREAD_CHANNEL_DROP_OLDEST){
+				// the sender might be claiming the same value to drop it
+				if(!head.value.compare_exchange_weak(position, position + 1, std::memory_order_acq_rel, std::memory_order_relaxed)){
+					continue;
+				}
+			}else{
+				head.value.store(position + 1, std::memory_order_relaxed);
+			}
+			std::swap(sentValue, slot.value);
+			slot.sequence.store(position + slots.size(), std::memory_order_release);
+			wake(senderWaiting);
+			return true;
+		}
+	}
+
+	// when full the oldest value lives in the slot about to be written,
+	// claiming it from the receiver frees the slot for the sender
+	bool dropOldest(std::size_t position){
+		if(policy != OF_THREAD_CHANNEL_DROP_OLDEST){
+			return false;
+		}
+		std::size_t oldest = position - slots.size();
+		if(head.value.compare_exchange_strong(oldest, oldest + 1, std::memory_order_acq_rel, std::memory_order_relaxed)){
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	// spins briefly and then sleeps until ready() or close(), the flag tells
+	// the other thread it has to notify
+	template<typename Ready>
+	void waitFor(std::atomic<bool> & waiting, Ready ready, int64_t timeoutMs){
+		for(int i = 0; i < 64; i++){
+			if(ready() || closed.load(std::memory_order_acquire)){
+				return;
+			}
+			std::this_thread::yield();
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		waiting.store(true, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto done = [&]{ return ready() || closed.load(std::memory_order_seq_cst); };
+		if(timeoutMs < 0){
+			condition.wait(lock, done);
+		}else{
+			condition.wait_for(lock, std::chrono::milliseconds(timeoutMs), done);
+		}
+		waiting.store(false, std::memory_order_relaxed);
+	}
+
+	void wake(std::atomic<bool> & waiting){
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(waiting.load(std::memory_order_seq_cst)){
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.notify_all();
+		}
+	}
+
+	PaddedIndex head; ///< next position to receive, owned by the receiver
+	PaddedIndex tail; ///< next position to send, owned by the sender
+	std::vector<Slot> slots;
+	std::size_t mask;
+	ofThreadChannelPolicy policy;
+	std::atomic<bool> closed;
+	std::atomic<bool> receiverWaiting;
+	std::atomic<bool> senderWaiting;
+	std::atomic<uint64_t> dropped;
+	std::mutex mutex;
+	std::condition_variable condition;
+};
@@ -87,6 +87,17 @@ static void on_eos_from_source (GstAppSink * elt, void * data){
 	((ofGstUtils*)data)->eos_cb();
 }
 
+#if GST_VERSION_MAJOR>0
+// flush stop is serialized with the samples, the ones before it are from
+// the position before a flushing seek
+static GstPadProbeReturn on_flush_from_source (GstPad * pad, GstPadProbeInfo * info, void * data){
+	if(GST_EVENT_TYPE(GST_PAD_PROBE_INFO_EVENT(info)) == GST_EVENT_FLUSH_STOP){
+		((ofGstUtils*)data)->flush_cb();
+	}
+	return GST_PAD_PROBE_OK;
+}
+#endif
+
 static gboolean appsink_plugin_init (GstPlugin * plugin)
 {
   gst_element_register (plugin, "appsink", GST_RANK_NONE, GST_TYPE_APP_SINK);
@@ -185,6 +196,9 @@ void ofGstUtils::eos_cb(){
 	}
 }
 
+void ofGstUtils::flush_cb(){
+}
+
 bool ofGstUtils::setPipelineWithSink(string pipeline, string sinkname, bool isStream){
 	ofGstUtils::startGstMainLoop();
 
@@ -273,6 +287,11 @@ bool ofGstUtils::startPipeline(){
 #endif
 
 			gst_app_sink_set_callbacks(GST_APP_SINK(gstSink), &gstCallbacks, this, NULL);
+#if GST_VERSION_MAJOR>0
+			GstPad * sinkPad = gst_element_get_static_pad(gstSink, "sink");
+			gst_pad_add_probe(sinkPad, GST_PAD_PROBE_TYPE_EVENT_FLUSH, &on_flush_from_source, this, NULL);
+			gst_object_unref(sinkPad);
+#endif
 		}
 	}
 
@@ -406,6 +425,25 @@ int64_t ofGstUtils::getDurationNanos() const{
 
 }
 
+int64_t ofGstUtils::getPositionNanos() const{
+	gint64 pos=-1;
+	if(gstPipeline){
+#if GST_VERSION_MAJOR==0
+		GstFormat format=GST_FORMAT_TIME;
+		if(!gst_element_query_position(GST_ELEMENT(gstPipeline),&format,&pos)){
+			ofLogVerbose("ofGstUtils") << "getPositionNanos(): couldn't query position";
+			return -1;
+		}
+#else
+		if(!gst_element_query_position(GST_ELEMENT(gstPipeline),GST_FORMAT_TIME,&pos)){
+			ofLogVerbose("ofGstUtils") << "getPositionNanos(): couldn't query position";
+			return -1;
+		}
+#endif
+	}
+	return pos;
+}
+
 bool  ofGstUtils::getIsMovieDone() const{
 	if(isAppSink){
 		return gst_app_sink_is_eos(GST_APP_SINK(gstSink));
@@ -802,6 +840,14 @@ ofGstVideoUtils::ofGstVideoUtils(){
 	glContext = NULL;
 #endif
 	copyPixels = false;
+#if GST_VERSION_MAJOR>0
+	numBuffers					= 1;
+	framePTSNanos				= -1;
+	frameDurationNanos			= -1;
+	prerollPTSNanos				= -1;
+	numDroppedFrames			= 0;
+	numLateFrames				= 0;
+#endif
 }
 
 ofGstVideoUtils::~ofGstVideoUtils(){
@@ -822,6 +868,12 @@ void ofGstVideoUtils::close(){
 	
 #if GST_VERSION_MAJOR==1
 	while(!bufferQueue.empty()) bufferQueue.pop();
+	clearFrames();
+	framePTSNanos				= -1;
+	frameDurationNanos			= -1;
+	prerollPTSNanos				= -1;
+	numDroppedFrames			= 0;
+	numLateFrames				= 0;
 #endif
 }
 
@@ -872,6 +924,13 @@ void ofGstVideoUtils::update(){
 					frontBuffer = backBuffer;
 				}
 			}
+#if GST_VERSION_MAJOR>0
+			if(!queuedFrames.empty()){
+				numDroppedFrames += queuedFrames.size() - 1;
+				makeCurrent(queuedFrames.size() - 1);
+				bHavePixelsChanged = true;
+			}
+#endif
 		}else{
 #if GST_VERSION_MAJOR==0
 			ofLogError() << "frame by frame doesn't work any more in 0.10";
@@ -1187,6 +1246,9 @@ bool ofGstVideoUtils::allocate(int w, int h, ofPixelFormat pixelFormat){
 
 	bHavePixelsChanged = false;
 	bBackPixelsChanged = true;
+#if GST_VERSION_MAJOR>0
+	clearFrames();
+#endif
 
 	internalPixelFormat = pixelFormat;
 	return pixels.isAllocated();
@@ -1203,6 +1265,12 @@ void ofGstVideoUtils::reallocateOnNextFrame(){
 	backBuffer.reset();
 #if GST_VERSION_MAJOR==1
 	while(!bufferQueue.empty()) bufferQueue.pop();
+	clearFrames();
+	framePTSNanos				= -1;
+	frameDurationNanos			= -1;
+	prerollPTSNanos				= -1;
+	numDroppedFrames			= 0;
+	numLateFrames				= 0;
 #endif
 }
 
@@ -1255,7 +1323,7 @@ static GstVideoInfo getVideoInfo(GstSample * sample){
     return vinfo;
 }
 
-GstFlowReturn ofGstVideoUtils::process_sample(shared_ptr<GstSample> sample){
+GstFlowReturn ofGstVideoUtils::process_sample(shared_ptr<GstSample> sample, bool preroll){
 	GstBuffer * _buffer = gst_sample_get_buffer(sample.get());
 
 #ifdef OF_USE_GST_GL
@@ -1302,55 +1370,203 @@ GstFlowReturn ofGstVideoUtils::process_sample(shared_ptr<GstSample> sample){
 	// video frame has normal texture
 	gst_buffer_map (_buffer, &mapinfo, GST_MAP_READ);
 	guint size = mapinfo.size;
+	int64_t ptsNanos = GST_BUFFER_PTS_IS_VALID(_buffer) ? GST_BUFFER_PTS(_buffer) : -1;
 
-	size_t stride = 0;
-	if(pixels.isAllocated() && (pixels.getTotalBytes() != size_t(size))){
-		GstVideoInfo v_info = getVideoInfo(sample.get());
-		stride = v_info.stride[0];
-
-		if(stride == (pixels.getWidth() * pixels.getBytesPerPixel())) {
-			ofLogError("ofGstVideoUtils") << "buffer_cb(): error on new buffer, buffer size: " << size << "!= init size: " << pixels.getTotalBytes();
-			return GST_FLOW_ERROR;
-		}
-	}
+	// take a free frame and the size of the current one, the frame is filled
+	// without holding the lock so update never waits for the copy
+	std::unique_ptr<Frame> frame;
 	mutex.lock();
-	if(!copyPixels){
-		backBuffer = sample;
+	bool allocated = pixels.isAllocated();
+	// the appsink delivers the prerolled buffer again as the first new
+	// sample, it's already queued so it's not a new frame
+	bool prerolled = !preroll && ptsNanos != -1 && ptsNanos == prerollPTSNanos;
+	prerollPTSNanos = preroll && allocated ? ptsNanos : -1;
+	if(prerolled){
+		mutex.unlock();
+		gst_buffer_unmap(_buffer, &mapinfo);
+		return GST_FLOW_OK;
 	}
-
-	if(pixels.isAllocated()){
-		if(stride > 0) {
-			if(pixels.getPixelFormat() == OF_PIXELS_I420){
-				GstVideoInfo v_info = getVideoInfo(sample.get());
-				std::vector<size_t> strides{size_t(v_info.stride[0]),size_t(v_info.stride[1]),size_t(v_info.stride[2])};
-				backPixels.setFromAlignedPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat(),strides);
-			} else {
-				backPixels.setFromAlignedPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat(),stride);
-			}
-		} else if(!copyPixels){
-			backPixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
-			eventPixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
+	size_t width = pixels.getWidth();
+	size_t height = pixels.getHeight();
+	size_t bytesPerPixel = pixels.getBytesPerPixel();
+	size_t totalBytes = pixels.getTotalBytes();
+	ofPixelFormat pixelFormat = pixels.getPixelFormat();
+	if(allocated){
+		if(freeFrames.empty()){
+			frame.reset(new Frame);
 		}else{
-			backPixels.setFromPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
+			frame = std::move(freeFrames.back());
+			freeFrames.pop_back();
 		}
+	}
+	mutex.unlock();
 
-		bBackPixelsChanged=true;
-		mutex.unlock();
-		if(stride == 0) {
-			ofNotifyEvent(prerollEvent,eventPixels);
-		}
-	}else{
-		mutex.unlock();
+	if(!allocated){
 		if(appsink){
 			appsink->on_stream_prepared();
 		}else{
 			GstVideoInfo v_info = getVideoInfo(sample.get());
 			allocate(v_info.width,v_info.height,getOFFormat(v_info.finfo->format));
 		}
+		gst_buffer_unmap(_buffer, &mapinfo);
+		return GST_FLOW_OK;
 	}
+
+	size_t stride = 0;
+	if(totalBytes != size_t(size)){
+		GstVideoInfo v_info = getVideoInfo(sample.get());
+		stride = v_info.stride[0];
+
+		if(stride == (width * bytesPerPixel)) {
+			ofLogError("ofGstVideoUtils") << "buffer_cb(): error on new buffer, buffer size: " << size << "!= init size: " << totalBytes;
+			gst_buffer_unmap(_buffer, &mapinfo);
+			return GST_FLOW_ERROR;
+		}
+	}
+
+	if(stride > 0) {
+		if(pixelFormat == OF_PIXELS_I420){
+			GstVideoInfo v_info = getVideoInfo(sample.get());
+			std::vector<size_t> strides{size_t(v_info.stride[0]),size_t(v_info.stride[1]),size_t(v_info.stride[2])};
+			frame->pixels.setFromAlignedPixels(mapinfo.data,width,height,pixelFormat,strides);
+		} else {
+			frame->pixels.setFromAlignedPixels(mapinfo.data,width,height,pixelFormat,stride);
+		}
+	} else if(!copyPixels){
+		frame->pixels.setFromExternalPixels(mapinfo.data,width,height,pixelFormat);
+		frame->sample = sample;
+	}else{
+		frame->pixels.setFromPixels(mapinfo.data,width,height,pixelFormat);
+	}
+	frame->ptsNanos = ptsNanos;
+	frame->durationNanos = GST_BUFFER_DURATION_IS_VALID(_buffer) ? GST_BUFFER_DURATION(_buffer) : -1;
+
+	if(stride == 0) {
+		ofNotifyEvent(prerollEvent,frame->pixels);
+	}
+
+	mutex.lock();
+	queuedFrames.push_back(std::move(frame));
+	while(queuedFrames.size() > numBuffers){
+		recycleFrame(std::move(queuedFrames.front()));
+		queuedFrames.pop_front();
+		numDroppedFrames++;
+	}
+	mutex.unlock();
 	gst_buffer_unmap(_buffer, &mapinfo);
 	return GST_FLOW_OK;
 }
+
+void ofGstVideoUtils::makeCurrent(size_t queuedFrame){
+	auto & frame = queuedFrames[queuedFrame];
+	swap(pixels, frame->pixels);
+	swap(frontBuffer, frame->sample);
+	framePTSNanos = frame->ptsNanos;
+	frameDurationNanos = frame->durationNanos;
+
+	// the frame and the ones before it go back to the pool, the current
+	// frame now holds the previous pixels
+	for(size_t i = 0; i <= queuedFrame; i++){
+		recycleFrame(std::move(queuedFrames.front()));
+		queuedFrames.pop_front();
+	}
+}
+
+void ofGstVideoUtils::recycleFrame(std::unique_ptr<Frame> frame){
+	if(frame->sample){
+		// the pixels point to the memory of the sample
+		frame->pixels.clear();
+		frame->sample.reset();
+	}
+	freeFrames.push_back(std::move(frame));
+}
+
+void ofGstVideoUtils::clearFrames(){
+	queuedFrames.clear();
+	freeFrames.clear();
+}
+
+bool ofGstVideoUtils::updateToTime(int64_t timeNanos){
+	std::unique_lock<std::mutex> lock(mutex);
+	// frames are queued in presentation order, find the last one due
+	size_t numDue = 0;
+	while(numDue < queuedFrames.size() && queuedFrames[numDue]->ptsNanos <= timeNanos){
+		numDue++;
+	}
+	bIsFrameNew = numDue > 0;
+	if(bIsFrameNew){
+		numLateFrames += numDue - 1;
+		makeCurrent(numDue - 1);
+	}
+	return bIsFrameNew;
+}
+
+void ofGstVideoUtils::flushFrames(bool keepPreroll){
+	std::unique_lock<std::mutex> lock(mutex);
+	// the prerolled frame is the last one queued with its timestamp
+	std::unique_ptr<Frame> prerolled;
+	if(keepPreroll && prerollPTSNanos != -1){
+		for(size_t i = queuedFrames.size(); i > 0; i--){
+			if(queuedFrames[i - 1]->ptsNanos == prerollPTSNanos){
+				prerolled = std::move(queuedFrames[i - 1]);
+				queuedFrames.erase(queuedFrames.begin() + (i - 1));
+				break;
+			}
+		}
+	}
+	while(!queuedFrames.empty()){
+		recycleFrame(std::move(queuedFrames.front()));
+		queuedFrames.pop_front();
+	}
+	if(prerolled){
+		queuedFrames.push_back(std::move(prerolled));
+	}else{
+		// the prerolled frame is gone, queue it when it comes again
+		prerollPTSNanos = -1;
+	}
+}
+
+void ofGstVideoUtils::flush_cb(){
+	flushFrames();
+	ofGstUtils::flush_cb();
+}
+
+void ofGstVideoUtils::setNumBuffers(size_t numBuffers){
+	std::unique_lock<std::mutex> lock(mutex);
+	this->numBuffers = std::max(numBuffers, size_t(1));
+	while(queuedFrames.size() > this->numBuffers){
+		recycleFrame(std::move(queuedFrames.front()));
+		queuedFrames.pop_front();
+		numDroppedFrames++;
+	}
+}
+
+size_t ofGstVideoUtils::getNumBuffers() const{
+	return numBuffers;
+}
+
+int64_t ofGstVideoUtils::getFramePTSNanos() const{
+	return framePTSNanos;
+}
+
+int64_t ofGstVideoUtils::getFrameDurationNanos() const{
+	return frameDurationNanos;
+}
+
+size_t ofGstVideoUtils::getNumQueuedFrames() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return queuedFrames.size();
+}
+
+uint64_t ofGstVideoUtils::getNumDroppedFrames() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return numDroppedFrames;
+}
+
+uint64_t ofGstVideoUtils::getNumLateFrames() const{
+	std::unique_lock<std::mutex> lock(mutex);
+	return numLateFrames;
+}
 #endif
 
 #if GST_VERSION_MAJOR==0
@@ -1364,7 +1580,7 @@ GstFlowReturn ofGstVideoUtils::preroll_cb(shared_ptr<GstBuffer> buffer){
 }
 #else
 GstFlowReturn ofGstVideoUtils::preroll_cb(shared_ptr<GstSample> sample){
-	GstFlowReturn ret = process_sample(sample);
+	GstFlowReturn ret = process_sample(sample, true);
 	if(ret==GST_FLOW_OK){
 		return ofGstUtils::preroll_cb(sample);
 	}else{
@@ -1384,7 +1600,7 @@ GstFlowReturn ofGstVideoUtils::buffer_cb(shared_ptr<GstBuffer> buffer){
 }
 #else
 GstFlowReturn ofGstVideoUtils::buffer_cb(shared_ptr<GstSample> sample){
-	GstFlowReturn ret = process_sample(sample);
+	GstFlowReturn ret = process_sample(sample, false);
 	if(ret==GST_FLOW_OK){
 		return ofGstUtils::buffer_cb(sample);
 	}else{
@@ -1399,4 +1615,206 @@ void ofGstVideoUtils::eos_cb(){
 	ofNotifyEvent(eosEvent,args);
 }
 
+#if GST_VERSION_MAJOR>0
+//-------------------------------------------------
+//----------------------------------------- videoGroup
+//-------------------------------------------------
+
+// time for every pipeline to go to playing before the group starts
+static const GstClockTime GROUP_START_DELAY = 100 * GST_MSECOND;
+
+ofGstVideoGroup::ofGstVideoGroup()
+:clock(nullptr)
+,baseTime(0)
+,startPositionNanos(0)
+,pausedRunningTimeNanos(0)
+,bPlaying(false)
+,bPaused(true){}
+
+ofGstVideoGroup::~ofGstVideoGroup(){
+	clear();
+	if(clock){
+		gst_object_unref(clock);
+	}
+}
+
+// gives back a pipeline its own clock and lets it choose its base time
+// again when it goes to playing
+static void releasePipeline(GstElement * pipeline){
+	if(pipeline && GST_IS_PIPELINE(pipeline)){
+		gst_pipeline_auto_clock(GST_PIPELINE(pipeline));
+		gst_element_set_start_time(pipeline, 0);
+	}
+}
+
+bool ofGstVideoGroup::add(ofGstVideoUtils & video){
+	auto pipeline = video.getPipeline();
+	if(!pipeline || !GST_IS_PIPELINE(pipeline)){
+		ofLogError("ofGstVideoGroup") << "add(): the video doesn't have a pipeline, set one with setPipeline or setPipelineWithSink first";
+		return false;
+	}
+	if(!clock){
+		clock = gst_system_clock_obtain();
+	}
+	gst_pipeline_use_clock(GST_PIPELINE(pipeline), clock);
+	// the group sets the base time of the pipelines instead of each of
+	// them choosing its own when it goes to playing
+	gst_element_set_start_time(pipeline, GST_CLOCK_TIME_NONE);
+	if(!video.isLoaded() && !video.startPipeline()){
+		ofLogError("ofGstVideoGroup") << "add(): couldn't start the pipeline";
+		releasePipeline(pipeline);
+		return false;
+	}
+	videos.push_back(&video);
+	return true;
+}
+
+void ofGstVideoGroup::clear(){
+	for(auto video: videos){
+		releasePipeline(video->getPipeline());
+	}
+	videos.clear();
+	startPositionNanos = 0;
+	pausedRunningTimeNanos = 0;
+	bPlaying = false;
+	bPaused = true;
+}
+
+size_t ofGstVideoGroup::size() const{
+	return videos.size();
+}
+
+ofGstVideoUtils & ofGstVideoGroup::get(size_t video){
+	return *videos[video];
+}
+
+const ofGstVideoUtils & ofGstVideoGroup::get(size_t video) const{
+	return *videos[video];
+}
+
+void ofGstVideoGroup::play(){
+	bPlaying = true;
+	if(bPaused){
+		resume();
+	}
+}
+
+void ofGstVideoGroup::setPaused(bool paused){
+	if(!paused){
+		play();
+	}else if(bPlaying && !bPaused){
+		pausedRunningTimeNanos = getPositionNanos() - startPositionNanos;
+		for(auto video: videos){
+			video->setPaused(true);
+		}
+		bPaused = true;
+	}
+}
+
+void ofGstVideoGroup::resume(){
+	bPaused = false;
+	if(videos.empty()){
+		return;
+	}
+	// preroll the videos that haven't played yet so the delay only has
+	// to cover going from paused to playing
+	for(auto video: videos){
+		video->setPaused(true);
+	}
+	// every pipeline renders the frame for running time t at baseTime + t,
+	// the running time continues from where it was paused
+	baseTime = gst_clock_get_time(clock) + GROUP_START_DELAY - pausedRunningTimeNanos;
+	for(auto video: videos){
+		gst_element_set_base_time(video->getPipeline(), baseTime);
+	}
+	for(auto video: videos){
+		video->setPaused(false);
+	}
+}
+
+bool ofGstVideoGroup::isPaused() const{
+	return bPaused;
+}
+
+bool ofGstVideoGroup::isPlaying() const{
+	return bPlaying;
+}
+
+bool ofGstVideoGroup::getIsMovieDone() const{
+	if(videos.empty()){
+		return false;
+	}
+	for(auto video: videos){
+		if(!video->getIsMovieDone()){
+			return false;
+		}
+	}
+	return true;
+}
+
+void ofGstVideoGroup::setPositionNanos(int64_t positionNanos){
+	bool wasPlaying = bPlaying && !bPaused;
+	for(auto video: videos){
+		video->setPaused(true);
+		video->flushFrames();
+	}
+	GstSeekFlags flags = (GstSeekFlags) (GST_SEEK_FLAG_ACCURATE | GST_SEEK_FLAG_FLUSH);
+	for(size_t i = 0; i < videos.size(); i++){
+		if(!gst_element_seek_simple(videos[i]->getPipeline(), GST_FORMAT_TIME, flags, positionNanos)){
+			ofLogWarning("ofGstVideoGroup") << "setPositionNanos(): unable to seek video " << i;
+		}
+	}
+	// wait for every video to preroll at the new position
+	for(auto video: videos){
+		gst_element_get_state(video->getPipeline(), NULL, NULL, 2*GST_SECOND);
+	}
+	// frames from the old position could be queued until the seek
+	// flushed the pipelines, only keep the ones prerolled at the new one
+	for(auto video: videos){
+		video->flushFrames(true);
+	}
+	startPositionNanos = positionNanos;
+	pausedRunningTimeNanos = 0;
+	bPaused = true;
+	if(wasPlaying){
+		resume();
+	}
+}
+
+int64_t ofGstVideoGroup::getPositionNanos() const{
+	if(!bPlaying || bPaused || !clock){
+		return startPositionNanos + pausedRunningTimeNanos;
+	}
+	// stays at the paused position until the pipelines start again
+	int64_t runningTime = int64_t(gst_clock_get_time(clock)) - int64_t(baseTime);
+	return startPositionNanos + std::max(runningTime, pausedRunningTimeNanos);
+}
+
+size_t ofGstVideoGroup::update(){
+	// every video is updated to the same position so all of them show
+	// the frame for the same tick
+	auto position = getPositionNanos();
+	size_t numNewFrames = 0;
+	for(auto video: videos){
+		if(video->updateToTime(position)){
+			numNewFrames++;
+		}
+	}
+	return numNewFrames;
+}
+
+int64_t ofGstVideoGroup::getDriftNanos() const{
+	int64_t oldest = std::numeric_limits<int64_t>::max();
+	int64_t newest = std::numeric_limits<int64_t>::min();
+	for(auto video: videos){
+		auto pts = video->getFramePTSNanos();
+		if(pts >= 0){
+			oldest = std::min(oldest, pts);
+			newest = std::max(newest, pts);
+		}
+	}
+	return newest >= oldest ? newest - oldest : 0;
+}
+#endif
+
 #endif
@@ -11,6 +11,7 @@
 #include <gst/gstpad.h>
 #include <gst/video/video.h>
 #include <queue>
+#include <deque>
 #include <condition_variable>
 #include <mutex>
 
@@ -50,6 +51,7 @@ public:
 	float 	getSpeed() const;
 	float 	getDuration() const;
 	int64_t  getDurationNanos() const;
+	int64_t  getPositionNanos() const;
 	bool  	getIsMovieDone() const;
 
 	void 	setPosition(float pct);
@@ -80,6 +82,10 @@ public:
 	virtual GstFlowReturn buffer_cb(std::shared_ptr<GstSample> buffer);
 #endif
 	virtual void 		  eos_cb();
+	/// called from the streaming thread when a flushing seek, like a
+	/// setPosition or a loop, reaches the sink. the samples received
+	/// before it are from the old position
+	virtual void 		  flush_cb();
 
 	static void startGstMainLoop();
 	static GMainLoop * getGstMainLoop();
@@ -188,6 +194,42 @@ public:
 	// https://bugzilla.gnome.org/show_bug.cgi?id=737427
 	void setCopyPixels(bool copy);
 
+#if GST_VERSION_MAJOR>0
+	/// \brief Sets how many decoded frames can wait for update, 1 by default.
+	///
+	/// When a new frame arrives and the queue is full the oldest one is
+	/// dropped. Frames are recycled so their pixels are only allocated once,
+	/// without setCopyPixels each of them keeps a gstreamer buffer alive.
+	void setNumBuffers(size_t numBuffers);
+	size_t getNumBuffers() const;
+
+	/// \brief Makes current the last decoded frame whose presentation time
+	/// is at or before timeNanos, like getPositionNanos(), instead of the
+	/// newest one as update() does.
+	///
+	/// Call it instead of update() to pace the playback. Older frames that
+	/// were never current are counted as late.
+	/// \returns true if the current frame changed
+	bool updateToTime(int64_t timeNanos);
+
+	/// drops the frames waiting for update. flushing seeks, like
+	/// setPosition or a loop, already drop the frames from the old
+	/// position when they reach the sink. keepPreroll keeps the frame
+	/// prerolled at the new position
+	void flushFrames(bool keepPreroll = false);
+
+	/// presentation timestamp of the current frame, -1 if unknown
+	int64_t getFramePTSNanos() const;
+	/// duration of the current frame, -1 if unknown
+	int64_t getFrameDurationNanos() const;
+	/// frames waiting for update
+	size_t getNumQueuedFrames() const;
+	/// frames replaced by newer ones before being current
+	uint64_t getNumDroppedFrames() const;
+	/// frames skipped by updateToTime because a newer one was already due
+	uint64_t getNumLateFrames() const;
+#endif
+
 	// this events happen in a different thread
 	// do not use them for opengl stuff
 	ofEvent<ofPixels> prerollEvent;
@@ -200,9 +242,20 @@ protected:
 	GstFlowReturn preroll_cb(std::shared_ptr<GstBuffer> buffer);
 	GstFlowReturn buffer_cb(std::shared_ptr<GstBuffer> buffer);
 #else
-	GstFlowReturn process_sample(std::shared_ptr<GstSample> sample);
+	GstFlowReturn process_sample(std::shared_ptr<GstSample> sample, bool preroll);
 	GstFlowReturn preroll_cb(std::shared_ptr<GstSample> buffer);
 	GstFlowReturn buffer_cb(std::shared_ptr<GstSample> buffer);
+
+	struct Frame{
+		ofPixels pixels;
+		std::shared_ptr<GstSample> sample;
+		int64_t ptsNanos = -1;
+		int64_t durationNanos = -1;
+	};
+	void makeCurrent(size_t queuedFrame);
+	void recycleFrame(std::unique_ptr<Frame> frame);
+	void clearFrames();
+	void			flush_cb();
 #endif
 	void			eos_cb();
 
@@ -215,12 +268,20 @@ private:
 	bool			bIsFrameNew;			// if we are new
 	bool			bHavePixelsChanged;
 	bool			bBackPixelsChanged;
-	std::mutex		mutex;
+	mutable std::mutex	mutex;
 #if GST_VERSION_MAJOR==0
 	std::shared_ptr<GstBuffer> 	frontBuffer, backBuffer;
 #else
 	std::shared_ptr<GstSample> 	frontBuffer, backBuffer;
 	std::queue<std::shared_ptr<GstSample> > bufferQueue;
+	std::deque<std::unique_ptr<Frame>> queuedFrames;
+	std::vector<std::unique_ptr<Frame>> freeFrames;
+	size_t numBuffers;
+	int64_t framePTSNanos;
+	int64_t frameDurationNanos;
+	int64_t prerollPTSNanos;
+	uint64_t numDroppedFrames;
+	uint64_t numLateFrames;
 	GstMapInfo mapinfo;
 	#ifdef OF_USE_GST_GL
 		ofTexture		frontTexture, backTexture;
@@ -236,6 +297,75 @@ private:
 };
 
 
+#if GST_VERSION_MAJOR>0
+//-------------------------------------------------
+//----------------------------------------- videoGroup
+//-------------------------------------------------
+
+/// \brief Plays several ofGstVideoUtils in sync, like the clips of a video wall.
+///
+/// Every pipeline in the group runs on the same clock with the same base
+/// time, so frames with the same timestamp are rendered at the same moment
+/// and the videos don't drift apart. play, setPaused and setPositionNanos
+/// change every video at once, and update makes current in every video
+/// the frame due at the same position.
+///
+/// Add the videos before playing and use the group instead of their own
+/// play, setPaused, setPosition and update.
+///
+/// The group only keeps pointers to the videos, they have to outlive it
+/// or be removed with clear before being destroyed or closed. clear and
+/// the destructor give the videos back their own clock so they can play
+/// on their own again.
+class ofGstVideoGroup{
+public:
+	ofGstVideoGroup();
+	~ofGstVideoGroup();
+	ofGstVideoGroup(const ofGstVideoGroup &) = delete;
+	ofGstVideoGroup & operator=(const ofGstVideoGroup &) = delete;
+
+	/// adds a video whose pipeline has been set with setPipeline or
+	/// setPipelineWithSink, starting the pipeline if it wasn't
+	bool add(ofGstVideoUtils & video);
+	void clear();
+	size_t size() const;
+	ofGstVideoUtils & get(size_t video);
+	const ofGstVideoUtils & get(size_t video) const;
+
+	void play();
+	void setPaused(bool paused);
+	bool isPaused() const;
+	bool isPlaying() const;
+	bool getIsMovieDone() const;
+
+	/// seeks every video to the same position and waits for them to preroll
+	void setPositionNanos(int64_t positionNanos);
+	int64_t getPositionNanos() const;
+
+	/// \brief Makes current in every video the frame due at the position
+	/// of the group.
+	///
+	/// \returns the number of videos with a new frame
+	size_t update();
+
+	/// difference between the newest and the oldest timestamp of the
+	/// current frames of the videos
+	int64_t getDriftNanos() const;
+
+private:
+	void resume();
+
+	std::vector<ofGstVideoUtils*> videos;
+	GstClock * clock;
+	GstClockTime baseTime;
+	int64_t startPositionNanos;		// position when the running time is 0
+	int64_t pausedRunningTimeNanos;
+	bool bPlaying;
+	bool bPaused;
+};
+#endif
+
+
 //-------------------------------------------------
 //----------------------------------------- appsink listener
 //-------------------------------------------------
@@ -0,0 +1,352 @@
+#include "ofMesh.h"
+#include "ofUtils.h"
+#include "ofFileUtils.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// grid of cols x rows quads in the xy plane as independent triangles,
+	// every vertex colored by its position so merged colors can be checked
+	ofMesh triangleGrid(int cols, int rows, float jitter = 0){
+		ofMesh mesh;
+		auto addVertex = [&](int x, int y){
+			mesh.addVertex({x + ofRandom(-jitter, jitter), y + ofRandom(-jitter, jitter), 0});
+			mesh.addColor(ofFloatColor(x / float(cols), y / float(rows), 0));
+		};
+		for(int y = 0; y < rows; y++){
+			for(int x = 0; x < cols; x++){
+				addVertex(x, y);
+				addVertex(x + 1, y);
+				addVertex(x + 1, y + 1);
+				addVertex(x, y);
+				addVertex(x + 1, y + 1);
+				addVertex(x, y + 1);
+			}
+		}
+		return mesh;
+	}
+
+	// uv sphere as independent triangles
+	ofMesh triangleSphere(int resolution){
+		ofMesh mesh;
+		auto point = [&](int i, int j){
+			float theta = i * PI / resolution;
+			float phi = j * TWO_PI / resolution;
+			return glm::vec3(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
+		};
+		for(int i = 0; i < resolution; i++){
+			for(int j = 0; j < resolution; j++){
+				auto p00 = point(i, j), p10 = point(i + 1, j), p11 = point(i + 1, j + 1), p01 = point(i, j + 1);
+				if(i > 0){
+					mesh.addVertices({p00, p10, p01});
+				}
+				if(i < resolution - 1){
+					mesh.addVertices({p10, p11, p01});
+				}
+			}
+		}
+		return mesh;
+	}
+
+	bool colorsMatchPositions(const ofMesh & mesh, int cols, int rows){
+		bool match = true;
+		for(size_t i = 0; i < mesh.getNumVertices(); i++){
+			const auto & v = mesh.getVertices()[i];
+			const auto & c = mesh.getColors()[i];
+			match &= fabs(c.r - round(v.x) / float(cols)) < 0.0001f && fabs(c.g - round(v.y) / float(rows)) < 0.0001f;
+		}
+		return match;
+	}
+
+	void testMergeDuplicateVertices(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "mergeDuplicateVertices";
+
+		{
+			auto mesh = triangleGrid(10, 10);
+			auto original = mesh;
+			mesh.mergeDuplicateVertices();
+			ofxTestEq(mesh.getNumVertices(), size_t(11 * 11), "grid vertices are merged");
+			ofxTestEq(mesh.getNumColors(), size_t(11 * 11), "colors are carried along");
+			ofxTestEq(mesh.getNumIndices(), original.getNumVertices(), "every triangle corner is indexed");
+			bool sameTriangles = true;
+			for(size_t i = 0; i < mesh.getNumIndices(); i++){
+				sameTriangles &= mesh.getVertex(mesh.getIndex(i)) == original.getVertex(i);
+			}
+			ofxTest(sameTriangles, "indices point to the original positions");
+			ofxTest(colorsMatchPositions(mesh, 10, 10), "every vertex keeps its own color");
+
+			auto merged = mesh;
+			mesh.mergeDuplicateVertices();
+			ofxTest(mesh.getVertices() == merged.getVertices() && mesh.getIndices() == merged.getIndices(), "merging again doesn't change the mesh");
+		}
+
+		{
+			auto mesh = triangleGrid(10, 10, 0.001f);
+			auto exact = mesh;
+			exact.mergeDuplicateVertices();
+			ofxTestEq(exact.getNumVertices(), exact.getNumIndices(), "epsilon 0 doesn't merge jittered vertices");
+			mesh.mergeDuplicateVertices(0.01f);
+			ofxTestEq(mesh.getNumVertices(), size_t(11 * 11), "jittered vertices are merged within epsilon");
+			ofxTest(colorsMatchPositions(mesh, 10, 10), "jittered vertices keep their own color");
+		}
+
+		{
+			auto mesh = triangleGrid(200, 200, 0.001f);
+			auto threaded = mesh;
+			mesh.mergeDuplicateVertices(0.01f);
+			threaded.mergeDuplicateVertices(0.01f, 0);
+			ofxTest(mesh.getVertices() == threaded.getVertices() && mesh.getIndices() == threaded.getIndices() && mesh.getColors() == threaded.getColors(),
+				"threaded merge gives the same result");
+		}
+	}
+
+	void testSmoothNormals(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "smoothNormals";
+
+		auto mesh = triangleSphere(32);
+		auto threaded = mesh;
+		mesh.smoothNormals(60);
+		bool radial = true;
+		for(size_t i = 0; i < mesh.getNumVertices(); i++){
+			radial &= glm::dot(glm::normalize(mesh.getNormal(i)), mesh.getVertex(i)) > 0.99f;
+		}
+		ofxTest(radial, "smooth sphere normals point out from the center");
+
+		threaded.smoothNormals(60, 0.01f, 0);
+		ofxTest(mesh.getNormals() == threaded.getNormals(), "threaded smooth normals give the same result");
+
+		auto cube = ofMesh::box(1, 1, 1, 1, 1, 1);
+		auto sharp = cube;
+		sharp.smoothNormals(30);
+		bool flat = true;
+		for(size_t i = 0; i < sharp.getNumVertices(); i++){
+			auto n = sharp.getNormal(i);
+			flat &= fabs(fabs(n.x) + fabs(n.y) + fabs(n.z) - 1) < 0.0001f;
+		}
+		ofxTest(flat, "faces over the angle aren't smoothed");
+	}
+
+	// mesh with every attribute and random triangles
+	ofMesh randomMesh(size_t numVertices){
+		ofMesh mesh;
+		for(size_t i = 0; i < numVertices; i++){
+			mesh.addVertex({ofRandom(-1, 1), ofRandom(-1, 1), ofRandom(-1, 1)});
+			mesh.addColor(ofFloatColor(ofRandom(1), ofRandom(1), ofRandom(1), ofRandom(1)));
+			mesh.addTexCoord({ofRandom(1), ofRandom(1)});
+			mesh.addNormal({ofRandom(-1, 1), ofRandom(-1, 1), ofRandom(-1, 1)});
+		}
+		for(size_t i = 0; i < numVertices * 2; i++){
+			mesh.addTriangle(ofIndexType(ofRandom(numVertices)), ofIndexType(ofRandom(numVertices)), ofIndexType(ofRandom(numVertices)));
+		}
+		return mesh;
+	}
+
+	template<typename Vector>
+	bool nearlyEqual(const std::vector<Vector> & v1, const std::vector<Vector> & v2, float tolerance){
+		if(v1.size() != v2.size()){
+			return false;
+		}
+		for(size_t i = 0; i < v1.size(); i++){
+			for(size_t j = 0; j < sizeof(Vector) / sizeof(float); j++){
+				if(fabs((&v1[i][0])[j] - (&v2[i][0])[j]) > tolerance){
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool nearColors(const ofMesh & m1, const ofMesh & m2){
+		if(m1.getNumColors() != m2.getNumColors()){
+			return false;
+		}
+		for(size_t i = 0; i < m1.getNumColors(); i++){
+			auto c1 = m1.getColors()[i], c2 = m2.getColors()[i];
+			// saving converts colors to 8 bits
+			float tolerance = 1.01f / 255.f;
+			if(fabs(c1.r - c2.r) > tolerance || fabs(c1.g - c2.g) > tolerance || fabs(c1.b - c2.b) > tolerance || fabs(c1.a - c2.a) > tolerance){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// the line by line loader ofMesh used before reading binary files,
+	// only for the layout ofMesh saves, to compare timings
+	ofMesh loadWithStringstream(const std::string & path){
+		ofMesh mesh;
+		ofBuffer buffer = ofBufferFromFile(path);
+		size_t numVertices = 0;
+		bool header = true;
+		for(auto & line: buffer.getLines()){
+			if(header){
+				if(line.find("element vertex") == 0){
+					numVertices = ofTo<size_t>(line.substr(15));
+				}
+				header = line != "end_header";
+				continue;
+			}
+			if(line.empty()){
+				continue;
+			}
+			std::stringstream sline(line);
+			if(mesh.getNumVertices() < numVertices){
+				glm::vec3 v, n;
+				glm::vec2 t;
+				int r, g, b, a;
+				sline >> v.x >> v.y >> v.z >> r >> g >> b >> a >> t.x >> t.y >> n.x >> n.y >> n.z;
+				mesh.addVertex(v);
+				mesh.addColor(ofColor(r, g, b, a));
+				mesh.addTexCoord(t);
+				mesh.addNormal(n);
+			}else{
+				int numIndices;
+				ofIndexType i1, i2, i3;
+				sline >> numIndices >> i1 >> i2 >> i3;
+				mesh.addTriangle(i1, i2, i3);
+			}
+		}
+		return mesh;
+	}
+
+	void writeFile(const std::string & path, const std::string & contents){
+		ofBuffer buffer;
+		buffer.set(contents);
+		ofBufferToFile(path, buffer);
+	}
+
+	void testPly(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "ply";
+
+		auto mesh = randomMesh(1000);
+		mesh.save("mesh_binary.ply", true);
+		mesh.save("mesh_ascii.ply", false);
+
+		ofMesh binary;
+		binary.load("mesh_binary.ply");
+		ofxTest(binary.getVertices() == mesh.getVertices(), "binary positions are loaded exactly");
+		ofxTest(binary.getNormals() == mesh.getNormals(), "binary normals are loaded exactly");
+		ofxTest(binary.getTexCoords() == mesh.getTexCoords(), "binary texcoords are loaded exactly");
+		ofxTest(nearColors(binary, mesh), "binary colors are loaded with 8 bit precision");
+		ofxTest(binary.getIndices() == mesh.getIndices(), "binary indices are loaded exactly");
+
+		ofMesh ascii;
+		ascii.load("mesh_ascii.ply");
+		ofxTest(nearlyEqual(ascii.getVertices(), mesh.getVertices(), 0.0001f), "ascii positions are loaded");
+		ofxTest(nearlyEqual(ascii.getNormals(), mesh.getNormals(), 0.0001f), "ascii normals are loaded");
+		ofxTest(nearlyEqual(ascii.getTexCoords(), mesh.getTexCoords(), 0.0001f), "ascii texcoords are loaded");
+		ofxTest(nearColors(ascii, mesh), "ascii colors are loaded with 8 bit precision");
+		ofxTest(ascii.getIndices() == mesh.getIndices(), "ascii indices are loaded exactly");
+
+		auto triangles = triangleGrid(4, 4);
+		triangles.save("triangles.ply", true);
+		ofMesh loadedTriangles;
+		loadedTriangles.load("triangles.ply");
+		ofxTestEq(loadedTriangles.getNumIndices(), triangles.getNumVertices(), "meshes without indices are saved with one face per triangle");
+
+		writeFile("polygon.ply", "ply\nformat ascii 1.0\nelement vertex 4\nproperty float x\nproperty float y\nproperty float z\n"
+			"element face 1\nproperty list uchar int vertex_indices\nend_header\n0 0 0\n1 0 0\n1 1 0\n0 1 0\n4 0 1 2 3\n");
+		ofMesh polygon;
+		polygon.load("polygon.ply");
+		ofxTest(polygon.getIndices() == std::vector<ofIndexType>({0, 1, 2, 0, 2, 3}), "polygons are triangulated as fans");
+
+		writeFile("truncated.ply", "ply\nformat binary_little_endian 1.0\nelement vertex 100\nproperty float x\nproperty float y\nproperty float z\nend_header\n");
+		auto unchanged = polygon;
+		polygon.load("truncated.ply");
+		ofxTest(polygon.getVertices() == unchanged.getVertices() && polygon.getIndices() == unchanged.getIndices(), "a truncated file leaves the mesh unchanged");
+
+		// list counts that are negative or bigger than the file are errors
+		// instead of allocating the list
+		std::string asciiHeader = "ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+			"element face 1\nproperty list uint int vertex_indices\nend_header\n0 0 0\n1 0 0\n1 1 0\n";
+		writeFile("corrupt.ply", asciiHeader + "-3 0 1 2\n");
+		polygon.load("corrupt.ply");
+		ofxTest(polygon.getVertices() == unchanged.getVertices() && polygon.getIndices() == unchanged.getIndices(), "a negative list count leaves the mesh unchanged");
+		writeFile("corrupt.ply", asciiHeader + "4000000000 0 1 2\n");
+		polygon.load("corrupt.ply");
+		ofxTest(polygon.getVertices() == unchanged.getVertices() && polygon.getIndices() == unchanged.getIndices(), "an ascii list count bigger than the file leaves the mesh unchanged");
+		std::string binary = "ply\nformat binary_little_endian 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+			"element face 1\nproperty list uint int vertex_indices\nend_header\n";
+		binary += std::string(3 * 3 * sizeof(float), '\0') + "\xff\xff\xff\xff" + std::string(3 * sizeof(int32_t), '\0');
+		writeFile("corrupt.ply", binary);
+		polygon.load("corrupt.ply");
+		ofxTest(polygon.getVertices() == unchanged.getVertices() && polygon.getIndices() == unchanged.getIndices(), "a binary list count bigger than the file leaves the mesh unchanged");
+		writeFile("corrupt.ply", "ply\nformat ascii 1.0\nelement vertex 18446744073709551615\nproperty float x\nproperty float y\nproperty float z\nend_header\n0 0 0\n");
+		polygon.load("corrupt.ply");
+		ofxTest(polygon.getVertices() == unchanged.getVertices(), "an element count that overflows leaves the mesh unchanged");
+
+		for(auto path: {"mesh_binary.ply", "mesh_ascii.ply", "triangles.ply", "polygon.ply", "truncated.ply", "corrupt.ply"}){
+			ofFile::removeFile(path);
+		}
+	}
+
+	void benchmark(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "benchmark";
+
+		for(int size: {32, 100, 320, 550}){
+			auto mesh = triangleGrid(size, size, 0.001f);
+			auto threaded = mesh;
+			auto then = ofGetElapsedTimeMicros();
+			mesh.mergeDuplicateVertices(0.01f);
+			auto now = ofGetElapsedTimeMicros();
+			threaded.mergeDuplicateVertices(0.01f, 0);
+			auto threadedNow = ofGetElapsedTimeMicros();
+			ofLogNotice() << "mergeDuplicateVertices " << size * size * 2 << " triangles: "
+				<< (now - then) / 1000. << "ms, all cores: " << (threadedNow - now) / 1000. << "ms";
+		}
+
+		for(size_t numVertices: {size_t(10000), size_t(100000), size_t(500000)}){
+			auto mesh = randomMesh(numVertices);
+			mesh.save("benchmark_binary.ply", true);
+			mesh.save("benchmark_ascii.ply", false);
+			auto then = ofGetElapsedTimeMicros();
+			auto legacy = loadWithStringstream("benchmark_ascii.ply");
+			auto legacyNow = ofGetElapsedTimeMicros();
+			ofMesh ascii;
+			ascii.load("benchmark_ascii.ply");
+			auto asciiNow = ofGetElapsedTimeMicros();
+			ofMesh binary;
+			binary.load("benchmark_binary.ply");
+			auto binaryNow = ofGetElapsedTimeMicros();
+			ofLogNotice() << "load " << numVertices << " vertices " << numVertices * 2 << " triangles: line by line "
+				<< (legacyNow - then) / 1000. << "ms, ascii " << (asciiNow - legacyNow) / 1000. << "ms, binary " << (binaryNow - asciiNow) / 1000. << "ms";
+		}
+		ofFile::removeFile("benchmark_binary.ply");
+		ofFile::removeFile("benchmark_ascii.ply");
+
+		for(int resolution: {32, 100, 320, 390}){
+			auto mesh = triangleSphere(resolution);
+			auto numTriangles = mesh.getNumVertices() / 3;
+			auto threaded = mesh;
+			auto then = ofGetElapsedTimeMicros();
+			mesh.smoothNormals(60);
+			auto now = ofGetElapsedTimeMicros();
+			threaded.smoothNormals(60, 0.01f, 0);
+			auto threadedNow = ofGetElapsedTimeMicros();
+			ofLogNotice() << "smoothNormals " << numTriangles << " triangles: "
+				<< (now - then) / 1000. << "ms, all cores: " << (threadedNow - now) / 1000. << "ms";
+		}
+	}
+
+	void run(){
+		testMergeDuplicateVertices();
+		testSmoothNormals();
+		testPly();
+		benchmark();
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,338 @@
+#include "ofxKinectPlayer.h"
+#include "ofxKinectRecorder.h"
+#include "ofxKinectPointCloud.h"
+#include "libfreenect_registration.h"
+#include "freenect_internal.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+
+// parameters of a kinect for xbox 360
+static const float ZERO_PLANE_PIXEL_SIZE = 0.1042f;
+static const float ZERO_PLANE_DISTANCE = 120;
+static const uint64_t FRAME_MICROS = 33333;
+
+class ofApp: public ofxUnitTestsApp{
+	// a wall at 2m with a ball moving in front of it, holes without depth
+	// around the ball as the shadow of the projector, and a gradient video
+	void syntheticFrame(int frame, ofShortPixels & depth, ofPixels & video){
+		depth.allocate(640, 480, 1);
+		video.allocate(640, 480, OF_PIXELS_RGB);
+		glm::vec2 center(100 + frame * 10 % 440, 240);
+		for(int y = 0; y < 480; y++){
+			for(int x = 0; x < 640; x++){
+				float distance = glm::distance(glm::vec2(x, y), center);
+				unsigned short z = 2000 + y / 4 + ofRandom(-4, 4);
+				if(distance < 80){
+					z = 900 + distance * 2;
+				}else if(distance < 90 && x > center.x){
+					z = 0;
+				}
+				depth[y * 640 + x] = z;
+				size_t i = (y * 640 + x) * 3;
+				video[i] = x * 255 / 640;
+				video[i + 1] = y * 255 / 480;
+				video[i + 2] = frame;
+			}
+		}
+	}
+
+	template<typename T>
+	bool equal(const ofPixels_<T> & a, const ofPixels_<T> & b){
+		return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight()
+			&& a.getNumChannels() == b.getNumChannels()
+			&& std::equal(a.getData(), a.getData() + a.size(), b.getData());
+	}
+
+	bool record(const std::string & filename, int numFrames, std::vector<ofShortPixels> & depths, std::vector<ofPixels> & videos){
+		ofxKinectRecorder recorder;
+		if(!recorder.open(filename, ZERO_PLANE_PIXEL_SIZE, ZERO_PLANE_DISTANCE)){
+			return false;
+		}
+		depths.resize(numFrames);
+		videos.resize(numFrames);
+		bool added = true;
+		for(int i = 0; i < numFrames; i++){
+			syntheticFrame(i, depths[i], videos[i]);
+			// every 5th frame only has depth
+			if(i % 5 == 4){
+				videos[i].clear();
+			}
+			added &= recorder.addFrame(depths[i], videos[i], i * FRAME_MICROS);
+		}
+		return added && recorder.getNumFrames() == size_t(numFrames);
+	}
+
+	void testRecording(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "record and play";
+
+		const int numFrames = 20;
+		std::vector<ofShortPixels> depths;
+		std::vector<ofPixels> videos;
+		ofxTest(record("recording.kinect", numFrames, depths, videos), "frames are recorded");
+
+		uint64_t rawBytes = 0;
+		for(int i = 0; i < numFrames; i++){
+			rawBytes += depths[i].size() * 2 + videos[i].size();
+		}
+		auto fileBytes = ofFile("recording.kinect").getSize();
+		ofLogNotice() << "recorded " << fileBytes << " bytes, " << rawBytes << " raw";
+		ofxTestGt(rawBytes, fileBytes, "the recording is smaller than the raw frames");
+
+		ofxKinectPlayer player;
+		player.setUseTexture(false);
+		player.setLoop(false);
+		ofxTest(player.load("recording.kinect"), "the recording loads");
+		ofxTestEq(player.getZeroPlanePixelSize(), ZERO_PLANE_PIXEL_SIZE, "the zero plane pixel size is recorded");
+		ofxTestEq(player.getZeroPlaneDistance(), ZERO_PLANE_DISTANCE, "the zero plane distance is recorded");
+		ofxTestEq(player.getWidth(), 640.f, "the player has the size of the recording");
+
+		bool sameDepth = true, sameVideo = true, sameTimestamps = true, sameDistance = true, newVideo = true;
+		for(int i = 0; i < numFrames; i++){
+			if(i > 0 && !player.nextFrame()){
+				break;
+			}
+			sameDepth &= equal(player.getRawDepthPixels(), depths[i]);
+			sameVideo &= equal(player.getPixels(), videos[i]);
+			sameTimestamps &= player.getFrameTimestampMicros() == i * FRAME_MICROS && player.getCurrentFrame() == size_t(i);
+			sameDistance &= player.getDistancePixels()[1000] == depths[i][1000] && player.getDistanceAt(10, 400) == depths[i][400 * 640 + 10];
+			newVideo &= player.isFrameNew() && player.isFrameNewVideo() == videos[i].isAllocated();
+		}
+		ofxTest(sameDepth, "the depth is the same as recorded");
+		ofxTest(sameVideo, "the video is the same as recorded");
+		ofxTest(sameTimestamps, "frames keep their timestamps");
+		ofxTest(sameDistance, "the distance pixels are the raw depth");
+		ofxTest(newVideo, "frames without video are depth only");
+
+		ofxTest(!player.nextFrame(), "there's no frame after the last one");
+		ofxTest(player.isDone(), "the player is done at the end without looping");
+		player.setLoop(true);
+		ofxTest(player.nextFrame(), "looping goes back to the first frame");
+		ofxTestEq(player.getCurrentFrame(), size_t(0), "the first frame is current after looping");
+		ofxTest(equal(player.getRawDepthPixels(), depths[0]), "the first frame is the same after looping");
+
+		ofFile bad("notARecording.kinect", ofFile::WriteOnly);
+		bad << "not a kinect recording";
+		bad.close();
+		ofxTest(!player.load("notARecording.kinect"), "other files are not loaded");
+		ofxTest(!player.isInitialized(), "the player is closed after a failed load");
+	}
+
+	void testRealTime(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "real time playback";
+
+		ofxKinectPlayer player;
+		player.setUseTexture(false);
+		player.setLoop(false);
+		auto start = ofGetElapsedTimeMicros();
+		ofxTest(player.load("recording.kinect"), "the recording loads");
+		bool inOrder = true;
+		bool onTime = true;
+		size_t lastFrame = 0;
+		int numFrames = 1;
+		int numUpdates = 0;
+		while(!player.isDone() && ofGetElapsedTimeMicros() - start < 2000000){
+			player.update();
+			if(player.isFrameNew()){
+				inOrder &= player.getCurrentFrame() > lastFrame;
+				onTime &= player.getFrameTimestampMicros() <= ofGetElapsedTimeMicros() - start;
+				lastFrame = player.getCurrentFrame();
+				numFrames++;
+			}
+			// sometimes stall for longer than a frame
+			numUpdates++;
+			ofSleepMillis(numUpdates % 5 == 0 ? 50 : 5);
+		}
+		ofxTest(player.isDone(), "the recording plays in about its length");
+		ofxTestEq(lastFrame, size_t(19), "playback ends in the last frame");
+		ofxTest(inOrder, "frames are shown in order");
+		ofxTest(onTime, "frames are not shown before their time");
+		ofLogNotice() << numFrames << " of 20 frames shown, the rest skipped";
+	}
+
+	void testWorldCoordinates(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "world coordinates";
+
+		ofShortPixels depth;
+		ofPixels video;
+		syntheticFrame(3, depth, video);
+
+		// a device with only the registration parameters, enough for
+		// freenect_camera_to_world
+		freenect_device device;
+		memset(&device, 0, sizeof(device));
+		device.registration.zero_plane_info.reference_pixel_size = ZERO_PLANE_PIXEL_SIZE;
+		device.registration.zero_plane_info.reference_distance = ZERO_PLANE_DISTANCE;
+
+		ofxKinectPointCloud pointCloud;
+		pointCloud.setup(ZERO_PLANE_PIXEL_SIZE, ZERO_PLANE_DISTANCE);
+		ofxTest(pointCloud.isSetup(), "the point cloud is set up");
+
+		std::vector<float> simd(640 * 480 * 3), scalar(640 * 480 * 3);
+		ofxKinectPointCloud::setUseSIMD(true);
+		pointCloud.getWorldCoordinates(depth, simd.data());
+		ofxKinectPointCloud::setUseSIMD(false);
+		pointCloud.getWorldCoordinates(depth, scalar.data());
+		ofxKinectPointCloud::setUseSIMD(true);
+		ofxTest(simd == scalar, "SIMD and scalar conversions are the same");
+
+		float maxError = 0;
+		bool single = true;
+		for(int y = 0; y < 480; y++){
+			for(int x = 0; x < 640; x++){
+				int i = y * 640 + x;
+				double wx, wy;
+				freenect_camera_to_world(&device, x, y, depth[i], &wx, &wy);
+				maxError = std::max(maxError, float(std::abs(simd[i * 3] - wx) / std::max(1., std::abs(wx))));
+				maxError = std::max(maxError, float(std::abs(simd[i * 3 + 1] - wy) / std::max(1., std::abs(wy))));
+				maxError = std::max(maxError, std::abs(simd[i * 3 + 2] - depth[i]));
+				if(x % 37 == 0 && y % 23 == 0){
+					auto p = pointCloud.getWorldCoordinateAt(x, y, depth[i]);
+					single &= p.x == simd[i * 3] && p.y == simd[i * 3 + 1] && p.z == simd[i * 3 + 2];
+				}
+			}
+		}
+		ofLogNotice() << "max relative error " << maxError;
+		ofxTestGt(1e-5f, maxError, "the world coordinates are the same as libfreenect's");
+		ofxTest(single, "getWorldCoordinateAt is the same as the bulk conversion");
+
+		for(int step: {1, 2, 3}){
+			size_t withDepth = 0;
+			for(int y = 0; y < 480; y += step){
+				for(int x = 0; x < 640; x += step){
+					withDepth += depth[y * 640 + x] > 0;
+				}
+			}
+			ofMesh mesh;
+			pointCloud.getWorldCoordinates(depth, video, mesh, step);
+			ofxTestEq(mesh.getNumVertices(), withDepth, "the mesh has a vertex per pixel with depth every " + ofToString(step) + " pixels");
+			ofxTestEq(mesh.getNumColors(), withDepth, "the mesh has a color per vertex every " + ofToString(step) + " pixels");
+		}
+
+		ofMesh mesh;
+		pointCloud.getWorldCoordinates(depth, video, mesh, 2);
+		bool sameVertices = true, sameColors = true;
+		size_t v = 0;
+		for(int y = 0; y < 480; y += 2){
+			for(int x = 0; x < 640; x += 2){
+				int i = y * 640 + x;
+				if(depth[i] == 0){
+					continue;
+				}
+				auto & vertex = mesh.getVertices()[v];
+				sameVertices &= vertex.x == simd[i * 3] && vertex.y == simd[i * 3 + 1] && vertex.z == simd[i * 3 + 2];
+				auto color = mesh.getColors()[v];
+				auto expected = video.getColor(x, y);
+				sameColors &= std::abs(color.r * 255 - expected.r) < 0.5f
+					&& std::abs(color.g * 255 - expected.g) < 0.5f
+					&& std::abs(color.b * 255 - expected.b) < 0.5f;
+				v++;
+			}
+		}
+		ofxTest(sameVertices, "mesh vertices are the world coordinates of the pixels");
+		ofxTest(sameColors, "mesh colors are the colors of the pixels");
+
+		pointCloud.getWorldCoordinates(depth, ofPixels(), mesh, 2);
+		ofxTestEq(mesh.getNumColors(), size_t(0), "meshes without video have no colors");
+	}
+
+	// converting the frames of a recording to world coordinates with a
+	// libfreenect call per pixel, as getWorldCoordinateAt does, and in bulk
+	void benchmark(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "benchmark";
+
+		ofxKinectPlayer player;
+		player.setUseTexture(false);
+		if(!player.load("recording.kinect")){
+			return;
+		}
+		const int numFrames = 60;
+		freenect_device device;
+		memset(&device, 0, sizeof(device));
+		device.registration.zero_plane_info.reference_pixel_size = player.getZeroPlanePixelSize();
+		device.registration.zero_plane_info.reference_distance = player.getZeroPlaneDistance();
+
+		std::vector<float> xyz(640 * 480 * 3);
+		ofMesh mesh;
+		uint64_t playMicros = 0, perPixelMicros = 0, scalarMicros = 0, simdMicros = 0, meshMicros = 0, perPixelMeshMicros = 0;
+		double checksum = 0;
+		for(int i = 0; i < numFrames; i++){
+			auto then = ofGetElapsedTimeMicros();
+			player.nextFrame();
+			playMicros += ofGetElapsedTimeMicros() - then;
+			auto & depth = player.getRawDepthPixels();
+
+			then = ofGetElapsedTimeMicros();
+			for(int y = 0, n = 0; y < 480; y++){
+				for(int x = 0; x < 640; x++, n++){
+					double wx, wy;
+					freenect_camera_to_world(&device, x, y, depth[n], &wx, &wy);
+					xyz[n * 3] = wx;
+					xyz[n * 3 + 1] = wy;
+					xyz[n * 3 + 2] = depth[n];
+				}
+			}
+			perPixelMicros += ofGetElapsedTimeMicros() - then;
+			checksum += xyz[i * 3000];
+
+			ofxKinectPointCloud::setUseSIMD(false);
+			then = ofGetElapsedTimeMicros();
+			player.getWorldCoordinates(xyz.data());
+			scalarMicros += ofGetElapsedTimeMicros() - then;
+			checksum += xyz[i * 3000];
+
+			ofxKinectPointCloud::setUseSIMD(true);
+			then = ofGetElapsedTimeMicros();
+			player.getWorldCoordinates(xyz.data());
+			simdMicros += ofGetElapsedTimeMicros() - then;
+			checksum += xyz[i * 3000];
+
+			// the point cloud of kinectExample, every 2 pixels with colors
+			then = ofGetElapsedTimeMicros();
+			ofMesh perPixelMesh;
+			for(int y = 0; y < 480; y += 2){
+				for(int x = 0; x < 640; x += 2){
+					if(player.getDistanceAt(x, y) > 0){
+						perPixelMesh.addColor(player.getColorAt(x, y));
+						perPixelMesh.addVertex(player.getWorldCoordinateAt(x, y));
+					}
+				}
+			}
+			perPixelMeshMicros += ofGetElapsedTimeMicros() - then;
+
+			then = ofGetElapsedTimeMicros();
+			player.getWorldCoordinates(mesh, 2);
+			meshMicros += ofGetElapsedTimeMicros() - then;
+			checksum += mesh.getNumVertices() + perPixelMesh.getNumVertices();
+		}
+		ofLogNotice() << "reading and decoding a frame: " << double(playMicros) / numFrames << "us";
+		ofLogNotice() << "world coordinates of a frame, freenect per pixel: " << double(perPixelMicros) / numFrames
+			<< "us, bulk scalar: " << double(scalarMicros) / numFrames
+			<< "us, bulk SIMD: " << double(simdMicros) / numFrames << "us";
+		ofLogNotice() << "colored mesh every 2 pixels, per pixel: " << double(perPixelMeshMicros) / numFrames
+			<< "us, bulk: " << double(meshMicros) / numFrames << "us (" << checksum << ")";
+	}
+
+	void run(){
+		ofSeedRandom(0);
+		testRecording();
+		testRealTime();
+		testWorldCoordinates();
+		benchmark();
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
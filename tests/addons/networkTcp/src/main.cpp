@@ -256,6 +256,147 @@ public:
 		ofxTestEq(received, str, "received max size message == sent message");
 	}
 
+	void testEventDrivenLoad(){
+#ifdef TARGET_LINUX
+		ofLogNotice() << "";
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "testEventDrivenLoad";
+
+		int port = ofRandom(15000, 65535);
+		ofxTCPSettings settings(port);
+		settings.eventDriven = true;
+
+		ofxTCPServer server;
+		std::atomic<int> numConnected(0), numDisconnected(0), numReceived(0);
+		auto connectedListener = server.clientConnected.newListener([&](ofxTCPServerEventArgs &){
+			numConnected++;
+		});
+		auto disconnectedListener = server.clientDisconnected.newListener([&](ofxTCPServerEventArgs &){
+			numDisconnected++;
+		});
+		auto receivedListener = server.dataReceived.newListener([&](ofxTCPServerEventArgs & args){
+			while(server.receive(args.clientID) == "message"){
+				numReceived++;
+			}
+		});
+		ofxTest(server.setup(settings), "event driven server");
+
+		const int numClients = 256;
+		std::vector<std::unique_ptr<ofxTCPClient>> clients;
+		bool allConnected = true;
+		auto then = ofGetElapsedTimeMillis();
+		for(int i=0;i<numClients;i++){
+			clients.emplace_back(new ofxTCPClient);
+			allConnected &= clients.back()->setup("127.0.0.1", port, false);
+		}
+		ofxTest(allConnected, "connect " + ofToString(numClients) + " clients");
+		for(int i=0;i<100 && numConnected<numClients;i++){
+			ofSleepMillis(10);
+		}
+		ofxTestEq(numConnected.load(), numClients, "connection events");
+		ofxTestEq(server.getNumClients(), numClients, "connected clients");
+
+		for(auto & client: clients){
+			client->send("message");
+		}
+		for(int i=0;i<100 && numReceived<numClients;i++){
+			ofSleepMillis(10);
+		}
+		ofxTestEq(numReceived.load(), numClients, "messages received from every client");
+
+		ofxTest(server.sendToAll("message"), "send to all");
+		int numClientsReceived = 0;
+		for(auto & client: clients){
+			std::string messageReceived;
+			for(int i=0;i<100 && messageReceived.empty();i++){
+				messageReceived = client->receive();
+				if(messageReceived.empty()) ofSleepMillis(1);
+			}
+			if(messageReceived == "message"){
+				numClientsReceived++;
+			}
+		}
+		ofxTestEq(numClientsReceived, numClients, "every client received the message sent to all");
+
+		for(int i=0;i<numClients/2;i++){
+			clients[i]->close();
+		}
+		for(int i=0;i<100 && numDisconnected<numClients/2;i++){
+			ofSleepMillis(10);
+		}
+		ofxTestEq(numDisconnected.load(), numClients/2, "disconnection events");
+		ofxTestEq(server.getNumClients(), numClients - numClients/2, "remaining clients");
+		ofLogNotice() << numClients << " clients connected, messaged and broadcast to in " << ofGetElapsedTimeMillis() - then << "ms";
+
+		ofxTest(server.close(), "event driven server closes");
+#endif
+	}
+
+	void testEventDrivenHangUp(){
+#ifdef TARGET_LINUX
+		ofLogNotice() << "";
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "testEventDrivenHangUp";
+
+		int port = ofRandom(15000, 65535);
+		ofxTCPSettings settings(port);
+		settings.eventDriven = true;
+		settings.receiveBufferSize = 1024;
+
+		ofxTCPServer server;
+		std::atomic<int> numDisconnected(0);
+		auto disconnectedListener = server.clientDisconnected.newListener([&](ofxTCPServerEventArgs &){
+			numDisconnected++;
+		});
+		ofxTest(server.setup(settings), "event driven server");
+
+		ofxTCPClient client;
+		ofxTest(client.setup("127.0.0.1", port, false), "client connects");
+		server.waitConnectedClient(500);
+
+		const char withZeros[] = "a\0b[/TCP]";
+		client.sendRawBytes(withZeros, sizeof(withZeros) - 1);
+		std::string received;
+		for(int i=0;i<100 && received.empty();i++){
+			received = server.receive(0);
+			if(received.empty()) ofSleepMillis(1);
+		}
+		ofxTestEq(received, std::string("a\0b", 3), "0s in a message are kept");
+
+		// more than the receive buffer holds, still unread when the client closes
+		const int numMessages = 2000;
+		for(int i=0;i<numMessages;i++){
+			client.send("message " + ofToString(i));
+		}
+		ofSleepMillis(50);
+		client.close();
+		ofSleepMillis(50);
+		ofxTest(!server.isClientConnected(0), "server detects disconnection");
+		ofxTestEq(numDisconnected.load(), 0, "client kept while there's data to read");
+
+		int numReceived = 0;
+		for(int i=0;i<1000 && numReceived<numMessages;){
+			received = server.receive(0);
+			if(received.empty()){
+				ofSleepMillis(1);
+				i++;
+			}else if(received == "message " + ofToString(numReceived)){
+				numReceived++;
+			}else{
+				break;
+			}
+		}
+		ofxTestEq(numReceived, numMessages, "every message sent before closing is received");
+		for(int i=0;i<100 && numDisconnected<1;i++){
+			ofSleepMillis(10);
+		}
+		ofxTestEq(numDisconnected.load(), 1, "client removed once its data has been read");
+		ofxTestEq(server.getNumClients(), 0, "no clients left");
+
+		ofxTest(server.close(), "event driven server closes");
+#endif
+	}
+
 	void run(){
 		ofSeedRandom(ofGetSeconds());
 		testNonBlocking();
@@ -266,6 +407,8 @@ public:
 		testWrongConnect();
 		testReceiveTimeout();
 		testSendMaxSize();
+		testEventDrivenLoad();
+		testEventDrivenHangUp();
 	}
 };
 
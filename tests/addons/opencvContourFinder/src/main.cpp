@@ -0,0 +1,239 @@
+#include "ofxOpenCv.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+
+// a white disc moving at a constant speed over a black background
+struct MovingBlob{
+	glm::vec2 position;
+	glm::vec2 velocity;
+	float radius;
+};
+
+class ofApp: public ofxUnitTestsApp{
+	void drawFrame(ofxCvGrayscaleImage & image, const std::vector<MovingBlob> & movingBlobs){
+		pixels.allocate(image.getWidth(), image.getHeight(), OF_PIXELS_GRAY);
+		pixels.set(0);
+		for(auto & blob: movingBlobs){
+			int x0 = std::max(0, int(blob.position.x - blob.radius));
+			int x1 = std::min(int(pixels.getWidth()) - 1, int(blob.position.x + blob.radius));
+			int y0 = std::max(0, int(blob.position.y - blob.radius));
+			int y1 = std::min(int(pixels.getHeight()) - 1, int(blob.position.y + blob.radius));
+			for(int y = y0; y <= y1; y++){
+				for(int x = x0; x <= x1; x++){
+					if(glm::distance(glm::vec2(x, y), blob.position) <= blob.radius){
+						pixels[y * pixels.getWidth() + x] = 255;
+					}
+				}
+			}
+		}
+		image.setFromPixels(pixels);
+	}
+
+	void move(std::vector<MovingBlob> & movingBlobs){
+		for(auto & blob: movingBlobs){
+			blob.position += blob.velocity;
+		}
+	}
+
+	// the found blob closest to a moving blob
+	const ofxCvBlob * find(const ofxCvContourFinder & finder, const MovingBlob & movingBlob){
+		const ofxCvBlob * closest = nullptr;
+		float closestDistance = std::numeric_limits<float>::max();
+		for(auto & blob: finder.blobs){
+			float distance = glm::distance(glm::vec2(blob.centroid.x, blob.centroid.y), movingBlob.position);
+			if(distance < closestDistance){
+				closest = &blob;
+				closestDistance = distance;
+			}
+		}
+		return closestDistance < movingBlob.radius ? closest : nullptr;
+	}
+
+	std::vector<MovingBlob> randomBlobs(size_t numBlobs, float width, float height){
+		std::vector<MovingBlob> movingBlobs;
+		for(size_t i = 0; i < numBlobs; i++){
+			// on a grid so they don't overlap while they move
+			float cellSize = 60;
+			size_t cols = width / cellSize;
+			glm::vec2 cell((i % cols) * cellSize + cellSize / 2, (i / cols) * cellSize + cellSize / 2);
+			movingBlobs.push_back({cell, {ofRandom(-1, 1), ofRandom(-1, 1)}, ofRandom(8, 15)});
+		}
+		return movingBlobs;
+	}
+
+	void testTracking(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "tracking";
+
+		ofxCvGrayscaleImage image;
+		image.setUseTexture(false);
+		image.allocate(320, 240);
+		std::vector<MovingBlob> movingBlobs{
+			{{50, 50}, {3, 1}, 12},
+			{{250, 60}, {-2, 2}, 10},
+			{{60, 180}, {4, -1}, 15},
+			{{260, 190}, {-1, -2}, 9},
+		};
+
+		ofxCvContourFinder finder;
+		drawFrame(image, movingBlobs);
+		finder.findContours(image, 20, 320 * 240, 10, false);
+		ofxTestEq(finder.blobs.size(), movingBlobs.size(), "every blob is found");
+		ofxTestEq(finder.blobs[0].id, -1, "blobs have no id when not tracking");
+
+		finder.setTracking(true, 20);
+		ofxTest(finder.isTracking(), "tracking is enabled");
+		std::vector<int> ids;
+		bool allFound = true;
+		bool sameIds = true;
+		bool velocities = true;
+		for(int frame = 0; frame < 30; frame++){
+			drawFrame(image, movingBlobs);
+			finder.findContours(image, 20, 320 * 240, 10, false);
+			for(size_t i = 0; i < movingBlobs.size(); i++){
+				auto blob = find(finder, movingBlobs[i]);
+				if(!blob){
+					allFound = false;
+					continue;
+				}
+				if(frame == 0){
+					ids.push_back(blob->id);
+					velocities &= blob->velocity.x == 0 && blob->velocity.y == 0;
+				}else{
+					sameIds &= blob->id == ids[i];
+					// the centroid of a rasterized disc moves by +-1px
+					velocities &= glm::distance(glm::vec2(blob->velocity.x, blob->velocity.y), movingBlobs[i].velocity) < 1.5f;
+				}
+			}
+			move(movingBlobs);
+		}
+		ofxTest(allFound, "every blob is found in every frame");
+		ofxTestEq(ids.size(), movingBlobs.size(), "every blob gets an id");
+		ofxTest(std::set<int>(ids.begin(), ids.end()).size() == ids.size(), "ids are unique");
+		ofxTest(sameIds, "blobs keep their id while they move");
+		ofxTest(velocities, "blobs have the velocity of the moving disc");
+
+		// a blob that disappears loses its id and new blobs get new ids
+		int lostId = ids[3];
+		movingBlobs.pop_back();
+		movingBlobs.push_back({{160, 120}, {0, 0}, 10});
+		drawFrame(image, movingBlobs);
+		finder.findContours(image, 20, 320 * 240, 10, false);
+		auto newBlob = find(finder, movingBlobs.back());
+		int newId = newBlob ? newBlob->id : -1;
+		ofxTest(newId > *std::max_element(ids.begin(), ids.end()), "new blobs get a new id");
+		bool idReused = false;
+		for(auto & blob: finder.blobs){
+			idReused |= blob.id == lostId;
+		}
+		ofxTest(!idReused, "ids of lost blobs are not reused");
+
+		// blobs that jump further than the max distance are new blobs
+		for(auto & blob: movingBlobs){
+			blob.position.y += 30;
+		}
+		drawFrame(image, movingBlobs);
+		finder.findContours(image, 20, 320 * 240, 10, false);
+		bool allNew = true;
+		for(auto & blob: finder.blobs){
+			allNew &= std::find(ids.begin(), ids.end(), blob.id) == ids.end() && blob.id != newId;
+		}
+		ofxTest(allNew, "blobs further than the max distance get new ids");
+
+		finder.resetTracking();
+		finder.findContours(image, 20, 320 * 240, 10, false);
+		ofxTestEq(std::min_element(finder.blobs.begin(), finder.blobs.end(), [](const ofxCvBlob & a, const ofxCvBlob & b){
+			return a.id < b.id;
+		})->id, 0, "ids start from 0 after resetting");
+	}
+
+	void testNoCopy(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "without copying the input";
+
+		ofxCvGrayscaleImage image;
+		image.setUseTexture(false);
+		image.allocate(640, 480);
+		auto movingBlobs = randomBlobs(50, 640, 480);
+		drawFrame(image, movingBlobs);
+
+		ofxCvContourFinder copying, inPlace;
+		inPlace.setCopyInput(false);
+		ofxTest(!inPlace.isCopyingInput(), "the input isn't copied");
+		copying.findContours(image, 20, 640 * 480, 100, true);
+		inPlace.findContours(image, 20, 640 * 480, 100, true);
+		bool equal = copying.blobs.size() == inPlace.blobs.size();
+		for(size_t i = 0; i < copying.blobs.size() && equal; i++){
+			equal = copying.blobs[i].area == inPlace.blobs[i].area
+				&& copying.blobs[i].centroid == inPlace.blobs[i].centroid
+				&& copying.blobs[i].pts == inPlace.blobs[i].pts;
+		}
+		ofxTest(equal, "the same blobs are found without copying the input");
+
+		bool sorted = true;
+		for(size_t i = 1; i < inPlace.blobs.size(); i++){
+			sorted &= inPlace.blobs[i - 1].area >= inPlace.blobs[i].area;
+		}
+		ofxTest(sorted, "blobs are sorted by area");
+	}
+
+	// 640x480 frames with many moving blobs, as in a camera of an installation
+	void benchmark(size_t numBlobs, bool copyInput, bool tracking){
+		const int numFrames = 120;
+		ofxCvGrayscaleImage image;
+		image.setUseTexture(false);
+		image.allocate(640, 480);
+		auto movingBlobs = randomBlobs(numBlobs, 640, 480);
+		std::vector<ofxCvGrayscaleImage> frames(numFrames);
+		for(auto & frame: frames){
+			frame.setUseTexture(false);
+			frame.allocate(640, 480);
+			drawFrame(frame, movingBlobs);
+			move(movingBlobs);
+		}
+
+		ofxCvContourFinder finder;
+		finder.setCopyInput(copyInput);
+		finder.setTracking(tracking, 20);
+		uint64_t micros = 0;
+		for(auto & frame: frames){
+			image = frame;
+			auto then = ofGetElapsedTimeMicros();
+			finder.findContours(image, 20, 640 * 480, numBlobs, false);
+			micros += ofGetElapsedTimeMicros() - then;
+		}
+		ofLogNotice() << numBlobs << " blobs, " << (copyInput ? "copying, " : "in place, ")
+			<< (tracking ? "tracking: " : "not tracking: ") << double(micros) / numFrames << "us per frame";
+	}
+
+	void benchmark(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "benchmark";
+		for(size_t numBlobs: {10, 80}){
+			benchmark(numBlobs, true, false);
+			benchmark(numBlobs, false, false);
+			benchmark(numBlobs, false, true);
+		}
+	}
+
+	void run(){
+		ofSeedRandom(0);
+		testTracking();
+		testNoCopy();
+		benchmark();
+	}
+
+	ofPixels pixels;
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,154 @@
+#include "ofxOpenCv.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	ofPixels randomPixels(size_t width, size_t height, ofPixelFormat format){
+		ofPixels pixels;
+		pixels.allocate(width, height, format);
+		for(auto & p: pixels){
+			p = ofRandom(255);
+		}
+		return pixels;
+	}
+
+	bool equal(const ofPixels & a, const ofPixels & b){
+		return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight()
+			&& a.getNumChannels() == b.getNumChannels()
+			&& std::equal(a.getData(), a.getData() + a.getTotalBytes(), b.getData());
+	}
+
+	void testSharedPixels(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "shared pixels";
+
+		// an odd width so opencv would pad the rows
+		auto colorPixels = randomPixels(321, 240, OF_PIXELS_RGB);
+		ofxCvColorImage color;
+		color.setUseTexture(false);
+		color.setSharePixels(true);
+		ofxTest(color.isSharingPixels(), "color images can share their pixels");
+		color.setFromPixels(colorPixels);
+		ofxTest(color.getPixels().getData() == (unsigned char*)color.getCvImage()->imageData, "getPixels is the memory of the opencv image");
+		ofxTestEq(color.getCvImage()->widthStep, 321 * 3, "rows are packed");
+		ofxTest(equal(color.getPixels(), colorPixels), "the pixels are set");
+
+		ofxCvGrayscaleImage gray, reference;
+		gray.setUseTexture(false);
+		reference.setUseTexture(false);
+		gray.setSharePixels(true);
+		gray.allocate(321, 240);
+		reference.allocate(321, 240);
+		gray = color;
+		reference = color;
+		ofxTest(equal(gray.getPixels(), reference.getPixels()), "converting to gray is the same as without sharing");
+
+		// operations go through the temporary image and swap it
+		gray.blurGaussian(5);
+		reference.blurGaussian(5);
+		gray.threshold(128);
+		reference.threshold(128);
+		ofxTest(gray.getPixels().getData() == (unsigned char*)gray.getCvImage()->imageData, "getPixels follows the opencv image after swapping");
+		ofxTest(equal(gray.getPixels(), reference.getPixels()), "operations give the same result as without sharing");
+
+		// writes to the pixels are seen by opencv
+		gray.getPixels().set(0);
+		gray.getPixels()[10 * 321 + 10] = 255;
+		gray.flagImageChanged();
+		ofxTestEq(cvCountNonZero(gray.getCvImage()), 1, "opencv sees writes to getPixels");
+		gray.setFromPixels(gray.getPixels());
+		ofxTestEq(cvCountNonZero(gray.getCvImage()), 1, "setting the image from its own pixels keeps them");
+
+		// and opencv writes are seen by the pixels and cv::Mat
+		auto mat = gray.getCvMat();
+		ofxTest(mat.data == gray.getPixels().getData(), "getCvMat doesn't copy the image");
+		mat.setTo(7);
+		ofxTestEq(gray.getPixels()[0], (unsigned char)7, "writes to the cv::Mat are seen by getPixels");
+
+		// changing the mode keeps the image
+		reference.setROI(10, 10, 100, 100);
+		auto before = reference.getPixels();
+		reference.setSharePixels(true);
+		ofxTest(equal(reference.getPixels(), before), "sharing pixels after allocating keeps the image");
+		ofxTestEq(reference.getROI(), ofRectangle(10, 10, 100, 100), "sharing pixels after allocating keeps the ROI");
+		reference.setSharePixels(false);
+		reference.resetROI();
+		ofxTest(equal(reference.getPixels(), before), "stopping sharing keeps the image");
+
+		ofxCvFloatImage floatImage;
+		floatImage.setSharePixels(true);
+		ofxTest(!floatImage.isSharingPixels(), "float images can't share their pixels");
+	}
+
+	// a 1080p camera frame converted to gray, thresholded, blurred and
+	// with its contours found, getting the pixels of every step as an
+	// app drawing them would
+	void benchmark(size_t width, size_t height, bool sharePixels){
+		const int numFrames = 60;
+		auto frame = randomPixels(width, height, OF_PIXELS_RGB);
+		ofxCvColorImage color;
+		ofxCvGrayscaleImage gray;
+		color.setUseTexture(false);
+		gray.setUseTexture(false);
+		color.setSharePixels(sharePixels);
+		gray.setSharePixels(sharePixels);
+		color.allocate(width, height);
+		gray.allocate(width, height);
+		ofxCvContourFinder finder;
+		finder.setCopyInput(false);
+
+		uint64_t setMicros = 0, chainMicros = 0, pixelsMicros = 0;
+		size_t checksum = 0;
+		for(int i = 0; i < numFrames; i++){
+			auto then = ofGetElapsedTimeMicros();
+			color.setFromPixels(frame);
+			setMicros += ofGetElapsedTimeMicros() - then;
+
+			then = ofGetElapsedTimeMicros();
+			gray = color;
+			gray.threshold(128);
+			gray.blur(5);
+			chainMicros += ofGetElapsedTimeMicros() - then;
+
+			then = ofGetElapsedTimeMicros();
+			checksum += color.getPixels()[i] + gray.getPixels()[i];
+			pixelsMicros += ofGetElapsedTimeMicros() - then;
+
+			then = ofGetElapsedTimeMicros();
+			finder.findContours(gray, 20, width * height, 100, false);
+			chainMicros += ofGetElapsedTimeMicros() - then;
+		}
+		ofLogNotice() << width << "x" << height << (sharePixels ? " sharing pixels: " : " opencv memory: ")
+			<< "setFromPixels " << double(setMicros) / numFrames << "us, "
+			<< "threshold, blur and contours " << double(chainMicros) / numFrames << "us, "
+			<< "getPixels " << double(pixelsMicros) / numFrames << "us per frame (" << checksum << ")";
+	}
+
+	void benchmark(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "benchmark";
+		// 1918 pixels wide gray rows are padded by opencv
+		for(size_t width: {1920, 1918}){
+			benchmark(width, 1080, false);
+			benchmark(width, 1080, true);
+		}
+	}
+
+	void run(){
+		ofSeedRandom(0);
+		testSharedPixels();
+		benchmark();
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,246 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+#include "ofxOsc.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// printable bytes for strings and symbols
+	std::string makeString(size_t size, char first){
+		std::string str(size, ' ');
+		for(size_t i = 0; i < size; i++){
+			str[i] = first + i % 26;
+		}
+		return str;
+	}
+
+	// every byte value, including 0, for blobs
+	std::string makeBlob(size_t size){
+		std::string blob(size, 0);
+		for(size_t i = 0; i < size; i++){
+			blob[i] = char(i * 7);
+		}
+		return blob;
+	}
+
+	// a message with one argument of every type, the string, symbol
+	// and blob have dataSize bytes each
+	ofxOscMessage allTypesMessage(const std::string & address, size_t dataSize){
+		ofxOscMessage msg;
+		msg.setAddress(address);
+		msg.addInt32Arg(-123456);
+		msg.addInt64Arg(-1234567890123LL);
+		msg.addFloatArg(1.5f);
+		msg.addDoubleArg(3.25);
+		msg.addStringArg(makeString(dataSize, 'a'));
+		msg.addSymbolArg(makeString(dataSize, 'A'));
+		msg.addCharArg('x');
+		msg.addMidiMessageArg(0x90407F00);
+		msg.addBoolArg(true);
+		msg.addBoolArg(false);
+		msg.addNoneArg();
+		msg.addTriggerArg();
+		msg.addTimetagArg(0x0123456789ABCDEFULL);
+		auto blob = makeBlob(dataSize);
+		msg.addBlobArg(blob.data(), blob.size());
+		msg.addRgbaColorArg(0xFF8040C0);
+		return msg;
+	}
+
+	// true if msg has the arguments created by allTypesMessage
+	bool hasAllTypes(const ofxOscMessage & msg, size_t dataSize){
+		auto blob = msg.getArgAsBlob(13);
+		return msg.getTypeString() == "ihfdsScmTFNItbr"
+			&& msg.getArgAsInt32(0) == -123456
+			&& msg.getArgAsInt64(1) == -1234567890123LL
+			&& msg.getArgAsFloat(2) == 1.5f
+			&& msg.getArgAsDouble(3) == 3.25
+			&& msg.getArgAsString(4) == makeString(dataSize, 'a')
+			&& msg.getArgAsSymbol(5) == makeString(dataSize, 'A')
+			&& msg.getArgAsChar(6) == 'x'
+			&& msg.getArgAsMidiMessage(7) == 0x90407F00
+			&& msg.getArgAsBool(8)
+			&& !msg.getArgAsBool(9)
+			&& msg.getArgAsNone(10)
+			&& msg.getArgAsTrigger(11)
+			&& msg.getArgAsTimetag(12) == 0x0123456789ABCDEFULL
+			&& std::string(blob.getData(), blob.size()) == makeBlob(dataSize)
+			&& msg.getArgAsRgbaColor(14) == 0xFF8040C0;
+	}
+
+	// waits for the next message for up to a second
+	bool waitForMessage(ofxOscReceiver & receiver, ofxOscMessage & msg){
+		for(int i = 0; i < 100; i++){
+			if(receiver.getNextMessage(msg)){
+				return true;
+			}
+			ofSleepMillis(10);
+		}
+		return false;
+	}
+
+	void testArgs(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "arguments";
+
+		ofxTest(hasAllTypes(allTypesMessage("/empty", 0), 0), "every argument type with empty strings and blobs");
+		ofxTest(hasAllTypes(allTypesMessage("/short", 3), 3), "every argument type with short strings and blobs");
+		ofxTest(hasAllTypes(allTypesMessage("/long", 10000), 10000), "every argument type with strings and blobs that outgrow the data storage");
+
+		// the data storage reallocates many times while this is filled,
+		// earlier arguments have to stay readable
+		ofxOscMessage msg;
+		for(size_t i = 0; i < 100; i++){
+			if(i % 2){
+				auto blob = makeBlob(i * 50);
+				msg.addBlobArg(blob.data(), blob.size());
+			}else{
+				msg.addStringArg(makeString(i * 50, 'a'));
+			}
+		}
+		bool allEqual = msg.getNumArgs() == 100;
+		for(size_t i = 0; i < msg.getNumArgs() && allEqual; i++){
+			if(i % 2){
+				auto blob = msg.getArgAsBlob(i);
+				allEqual = std::string(blob.getData(), blob.size()) == makeBlob(i * 50);
+			}else{
+				allEqual = msg.getArgAsString(i) == makeString(i * 50, 'a');
+			}
+		}
+		ofxTest(allEqual, "100 strings and blobs of growing size keep their values");
+	}
+
+	void testCopy(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "copy";
+
+		auto original = allTypesMessage("/original", 1000);
+		original.setRemoteEndpoint("localhost", 1234);
+
+		ofxOscMessage copied(original);
+		ofxTest(hasAllTypes(copied, 1000), "copy constructor copies every argument");
+		ofxTestEq(copied.getAddress(), std::string("/original"), "copy constructor copies the address");
+		ofxTestEq(copied.getRemoteHost(), std::string("localhost"), "copy constructor copies the remote host");
+		ofxTestEq(copied.getRemotePort(), 1234, "copy constructor copies the remote port");
+
+		// assigning over a message with more arguments and data
+		ofxOscMessage assigned = allTypesMessage("/assigned", 5000);
+		assigned.addStringArg("extra");
+		assigned = original;
+		ofxTest(hasAllTypes(assigned, 1000), "assignment replaces every argument");
+		ofxTestEq(assigned.getNumArgs(), original.getNumArgs(), "assignment drops the extra arguments");
+		ofxTestEq(assigned.getAddress(), std::string("/original"), "assignment copies the address");
+
+		// assigning over a message with less arguments and data
+		ofxOscMessage small;
+		small.addIntArg(1);
+		small = allTypesMessage("/big", 5000);
+		ofxTest(hasAllTypes(small, 5000), "assignment grows the arguments");
+
+		auto & self = assigned;
+		assigned = self;
+		ofxTest(hasAllTypes(assigned, 1000), "self assignment keeps every argument");
+
+		// copies don't share storage
+		original.clear();
+		original.addStringArg(makeString(1000, 'z'));
+		ofxTest(hasAllTypes(copied, 1000), "a copy doesn't change when the original is cleared and refilled");
+		ofxTest(hasAllTypes(assigned, 1000), "an assigned message doesn't change when the original is cleared and refilled");
+
+		ofxOscMessage moved(std::move(copied));
+		ofxTest(hasAllTypes(moved, 1000), "move constructor keeps every argument");
+		ofxOscMessage moveAssigned;
+		moveAssigned = std::move(moved);
+		ofxTest(hasAllTypes(moveAssigned, 1000), "move assignment keeps every argument");
+	}
+
+	void testClear(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "clear";
+
+		auto msg = allTypesMessage("/full", 1000);
+		msg.setRemoteEndpoint("localhost", 1234);
+		msg.clear();
+		ofxTestEq(msg.getNumArgs(), size_t(0), "clear removes every argument");
+		ofxTestEq(msg.getTypeString(), std::string(""), "clear empties the type string");
+		ofxTestEq(msg.getAddress(), std::string(""), "clear resets the address");
+		ofxTestEq(msg.getRemoteHost(), std::string(""), "clear resets the remote host");
+		ofxTestEq(msg.getRemotePort(), 0, "clear resets the remote port");
+
+		msg.setAddress("/refilled");
+		msg.addStringArg("short");
+		msg.addBlobArg("ab", 2);
+		ofxTestEq(msg.getTypeString(), std::string("sb"), "a cleared message only has the new arguments");
+		ofxTestEq(msg.getArgAsString(0), std::string("short"), "a cleared message doesn't keep old string data");
+		ofxTestEq(msg.getArgAsBlob(1).size(), size_t(2), "a cleared message doesn't keep old blob data");
+	}
+
+	void testReceiver(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "receiver";
+
+		int port = ofRandom(15000, 65535);
+		ofxOscReceiver receiver;
+		ofxTest(receiver.setup(port), "receiver setup");
+		ofxOscSender sender;
+		ofxTest(sender.setup("127.0.0.1", port), "sender setup");
+
+		// the data has to fit in a single udp packet
+		ofxOscMessage msg;
+		sender.sendMessage(allTypesMessage("/first", 1000), false);
+		ofxTest(waitForMessage(receiver, msg), "receive the first message");
+		ofxTestEq(msg.getAddress(), std::string("/first"), "the first message address");
+		ofxTest(hasAllTypes(msg, 1000), "every argument type survives sending and receiving");
+		ofxTestEq(msg.getRemoteHost(), std::string("127.0.0.1"), "the remote host is the sender");
+		ofxTest(msg.getRemotePort() != 0, "the remote port is set");
+
+		sender.sendMessage(allTypesMessage("/bundled", 1000), true);
+		ofxTest(waitForMessage(receiver, msg), "receive a message in a bundle");
+		ofxTest(hasAllTypes(msg, 1000), "every argument type survives a bundle");
+
+		// the storage of the first message is in the pool now and gets
+		// refilled with this one, nothing of the old one can be left
+		ofxOscMessage small;
+		small.setAddress("/small");
+		small.addIntArg(7);
+		sender.sendMessage(small, false);
+		ofxTest(waitForMessage(receiver, msg), "receive a message into a recycled message");
+		ofxTestEq(msg.getAddress(), std::string("/small"), "a recycled message has the new address");
+		ofxTestEq(msg.getTypeString(), std::string("i"), "a recycled message has no old arguments");
+		ofxTestEq(msg.getArgAsInt32(0), 7, "a recycled message has the new argument");
+		ofxTestEq(msg.getRemoteHost(), std::string("127.0.0.1"), "a recycled message has the new remote host");
+
+		// many messages queued at once, each with its own data
+		for(int i = 0; i < 20; i++){
+			ofxOscMessage numbered;
+			numbered.setAddress("/numbered");
+			numbered.addIntArg(i);
+			numbered.addStringArg(makeString(i * 10, 'a'));
+			sender.sendMessage(numbered, false);
+		}
+		bool allReceived = true;
+		for(int i = 0; i < 20 && allReceived; i++){
+			allReceived = waitForMessage(receiver, msg)
+				&& msg.getTypeString() == "is"
+				&& msg.getArgAsInt32(0) == i
+				&& msg.getArgAsString(1) == makeString(i * 10, 'a');
+		}
+		ofxTest(allReceived, "20 queued messages are received in order with their own arguments");
+		ofxTest(!receiver.hasWaitingMessages(), "no messages are left");
+	}
+
+	void run(){
+		testArgs();
+		testCopy();
+		testClear();
+		testReceiver();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
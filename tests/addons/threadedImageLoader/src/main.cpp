@@ -0,0 +1,169 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+#include "ofxThreadedImageLoader.h"
+
+class ofApp: public ofxUnitTestsApp{
+public:
+	// every test image has a different width so loaded images can be
+	// told apart, they don't use textures so there's no need for a
+	// gl context when the loader updates them
+	std::string createImage(size_t width, size_t height){
+		ofPixels pixels;
+		pixels.allocate(width, height, OF_PIXELS_RGB);
+		pixels.setColor(ofColor::white);
+		std::string path = "image" + ofToString(width) + "x" + ofToString(height) + ".png";
+		ofSaveImage(pixels, path);
+		return path;
+	}
+
+	std::vector<ofImage> createImages(size_t numImages){
+		std::vector<ofImage> images(numImages);
+		for(auto & image: images){
+			image.setUseTexture(false);
+		}
+		return images;
+	}
+
+	// updates until every request has been uploaded returning how many
+	// images were updated on each frame
+	std::vector<size_t> updateAll(ofxThreadedImageLoader & loader, std::vector<ofImage> & images, std::vector<size_t> & order){
+		std::vector<size_t> perFrame;
+		std::vector<bool> loaded(images.size(), false);
+		for(int i=0;i<1000 && loader.getNumPending()>0;i++){
+			ofSleepMillis(10);
+			ofEvents().notifyUpdate();
+			size_t updated = 0;
+			for(size_t j=0;j<images.size();j++){
+				if(!loaded[j] && images[j].isAllocated()){
+					loaded[j] = true;
+					order.push_back(j);
+					updated++;
+				}
+			}
+			if(updated > 0){
+				perFrame.push_back(updated);
+			}
+		}
+		return perFrame;
+	}
+
+	void testPriority(){
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "testPriority";
+
+		ofxThreadedImageLoader loader(1);
+		loader.setUploadBudget(1);
+		auto images = createImages(6);
+		std::vector<std::string> files;
+		for(size_t i=0;i<images.size();i++){
+			files.push_back(createImage(10 + i, 10));
+		}
+
+		// requests made while stopped are all pending when it starts
+		loader.stopThread();
+		loader.waitForThread(false);
+		ofxTest(!loader.isThreadRunning(), "workers stopped");
+		int priorities[] = {0, 5, -1, 10, 5, 2};
+		for(size_t i=0;i<images.size();i++){
+			loader.loadFromDisk(images[i], files[i], priorities[i]);
+		}
+		loader.setPriority(images[2], 20);
+		loader.startThread();
+		ofxTest(loader.isThreadRunning(), "workers restarted");
+
+		std::vector<size_t> order;
+		updateAll(loader, images, order);
+		std::vector<size_t> expected = {2, 3, 1, 4, 5, 0};
+		ofxTest(order == expected, "images loaded by priority, then by request order");
+		bool rightSizes = true;
+		for(size_t i=0;i<images.size();i++){
+			rightSizes &= images[i].getWidth() == 10 + i;
+		}
+		ofxTest(rightSizes, "every image loaded its file");
+	}
+
+	void testCancel(){
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "testCancel";
+
+		ofxThreadedImageLoader loader(2);
+		auto images = createImages(3);
+		auto first = createImage(20, 10);
+		auto second = createImage(30, 10);
+
+		loader.stopThread();
+		loader.loadFromDisk(images[0], first);
+		loader.loadFromDisk(images[0], second);
+		loader.loadFromDisk(images[1], first);
+		loader.loadFromDisk(images[2], first);
+		loader.cancel(images[1]);
+		ofxTestEq(loader.getNumPending(), size_t(2), "replaced and canceled requests aren't pending");
+		loader.startThread();
+
+		std::vector<size_t> order;
+		updateAll(loader, images, order);
+		ofxTestEq(loader.getNumPending(), size_t(0), "every request uploaded");
+		ofxTestEq(images[0].getWidth(), 30.f, "a new request replaces the pending one");
+		ofxTest(!images[1].isAllocated(), "a canceled image isn't loaded");
+		ofxTestEq(images[2].getWidth(), 20.f, "other images are still loaded");
+
+		// canceled before being uploaded
+		loader.loadFromDisk(images[1], second);
+		loader.cancelAll();
+		ofxTestEq(loader.getNumPending(), size_t(0), "no requests pending after canceling all");
+		updateAll(loader, images, order);
+		ofxTest(!images[1].isAllocated(), "an image canceled before being uploaded isn't loaded");
+	}
+
+	void testUploadBudget(){
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "testUploadBudget";
+
+		ofxThreadedImageLoader loader(4);
+		auto images = createImages(7);
+		auto file = createImage(40, 40);
+		ofPixels pixels;
+		ofLoadImage(pixels, file);
+		loader.setUploadBudget(pixels.getTotalBytes() * 2);
+
+		for(auto & image: images){
+			loader.loadFromDisk(image, file);
+		}
+		// lets the workers decode everything before the first update
+		ofSleepMillis(200);
+		std::vector<size_t> order;
+		auto perFrame = updateAll(loader, images, order);
+		std::vector<size_t> expected = {2, 2, 2, 1};
+		ofxTest(perFrame == expected, "images uploaded per frame within the budget");
+		ofxTestEq(order.size(), images.size(), "every image uploaded");
+
+		loader.setUploadBudget(1);
+		for(auto & image: images){
+			image.clear();
+			image.setUseTexture(false);
+			loader.loadFromDisk(image, file);
+		}
+		order.clear();
+		perFrame = updateAll(loader, images, order);
+		ofxTestEq(perFrame.size(), images.size(), "at least one image uploaded per frame");
+	}
+
+	void run(){
+		testPriority();
+		testCancel();
+		testUploadBudget();
+	}
+};
+
+//========================================================================
+int main( ){
+    ofInit();
+	auto window = make_shared<ofAppNoWindow>();
+	auto app = make_shared<ofApp>();
+	// this kicks off the running of my app
+	// can be OF_WINDOW or OF_FULLSCREEN
+	// pass in width and height too:
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
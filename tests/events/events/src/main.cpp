@@ -25,6 +25,36 @@ namespace {
 	void voidFunc(){
 		toggleVoidFunc = !toggleVoidFunc;
 	}
+
+	// exposes the snapshots kept until no notify is running
+	class SnapshotEvent: public ofEvent<const int>{
+	public:
+		size_t getNumRetiredSnapshots(){
+			std::unique_lock<std::recursive_mutex> lck(self->mtx);
+			return self->retiredSnapshots.size();
+		}
+	};
+
+	// returns the average time in nanoseconds of a notify call
+	// with numListeners listeners in copy or snapshot dispatch mode
+	double benchmarkNotify(size_t numListeners, bool snapshotDispatch){
+		const int iterations = 100000;
+		ofEvent<const int> e;
+		e.setSnapshotDispatch(snapshotDispatch);
+		int sum = 0;
+		ofEventListeners listeners;
+		for(size_t i = 0; i < numListeners; i++){
+			listeners.push(e.newListener([&](const int & i){
+				sum += i;
+			}));
+		}
+		auto then = ofGetElapsedTimeMicros();
+		for(int i = 0; i < iterations; i++){
+			e.notify(1);
+		}
+		auto now = ofGetElapsedTimeMicros();
+		return double(now - then) * 1000. / iterations;
+	}
 }
 
 class ofApp: public ofxUnitTestsApp{
@@ -158,6 +188,66 @@ class ofApp: public ofxUnitTestsApp{
 		}
 
 
+		{
+			ofEvent<const int> intEvent;
+			intEvent.setSnapshotDispatch(true);
+			lastIntFromLambda = 0;
+			lastIntWithToken = 0;
+			ofEventListener listenerLambda(intEvent.newListener([&](const int & i){
+				lastIntFromLambda = i;
+			}, 0));
+			ofEventListener listenerMember(intEvent.newListener(this, &ofApp::intListenerWithToken));
+
+			ofNotifyEvent(intEvent, 5);
+			ofxTestEq(lastIntFromLambda, 5, "Testing snapshot dispatch int event to lambda function");
+			ofxTestEq(lastIntWithToken, 5, "Testing snapshot dispatch int event to member function with release token");
+
+			listenerMember.unsubscribe();
+			ofNotifyEvent(intEvent, 6);
+			ofxTestEq(lastIntFromLambda, 6, "Testing snapshot dispatch int event after removing a listener");
+			ofxTestEq(lastIntWithToken, 5, "Testing snapshot dispatch remove listener on int event to member function");
+
+			intEvent.setSnapshotDispatch(false);
+			ofNotifyEvent(intEvent, 7);
+			ofxTestEq(lastIntFromLambda, 7, "Testing int event to lambda function after disabling snapshot dispatch");
+		}
+
+		{
+			selfUnregisterValue = 0;
+			selfUnregisterEvent.setSnapshotDispatch(true);
+			auto listener = selfUnregisterEvent.newListener(selfUnregister);
+			selfUnregisterEvent.notify(5);
+			ofxTestEq(selfUnregisterValue, 5, "Testing snapshot dispatch remove listener on event callback, first call");
+			selfUnregisterEvent.notify(6);
+			ofxTestEq(selfUnregisterValue, 5, "Testing snapshot dispatch remove listener on event callback, second call");
+			selfUnregisterEvent.setSnapshotDispatch(false);
+		}
+
+		{
+			// every listener added while notifying replaces the snapshot
+			// being iterated, the last notify frees them when it finishes
+			SnapshotEvent e;
+			e.setSnapshotDispatch(true);
+			ofEventListeners added;
+			auto listener = e.newListener([&](const int & i){
+				added.push(e.newListener([](const int & i){}));
+			});
+			for(int i = 0; i < 100; i++){
+				e.notify(i);
+			}
+			ofxTestEq(e.getNumRetiredSnapshots(), size_t(0), "Testing snapshot dispatch frees snapshots replaced while notifying");
+		}
+
+		{
+			for(auto numListeners: {1, 10, 100}){
+				auto copyTime = benchmarkNotify(numListeners, false);
+				auto snapshotTime = benchmarkNotify(numListeners, true);
+				ofLogNotice() << "notify with " << numListeners << " listeners: "
+							  << copyTime << "ns copy dispatch, "
+							  << snapshotTime << "ns snapshot dispatch";
+			}
+		}
+
 		{
 			ofEvent<const int> e;
 			auto listener = e.newListener([](const int & v){
@@ -274,6 +274,176 @@ class ofApp: public ofxUnitTestsApp{
 		return 0;
 	}
 
+	template<typename PixelType>
+	void randomize(ofPixels_<PixelType> & pixels){
+		for(auto & p: pixels){
+			p = ofRandom(ofColor_<PixelType>::limit());
+		}
+	}
+
+	template<typename PixelType>
+	bool equal(const ofPixels_<PixelType> & a, const ofPixels_<PixelType> & b, float tolerance = 0){
+		if(a.size() != b.size()){
+			return false;
+		}
+		for(size_t i = 0; i < a.size(); i++){
+			if(std::abs(float(a[i]) - float(b[i])) > tolerance){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// runs an operation with and without SIMD and checks that the results are the same
+	template<typename PixelType, typename Op>
+	void testSIMD(ofPixelFormat pixelFormat, string name, Op op, float tolerance = 0){
+		ofPixels_<PixelType> src, scalar, simd;
+		src.allocate(67, 33, pixelFormat);
+		randomize(src);
+		ofSetPixelsUsingSIMD(false);
+		op(src, scalar);
+		ofSetPixelsUsingSIMD(true);
+		op(src, simd);
+		ofxTest(equal(scalar, simd, tolerance), name + " " + formatName(pixelFormat) + " SIMD == scalar");
+	}
+
+	template<typename PixelType>
+	void testSIMD(ofPixelFormat pixelFormat){
+		if(pixelFormat == OF_PIXELS_RGB || pixelFormat == OF_PIXELS_RGBA){
+			testSIMD<PixelType>(pixelFormat, "swapRgb", [](const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
+				dst = src;
+				dst.swapRgb();
+			});
+		}
+		testSIMD<PixelType>(pixelFormat, "mirrorTo horizontal", [](const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
+			src.mirrorTo(dst, false, true);
+		});
+		testSIMD<PixelType>(pixelFormat, "mirrorTo both", [](const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
+			src.mirrorTo(dst, true, true);
+		});
+		testSIMD<PixelType>(pixelFormat, "blendInto", [](const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
+			dst.allocate(src.getWidth() + 10, src.getHeight() + 10, src.getPixelFormat());
+			dst.setColor(ofColor_<PixelType>(ofColor_<PixelType>::limit() / 2));
+			src.blendInto(dst, 5, 7);
+		});
+		testSIMD<PixelType>(pixelFormat, "convert to float", [](const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
+			ofFloatPixels f = src;
+			dst = f;
+		});
+		testSIMD<PixelType>(pixelFormat, "convert to short", [](const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
+			ofShortPixels s = src;
+			dst = s;
+		});
+		testSIMD<PixelType>(pixelFormat, "convert to char", [](const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
+			ofPixels c = src;
+			dst = c;
+		});
+	}
+
+	// logs the speed of an operation in MPixel/s with and without SIMD
+	template<typename Op>
+	void benchmarkSIMD(string name, size_t numPixels, Op op){
+		const int iterations = 20;
+		for(auto simd: {false, true}){
+			ofSetPixelsUsingSIMD(simd);
+			op();
+			auto then = ofGetElapsedTimeMicros();
+			for(int i = 0; i < iterations; i++){
+				op();
+			}
+			auto elapsed = std::max<uint64_t>(ofGetElapsedTimeMicros() - then, 1);
+			ofLogNotice() << name << (simd ? " SIMD: " : " scalar: ") << numPixels * iterations / double(elapsed) << " MPixel/s";
+		}
+		ofSetPixelsUsingSIMD(true);
+	}
+
+	void benchmarkSIMD(){
+		const size_t w = 1920;
+		const size_t h = 1080;
+		ofPixels src, dst, small;
+		src.allocate(w, h, OF_PIXELS_RGBA);
+		randomize(src);
+		dst = src;
+		small.allocate(w / 2, h / 2, OF_PIXELS_RGBA);
+		ofFloatPixels f;
+		benchmarkSIMD("swapRgb RGBA", w * h, [&]{ dst.swapRgb(); });
+		benchmarkSIMD("mirrorTo RGBA", w * h, [&]{ src.mirrorTo(dst, false, true); });
+		benchmarkSIMD("blendInto RGBA", w * h, [&]{ src.blendInto(dst, 0, 0); });
+		benchmarkSIMD("copyFrom RGBA to float", w * h, [&]{ f = src; });
+		benchmarkSIMD("copyFrom float to RGBA", w * h, [&]{ dst = f; });
+		benchmarkSIMD("resizeTo bicubic RGBA", w * h / 4, [&]{ src.resizeTo(small, OF_INTERPOLATE_BICUBIC); });
+	}
+
+	// runs an operation with one thread and with all the cores and checks
+	// that the results are the same
+	template<typename Op>
+	void testThreads(ofPixelFormat pixelFormat, string name, Op op){
+		ofPixels src, single, multi;
+		src.allocate(1024, 768, pixelFormat);
+		randomize(src);
+		ofSetPixelsNumThreads(1);
+		op(src, single);
+		ofSetPixelsNumThreads(0);
+		op(src, multi);
+		ofSetPixelsNumThreads(1);
+		ofxTest(equal(single, multi), name + " " + formatName(pixelFormat) + " threaded == single thread");
+	}
+
+	void testThreads(ofPixelFormat pixelFormat){
+		testThreads(pixelFormat, "resizeTo nearest", [](const ofPixels & src, ofPixels & dst){
+			dst.allocate(src.getWidth() * 2, src.getHeight() * 2, src.getPixelFormat());
+			src.resizeTo(dst, OF_INTERPOLATE_NEAREST_NEIGHBOR);
+		});
+		testThreads(pixelFormat, "resizeTo bicubic", [](const ofPixels & src, ofPixels & dst){
+			dst.allocate(src.getWidth() * 3 / 2, src.getHeight() / 2, src.getPixelFormat());
+			src.resizeTo(dst, OF_INTERPOLATE_BICUBIC);
+		});
+		testThreads(pixelFormat, "mirrorTo", [](const ofPixels & src, ofPixels & dst){
+			src.mirrorTo(dst, true, true);
+		});
+		testThreads(pixelFormat, "pasteInto", [](const ofPixels & src, ofPixels & dst){
+			dst.allocate(src.getWidth() + 20, src.getHeight() + 20, src.getPixelFormat());
+			dst.set(0);
+			src.pasteInto(dst, 10, 20);
+		});
+		if(numChannels(pixelFormat) > 0){
+			testThreads(pixelFormat, "rotate90To", [](const ofPixels & src, ofPixels & dst){
+				src.rotate90To(dst, 1);
+			});
+			testThreads(pixelFormat, "rotate90To -1", [](const ofPixels & src, ofPixels & dst){
+				src.rotate90To(dst, -1);
+			});
+			testThreads(pixelFormat, "blendInto", [](const ofPixels & src, ofPixels & dst){
+				dst = src;
+				dst.mirror(true, false);
+				src.blendInto(dst, 0, 0);
+			});
+			testThreads(pixelFormat, "getChannel/setChannel", [](const ofPixels & src, ofPixels & dst){
+				dst = src;
+				dst.setChannel(0, src.getChannel(src.getNumChannels() - 1));
+			});
+		}
+	}
+
+	void benchmarkThreads(){
+		ofPixels src, dst;
+		src.allocate(3840, 2160, OF_PIXELS_RGBA);
+		randomize(src);
+		dst.allocate(1920, 1080, OF_PIXELS_RGBA);
+		for(auto numThreads: {1, 0}){
+			ofSetPixelsNumThreads(numThreads);
+			auto then = ofGetElapsedTimeMicros();
+			src.resizeTo(dst, OF_INTERPOLATE_BICUBIC);
+			auto resize = ofGetElapsedTimeMicros() - then;
+			then = ofGetElapsedTimeMicros();
+			src.mirrorTo(dst, true, true);
+			auto mirror = ofGetElapsedTimeMicros() - then;
+			ofLogNotice() << "4K RGBA with " << ofGetPixelsNumThreads() << " threads: resizeTo bicubic "
+				<< resize / 1000. << "ms, mirrorTo " << mirror / 1000. << "ms";
+		}
+		ofSetPixelsNumThreads(1);
+	}
+
 	void run(){
 		ofPixels pixels;
 		const int w = 320;
@@ -309,6 +479,26 @@ class ofApp: public ofxUnitTestsApp{
                 ofxTestEq((uint64_t)&pixels.getLine(0).getPixel(10)[0], (uint64_t)pixels.getData()+(10*bpp/8),"getLine(0).getPixel(10)[0]==pixels.getData()+(10*bpp/8)");
 			}
 		}
+
+		ofLogNotice() << "SIMD " << (ofGetPixelsUsingSIMD() ? "enabled" : "not supported");
+		for(auto pixelFormat: {OF_PIXELS_GRAY, OF_PIXELS_GRAY_ALPHA, OF_PIXELS_RGB, OF_PIXELS_RGBA}){
+			testSIMD<unsigned char>(pixelFormat);
+			testSIMD<unsigned short>(pixelFormat);
+			testSIMD<float>(pixelFormat);
+		}
+		for(auto pixelFormat: {OF_PIXELS_RGB, OF_PIXELS_RGBA}){
+			// the SIMD version might use fused multiply add on some platforms
+			testSIMD<unsigned char>(pixelFormat, "resizeTo bicubic", [](const ofPixels & src, ofPixels & dst){
+				dst.allocate(src.getWidth() * 3 / 2, src.getHeight() * 2, src.getPixelFormat());
+				src.resizeTo(dst, OF_INTERPOLATE_BICUBIC);
+			}, 1);
+		}
+		benchmarkSIMD();
+
+		for(auto pixelFormat: {OF_PIXELS_GRAY, OF_PIXELS_RGB, OF_PIXELS_RGBA, OF_PIXELS_NV12, OF_PIXELS_I420}){
+			testThreads(pixelFormat);
+		}
+		benchmarkThreads();
 	}
 };
 
@@ -0,0 +1,118 @@
+#include "ofPolyline.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// a star with uneven spikes, big enough to get a spatial index
+	ofPolyline randomStar(size_t numPoints, bool closed){
+		ofPolyline star;
+		for(size_t i = 0; i < numPoints; i++){
+			float angle = i * TWO_PI / numPoints;
+			float r = (i % 2 ? 60 : 100) * ofRandom(0.8f, 1.2f);
+			star.addVertex(glm::vec3(cos(angle), sin(angle), 0) * r);
+		}
+		if(closed){
+			star.close();
+		}
+		return star;
+	}
+
+	// copies the polyline without its index so queries scan every segment
+	ofPolyline linearCopy(const ofPolyline & polyline){
+		ofPolyline linear = polyline;
+		linear.getVertices();
+		return linear;
+	}
+
+	// true if inside() and getClosestPoint() give the same results with
+	// and without the index for every point
+	bool sameQueries(const ofPolyline & indexed, const std::vector<glm::vec3> & points){
+		auto linear = linearCopy(indexed);
+		for(auto & p: points){
+			unsigned int indexedNearest = 0, linearNearest = 0;
+			if(indexed.inside(p) != linear.inside(p)
+			   || indexed.getClosestPoint(p, &indexedNearest) != linear.getClosestPoint(p, &linearNearest)
+			   || indexedNearest != linearNearest){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void testIndex(bool closed){
+		std::string type = closed ? "closed" : "open";
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << type << " polyline";
+
+		auto polyline = randomStar(1000, closed);
+		polyline.buildSpatialIndex();
+		ofxTest(polyline.hasSpatialIndex(), "a big " + type + " polyline gets an index");
+		ofxTest(!linearCopy(polyline).hasSpatialIndex(), "non const access to the vertices drops the index");
+
+		// points inside and around the bounds
+		auto bounds = polyline.getBoundingBox();
+		std::vector<glm::vec3> points;
+		for(int i = 0; i < 2000; i++){
+			points.emplace_back(ofRandom(bounds.getLeft() - bounds.width, bounds.getRight() + bounds.width),
+								ofRandom(bounds.getTop() - bounds.height, bounds.getBottom() + bounds.height), 0);
+		}
+		ofxTest(sameQueries(polyline, points), type + " polyline: the same results as the linear scan for random points");
+
+		// vertices and points in the middle of the edges
+		points.clear();
+		auto & vertices = static_cast<const ofPolyline &>(polyline).getVertices();
+		for(size_t i = 0; i < vertices.size(); i++){
+			points.push_back(vertices[i]);
+			points.push_back((vertices[i] + vertices[(i + 1) % vertices.size()]) * 0.5f);
+		}
+		ofxTest(sameQueries(polyline, points), type + " polyline: the same results as the linear scan for points on the edges");
+	}
+
+	void testTies(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "ties";
+
+		// a zigzag that goes back over itself, every point is as close
+		// to a segment on the way there as to one on the way back
+		ofPolyline polyline;
+		for(int i = 0; i <= 100; i++){
+			polyline.addVertex(i * 10, i % 2 ? 10 : 0);
+		}
+		for(int i = 99; i >= 0; i--){
+			polyline.addVertex(i * 10, i % 2 ? 10 : 0);
+		}
+		polyline.buildSpatialIndex();
+		ofxTest(polyline.hasSpatialIndex(), "the zigzag gets an index");
+
+		std::vector<glm::vec3> points;
+		for(int i = 0; i < 500; i++){
+			points.emplace_back(ofRandom(-50, 1050), ofRandom(-50, 60), 0);
+		}
+		ofxTest(sameQueries(polyline, points), "ties are resolved by the lowest segment index as in the linear scan");
+		// the closest point is the vertex at 10,10 for the two segments
+		// that meet there on the way there and the two on the way back
+		unsigned int nearest = 0;
+		auto closest = polyline.getClosestPoint(glm::vec3(15, 20, 0), &nearest);
+		ofxTest(closest == glm::vec3(10, 10, 0), "the closest point is the shared vertex");
+		ofxTestEq(nearest, 1u, "the first segment wins the tie");
+	}
+
+	void run(){
+		ofSeedRandom(0);
+		testIndex(true);
+		testIndex(false);
+		testTies();
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
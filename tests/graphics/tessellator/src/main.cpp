@@ -0,0 +1,175 @@
+#include "ofTessellator.h"
+#include "ofPolyline.h"
+#include "ofMesh.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// a star with a hole in the middle, as the contours of a glyph or a
+	// vector drawing, every few shapes is empty
+	std::vector<ofPolyline> randomShape(size_t index, int numPoints){
+		std::vector<ofPolyline> contours;
+		if(index % 17 == 16){
+			return contours;
+		}
+		glm::vec3 center(ofRandom(-500, 500), ofRandom(-500, 500), 0);
+		float radius = ofRandom(20, 60);
+		ofPolyline star, hole;
+		for(int i = 0; i < numPoints; i++){
+			float angle = i * TWO_PI / numPoints;
+			float r = radius * (i % 2 ? 0.6f : 1.f) * ofRandom(0.9f, 1.1f);
+			star.addVertex(center + glm::vec3(cos(angle), sin(angle), 0) * r);
+			hole.addVertex(center + glm::vec3(cos(-angle), sin(-angle), 0) * radius * 0.3f);
+		}
+		star.close();
+		hole.close();
+		contours.push_back(star);
+		contours.push_back(hole);
+		return contours;
+	}
+
+	std::vector<std::vector<ofPolyline>> randomShapes(size_t numShapes, int numPoints){
+		std::vector<std::vector<ofPolyline>> shapes;
+		for(size_t i = 0; i < numShapes; i++){
+			shapes.push_back(randomShape(i, numPoints));
+		}
+		return shapes;
+	}
+
+	bool sameRanges(const std::vector<ofTessellator::ShapeRange> & a, const std::vector<ofTessellator::ShapeRange> & b){
+		if(a.size() != b.size()){
+			return false;
+		}
+		for(size_t i = 0; i < a.size(); i++){
+			if(a[i].vertexOffset != b[i].vertexOffset || a[i].numVertices != b[i].numVertices
+			   || a[i].indexOffset != b[i].indexOffset || a[i].numIndices != b[i].numIndices){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool sameMesh(const ofMesh & a, const ofMesh & b){
+		return a.getVertices() == b.getVertices() && a.getIndices() == b.getIndices();
+	}
+
+	void testBatch(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "batch";
+
+		auto shapes = randomShapes(400, 40);
+		ofTessellator serial;
+		ofMesh serialMesh;
+		std::vector<ofTessellator::ShapeRange> serialRanges;
+		serial.tessellateToMesh(shapes, OF_POLY_WINDING_ODD, serialMesh, serialRanges, true);
+		ofxTestEq(serialRanges.size(), shapes.size(), "there's a range per shape");
+
+		// every shape is where its range says, the same as tessellating it alone
+		bool sameAsSingle = true;
+		bool indicesInRange = true;
+		bool emptyRanges = true;
+		size_t vertexOffset = 0;
+		size_t indexOffset = 0;
+		ofTessellator single;
+		ofMesh singleMesh;
+		for(size_t i = 0; i < shapes.size(); i++){
+			auto & range = serialRanges[i];
+			if(shapes[i].empty()){
+				emptyRanges &= range.numVertices == 0 && range.numIndices == 0;
+				continue;
+			}
+			sameAsSingle &= range.vertexOffset == vertexOffset && range.indexOffset == indexOffset;
+			single.tessellateToMesh(shapes[i], OF_POLY_WINDING_ODD, singleMesh, true);
+			sameAsSingle &= singleMesh.getNumVertices() == range.numVertices && singleMesh.getNumIndices() == range.numIndices;
+			for(size_t j = 0; j < range.numVertices && sameAsSingle; j++){
+				sameAsSingle &= serialMesh.getVertex(range.vertexOffset + j) == singleMesh.getVertex(j);
+			}
+			for(size_t j = 0; j < range.numIndices && sameAsSingle; j++){
+				auto index = serialMesh.getIndex(range.indexOffset + j);
+				indicesInRange &= index >= range.vertexOffset && index < range.vertexOffset + range.numVertices;
+				sameAsSingle &= index - range.vertexOffset == singleMesh.getIndex(j);
+			}
+			vertexOffset += range.numVertices;
+			indexOffset += range.numIndices;
+		}
+		ofxTest(sameAsSingle, "every shape is the same as tessellated alone");
+		ofxTest(indicesInRange, "indices point to the vertices of their shape");
+		ofxTest(emptyRanges, "empty shapes have empty ranges");
+		ofxTestEq(serialMesh.getNumVertices(), vertexOffset, "the mesh only has the vertices of the shapes");
+
+		for(size_t numThreads: {2, 4, 0}){
+			ofTessellator threaded;
+			threaded.setNumThreads(numThreads);
+			ofMesh mesh;
+			std::vector<ofTessellator::ShapeRange> ranges;
+			threaded.tessellateToMesh(shapes, OF_POLY_WINDING_ODD, mesh, ranges, true);
+			ofxTest(sameMesh(mesh, serialMesh), ofToString(numThreads) + " threads give the same mesh as 1");
+			ofxTest(sameRanges(ranges, serialRanges), ofToString(numThreads) + " threads give the same ranges as 1");
+
+			// the threads and the mesh are reused by the next batch
+			auto otherShapes = randomShapes(300, 24);
+			ofMesh otherSerialMesh;
+			std::vector<ofTessellator::ShapeRange> otherSerialRanges;
+			serial.tessellateToMesh(otherShapes, OF_POLY_WINDING_ODD, otherSerialMesh, otherSerialRanges, true);
+			threaded.tessellateToMesh(otherShapes, OF_POLY_WINDING_ODD, mesh, ranges, true);
+			ofxTest(sameMesh(mesh, otherSerialMesh) && sameRanges(ranges, otherSerialRanges),
+					ofToString(numThreads) + " threads give the same result when reused");
+
+			// small batches are tessellated in the calling thread
+			auto fewShapes = randomShapes(3, 10);
+			ofMesh fewSerialMesh;
+			std::vector<ofTessellator::ShapeRange> fewSerialRanges;
+			serial.tessellateToMesh(fewShapes, OF_POLY_WINDING_ODD, fewSerialMesh, fewSerialRanges, true);
+			threaded.tessellateToMesh(fewShapes, OF_POLY_WINDING_ODD, mesh, ranges, true);
+			ofxTest(sameMesh(mesh, fewSerialMesh) && sameRanges(ranges, fewSerialRanges),
+					ofToString(numThreads) + " threads give the same result for small batches");
+		}
+	}
+
+	// a batch tessellated every frame, as the shapes of an animated
+	// vector drawing
+	void benchmark(size_t numShapes, int numPoints, size_t numThreads){
+		const int numFrames = 100;
+		auto shapes = randomShapes(numShapes, numPoints);
+		ofTessellator tessellator;
+		tessellator.setNumThreads(numThreads);
+		ofMesh mesh;
+		std::vector<ofTessellator::ShapeRange> ranges;
+		tessellator.tessellateToMesh(shapes, OF_POLY_WINDING_ODD, mesh, ranges, true);
+		auto then = ofGetElapsedTimeMicros();
+		for(int i = 0; i < numFrames; i++){
+			tessellator.tessellateToMesh(shapes, OF_POLY_WINDING_ODD, mesh, ranges, true);
+		}
+		auto micros = ofGetElapsedTimeMicros() - then;
+		ofLogNotice() << numShapes << " shapes of " << numPoints * 2 << " vertices, " << numThreads << " threads: "
+			<< double(micros) / numFrames << "us per batch";
+	}
+
+	void benchmark(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "benchmark";
+		for(size_t numShapes: {10, 100, 1000}){
+			for(size_t numThreads: {1, 2, 4}){
+				benchmark(numShapes, 40, numThreads);
+			}
+		}
+	}
+
+	void run(){
+		ofSeedRandom(0);
+		testBatch();
+		benchmark();
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -10,6 +10,60 @@ class ofApp: public ofxUnitTestsApp{
 		ofxTest(img.load(ofToDataPath("indispensable.jpg", true)), "load from fs");
 		ofxTest(img.load("http://openframeworks.cc/about/0.jpg"), "load from http");
 		ofxTest(img.load("https://forum.openframeworks.cc/user_avatar/forum.openframeworks.cc/arturo/45/3965_1.png"), "load from https");
+
+		ofPixels loaded;
+		ofxTest(ofLoadImage(loaded, "indispensable.jpg"), "ofLoadImage");
+
+		ofPixels into;
+		into.allocate(loaded.getWidth(), loaded.getHeight(), loaded.getPixelFormat());
+		auto data = into.getData();
+		ofxTest(ofLoadImageInto(into, "indispensable.jpg"), "ofLoadImageInto");
+		ofxTestEq((uint64_t)into.getData(), (uint64_t)data, "ofLoadImageInto doesn't reallocate");
+		ofxTest(std::equal(loaded.begin(), loaded.end(), into.begin()), "ofLoadImageInto same pixels as ofLoadImage");
+
+		ofPixels bgra;
+		bgra.allocate(loaded.getWidth(), loaded.getHeight(), OF_PIXELS_BGRA);
+		ofxTest(ofLoadImageInto(bgra, "indispensable.jpg"), "ofLoadImageInto BGRA");
+		auto color = loaded.getColor(10, 20);
+		auto colorBgra = bgra.getColor(10, 20);
+		ofxTestEq(int(colorBgra.r), int(color.r), "ofLoadImageInto BGRA red");
+		ofxTestEq(int(colorBgra.b), int(color.b), "ofLoadImageInto BGRA blue");
+		ofxTestEq(int(colorBgra.a), 255, "ofLoadImageInto BGRA opaque alpha");
+
+		ofPixels wrongSize;
+		wrongSize.allocate(loaded.getWidth() / 2, loaded.getHeight(), loaded.getPixelFormat());
+		data = wrongSize.getData();
+		ofxTest(!ofLoadImageInto(wrongSize, "indispensable.jpg"), "ofLoadImageInto fails with wrong size");
+		ofxTestEq((uint64_t)wrongSize.getData(), (uint64_t)data, "ofLoadImageInto doesn't reallocate with wrong size");
+		ofxTestEq(wrongSize.getWidth(), loaded.getWidth() / 2, "ofLoadImageInto doesn't resize");
+
+		ofPixels notAllocated;
+		ofxTest(!ofLoadImageInto(notAllocated, "indispensable.jpg"), "ofLoadImageInto fails with unallocated pixels");
+
+		ofPixels rgba;
+		rgba.allocate(67, 33, OF_PIXELS_RGBA);
+		for(auto & p: rgba){
+			p = ofRandom(255);
+		}
+		ofBuffer png;
+		ofSaveImage(rgba, png, OF_IMAGE_FORMAT_PNG);
+		ofPixels rgbaInto;
+		rgbaInto.allocate(67, 33, OF_PIXELS_RGBA);
+		ofxTest(ofLoadImageInto(rgbaInto, png), "ofLoadImageInto from buffer");
+		ofxTest(std::equal(rgba.begin(), rgba.end(), rgbaInto.begin()), "ofLoadImageInto RGBA png round trip");
+
+		const int iterations = 20;
+		auto then = ofGetElapsedTimeMicros();
+		for(int i = 0; i < iterations; i++){
+			ofLoadImage(loaded, "indispensable.jpg");
+		}
+		auto loadTime = ofGetElapsedTimeMicros() - then;
+		then = ofGetElapsedTimeMicros();
+		for(int i = 0; i < iterations; i++){
+			ofLoadImageInto(into, "indispensable.jpg");
+		}
+		auto intoTime = ofGetElapsedTimeMicros() - then;
+		ofLogNotice() << "ofLoadImage " << loadTime / iterations << "us, ofLoadImageInto " << intoTime / iterations << "us";
 	}
 };
 
@@ -0,0 +1,286 @@
+#include "ofSoundBuffer.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include "glm/gtc/constants.hpp"
+
+class ofApp: public ofxUnitTestsApp{
+	void testExternalBuffer(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "external buffer";
+
+		std::vector<float> device(16, 0.f);
+		ofSoundBuffer view;
+		view.setFromExternalBuffer(device.data(), 8, 2, 48000);
+		ofxTest(!view.isBufferOwner(), "wraps external memory");
+		ofxTestEq(view.getNumFrames(), size_t(8), "frames of the external memory");
+		ofxTestEq(view.getSampleRate(), 48000u, "sample rate of the external memory");
+		ofxTest(view.getData() == device.data(), "samples are not copied");
+
+		view.getSample(1, 1) = 1.f;
+		view *= 0.5f;
+		ofxTestEq(device[3], 0.5f, "writes go to the external memory");
+
+		ofSoundBuffer copy = view;
+		ofxTest(copy.isBufferOwner(), "copies own their samples");
+		ofxTestEq(copy[3], 0.5f, "copies keep the samples");
+		copy[3] = 0.f;
+		ofxTestEq(device[3], 0.5f, "writing a copy doesn't modify the external memory");
+
+		ofSoundBuffer other;
+		other.allocate(8, 2);
+		other.set(0.25f);
+		other.copyTo(view);
+		view.resize(16);
+		ofxTest(!view.isBufferOwner(), "resizing to the same size keeps wrapping");
+		ofxTestEq(device[0], 0.25f, "copying to a view writes the external memory");
+
+		ofSoundBuffer retained;
+		retained.swap(view);
+		ofxTest(retained.isBufferOwner() && view.isBufferOwner(), "swapped buffers own their samples");
+		ofxTest(retained.getData() != device.data(), "swapped buffers don't wrap the external memory");
+		ofxTestEq(retained[0], 0.25f, "swapped buffers keep the samples");
+
+		view.setFromExternalBuffer(device.data(), 8, 2, 48000);
+		view.getBuffer();
+		ofxTest(view.isBufferOwner(), "the vector of a view is owned");
+		ofxTestEq(view.size(), size_t(16), "owning keeps the size");
+		view.setFromExternalBuffer(device.data(), 8, 2, 48000);
+		view.resize(32);
+		ofxTest(view.isBufferOwner(), "resizing a view owns its samples");
+		ofxTestEq(view[0], 0.25f, "resizing a view keeps its samples");
+	}
+
+	ofSoundBuffer randomBuffer(size_t numFrames, size_t numChannels){
+		ofSoundBuffer buffer;
+		buffer.allocate(numFrames, numChannels);
+		buffer.fillWithNoise(1);
+		return buffer;
+	}
+
+	// runs an operation with and without SIMD and checks that the results are the same
+	template<typename Op>
+	void testSIMD(std::string name, Op op, float tolerance = 0){
+		ofSetSoundBufferUsingSIMD(false);
+		auto scalar = op();
+		ofSetSoundBufferUsingSIMD(true);
+		auto simd = op();
+		bool equal = scalar.size() == simd.size();
+		for(size_t i = 0; i < scalar.size() && equal; i++){
+			equal = std::abs(float(scalar[i]) - float(simd[i])) <= tolerance;
+		}
+		ofxTest(equal, name + " SIMD == scalar");
+	}
+
+	void testSIMD(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "SIMD";
+
+		// odd sizes so the scalar code finishes what SIMD leaves
+		auto stereo = randomBuffer(1001, 2);
+		auto mono = randomBuffer(1001, 1);
+		testSIMD("gain", [&]{
+			auto buffer = stereo;
+			buffer *= 0.3f;
+			return buffer.getBuffer();
+		});
+		testSIMD("stereoPan", [&]{
+			auto buffer = stereo;
+			buffer.stereoPan(0.2f, 0.7f);
+			return buffer.getBuffer();
+		});
+		testSIMD("addTo", [&]{
+			auto buffer = stereo;
+			stereo.addTo(buffer, 0, false);
+			return buffer.getBuffer();
+		});
+		testSIMD("copyTo mono to stereo", [&]{
+			ofSoundBuffer buffer;
+			mono.copyTo(buffer, mono.getNumFrames(), 2, 0);
+			return buffer.getBuffer();
+		});
+		testSIMD("addTo mono to stereo", [&]{
+			auto buffer = stereo;
+			mono.addTo(buffer, 0, false);
+			return buffer.getBuffer();
+		});
+		testSIMD("toShortPCM", [&]{
+			std::vector<short> pcm;
+			stereo.toShortPCM(pcm);
+			return pcm;
+		});
+		testSIMD("copyFrom short", [&]{
+			std::vector<short> pcm;
+			stereo.toShortPCM(pcm);
+			ofSoundBuffer buffer;
+			buffer.copyFrom(pcm, 2, 44100);
+			return buffer.getBuffer();
+		});
+		testSIMD("RMS", [&]{
+			return std::vector<float>{stereo.getRMSAmplitude()};
+		}, 1e-6f);
+	}
+
+	ofSoundBuffer tone(float pitchHz, size_t numFrames, size_t numChannels, unsigned int sampleRate){
+		ofSoundBuffer buffer;
+		buffer.allocate(numFrames, numChannels);
+		buffer.setSampleRate(sampleRate);
+		// not fillWithTone which accumulates the phase in a float
+		for(size_t i = 0; i < numFrames; i++){
+			for(size_t j = 0; j < numChannels; j++){
+				buffer.getSample(i, j) = sin(glm::two_pi<double>() * pitchHz * i / sampleRate);
+			}
+		}
+		return buffer;
+	}
+
+	void testPolyphase(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "polyphase resampler";
+
+		const float speed = 48000 / 44100.f;
+		const size_t numFrames = 4410;
+		auto input = tone(1000, 4800, 1, 48000);
+		ofSoundBuffer output;
+		input.resampleTo(output, 0, numFrames, speed, false, ofSoundBuffer::Polyphase);
+		ofxTestEq(output.getNumFrames(), numFrames, "output frames");
+		// away from the edges, where the filter reads silence, the result
+		// is the same tone sampled at 44100Hz
+		float maxError = 0;
+		for(size_t i = 100; i < numFrames - 100; i++){
+			float expected = sin(glm::two_pi<double>() * 1000 * i * speed / 48000);
+			maxError = std::max(maxError, std::abs(output[i] - expected));
+		}
+		ofxTestGt(0.001f, maxError, "resampled tone matches the reference");
+
+		// a tone over the new nyquist frequency is filtered instead of aliasing
+		auto high = tone(23000, 4800, 1, 48000);
+		high.resampleTo(output, 0, numFrames, speed, false, ofSoundBuffer::Polyphase);
+		float aliasing = 0;
+		for(size_t i = 100; i < numFrames - 100; i++){
+			aliasing = std::max(aliasing, std::abs(output[i]));
+		}
+		ofxTestGt(0.001f, aliasing, "frequencies over nyquist are filtered");
+		high.resampleTo(output, 0, numFrames, speed, false, ofSoundBuffer::Linear);
+		ofLogNotice() << "aliasing: polyphase " << aliasing << ", linear " << output.getRMSAmplitude() * sqrt(2.f);
+
+		// every channel is resampled like a mono buffer
+		auto multichannel = randomBuffer(4800, 64);
+		ofSoundBuffer channel, resampledChannel, resampled;
+		multichannel.getChannel(channel, 37);
+		multichannel.resampleTo(resampled, 10, numFrames, speed, true, ofSoundBuffer::Polyphase);
+		channel.resampleTo(resampledChannel, 10, numFrames, speed, true, ofSoundBuffer::Polyphase);
+		resampled.getChannel(channel, 37);
+		bool equal = true;
+		for(size_t i = 0; i < numFrames; i++){
+			equal &= std::abs(channel[i] - resampledChannel[i]) < 1e-5f;
+		}
+		ofxTest(equal, "channels are resampled independently");
+	}
+
+	void benchmarkSIMD(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "SIMD benchmark";
+
+		auto stereo = randomBuffer(1 << 20, 2);
+		auto mono = randomBuffer(1 << 20, 1);
+		std::vector<short> pcm;
+		for(bool simd: {false, true}){
+			ofSetSoundBufferUsingSIMD(simd);
+			auto buffer = stereo;
+			auto then = ofGetElapsedTimeMicros();
+			buffer *= 0.5f;
+			auto gain = ofGetElapsedTimeMicros() - then;
+			then = ofGetElapsedTimeMicros();
+			stereo.addTo(buffer, 0, false);
+			mono.addTo(buffer, 0, false);
+			auto mix = ofGetElapsedTimeMicros() - then;
+			then = ofGetElapsedTimeMicros();
+			buffer.toShortPCM(pcm);
+			buffer.copyFrom(pcm, 2, 44100);
+			auto conversion = ofGetElapsedTimeMicros() - then;
+			then = ofGetElapsedTimeMicros();
+			buffer.getRMSAmplitude();
+			auto rms = ofGetElapsedTimeMicros() - then;
+			ofLogNotice() << (simd ? "SIMD" : "scalar") << " 1M stereo frames: gain " << gain << "us, mix " << mix
+				<< "us, short conversion " << conversion << "us, RMS " << rms << "us";
+		}
+		ofSetSoundBufferUsingSIMD(true);
+
+		auto input = randomBuffer(48000, 64);
+		ofSoundBuffer output;
+		auto then = ofGetElapsedTimeMicros();
+		input.resampleTo(output, 0, 44100, 48000 / 44100.f, false, ofSoundBuffer::Polyphase);
+		auto micros = ofGetElapsedTimeMicros() - then;
+		ofLogNotice() << "polyphase 48000 to 44100Hz, 64 channels: " << micros / 1000. << "ms per second of audio";
+	}
+
+	// the callback of ofRtAudioSoundStream before and after wrapping the
+	// device memory, with a callback that writes a tone to every sample
+	double copyingCallbackMicros(size_t numFrames, int numCallbacks){
+		const size_t numChannels = 2;
+		std::vector<float> in(numFrames * numChannels), out(numFrames * numChannels);
+		ofSoundBuffer inputBuffer, outputBuffer;
+		float phase = 0;
+		auto then = ofGetElapsedTimeMicros();
+		for(int i = 0; i < numCallbacks; i++){
+			inputBuffer.copyFrom(in.data(), numFrames, numChannels, 44100);
+			if(outputBuffer.size() != numFrames * numChannels){
+				outputBuffer.setNumChannels(numChannels);
+				outputBuffer.resize(numFrames * numChannels);
+			}
+			phase = outputBuffer.fillWithTone(440, phase);
+			outputBuffer.copyTo(out.data(), numFrames, numChannels, 0);
+			outputBuffer.set(0);
+		}
+		return double(ofGetElapsedTimeMicros() - then) / numCallbacks;
+	}
+
+	double wrappingCallbackMicros(size_t numFrames, int numCallbacks){
+		const size_t numChannels = 2;
+		std::vector<float> in(numFrames * numChannels), out(numFrames * numChannels);
+		ofSoundBuffer inputBuffer, outputBuffer;
+		float phase = 0;
+		auto then = ofGetElapsedTimeMicros();
+		for(int i = 0; i < numCallbacks; i++){
+			inputBuffer.setFromExternalBuffer(in.data(), numFrames, numChannels, 44100);
+			inputBuffer.clear();
+			memset(out.data(), 0, out.size() * sizeof(float));
+			outputBuffer.setFromExternalBuffer(out.data(), numFrames, numChannels, 44100);
+			phase = outputBuffer.fillWithTone(440, phase);
+			outputBuffer.clear();
+		}
+		return double(ofGetElapsedTimeMicros() - then) / numCallbacks;
+	}
+
+	void benchmark(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "callback benchmark";
+
+		const int numCallbacks = 100000;
+		for(size_t numFrames: {32, 64, 256}){
+			auto copying = copyingCallbackMicros(numFrames, numCallbacks);
+			auto wrapping = wrappingCallbackMicros(numFrames, numCallbacks);
+			ofLogNotice() << numFrames << " frames: copying " << copying << "us, wrapping " << wrapping << "us per callback";
+		}
+	}
+
+	void run(){
+		testExternalBuffer();
+		testSIMD();
+		testPolyphase();
+		benchmark();
+		benchmarkSIMD();
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -3,7 +3,7 @@
 #include "ofxUnitTests.h"
 
 class ofApp: public ofxUnitTestsApp{
-	void run(){
+	void testGroupRemove(){
 		ofParameter<float> p1{"p>1", 0, 0, 1000};
 		ofParameter<float> p2{"p>2", 0, 0, 1000};
 		ofParameter<float> p3{"p>3", 0, 0, 1000};
@@ -25,6 +25,116 @@ class ofApp: public ofxUnitTestsApp{
 		ofxTest(!group.contains("p>3"), "Group shouldn't contain p2 after remove");
 		ofxTestEq(group.get("p>4").getName(), "p>4", "p4 name " + group.get("p>4").getName() + " should be p>4, probably index map is corrupt"); //Issue #6016
 	}
+
+	void testThreadSafe(){
+		ofParameter<float> gain{"gain", 0.5f, 0, 1};
+		ofParameter<ofFloatColor> color{"color", ofFloatColor(0, 0)};
+		ofParameter<std::string> label{"label", ""};
+		gain.setThreadSafe(true);
+		color.setThreadSafe(true);
+		label.setThreadSafe(true);
+		ofxTest(gain.isThreadSafe() && color.isThreadSafe(), "numbers and colors can be thread safe");
+		ofxTest(!label.isThreadSafe(), "strings can't be thread safe");
+
+		gain = 0.25f;
+		ofxTestEq(gain.getAtomic(), 0.25f, "set is visible to getAtomic");
+		gain += 0.25f;
+		ofxTestEq(gain.getAtomic(), 0.5f, "operators are visible to getAtomic");
+
+		// a writer changes every component of the color at once, a reader
+		// in another thread should never see half of a color
+		std::atomic<bool> done{false};
+		std::thread writer([&]{
+			for(int i = 0; i < 100000; i++){
+				float v = i / 100000.f;
+				color.setAtomic(ofFloatColor(v, v, v, v));
+			}
+			done = true;
+		});
+		bool torn = false;
+		while(!done){
+			auto c = color.getAtomic();
+			torn |= c.r != c.g || c.g != c.b || c.b != c.a;
+		}
+		writer.join();
+		ofxTest(!torn, "getAtomic never returns a partially written value");
+		ofxTestEq(color.get(), ofFloatColor(0, 0), "setAtomic doesn't change get until notified");
+	}
+
+	void testChangeQueue(){
+		ofParameter<float> gain{"gain", 0, 0, 1};
+		ofParameter<int> voices{"voices", 1, 1, 16};
+		ofParameterGroup synth{"synth", gain, voices};
+		gain.setThreadSafe(true);
+		voices.setThreadSafe(true);
+
+		std::thread::id listenerThread;
+		int numGainChanges = 0;
+		int numGroupChanges = 0;
+		float lastGain = 0;
+		auto gainListener = gain.newListener([&](float & g){
+			numGainChanges++;
+			lastGain = g;
+			listenerThread = std::this_thread::get_id();
+		});
+		auto groupListener = synth.parameterChangedE().newListener([&](ofAbstractParameter &){
+			numGroupChanges++;
+		});
+
+		ofParameterChangeQueue changes;
+		changes.add(synth);
+		std::thread writer([&]{
+			for(int i = 1; i <= 100; i++){
+				gain.setAtomic(i / 100.f);
+			}
+		});
+		writer.join();
+		ofxTestEq(numGainChanges, 0, "setAtomic doesn't notify from the writing thread");
+
+		ofxTestEq(changes.notify(), size_t(1), "one parameter changed");
+		ofxTestEq(numGainChanges, 1, "several changes are notified once");
+		ofxTestEq(lastGain, 1.f, "the last value is notified");
+		ofxTestEq(gain.get(), 1.f, "get returns the notified value");
+		ofxTestEq(numGroupChanges, 1, "the group is notified");
+		ofxTest(listenerThread == std::this_thread::get_id(), "listeners are called from the thread that calls notify");
+		ofxTestEq(changes.notify(), size_t(0), "changes are notified once");
+
+		changes.remove(gain);
+		gain.setAtomic(0.5f);
+		voices.setAtomic(4);
+		ofxTestEq(changes.notify(), size_t(1), "removed parameters are not notified");
+		ofxTestEq(voices.get(), 4, "parameters of a group are notified");
+	}
+
+	void benchmark(){
+		ofParameter<float> gain{"gain", 0, 0, 1};
+		gain.setThreadSafe(true);
+		std::atomic<bool> done{false};
+		std::thread writer([&]{
+			float v = 0;
+			while(!done){
+				gain.setAtomic(v);
+				v = 1 - v;
+			}
+		});
+		const int numReads = 10000000;
+		float sum = 0;
+		auto then = ofGetElapsedTimeMicros();
+		for(int i = 0; i < numReads; i++){
+			sum += gain.getAtomic();
+		}
+		auto micros = ofGetElapsedTimeMicros() - then;
+		done = true;
+		writer.join();
+		ofLogNotice() << "getAtomic while another thread writes: " << micros * 1000. / numReads << "ns per read (" << sum << ")";
+	}
+
+	void run(){
+		testGroupRemove();
+		testThreadSafe();
+		testChangeQueue();
+		benchmark();
+	}
 };
 
 //========================================================================
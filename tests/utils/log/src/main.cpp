@@ -0,0 +1,185 @@
+#include "ofLog.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#include <map>
+
+// collects the messages logged to it
+class ofMemoryLoggerChannel: public ofBaseLoggerChannel{
+public:
+	void log(ofLogLevel level, const std::string & module, const std::string & message){
+		std::unique_lock<std::mutex> lock(mutex);
+		messages.push_back(module + ": " + message);
+	}
+	void log(ofLogLevel level, const std::string & module, const char* format, ...){
+		va_list args;
+		va_start(args, format);
+		log(level, module, format, args);
+		va_end(args);
+	}
+	void log(ofLogLevel level, const std::string & module, const char* format, va_list args){
+		log(level, module, ofVAArgsToString(format, args));
+	}
+
+	std::mutex mutex;
+	std::vector<std::string> messages;
+};
+
+// discards every message, to measure the cost of logging itself
+class ofNullLoggerChannel: public ofBaseLoggerChannel{
+public:
+	void log(ofLogLevel, const std::string &, const std::string &){}
+	void log(ofLogLevel, const std::string &, const char*, ...){}
+	void log(ofLogLevel, const std::string &, const char*, va_list){}
+};
+
+// counts how many times it is formatted
+struct Counted{
+	int & count;
+};
+
+std::ostream & operator<<(std::ostream & os, const Counted & counted){
+	counted.count++;
+	return os << "counted";
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void testLevels(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "levels";
+
+		auto memory = std::make_shared<ofMemoryLoggerChannel>();
+		auto previous = ofGetLoggerChannel();
+		ofSetLoggerChannel(memory);
+
+		int numFormatted = 0;
+		ofSetLogLevel(OF_LOG_NOTICE);
+		ofLogVerbose("module") << Counted{numFormatted};
+		ofLogNotice("module") << Counted{numFormatted};
+		ofSetLogLevel("verbose", OF_LOG_VERBOSE);
+		ofSetLogLevel("error", OF_LOG_ERROR);
+		ofLogVerbose("verbose") << "verbose";
+		ofLogVerbose("module") << "filtered";
+		ofLogWarning("error") << "filtered";
+		ofLogWarning("module") << "warning";
+		ofLogError("error", "%d", 1);
+		ofLog(OF_LOG_VERBOSE) << Counted{numFormatted};
+		ofLog() << "notice";
+		auto verboseLevel = ofGetLogLevel("verbose");
+		auto defaultLevel = ofGetLogLevel("unknown");
+		ofSetLogLevel("verbose", OF_LOG_NOTICE);
+		ofSetLogLevel("error", OF_LOG_NOTICE);
+
+		ofSetLoggerChannel(previous);
+		ofxTestEq(numFormatted, 1, "filtered messages are not formatted");
+		ofxTest(memory->messages == std::vector<std::string>({"module: counted", "verbose: verbose", "module: warning", "error: 1", ": notice"}), "module levels filter messages");
+		ofxTestEq(verboseLevel, OF_LOG_VERBOSE, "module level");
+		ofxTestEq(defaultLevel, OF_LOG_NOTICE, "modules without a level use the global one");
+	}
+
+	void testAsync(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "async channel";
+
+		auto memory = std::make_shared<ofMemoryLoggerChannel>();
+		auto previous = ofGetLoggerChannel();
+		uint64_t numDropped;
+		{
+			auto async = std::make_shared<ofAsyncLoggerChannel>(memory, 64, true);
+			ofSetLoggerChannel(async);
+			const int numThreads = 4;
+			const int numMessages = 10000;
+			std::vector<std::thread> threads;
+			for(int i = 0; i < numThreads; i++){
+				threads.emplace_back([i, numMessages]{
+					for(int j = 0; j < numMessages; j++){
+						ofLogNotice("thread" + ofToString(i)) << j;
+					}
+				});
+			}
+			for(auto & thread: threads){
+				thread.join();
+			}
+			async->flush();
+			numDropped = async->getNumDropped();
+			ofSetLoggerChannel(previous);
+		}
+
+		std::map<std::string, int> last;
+		bool inOrder = true;
+		for(auto & message: memory->messages){
+			auto separator = message.find(": ");
+			auto module = message.substr(0, separator);
+			auto value = ofToInt(message.substr(separator + 2));
+			inOrder &= last.find(module) == last.end() || last[module] == value - 1;
+			last[module] = value;
+		}
+		ofxTestEq(memory->messages.size(), size_t(40000), "a blocking async channel writes every message");
+		ofxTestEq(numDropped, uint64_t(0), "a blocking async channel doesn't drop messages");
+		ofxTest(inOrder, "messages of each thread are written in order");
+
+		{
+			auto async = std::make_shared<ofAsyncLoggerChannel>(memory, 4);
+			memory->messages.clear();
+			async->log(OF_LOG_NOTICE, "module", "%s %d", "formatted", 1);
+			async->log(OF_LOG_NOTICE, "module", "message");
+		}
+		ofxTest(memory->messages == std::vector<std::string>({"module: formatted 1", "module: message"}), "pending messages are written when the channel is destroyed");
+	}
+
+	template<typename Func>
+	double nanosPerCall(Func func, int numCalls){
+		auto then = ofGetElapsedTimeMicros();
+		for(int i = 0; i < numCalls; i++){
+			func(i);
+		}
+		return (ofGetElapsedTimeMicros() - then) * 1000.0 / numCalls;
+	}
+
+	void benchmark(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "benchmark";
+
+		auto previous = ofGetLoggerChannel();
+		const int numCalls = 100000;
+		double filtered, emitted, emittedAsync;
+		uint64_t numDropped;
+		{
+			auto async = std::make_shared<ofAsyncLoggerChannel>(std::make_shared<ofNullLoggerChannel>(), 1024);
+			ofSetLoggerChannel(std::make_shared<ofNullLoggerChannel>());
+			filtered = nanosPerCall([](int i){
+				ofLogVerbose("benchmark") << "message " << i;
+			}, numCalls);
+			emitted = nanosPerCall([](int i){
+				ofLogNotice("benchmark") << "message " << i;
+			}, numCalls);
+			ofSetLoggerChannel(async);
+			emittedAsync = nanosPerCall([](int i){
+				ofLogNotice("benchmark") << "message " << i;
+			}, numCalls);
+			async->flush();
+			numDropped = async->getNumDropped();
+			ofSetLoggerChannel(previous);
+		}
+		ofLogNotice() << "filtered: " << filtered << "ns per message";
+		ofLogNotice() << "emitted: " << emitted << "ns per message";
+		ofLogNotice() << "emitted to an async channel: " << emittedAsync << "ns per message, " << numDropped << " dropped";
+	}
+
+	void run(){
+		testLevels();
+		testAsync();
+		benchmark();
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
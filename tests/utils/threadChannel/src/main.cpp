@@ -0,0 +1,170 @@
+#include "ofThreadChannel.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	template<typename Channel>
+	bool sendAndReceiveInOrder(Channel & channel, int numValues){
+		std::thread sender([&]{
+			for(int i = 0; i < numValues; i++){
+				channel.send(i);
+			}
+		});
+		bool inOrder = true;
+		int value;
+		for(int i = 0; i < numValues; i++){
+			inOrder &= channel.receive(value) && value == i;
+		}
+		sender.join();
+		return inOrder;
+	}
+
+	void testSPSC(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "spsc channel";
+
+		{
+			ofSPSCThreadChannel<int> channel(100);
+			ofxTestEq(channel.capacity(), std::size_t(128), "capacity is rounded up to a power of two");
+			ofxTest(sendAndReceiveInOrder(channel, 100000), "blocking channel receives every value in order");
+			ofxTestEq(channel.getNumDropped(), uint64_t(0), "blocking channel doesn't drop values");
+			ofxTest(channel.empty(), "channel is empty after receiving everything");
+		}
+
+		{
+			ofSPSCThreadChannel<int> channel(4, OF_THREAD_CHANNEL_DROP_OLDEST);
+			for(int i = 0; i < 10; i++){
+				ofxTest(channel.send(i), "drop oldest always accepts new values");
+			}
+			std::vector<int> received;
+			int value;
+			while(channel.tryReceive(value)){
+				received.push_back(value);
+			}
+			ofxTest(received == std::vector<int>({6, 7, 8, 9}), "drop oldest keeps the most recent values");
+			ofxTestEq(channel.getNumDropped(), uint64_t(6), "drop oldest counts dropped values");
+		}
+
+		{
+			ofSPSCThreadChannel<int> channel(4, OF_THREAD_CHANNEL_DROP_NEWEST);
+			int numSent = 0;
+			for(int i = 0; i < 10; i++){
+				numSent += channel.send(i);
+			}
+			ofxTestEq(numSent, 4, "drop newest rejects values when full");
+			std::vector<int> received;
+			int value;
+			while(channel.tryReceive(value)){
+				received.push_back(value);
+			}
+			ofxTest(received == std::vector<int>({0, 1, 2, 3}), "drop newest keeps the oldest values");
+		}
+
+		{
+			ofSPSCThreadChannel<std::string> channel(8, OF_THREAD_CHANNEL_DROP_OLDEST);
+			const int numValues = 100000;
+			std::thread sender([&]{
+				for(int i = 0; i < numValues; i++){
+					channel.send(ofToString(i));
+				}
+				channel.send(std::string("end"));
+			});
+			bool inOrder = true;
+			int numReceived = 0;
+			int last = -1;
+			std::string value;
+			while(channel.tryReceive(value, 1000) && value != "end"){
+				int current = ofToInt(value);
+				inOrder &= current > last;
+				last = current;
+				numReceived++;
+			}
+			sender.join();
+			ofxTest(inOrder, "drop oldest receives values in order while sending concurrently");
+			ofxTestEq(numReceived + channel.getNumDropped(), uint64_t(numValues), "every value is either received or dropped");
+		}
+
+		{
+			ofSPSCThreadChannel<int> channel(2);
+			channel.send(0);
+			channel.send(1);
+			std::thread sender([&]{
+				ofxTest(!channel.send(2), "close wakes up a sender blocked on a full channel");
+			});
+			ofSleepMillis(20);
+			channel.close();
+			sender.join();
+			int value;
+			ofxTest(!channel.receive(value), "receive fails after close");
+		}
+	}
+
+	template<typename Channel>
+	double throughput(Channel & channel, int numValues){
+		auto then = ofGetElapsedTimeMicros();
+		sendAndReceiveInOrder(channel, numValues);
+		return numValues / double(ofGetElapsedTimeMicros() - then);
+	}
+
+	template<typename Channel>
+	double roundTripMicros(Channel & ping, Channel & pong, int numValues){
+		std::thread echo([&]{
+			int value;
+			for(int i = 0; i < numValues; i++){
+				ping.receive(value);
+				pong.send(value);
+			}
+		});
+		auto then = ofGetElapsedTimeMicros();
+		int value;
+		for(int i = 0; i < numValues; i++){
+			ping.send(i);
+			pong.receive(value);
+		}
+		auto now = ofGetElapsedTimeMicros();
+		echo.join();
+		return double(now - then) / numValues;
+	}
+
+	void benchmark(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "benchmark";
+
+		const int numValues = 1000000;
+		{
+			ofThreadChannel<int> channel;
+			ofLogNotice() << "ofThreadChannel throughput: " << throughput(channel, numValues) << " Mvalues/s";
+		}
+		{
+			ofSPSCThreadChannel<int> channel(1024);
+			ofLogNotice() << "ofSPSCThreadChannel throughput: " << throughput(channel, numValues) << " Mvalues/s";
+		}
+
+		const int numRoundTrips = 100000;
+		{
+			ofThreadChannel<int> ping, pong;
+			ofLogNotice() << "ofThreadChannel round trip: " << roundTripMicros(ping, pong, numRoundTrips) << "us";
+		}
+		{
+			ofSPSCThreadChannel<int> ping(64), pong(64);
+			ofLogNotice() << "ofSPSCThreadChannel round trip: " << roundTripMicros(ping, pong, numRoundTrips) << "us";
+		}
+	}
+
+	void run(){
+		testSPSC();
+		benchmark();
+	}
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
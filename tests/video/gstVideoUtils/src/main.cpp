@@ -0,0 +1,325 @@
+#include "ofConstants.h"
+#include "ofUtils.h"
+#include "ofxUnitTests.h"
+#if defined(OF_VIDEO_PLAYER_GSTREAMER) && !defined(TARGET_ANDROID)
+#include "ofGstUtils.h"
+
+static const int NUM_FRAMES = 60;
+#endif
+
+class ofApp: public ofxUnitTestsApp{
+#if defined(OF_VIDEO_PLAYER_GSTREAMER) && !defined(TARGET_ANDROID)
+	// 60fps test video played in real time, a second by default
+	bool load(ofGstVideoUtils & video, size_t numBuffers, bool copyPixels, int numFrames = NUM_FRAMES){
+		std::string pipeline = "videotestsrc num-buffers=" + ofToString(numFrames)
+			+ " ! video/x-raw,format=RGB,width=320,height=240,framerate=60/1"
+			+ " ! appsink name=sink enable-last-sample=0";
+		video.setCopyPixels(copyPixels);
+		video.setNumBuffers(numBuffers);
+		return video.setPipelineWithSink(pipeline, "sink") && video.startPipeline();
+	}
+
+	bool play(ofGstVideoUtils & video, size_t numBuffers, bool copyPixels){
+		if(!load(video, numBuffers, copyPixels)){
+			return false;
+		}
+		video.play();
+		return true;
+	}
+
+	void waitForEOS(ofGstVideoUtils & video){
+		auto then = ofGetElapsedTimeMillis();
+		while(!video.getIsMovieDone() && ofGetElapsedTimeMillis() - then < 5000){
+			ofSleepMillis(5);
+		}
+	}
+
+	void testStalledApp(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "stalled app";
+
+		// nothing calls update while the video plays, only the newest
+		// frames are kept. the first sample only allocates the pixels
+		ofGstVideoUtils video;
+		ofxTest(play(video, 4, true), "videotestsrc pipeline starts");
+		waitForEOS(video);
+		ofxTestEq(video.getNumQueuedFrames(), size_t(4), "the queue keeps numBuffers frames");
+		ofxTestEq(video.getNumDroppedFrames(), uint64_t(NUM_FRAMES - 4), "older frames are dropped");
+
+		video.update();
+		ofxTest(video.isFrameNew(), "update makes the newest frame current");
+		ofxTestEq(video.getFramePTSNanos(), int64_t((NUM_FRAMES - 1) * GST_SECOND / 60), "the current frame is the last one");
+		ofxTest(std::abs(video.getFrameDurationNanos() - int64_t(GST_SECOND / 60)) <= 1, "frames carry their duration");
+		ofxTestEq(video.getPixels().getWidth(), size_t(320), "the current frame has pixels");
+		ofxTestEq(video.getNumQueuedFrames(), size_t(0), "update takes every queued frame");
+		video.update();
+		ofxTest(!video.isFrameNew(), "no new frame without new samples");
+	}
+
+	void testPrerolled(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "prerolled";
+
+		// the pixels are allocated before the pipeline starts so the
+		// prerolled frame is queued, the appsink delivers it again as the
+		// first sample once playing
+		ofGstVideoUtils video;
+		video.setNumBuffers(NUM_FRAMES * 2);
+		std::string pipeline = "videotestsrc num-buffers=" + ofToString(NUM_FRAMES) + " ! video/x-raw,framerate=60/1";
+		ofxTest(video.setPipeline(pipeline, OF_PIXELS_RGB, false, 320, 240) && video.startPipeline(), "preallocated pipeline starts");
+		ofxTestEq(video.getNumQueuedFrames(), size_t(1), "the prerolled frame is queued");
+		video.play();
+		waitForEOS(video);
+		ofxTestEq(video.getNumQueuedFrames(), size_t(NUM_FRAMES), "the prerolled frame is queued once");
+		ofxTestEq(video.getNumDroppedFrames(), uint64_t(0), "no frame is dropped");
+	}
+
+	void testPacedPlayback(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "paced playback";
+
+		ofGstVideoUtils video;
+		ofxTest(play(video, 8, false), "videotestsrc pipeline starts");
+		ofxTest(!video.updateToTime(-1), "no frame is due before the first timestamp");
+
+		int64_t lastPTS = -1;
+		bool inOrder = true;
+		bool onTime = true;
+		int numFrames = 0;
+		while(!video.getIsMovieDone()){
+			auto position = video.getPositionNanos();
+			if(video.updateToTime(position)){
+				inOrder &= video.getFramePTSNanos() > lastPTS;
+				onTime &= video.getFramePTSNanos() <= position;
+				lastPTS = video.getFramePTSNanos();
+				numFrames++;
+			}
+			ofSleepMillis(2);
+		}
+		while(video.updateToTime(std::numeric_limits<int64_t>::max())){
+			numFrames++;
+		}
+		ofxTest(inOrder, "frames are presented in order");
+		ofxTest(onTime, "frames are not presented before their time");
+		ofxTestEq(numFrames + video.getNumLateFrames() + video.getNumDroppedFrames(), uint64_t(NUM_FRAMES), "every frame is presented, late or dropped");
+	}
+
+	void testSeek(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "seek";
+
+		// the frames queued before a flushing seek are dropped once it
+		// reaches the sink, they would block the frames at the new position
+		// until their timestamp came around
+		ofGstVideoUtils video;
+		ofxTest(play(video, 8, true), "videotestsrc pipeline starts");
+		ofSleepMillis(500);
+		auto flags = (GstSeekFlags)(GST_SEEK_FLAG_ACCURATE | GST_SEEK_FLAG_FLUSH);
+		ofxTest(gst_element_seek_simple(video.getPipeline(), GST_FORMAT_TIME, flags, GST_SECOND / 10), "the pipeline seeks");
+		bool seeked = false;
+		auto then = ofGetElapsedTimeMillis();
+		while(!seeked && ofGetElapsedTimeMillis() - then < 200){
+			if(video.updateToTime(video.getPositionNanos())){
+				seeked = video.getFramePTSNanos() < GST_SECOND / 2;
+			}
+			ofSleepMillis(2);
+		}
+		ofxTest(seeked, "frames at the new position are presented right after seeking");
+	}
+
+	// an app that takes 2 frames of video to draw each of its frames and
+	// sometimes stalls for 100ms
+	void benchmark(size_t numBuffers, bool copyPixels, bool paced){
+		ofGstVideoUtils video;
+		if(!play(video, numBuffers, copyPixels)){
+			return;
+		}
+		uint64_t updateNanos = 0;
+		int numUpdates = 0;
+		int numFrames = 0;
+		while(!video.getIsMovieDone()){
+			auto then = ofGetElapsedTimeMicros();
+			bool isFrameNew;
+			if(paced){
+				isFrameNew = video.updateToTime(video.getPositionNanos());
+			}else{
+				video.update();
+				isFrameNew = video.isFrameNew();
+			}
+			updateNanos += (ofGetElapsedTimeMicros() - then) * 1000;
+			numUpdates++;
+			numFrames += isFrameNew;
+			ofSleepMillis(numUpdates % 20 == 0 ? 100 : 33);
+		}
+		ofLogNotice() << numBuffers << " buffers, " << (copyPixels ? "copying, " : "wrapping, ")
+			<< (paced ? "updateToTime: " : "update: ")
+			<< numFrames << " frames presented, " << video.getNumDroppedFrames() << " dropped, "
+			<< video.getNumLateFrames() << " late, " << updateNanos / numUpdates << "ns per update";
+	}
+
+	void benchmark(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "benchmark";
+		for(bool copyPixels: {true, false}){
+			benchmark(1, copyPixels, false);
+			benchmark(8, copyPixels, true);
+		}
+	}
+
+	void testGroup(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "video group";
+
+		std::vector<std::unique_ptr<ofGstVideoUtils>> videos;
+		ofGstVideoGroup group;
+		bool added = true;
+		for(int i = 0; i < 4; i++){
+			videos.emplace_back(new ofGstVideoUtils);
+			added &= load(*videos.back(), 1, true, NUM_FRAMES * 2);
+			added &= group.add(*videos.back());
+		}
+		ofxTest(added, "videos are added to the group");
+
+		group.setPositionNanos(GST_SECOND / 2);
+		group.update();
+		bool seeked = true;
+		for(auto & video: videos){
+			seeked &= video->getFramePTSNanos() == GST_SECOND / 2;
+		}
+		ofxTest(seeked, "every video is at the seeked position");
+
+		group.play();
+		int64_t maxDrift = 0;
+		auto then = ofGetElapsedTimeMillis();
+		while(ofGetElapsedTimeMillis() - then < 500){
+			group.update();
+			maxDrift = std::max(maxDrift, group.getDriftNanos());
+			ofSleepMillis(5);
+		}
+
+		// frames decoded before seeking while playing are flushed, the
+		// group starts again from the frame at the new position
+		group.setPositionNanos(GST_SECOND / 4);
+		group.update();
+		bool seekedPlaying = true;
+		for(auto & video: videos){
+			seekedPlaying &= video->getFramePTSNanos() == GST_SECOND / 4;
+		}
+		ofxTest(seekedPlaying, "every video is at the position seeked while playing");
+
+		group.setPaused(true);
+		auto pausedPosition = group.getPositionNanos();
+		ofSleepMillis(200);
+		ofxTestEq(group.getPositionNanos(), pausedPosition, "the position doesn't change while paused");
+		group.play();
+		bool resumed = true;
+		while(!group.getIsMovieDone()){
+			group.update();
+			maxDrift = std::max(maxDrift, group.getDriftNanos());
+			resumed &= group.getPositionNanos() >= pausedPosition;
+			ofSleepMillis(5);
+		}
+		ofxTest(resumed, "playback continues from the paused position");
+		ofLogNotice() << "max drift " << maxDrift / 1000000. << "ms";
+		ofxTestGt(GST_SECOND / 60, maxDrift, "videos in a group don't drift apart");
+
+		group.clear();
+		bool released = true;
+		for(auto & video: videos){
+			released &= gst_element_get_start_time(video->getPipeline()) == 0;
+		}
+		ofxTest(released, "cleared videos choose their own base time again");
+	}
+
+	// process cpu time per stream and the biggest difference between the
+	// timestamps of the frames drawn at the same time, with every video
+	// playing on its own or in a group
+	void benchmarkGroup(size_t numVideos, bool grouped){
+		std::vector<std::unique_ptr<ofGstVideoUtils>> videos;
+		ofGstVideoGroup group;
+		for(size_t i = 0; i < numVideos; i++){
+			videos.emplace_back(new ofGstVideoUtils);
+			if(!load(*videos.back(), 1, true, NUM_FRAMES * 2)){
+				return;
+			}
+			if(grouped){
+				group.add(*videos.back());
+			}
+		}
+
+		auto cpuThen = std::clock();
+		auto then = ofGetElapsedTimeMicros();
+		int64_t maxDrift = 0;
+		if(grouped){
+			group.play();
+			while(!group.getIsMovieDone()){
+				group.update();
+				maxDrift = std::max(maxDrift, group.getDriftNanos());
+				ofSleepMillis(16);
+			}
+		}else{
+			for(auto & video: videos){
+				video->play();
+			}
+			bool done = false;
+			while(!done){
+				done = true;
+				int64_t oldest = std::numeric_limits<int64_t>::max();
+				int64_t newest = 0;
+				for(auto & video: videos){
+					video->update();
+					if(video->getFramePTSNanos() >= 0){
+						oldest = std::min(oldest, video->getFramePTSNanos());
+						newest = std::max(newest, video->getFramePTSNanos());
+					}
+					done &= video->getIsMovieDone();
+				}
+				if(newest >= oldest){
+					maxDrift = std::max(maxDrift, newest - oldest);
+				}
+				ofSleepMillis(16);
+			}
+		}
+		double seconds = (ofGetElapsedTimeMicros() - then) / 1000000.;
+		double cpuSeconds = double(std::clock() - cpuThen) / CLOCKS_PER_SEC;
+		ofLogNotice() << numVideos << (grouped ? " videos in a group: " : " independent videos: ")
+			<< cpuSeconds / seconds / numVideos * 100 << "% cpu per stream, max drift "
+			<< maxDrift / 1000000. << "ms";
+	}
+
+	void benchmarkGroup(){
+		ofLogNotice() << "-------------------";
+		ofLogNotice() << "video group benchmark";
+		for(size_t numVideos: {1, 8, 24}){
+			benchmarkGroup(numVideos, false);
+			benchmarkGroup(numVideos, true);
+		}
+	}
+
+	void run(){
+		testStalledApp();
+		testPrerolled();
+		testPacedPlayback();
+		testSeek();
+		testGroup();
+		benchmark();
+		benchmarkGroup();
+	}
+#else
+	void run(){
+		ofLogNotice() << "ofGstVideoUtils is only available with gstreamer";
+	}
+#endif
+};
+
+
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}